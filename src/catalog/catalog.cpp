@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 #include "catalog/catalog.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "catalog/manager.h"
@@ -19,6 +20,7 @@
 #include "expression/string_functions.h"
 #include "expression/date_functions.h"
 #include "index/index_factory.h"
+#include "optimizer/stats_storage.h"
 #include "util/string_util.h"
 
 namespace peloton {
@@ -30,7 +32,9 @@ Catalog *Catalog::GetInstance(void) {
   return global_catalog.get();
 }
 
-Catalog::Catalog() {
+std::atomic<uint64_t> Catalog::version_(0);
+
+Catalog::Catalog() : databases_(new DatabaseSet()) {
   CreateCatalogDatabase();
 
   // Create metrics table in default database
@@ -62,6 +66,11 @@ void Catalog::CreateMetricsCatalog() {
   auto query_metrics_catalog = CreateMetricsCatalog(default_db_oid,
       QUERY_METRIC_NAME);
   default_db->AddTable(query_metrics_catalog.release(), true);
+
+  // Create table for the column statistics of ANALYZE
+  auto column_stats_catalog = CreateMetricsCatalog(default_db_oid,
+      COLUMN_STATS_NAME);
+  default_db->AddTable(column_stats_catalog.release(), true);
   LOG_TRACE("Metrics tables created");
 }
 
@@ -76,24 +85,29 @@ void Catalog::CreateCatalogDatabase() {
   auto table_catalog = CreateTableCatalog(START_OID, TABLE_CATALOG_NAME);
   storage::DataTable *tables_table = table_catalog.release();
   database->AddTable(tables_table, true);
-  databases_.push_back(database);
+  {
+    std::lock_guard<std::mutex> lock(catalog_mutex_);
+    PushDatabase(database);
+  }
   LOG_TRACE("Catalog database created");
 }
 
 // Create a database
 ResultType Catalog::CreateDatabase(std::string database_name,
     concurrency::Transaction *txn) {
-  // Check if a database with the same name exists
-  for (auto database : databases_) {
-    if (database->GetDBName() == database_name) {
+  oid_t database_id;
+  {
+    std::lock_guard<std::mutex> lock(catalog_mutex_);
+    // Check if a database with the same name exists
+    if (GetDatabaseSet()->databases_by_name.count(database_name) > 0) {
       LOG_TRACE("Database already exists. Returning ResultType::FAILURE.");
       return ResultType::FAILURE;
     }
+    database_id = GetNextOid();
+    storage::Database *database = new storage::Database(database_id);
+    database->setDBName(database_name);
+    PushDatabase(database);
   }
-  oid_t database_id = GetNextOid();
-  storage::Database *database = new storage::Database(database_id);
-  database->setDBName(database_name);
-  databases_.push_back(database);
 
   InsertDatabaseIntoCatalogDatabase(database_id, database_name, txn);
 
@@ -102,7 +116,10 @@ ResultType Catalog::CreateDatabase(std::string database_name,
 }
 
 void Catalog::AddDatabase(storage::Database *database) {
-  databases_.push_back(database);
+  {
+    std::lock_guard<std::mutex> lock(catalog_mutex_);
+    PushDatabase(database);
+  }
   std::string database_name;
   InsertDatabaseIntoCatalogDatabase(database->GetOid(), database_name, nullptr);
 }
@@ -110,21 +127,51 @@ void Catalog::AddDatabase(storage::Database *database) {
 void Catalog::AddDatabase(std::string database_name,
                           storage::Database *database){
   database->setDBName(database_name);
-  databases_.push_back(database);
+  {
+    std::lock_guard<std::mutex> lock(catalog_mutex_);
+    PushDatabase(database);
+  }
   LOG_DEBUG("Added database with name: %s", database_name.c_str());
   InsertDatabaseIntoCatalogDatabase(database->GetOid(), database_name, nullptr);
 }
 
 
+void Catalog::SetDatabases(std::vector<storage::Database *> &&databases) {
+  std::shared_ptr<DatabaseSet> new_databases(new DatabaseSet());
+  new_databases->databases = std::move(databases);
+  // The first database of a name wins, as with a scan of the vector
+  for (auto database : new_databases->databases) {
+    new_databases->databases_by_name.emplace(database->GetDBName(), database);
+    new_databases->databases_by_oid.emplace(database->GetOid(), database);
+  }
+  std::atomic_store(&databases_, std::shared_ptr<const DatabaseSet>(
+                                     std::move(new_databases)));
+  IncrementVersion();
+}
+
+void Catalog::PushDatabase(storage::Database *database) {
+  auto databases = GetDatabaseSet()->databases;
+  databases.push_back(database);
+  SetDatabases(std::move(databases));
+}
+
+void Catalog::EraseDatabase(storage::Database *database) {
+  auto databases = GetDatabaseSet()->databases;
+  auto itr = std::find(databases.begin(), databases.end(), database);
+  PL_ASSERT(itr != databases.end());
+  databases.erase(itr);
+  SetDatabases(std::move(databases));
+}
+
 void Catalog::InsertDatabaseIntoCatalogDatabase(oid_t database_id,
     std::string &database_name, concurrency::Transaction *txn) {
   // Update catalog_db with this database info
   auto tuple =
       GetDatabaseCatalogTuple(
-          databases_[START_OID]->GetTableWithName(DATABASE_CATALOG_NAME)->GetSchema(),
+          GetDatabaseWithOid(START_OID)->GetTableWithName(DATABASE_CATALOG_NAME)->GetSchema(),
           database_id, database_name, pool_);
   catalog::InsertTuple(
-      databases_[START_OID]->GetTableWithName(DATABASE_CATALOG_NAME),
+      GetDatabaseWithOid(START_OID)->GetTableWithName(DATABASE_CATALOG_NAME),
       std::move(tuple), txn);
 }
 
@@ -165,11 +212,11 @@ ResultType Catalog::CreateTable(std::string database_name, std::string table_nam
       // Update catalog_table with this table info
       auto tuple =
           GetTableCatalogTuple(
-              databases_[START_OID]->GetTableWithName(TABLE_CATALOG_NAME)->GetSchema(),
+              GetDatabaseWithOid(START_OID)->GetTableWithName(TABLE_CATALOG_NAME)->GetSchema(),
               table_id, table_name, database_id, database->GetDBName(), pool_);
       // Another way of insertion using transaction manager
       catalog::InsertTuple(
-          databases_[START_OID]->GetTableWithName(TABLE_CATALOG_NAME),
+          GetDatabaseWithOid(START_OID)->GetTableWithName(TABLE_CATALOG_NAME),
           std::move(tuple), txn);
       return ResultType::SUCCESS;
     }
@@ -222,6 +269,7 @@ ResultType Catalog::CreatePrimaryIndex(const std::string &database_name,
     std::shared_ptr<index::Index> pkey_index(
         index::IndexFactory::GetIndex(index_metadata));
     table->AddIndex(pkey_index);
+    IncrementVersion();
 
     LOG_TRACE("Successfully created primary key index '%s' for table '%s'",
               pkey_index->GetName().c_str(), table->GetName().c_str());
@@ -285,6 +333,7 @@ ResultType Catalog::CreateIndex(const std::string &database_name,
     std::shared_ptr<index::Index> key_index(
         index::IndexFactory::GetIndex(index_metadata));
     table->AddIndex(key_index);
+    IncrementVersion();
 
     LOG_TRACE("Successfully add index for table %s", table->GetName().c_str());
     return ResultType::SUCCESS;
@@ -319,19 +368,14 @@ ResultType Catalog::DropDatabaseWithName(std::string database_name,
     catalog::DeleteTuple(
         GetDatabaseWithName(CATALOG_DATABASE_NAME)->GetTableWithName(
             DATABASE_CATALOG_NAME), database->GetOid(), txn);
-    oid_t database_offset = 0;
-    for (auto database : databases_) {
-      if (database->GetDBName() == database_name) {
-        LOG_TRACE("Deleting database object in database vector");
-        delete database;
-        break;
-      }
-      database_offset++;
+    // Drop the database, after it is no longer found
+    {
+      std::lock_guard<std::mutex> lock(catalog_mutex_);
+      LOG_TRACE("Deleting database from database vector");
+      EraseDatabase(database);
     }
-    PL_ASSERT(database_offset < databases_.size());
-    // Drop the database
-    LOG_TRACE("Deleting database from database vector");
-    databases_.erase(databases_.begin() + database_offset);
+    LOG_TRACE("Deleting database object");
+    delete database;
   } catch (CatalogException &e) {
     LOG_TRACE("Database is not found!");
     return ResultType::FAILURE;
@@ -343,25 +387,20 @@ ResultType Catalog::DropDatabaseWithName(std::string database_name,
 void Catalog::DropDatabaseWithOid(const oid_t database_oid) {
   LOG_TRACE("Dropping database with oid: %d", database_oid);
   try {
-    GetDatabaseWithOid(database_oid);
+    storage::Database *database = GetDatabaseWithOid(database_oid);
     LOG_TRACE("Found database!");
     LOG_TRACE("Deleting tuple from catalog");
     catalog::DeleteTuple(
         GetDatabaseWithName(CATALOG_DATABASE_NAME)->GetTableWithName(
             DATABASE_CATALOG_NAME), database_oid, nullptr);
-    oid_t database_offset = 0;
-    for (auto database : databases_) {
-      if (database->GetOid() == database_oid) {
-        LOG_TRACE("Deleting database object in database vector");
-        delete database;
-        break;
-      }
-      database_offset++;
+    // Drop the database, after it is no longer found
+    {
+      std::lock_guard<std::mutex> lock(catalog_mutex_);
+      LOG_TRACE("Deleting database from database vector");
+      EraseDatabase(database);
     }
-    PL_ASSERT(database_offset < databases_.size());
-    // Drop the database
-    LOG_TRACE("Deleting database from database vector");
-    databases_.erase(databases_.begin() + database_offset);
+    LOG_TRACE("Deleting database object");
+    delete database;
   } catch (CatalogException &e) {
     LOG_TRACE("Database is not found!");
   }
@@ -384,6 +423,7 @@ ResultType Catalog::DropTable(std::string database_name, std::string table_name,
       catalog::DeleteTuple(
           GetDatabaseWithName(CATALOG_DATABASE_NAME)->GetTableWithName(
               TABLE_CATALOG_NAME), table_id, txn);
+      optimizer::StatsStorage::GetInstance().DropTableStats(table_id, txn);
       LOG_TRACE("Deleting table!");
       database->DropTableWithOid(table_id);
       return ResultType::SUCCESS;
@@ -398,17 +438,15 @@ ResultType Catalog::DropTable(std::string database_name, std::string table_name,
 }
 
 bool Catalog::HasDatabase(const oid_t db_oid) const {
-  for (auto database : databases_)
-    if (database->GetOid() == db_oid)
-      return (true);
-  return (false);
+  return (GetDatabaseSet()->databases_by_oid.count(db_oid) > 0);
 }
 
 // Find a database using its id
 storage::Database *Catalog::GetDatabaseWithOid(const oid_t db_oid) const {
-  for (auto database : databases_)
-    if (database->GetOid() == db_oid)
-      return database;
+  auto databases = GetDatabaseSet();
+  auto itr = databases->databases_by_oid.find(db_oid);
+  if (itr != databases->databases_by_oid.end())
+    return itr->second;
   throw CatalogException(
       "Database with oid = " + std::to_string(db_oid) + " is not found");
   return nullptr;
@@ -417,18 +455,19 @@ storage::Database *Catalog::GetDatabaseWithOid(const oid_t db_oid) const {
 // Find a database using its name
 storage::Database *Catalog::GetDatabaseWithName(
     const std::string database_name) const {
-  for (auto database : databases_) {
-    if (database != nullptr && database->GetDBName() == database_name)
-      return database;
-  }
+  auto databases = GetDatabaseSet();
+  auto itr = databases->databases_by_name.find(database_name);
+  if (itr != databases->databases_by_name.end())
+    return itr->second;
   throw CatalogException("Database " + database_name + " is not found");
   return nullptr;
 }
 
 storage::Database *Catalog::GetDatabaseWithOffset(
     const oid_t database_offset) const {
-  PL_ASSERT(database_offset < databases_.size());
-  auto database = databases_.at(database_offset);
+  auto databases = GetDatabaseSet();
+  PL_ASSERT(database_offset < databases->databases.size());
+  auto database = databases->databases.at(database_offset);
   return database;
 }
 
@@ -437,11 +476,32 @@ storage::DataTable *Catalog::GetTableWithName(std::string database_name,
     std::string table_name) {
   LOG_TRACE("Looking for table %s in database %s", table_name.c_str(),
       database_name.c_str());
+  // Tables looked up by this thread since the catalog last changed
+  static thread_local uint64_t cached_version = 0;
+  static thread_local std::unordered_map<std::string, storage::DataTable *>
+      cached_tables;
+
+  uint64_t version = GetVersion();
+  if (cached_version != version) {
+    cached_tables.clear();
+    cached_version = version;
+  }
+  std::string key = database_name + '\0' + table_name;
+  auto itr = cached_tables.find(key);
+  if (itr != cached_tables.end()) {
+    LOG_TRACE("Found table in the cache.");
+    return itr->second;
+  }
+
   storage::Database *database = GetDatabaseWithName(database_name);
   if (database != nullptr) {
     storage::DataTable *table = database->GetTableWithName(table_name);
     if (table) {
       LOG_TRACE("Found table.");
+      // Only cache what was current for the whole lookup
+      if (GetVersion() == version) {
+        cached_tables.emplace(key, table);
+      }
       return table;
     } else {
       LOG_TRACE("Couldn't find table.");
@@ -519,6 +579,8 @@ std::unique_ptr<storage::DataTable> Catalog::CreateMetricsCatalog(
     schema = InitializeDatabaseMetricsSchema().release();
   } else if (table_name == INDEX_METRIC_NAME) {
     schema = InitializeIndexMetricsSchema().release();
+  } else if (table_name == COLUMN_STATS_NAME) {
+    schema = InitializeColumnStatsSchema().release();
   }
 
   std::unique_ptr<storage::DataTable> table(
@@ -744,11 +806,66 @@ std::unique_ptr<catalog::Schema> Catalog::InitializeQueryMetricsSchema() {
   return database_schema;
 }
 
+// Initialize column statistics catalog schema
+std::unique_ptr<catalog::Schema> Catalog::InitializeColumnStatsSchema() {
+  const std::string not_null_constraint_name = "not_null";
+  catalog::Constraint not_null_constraint(ConstraintType::NOTNULL,
+      not_null_constraint_name);
+  oid_t integer_type_size = type::Type::GetTypeSize(type::Type::INTEGER);
+  oid_t bigint_type_size = type::Type::GetTypeSize(type::Type::BIGINT);
+  oid_t decimal_type_size = type::Type::GetTypeSize(type::Type::DECIMAL);
+  oid_t varchar_type_size = type::Type::GetTypeSize(type::Type::VARCHAR);
+  type::Type::TypeId integer_type = type::Type::INTEGER;
+  type::Type::TypeId bigint_type = type::Type::BIGINT;
+  type::Type::TypeId decimal_type = type::Type::DECIMAL;
+  type::Type::TypeId varchar_type = type::Type::VARCHAR;
+
+  // The table id comes first, so that the rows of a table can be deleted
+  // with catalog::DeleteTuple()
+  auto table_id_column = catalog::Column(integer_type, integer_type_size,
+      "table_id", true);
+  table_id_column.AddConstraint(not_null_constraint);
+  auto column_id_column = catalog::Column(integer_type, integer_type_size,
+      "column_id", true);
+  column_id_column.AddConstraint(not_null_constraint);
+  auto database_id_column = catalog::Column(integer_type, integer_type_size,
+      "database_id", true);
+  database_id_column.AddConstraint(not_null_constraint);
+
+  auto num_rows_column = catalog::Column(bigint_type, bigint_type_size,
+      "num_rows", true);
+  num_rows_column.AddConstraint(not_null_constraint);
+  auto null_frac_column = catalog::Column(decimal_type, decimal_type_size,
+      "null_frac", true);
+  null_frac_column.AddConstraint(not_null_constraint);
+  auto num_distinct_column = catalog::Column(decimal_type, decimal_type_size,
+      "num_distinct", true);
+  num_distinct_column.AddConstraint(not_null_constraint);
+
+  // Lists of values, printed as text
+  auto most_common_vals_column = catalog::Column(varchar_type,
+      varchar_type_size, "most_common_vals", false);
+  auto most_common_freqs_column = catalog::Column(varchar_type,
+      varchar_type_size, "most_common_freqs", false);
+  auto histogram_bounds_column = catalog::Column(varchar_type,
+      varchar_type_size, "histogram_bounds", false);
+
+  auto timestamp_column = catalog::Column(bigint_type, bigint_type_size,
+      "time_stamp", true);
+  timestamp_column.AddConstraint(not_null_constraint);
+
+  std::unique_ptr<catalog::Schema> column_stats_schema(new catalog::Schema( {
+      table_id_column, column_id_column, database_id_column, num_rows_column,
+      null_frac_column, num_distinct_column, most_common_vals_column,
+      most_common_freqs_column, histogram_bounds_column, timestamp_column }));
+  return column_stats_schema;
+}
+
 void Catalog::PrintCatalogs() {
 }
 
 oid_t Catalog::GetDatabaseCount() {
-  return databases_.size();
+  return GetDatabaseSet()->databases.size();
 }
 
 oid_t Catalog::GetNextOid() {
@@ -267,5 +267,46 @@ std::unique_ptr<storage::Tuple> GetTableCatalogTuple(
   tuple->SetValue(3, val4, pool);
   return std::move(tuple);
 }
+
+/**
+ * Generate a column statistics tuple
+ * Input: The table schema, the table id, the column id, the database id, the
+ * number of rows, the fraction of nulls, the number of distinct values, the
+ * most common values and their frequencies, the histogram bounds, the
+ * timestamp
+ * Returns: The generated tuple
+ */
+std::unique_ptr<storage::Tuple> GetColumnStatsCatalogTuple(
+    const catalog::Schema *schema, oid_t table_id, oid_t column_id,
+    oid_t database_id, int64_t num_rows, double null_fraction,
+    double distinct_count, std::string most_common_values,
+    std::string most_common_frequencies, std::string histogram_bounds,
+    int64_t time_stamp, type::AbstractPool *pool) {
+  std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
+  auto val1 = type::ValueFactory::GetIntegerValue(table_id);
+  auto val2 = type::ValueFactory::GetIntegerValue(column_id);
+  auto val3 = type::ValueFactory::GetIntegerValue(database_id);
+  auto val4 = type::ValueFactory::GetBigIntValue(num_rows);
+  auto val5 = type::ValueFactory::GetDecimalValue(null_fraction);
+  auto val6 = type::ValueFactory::GetDecimalValue(distinct_count);
+  auto val7 = type::ValueFactory::GetVarcharValue(most_common_values, nullptr);
+  auto val8 =
+      type::ValueFactory::GetVarcharValue(most_common_frequencies, nullptr);
+  auto val9 = type::ValueFactory::GetVarcharValue(histogram_bounds, nullptr);
+  auto val10 = type::ValueFactory::GetBigIntValue(time_stamp);
+
+  tuple->SetValue(0, val1, nullptr);
+  tuple->SetValue(1, val2, nullptr);
+  tuple->SetValue(2, val3, nullptr);
+  tuple->SetValue(3, val4, nullptr);
+  tuple->SetValue(4, val5, nullptr);
+  tuple->SetValue(5, val6, nullptr);
+  tuple->SetValue(6, val7, pool);
+  tuple->SetValue(7, val8, pool);
+  tuple->SetValue(8, val9, pool);
+  tuple->SetValue(9, val10, nullptr);
+  return tuple;
+}
+
 }
 }
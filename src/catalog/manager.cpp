@@ -10,12 +10,15 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+
 #include "common/exception.h"
 #include "common/logger.h"
 #include "catalog/manager.h"
 #include "catalog/foreign_key.h"
 #include "storage/database.h"
 #include "storage/data_table.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "concurrency/transaction_manager_factory.h"
 
 namespace peloton {
@@ -38,13 +41,49 @@ void Manager::AddTileGroup(const oid_t oid,
                            std::shared_ptr<storage::TileGroup> location) {
 
   // add/update the catalog reference to the tile group
+  auto old_location = tile_group_locator_.Find(oid);
+  tile_group_ptr_locator_.Update(oid, location.get());
   tile_group_locator_.Update(oid, location);
+
+  if (old_location != nullptr && old_location != location) {
+    RetireTileGroup(std::move(old_location));
+  }
 }
 
 void Manager::DropTileGroup(const oid_t oid) {
-  
+  // readers that come after this do not find the tile group
+  tile_group_ptr_locator_.Erase(oid, nullptr);
+
   // drop the catalog reference to the tile group
+  auto tile_group = tile_group_locator_.Find(oid);
   tile_group_locator_.Erase(oid, empty_tile_group_);
+
+  if (tile_group != nullptr) {
+    RetireTileGroup(std::move(tile_group));
+  }
+}
+
+void Manager::RetireTileGroup(std::shared_ptr<storage::TileGroup> tile_group) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  // without a running epoch thread the epochs never retire. this is only
+  // the case when nothing runs transactions concurrently, like in tests.
+  if (epoch_manager.IsRunning() == false) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(retired_tile_groups_mutex_);
+  retired_tile_groups_.emplace_back(epoch_manager.GetCurrentEpoch(),
+                                    std::move(tile_group));
+
+  // free the tile groups of epochs that no transaction runs in anymore
+  auto reclaim_tail = epoch_manager.GetReclaimTail();
+  auto retired_itr = std::remove_if(
+      retired_tile_groups_.begin(), retired_tile_groups_.end(),
+      [reclaim_tail](
+          const std::pair<size_t, std::shared_ptr<storage::TileGroup>> &
+              retired) { return retired.first < reclaim_tail; });
+  retired_tile_groups_.erase(retired_itr, retired_tile_groups_.end());
 }
 
 std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
@@ -58,7 +97,11 @@ std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
 // used for logging test
 void Manager::ClearTileGroup() {
 
+  tile_group_ptr_locator_.Clear(nullptr);
   tile_group_locator_.Clear(empty_tile_group_);
+
+  std::lock_guard<std::mutex> lock(retired_tile_groups_mutex_);
+  retired_tile_groups_.clear();
 }
 
 
@@ -36,8 +36,10 @@ void PelotonInit::Initialize() {
   GC_THREAD_COUNT = 1;
   EPOCH_THREAD_COUNT = 1;
 
-  // set max thread number.
-  thread_pool.Initialize(0, std::thread::hardware_concurrency() + 3);
+  // set max thread number. the pool threads run the tasks of parallel
+  // operators, the dedicated threads run the server and its workers.
+  thread_pool.Initialize(std::thread::hardware_concurrency(),
+                         std::thread::hardware_concurrency() + 3);
 
   int parallelism = (std::thread::hardware_concurrency() + 1) / 2;
   storage::DataTable::SetActiveTileGroupCount(parallelism);
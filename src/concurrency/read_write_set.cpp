@@ -0,0 +1,128 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.cpp
+//
+// Identification: src/concurrency/read_write_set.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/read_write_set.h"
+
+#include <utility>
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace concurrency {
+
+constexpr size_t ReadWriteSet::LINEAR_SEARCH_SIZE;
+constexpr uint32_t ReadWriteSet::EMPTY_SLOT;
+
+namespace {
+
+// Buffers of finished transactions, kept for the next transactions of the
+// thread. Buffers that grew very large are released instead.
+struct BufferCache {
+  static constexpr size_t MAX_CACHED_BUFFERS = 4;
+  static constexpr size_t MAX_CACHED_ENTRIES = 64 * 1024;
+
+  std::vector<std::vector<ReadWriteSet::Entry>> entry_buffers;
+  std::vector<std::vector<uint32_t>> index_buffers;
+};
+
+thread_local BufferCache buffer_cache;
+
+}  // namespace
+
+ReadWriteSet::ReadWriteSet() {
+  if (buffer_cache.entry_buffers.empty() == false) {
+    entries_.swap(buffer_cache.entry_buffers.back());
+    buffer_cache.entry_buffers.pop_back();
+  }
+  if (buffer_cache.index_buffers.empty() == false) {
+    index_.swap(buffer_cache.index_buffers.back());
+    buffer_cache.index_buffers.pop_back();
+  }
+}
+
+ReadWriteSet::~ReadWriteSet() {
+  if (entries_.capacity() > 0 &&
+      entries_.capacity() <= BufferCache::MAX_CACHED_ENTRIES &&
+      buffer_cache.entry_buffers.size() < BufferCache::MAX_CACHED_BUFFERS) {
+    entries_.clear();
+    buffer_cache.entry_buffers.push_back(std::move(entries_));
+  }
+  if (index_.capacity() > 0 &&
+      index_.capacity() <= 2 * BufferCache::MAX_CACHED_ENTRIES &&
+      buffer_cache.index_buffers.size() < BufferCache::MAX_CACHED_BUFFERS) {
+    index_.clear();
+    buffer_cache.index_buffers.push_back(std::move(index_));
+  }
+}
+
+RWType *ReadWriteSet::Find(const ItemPointer &location) {
+  if (index_.empty() == true) {
+    for (auto &entry : entries_) {
+      if (entry.location.block == location.block &&
+          entry.location.offset == location.offset) {
+        return &entry.type;
+      }
+    }
+    return nullptr;
+  }
+
+  size_t mask = index_.size() - 1;
+  for (size_t slot = HashLocation(location) & mask;
+       index_[slot] != EMPTY_SLOT; slot = (slot + 1) & mask) {
+    auto &entry = entries_[index_[slot]];
+    if (entry.location.block == location.block &&
+        entry.location.offset == location.offset) {
+      return &entry.type;
+    }
+  }
+  return nullptr;
+}
+
+void ReadWriteSet::Insert(const ItemPointer &location, RWType type) {
+  PL_ASSERT(Find(location) == nullptr);
+  entries_.push_back({location, type});
+
+  if (entries_.size() <= LINEAR_SEARCH_SIZE) {
+    return;
+  }
+
+  // Keep the index at most half full
+  if (entries_.size() * 2 > index_.size()) {
+    BuildIndex();
+  } else {
+    IndexEntry(entries_.size() - 1);
+  }
+}
+
+void ReadWriteSet::BuildIndex() {
+  size_t slot_count = 2 * LINEAR_SEARCH_SIZE;
+  while (slot_count < entries_.size() * 4) {
+    slot_count <<= 1;
+  }
+  index_.assign(slot_count, EMPTY_SLOT);
+
+  for (uint32_t entry_idx = 0; entry_idx < entries_.size(); entry_idx++) {
+    IndexEntry(entry_idx);
+  }
+}
+
+void ReadWriteSet::IndexEntry(uint32_t entry_idx) {
+  size_t mask = index_.size() - 1;
+  size_t slot = HashLocation(entries_[entry_idx].location) & mask;
+  while (index_[slot] != EMPTY_SLOT) {
+    slot = (slot + 1) & mask;
+  }
+  index_[slot] = entry_idx;
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -12,6 +12,9 @@
 
 #include "concurrency/timestamp_ordering_transaction_manager.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include "catalog/manager.h"
 #include "common/exception.h"
 #include "common/logger.h"
@@ -171,8 +174,12 @@ void TimestampOrderingTransactionManager::EndReadonlyTransaction(
 }
 
 TimestampOrderingTransactionManager &
-TimestampOrderingTransactionManager::GetInstance() {
+TimestampOrderingTransactionManager::GetInstance(ConcurrencyType protocol) {
   static TimestampOrderingTransactionManager txn_manager;
+  static TimestampOrderingTransactionManager epoch_txn_manager(true);
+  if (protocol == ConcurrencyType::TIMESTAMP_ORDERING_EPOCH) {
+    return epoch_txn_manager;
+  }
   return txn_manager;
 }
 
@@ -183,8 +190,9 @@ bool TimestampOrderingTransactionManager::IsOccupied(
     Transaction *const current_txn, const void *position_ptr) {
   ItemPointer &position = *((ItemPointer *)position_ptr);
 
-  auto tile_group_header =
-      catalog::Manager::GetInstance().GetTileGroup(position.block)->GetHeader();
+  auto tile_group_header = catalog::Manager::GetInstance()
+                               .GetTileGroupPtr(position.block)
+                               ->GetHeader();
   auto tuple_id = position.offset;
 
   txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
@@ -320,6 +328,64 @@ VisibilityType TimestampOrderingTransactionManager::IsVisible(
   }
 }
 
+// this function collects the visible versions of a whole tile group.
+// committed versions are decided from the header columns directly, and only
+// versions owned by a transaction go through IsVisible().
+void TimestampOrderingTransactionManager::GetVisibleTuples(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t tuple_count, std::vector<oid_t> &visible_tuples) {
+  cid_t snapshot_cid = current_txn->GetBeginCommitId();
+  visible_tuples.clear();
+
+  // every slot of a frozen tile group is visible.
+  if (tile_group_header->IsFrozen(snapshot_cid) == true) {
+    visible_tuples.resize(tuple_count);
+    std::iota(visible_tuples.begin(), visible_tuples.end(), 0);
+    return;
+  }
+
+  uint64_t generation = tile_group_header->GetWriteGeneration();
+  std::vector<oid_t> undecided_tuples;
+  cid_t max_begin_cid;
+  bool all_committed = tile_group_header->GetVisibleTuples(
+      snapshot_cid, 0, tuple_count, visible_tuples, undecided_tuples,
+      max_begin_cid);
+
+  bool has_dirty_range = (dirty_range_.first != dirty_range_.second);
+  if (has_dirty_range == true) {
+    // versions committed by transactions lost in a failure are not visible.
+    auto dirty_itr = std::remove_if(
+        visible_tuples.begin(), visible_tuples.end(),
+        [this, tile_group_header](const oid_t tuple_id) {
+          return CidIsInDirtyRange(
+              tile_group_header->GetBeginCommitId(tuple_id));
+        });
+    if (dirty_itr != visible_tuples.end()) {
+      visible_tuples.erase(dirty_itr, visible_tuples.end());
+      all_committed = false;
+    }
+  }
+
+  if (all_committed == true) {
+    tile_group_header->Freeze(generation, max_begin_cid);
+    return;
+  }
+
+  if (undecided_tuples.empty() == false) {
+    size_t committed_count = visible_tuples.size();
+    for (auto tuple_id : undecided_tuples) {
+      if (IsVisible(current_txn, tile_group_header, tuple_id) ==
+          VisibilityType::OK) {
+        visible_tuples.push_back(tuple_id);
+      }
+    }
+    std::inplace_merge(visible_tuples.begin(),
+                       visible_tuples.begin() + committed_count,
+                       visible_tuples.end());
+  }
+}
+
 // check whether the current transaction owns the tuple.
 // this function is called by update/delete executors.
 bool TimestampOrderingTransactionManager::IsOwner(
@@ -394,7 +460,7 @@ void TimestampOrderingTransactionManager::YieldOwnership(
     UNUSED_ATTRIBUTE Transaction *const current_txn, const oid_t &tile_group_id,
     const oid_t &tuple_id) {
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupPtr(tile_group_id)->GetHeader();
   PL_ASSERT(IsOwner(current_txn, tile_group_header, tuple_id));
   tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
 }
@@ -412,7 +478,7 @@ bool TimestampOrderingTransactionManager::PerformRead(
 
   LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group = manager.GetTileGroup(tile_group_id);
+  auto tile_group = manager.GetTileGroupPtr(tile_group_id);
   auto tile_group_header = tile_group->GetHeader();
 
   // Check if it's select for update before we check the ownership and modify
@@ -473,12 +539,14 @@ void TimestampOrderingTransactionManager::PerformInsert(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupPtr(tile_group_id)->GetHeader();
   auto transaction_id = current_txn->GetTransactionId();
 
   // check MVCC info
-  // the tuple slot must be empty.
-  PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID);
+  // the tuple slot must be empty, or claimed by this transaction when it
+  // bulk loads the tuple.
+  PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID ||
+            tile_group_header->GetTransactionId(tuple_id) == transaction_id);
   PL_ASSERT(tile_group_header->GetBeginCommitId(tuple_id) == MAX_CID);
   PL_ASSERT(tile_group_header->GetEndCommitId(tuple_id) == MAX_CID);
 
@@ -512,10 +580,10 @@ void TimestampOrderingTransactionManager::PerformUpdate(
             new_location.offset);
 
   auto tile_group_header = catalog::Manager::GetInstance()
-                               .GetTileGroup(old_location.block)
+                               .GetTileGroupPtr(old_location.block)
                                ->GetHeader();
   auto new_tile_group_header = catalog::Manager::GetInstance()
-                                   .GetTileGroup(new_location.block)
+                                   .GetTileGroupPtr(new_location.block)
                                    ->GetHeader();
 
   auto transaction_id = current_txn->GetTransactionId();
@@ -551,7 +619,7 @@ void TimestampOrderingTransactionManager::PerformUpdate(
 
   if (old_prev.IsNull() == false) {
     auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                          .GetTileGroup(old_prev.block)
+                                          .GetTileGroupPtr(old_prev.block)
                                           ->GetHeader();
 
     // once everything is set, we can allow traversing the new version.
@@ -603,7 +671,7 @@ void TimestampOrderingTransactionManager::PerformUpdate(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupPtr(tile_group_id)->GetHeader();
 
   PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
             current_txn->GetTransactionId());
@@ -632,10 +700,10 @@ void TimestampOrderingTransactionManager::PerformDelete(
   LOG_TRACE("Performing Delete");
 
   auto tile_group_header = catalog::Manager::GetInstance()
-                               .GetTileGroup(old_location.block)
+                               .GetTileGroupPtr(old_location.block)
                                ->GetHeader();
   auto new_tile_group_header = catalog::Manager::GetInstance()
-                                   .GetTileGroup(new_location.block)
+                                   .GetTileGroupPtr(new_location.block)
                                    ->GetHeader();
 
   auto transaction_id = current_txn->GetTransactionId();
@@ -672,7 +740,7 @@ void TimestampOrderingTransactionManager::PerformDelete(
 
   if (old_prev.IsNull() == false) {
     auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                          .GetTileGroup(old_prev.block)
+                                          .GetTileGroupPtr(old_prev.block)
                                           ->GetHeader();
 
     old_prev_tile_group_header->SetNextItemPointer(old_prev.offset,
@@ -724,7 +792,7 @@ void TimestampOrderingTransactionManager::PerformDelete(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupPtr(tile_group_id)->GetHeader();
 
   PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
             current_txn->GetTransactionId());
@@ -773,7 +841,8 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     if (!rw_set.empty()) {
       database_id =
-          manager.GetTileGroup(rw_set.begin()->first)->GetDatabaseId();
+          manager.GetTileGroupPtr(rw_set.begin()->location.block)
+              ->GetDatabaseId();
     }
   }
 
@@ -781,122 +850,128 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
   // 1. install a new version for update operations;
   // 2. install an empty version for delete operations;
   // 3. install a new tuple for insert operations.
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RWType::READ_OWN) {
-        // A read operation has acquired ownership but hasn't done any further
-        // update/delete yet
-        // Yield the ownership
-        YieldOwnership(current_txn, tile_group_id, tuple_slot);
-      } else if (tuple_entry.second == RWType::UPDATE) {
-        // we must guarantee that, at any time point, only one version is
-        // visible.
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
-
-        PL_ASSERT(new_version.IsNull() == false);
-
-        auto cid = tile_group_header->GetEndCommitId(tuple_slot);
-        PL_ASSERT(cid > end_commit_id);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
-        new_tile_group_header->SetEndCommitId(new_version.offset, cid);
-
-        COMPILER_MEMORY_FENCE;
-
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
-
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
-
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INITIAL_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
-
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = false;
-
-        // add to log manager
-        log_manager.LogUpdate(
-            end_commit_id, ItemPointer(tile_group_id, tuple_slot), new_version);
-
-      } else if (tuple_entry.second == RWType::DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
-
-        auto cid = tile_group_header->GetEndCommitId(tuple_slot);
-        PL_ASSERT(cid > end_commit_id);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
-        new_tile_group_header->SetEndCommitId(new_version.offset, cid);
-
-        COMPILER_MEMORY_FENCE;
-
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
-
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
-
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
-
-        // add to gc set.
-        // we need to recycle both old and new versions.
-        // we require the GC to delete tuple from index only once.
-        // recycle old version, delete from index
-        gc_set->operator[](tile_group_id)[tuple_slot] = true;
-        // recycle new version (which is an empty version), do not delete from index
-        gc_set->operator[](new_version.block)[new_version.offset] = false;
-
-        // add to log manager
-        log_manager.LogDelete(end_commit_id,
-                              ItemPointer(tile_group_id, tuple_slot));
-
-      } else if (tuple_entry.second == RWType::INSERT) {
-        PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
-                  current_txn->GetTransactionId());
-        // set the begin commit id to persist insert
-        tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
-
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
-
-        // nothing to be added to gc set.
-
-        // add to log manager
-        log_manager.LogInsert(end_commit_id,
-                              ItemPointer(tile_group_id, tuple_slot));
-
-      } else if (tuple_entry.second == RWType::INS_DEL) {
-        PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
-                  current_txn->GetTransactionId());
-
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+  // entries are in the order of first access, so consecutive entries
+  // mostly share a tile group.
+  oid_t tile_group_id = INVALID_OID;
+  storage::TileGroup *tile_group = nullptr;
+  storage::TileGroupHeader *tile_group_header = nullptr;
+  for (auto &tuple_entry : rw_set) {
+    if (tuple_entry.location.block != tile_group_id) {
+      tile_group_id = tuple_entry.location.block;
+      tile_group = manager.GetTileGroupPtr(tile_group_id);
+      tile_group_header = tile_group->GetHeader();
+    }
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+    auto tuple_slot = tuple_entry.location.offset;
+    if (tuple_entry.type == RWType::READ_OWN) {
+      // A read operation has acquired ownership but hasn't done any further
+      // update/delete yet
+      // Yield the ownership
+      YieldOwnership(current_txn, tile_group_id, tuple_slot);
+    } else if (tuple_entry.type == RWType::UPDATE) {
+      // we must guarantee that, at any time point, only one version is
+      // visible.
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        // set the begin commit id to persist insert
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      PL_ASSERT(new_version.IsNull() == false);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = true;
+      auto cid = tile_group_header->GetEndCommitId(tuple_slot);
+      PL_ASSERT(cid > end_commit_id);
+      auto new_tile_group_header =
+          manager.GetTileGroupPtr(new_version.block)->GetHeader();
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, cid);
 
-        // no log is needed for this case
-      }
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
+
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+
+      // add to gc set.
+      gc_set->operator[](tile_group_id)[tuple_slot] = false;
+
+      // add to log manager
+      log_manager.LogUpdate(
+          end_commit_id, ItemPointer(tile_group_id, tuple_slot), new_version);
+
+    } else if (tuple_entry.type == RWType::DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
+
+      auto cid = tile_group_header->GetEndCommitId(tuple_slot);
+      PL_ASSERT(cid > end_commit_id);
+      auto new_tile_group_header =
+          manager.GetTileGroupPtr(new_version.block)->GetHeader();
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, cid);
+
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
+
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+
+      // add to gc set.
+      // we need to recycle both old and new versions.
+      // we require the GC to delete tuple from index only once.
+      // recycle old version, delete from index
+      gc_set->operator[](tile_group_id)[tuple_slot] = true;
+      // recycle new version (which is an empty version), do not delete from index
+      gc_set->operator[](new_version.block)[new_version.offset] = false;
+
+      // add to log manager
+      log_manager.LogDelete(end_commit_id,
+                            ItemPointer(tile_group_id, tuple_slot));
+
+    } else if (tuple_entry.type == RWType::INSERT) {
+      PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
+                current_txn->GetTransactionId());
+      // set the begin commit id to persist insert
+      tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+
+      // nothing to be added to gc set.
+
+      // add to log manager
+      log_manager.LogInsert(end_commit_id,
+                            ItemPointer(tile_group_id, tuple_slot));
+
+    } else if (tuple_entry.type == RWType::INS_DEL) {
+      PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
+                current_txn->GetTransactionId());
+
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
+
+      // set the begin commit id to persist insert
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+
+      // add to gc set.
+      gc_set->operator[](tile_group_id)[tuple_slot] = true;
+
+      // no log is needed for this case
     }
   }
 
@@ -929,159 +1004,165 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     if (!rw_set.empty()) {
       database_id =
-          manager.GetTileGroup(rw_set.begin()->first)->GetDatabaseId();
+          manager.GetTileGroupPtr(rw_set.begin()->location.block)
+              ->GetDatabaseId();
     }
   }
 
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RWType::READ_OWN) {
-        // A read operation has acquired ownership but hasn't done any further
-        // update/delete yet
-        // Yield the ownership
-        YieldOwnership(current_txn, tile_group_id, tuple_slot);
-      } else if (tuple_entry.second == RWType::UPDATE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
-
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-
-        // these two fields can be set at any time.
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-
-        COMPILER_MEMORY_FENCE;
-
-        // as the aborted version has already been placed in the version chain,
-        // we need to unlink it by resetting the item pointers.
-        auto old_prev =
-            new_tile_group_header->GetPrevItemPointer(new_version.offset);
-
-        // check whether the previous version exists.
-        if (old_prev.IsNull() == true) {
-          PL_ASSERT(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
-          // if we updated the latest version.
-          // We must first adjust the head pointer
-          // before we unlink the aborted version from version list
-          ItemPointer *index_entry_ptr =
-              tile_group_header->GetIndirection(tuple_slot);
-          UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
-              index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
-          PL_ASSERT(res == true);
-        }
-        //////////////////////////////////////////////////
+  // entries are in the order of first access, so consecutive entries
+  // mostly share a tile group.
+  oid_t tile_group_id = INVALID_OID;
+  storage::TileGroup *tile_group = nullptr;
+  storage::TileGroupHeader *tile_group_header = nullptr;
+  for (auto &tuple_entry : rw_set) {
+    if (tuple_entry.location.block != tile_group_id) {
+      tile_group_id = tuple_entry.location.block;
+      tile_group = manager.GetTileGroupPtr(tile_group_id);
+      tile_group_header = tile_group->GetHeader();
+    }
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+    auto tuple_slot = tuple_entry.location.offset;
+    if (tuple_entry.type == RWType::READ_OWN) {
+      // A read operation has acquired ownership but hasn't done any further
+      // update/delete yet
+      // Yield the ownership
+      YieldOwnership(current_txn, tile_group_id, tuple_slot);
+    } else if (tuple_entry.type == RWType::UPDATE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
+
+      auto new_tile_group_header =
+          manager.GetTileGroupPtr(new_version.block)->GetHeader();
+
+      // these two fields can be set at any time.
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      // as the aborted version has already been placed in the version chain,
+      // we need to unlink it by resetting the item pointers.
+      auto old_prev =
+          new_tile_group_header->GetPrevItemPointer(new_version.offset);
+
+      // check whether the previous version exists.
+      if (old_prev.IsNull() == true) {
+        PL_ASSERT(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
+        // if we updated the latest version.
+        // We must first adjust the head pointer
+        // before we unlink the aborted version from version list
+        ItemPointer *index_entry_ptr =
+            tile_group_header->GetIndirection(tuple_slot);
+        UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
+            index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
+        PL_ASSERT(res == true);
+      }
+      //////////////////////////////////////////////////
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        if (old_prev.IsNull() == false) {
-          auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                                .GetTileGroup(old_prev.block)
-                                                ->GetHeader();
-          old_prev_tile_group_header->SetNextItemPointer(
-              old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
-          tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
-        } else {
-          tile_group_header->SetPrevItemPointer(tuple_slot,
-                                                INVALID_ITEMPOINTER);
-        }
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+
+      if (old_prev.IsNull() == false) {
+        auto old_prev_tile_group_header = catalog::Manager::GetInstance()
+                                              .GetTileGroupPtr(old_prev.block)
+                                              ->GetHeader();
+        old_prev_tile_group_header->SetNextItemPointer(
+            old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
+        tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
+      } else {
+        tile_group_header->SetPrevItemPointer(tuple_slot,
+                                              INVALID_ITEMPOINTER);
+      }
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](new_version.block)[new_version.offset] = false;
+      // add to gc set.
+      gc_set->operator[](new_version.block)[new_version.offset] = false;
 
-      } else if (tuple_entry.second == RWType::DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
+    } else if (tuple_entry.type == RWType::DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      auto new_tile_group_header =
+          manager.GetTileGroupPtr(new_version.block)->GetHeader();
 
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        // as the aborted version has already been placed in the version chain,
-        // we need to unlink it by resetting the item pointers.
-        auto old_prev =
-            new_tile_group_header->GetPrevItemPointer(new_version.offset);
+      // as the aborted version has already been placed in the version chain,
+      // we need to unlink it by resetting the item pointers.
+      auto old_prev =
+          new_tile_group_header->GetPrevItemPointer(new_version.offset);
 
-        // check whether the previous version exists.
-        if (old_prev.IsNull() == true) {
-          // if we updated the latest version.
-          // We must first adjust the head pointer
-          // before we unlink the aborted version from version list
-          ItemPointer *index_entry_ptr =
-              tile_group_header->GetIndirection(tuple_slot);
-          UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
-              index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
-          PL_ASSERT(res == true);
-        }
-        //////////////////////////////////////////////////
+      // check whether the previous version exists.
+      if (old_prev.IsNull() == true) {
+        // if we updated the latest version.
+        // We must first adjust the head pointer
+        // before we unlink the aborted version from version list
+        ItemPointer *index_entry_ptr =
+            tile_group_header->GetIndirection(tuple_slot);
+        UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
+            index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
+        PL_ASSERT(res == true);
+      }
+      //////////////////////////////////////////////////
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
 
-        if (old_prev.IsNull() == false) {
-          auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                                .GetTileGroup(old_prev.block)
-                                                ->GetHeader();
-          old_prev_tile_group_header->SetNextItemPointer(
-              old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
-        }
+      if (old_prev.IsNull() == false) {
+        auto old_prev_tile_group_header = catalog::Manager::GetInstance()
+                                              .GetTileGroupPtr(old_prev.block)
+                                              ->GetHeader();
+        old_prev_tile_group_header->SetNextItemPointer(
+            old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
+      }
 
-        tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
+      tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](new_version.block)[new_version.offset] = false;
+      // add to gc set.
+      gc_set->operator[](new_version.block)[new_version.offset] = false;
 
-      } else if (tuple_entry.second == RWType::INSERT) {
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (tuple_entry.type == RWType::INSERT) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // add to gc set.
-        // delete from index
-        gc_set->operator[](tile_group_id)[tuple_slot] = true;
+      // add to gc set.
+      // delete from index
+      gc_set->operator[](tile_group_id)[tuple_slot] = true;
 
-      } else if (tuple_entry.second == RWType::INS_DEL) {
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (tuple_entry.type == RWType::INS_DEL) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = true;
-      }
+      // add to gc set.
+      gc_set->operator[](tile_group_id)[tuple_slot] = true;
     }
   }
 
@@ -47,77 +47,58 @@ namespace concurrency {
  */
 
 RWType Transaction::GetRWType(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-  auto itr = rw_set_.find(tile_group_id);
-  if (itr == rw_set_.end()) {
+  RWType *type = rw_set_.Find(location);
+  if (type == nullptr) {
     return RWType::INVALID;
   }
 
-  auto inner_itr = itr->second.find(tuple_id);
-  if (inner_itr == itr->second.end()) {
-    return RWType::INVALID;
-  }
-
-  return inner_itr->second;
+  return *type;
 }
 
 void Transaction::RecordRead(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    PL_ASSERT(rw_set_.at(tile_group_id).at(tuple_id) != RWType::DELETE &&
-              rw_set_.at(tile_group_id).at(tuple_id) != RWType::INS_DEL);
+  RWType *type = rw_set_.Find(location);
+
+  if (type != nullptr) {
+    PL_ASSERT(*type != RWType::DELETE && *type != RWType::INS_DEL);
     return;
   } else {
-    rw_set_[tile_group_id][tuple_id] = RWType::READ;
+    rw_set_.Insert(location, RWType::READ);
   }
 }
 
 void Transaction::RecordReadOwn(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-      rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RWType::READ) {
-      type = RWType::READ_OWN;
+  RWType *type = rw_set_.Find(location);
+
+  if (type != nullptr) {
+    if (*type == RWType::READ) {
+      *type = RWType::READ_OWN;
       // record write.
       return;
     }
-    PL_ASSERT(type != RWType::DELETE && type != RWType::INS_DEL);
+    PL_ASSERT(*type != RWType::DELETE && *type != RWType::INS_DEL);
   } else {
-    rw_set_[tile_group_id][tuple_id] = RWType::READ_OWN;
+    rw_set_.Insert(location, RWType::READ_OWN);
   }
 }
 
 void Transaction::RecordUpdate(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RWType::READ || type == RWType::READ_OWN) {
-      type = RWType::UPDATE;
+  RWType *type = rw_set_.Find(location);
+
+  if (type != nullptr) {
+    if (*type == RWType::READ || *type == RWType::READ_OWN) {
+      *type = RWType::UPDATE;
       // record write.
       is_written_ = true;
 
       return;
     }
-    if (type == RWType::UPDATE) {
+    if (*type == RWType::UPDATE) {
       return;
     }
-    if (type == RWType::INSERT) {
+    if (*type == RWType::INSERT) {
       return;
     }
-    if (type == RWType::DELETE) {
+    if (*type == RWType::DELETE) {
       PL_ASSERT(false);
       return;
     }
@@ -126,47 +107,40 @@ void Transaction::RecordUpdate(const ItemPointer &location) {
 }
 
 void Transaction::RecordInsert(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
+  RWType *type = rw_set_.Find(location);
 
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
+  if (type != nullptr) {
     PL_ASSERT(false);
   } else {
-    rw_set_[tile_group_id][tuple_id] = RWType::INSERT;
+    rw_set_.Insert(location, RWType::INSERT);
     ++insert_count_;
 
   }
 }
 
 bool Transaction::RecordDelete(const ItemPointer &location) {
-  oid_t tile_group_id = location.block;
-  oid_t tuple_id = location.offset;
-
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RWType::READ || type == RWType::READ_OWN) {
-      type = RWType::DELETE;
+  RWType *type = rw_set_.Find(location);
+
+  if (type != nullptr) {
+    if (*type == RWType::READ || *type == RWType::READ_OWN) {
+      *type = RWType::DELETE;
       // record write.
       is_written_ = true;
 
       return false;
     }
-    if (type == RWType::UPDATE) {
-      type = RWType::DELETE;
+    if (*type == RWType::UPDATE) {
+      *type = RWType::DELETE;
 
       return false;
     }
-    if (type == RWType::INSERT) {
-      type = RWType::INS_DEL;
+    if (*type == RWType::INSERT) {
+      *type = RWType::INS_DEL;
       --insert_count_;
 
       return true;
     }
-    if (type == RWType::DELETE) {
+    if (*type == RWType::DELETE) {
       PL_ASSERT(false);
       return false;
     }
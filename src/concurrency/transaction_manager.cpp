@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// transaction_manager.cpp
+//
+// Identification: src/concurrency/transaction_manager.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/transaction_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+constexpr int TransactionManager::EPOCH_CID_SHIFT;
+constexpr cid_t TransactionManager::COMMIT_ID_LEASE_SIZE;
+
+namespace {
+
+// The counter values a thread has leased for epoch-based commit ids
+struct CommitIdLease {
+  const TransactionManager *txn_manager = nullptr;
+  uint64_t generation = 0;
+  cid_t epoch = 0;
+  cid_t next = 0;
+  cid_t end = 0;
+};
+
+thread_local CommitIdLease commit_id_lease;
+
+}  // namespace
+
+// Commit ids within an epoch are unique because the leases come from one
+// counter, and the epoch in the upper bits orders them against the commit
+// ids of other epochs. A lease is dropped when the epoch advances, so the
+// commit id of a transaction carries the epoch it enters, up to the same
+// race with the epoch thread that the epoch manager tolerates for a shared
+// counter.
+cid_t TransactionManager::GetNextEpochCommitId() {
+  auto &lease = commit_id_lease;
+  cid_t epoch = GetCommitIdEpoch();
+  uint64_t generation = lease_generation_.load();
+
+  if (lease.next == lease.end || lease.epoch != epoch ||
+      lease.txn_manager != this || lease.generation != generation) {
+    lease.txn_manager = this;
+    lease.generation = generation;
+    lease.epoch = epoch;
+    lease.next = next_cid_.fetch_add(COMMIT_ID_LEASE_SIZE);
+    lease.end = lease.next + COMMIT_ID_LEASE_SIZE;
+  }
+
+  return MakeEpochCommitId(epoch, lease.next++);
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
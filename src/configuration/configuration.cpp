@@ -37,6 +37,7 @@ void PrintConfiguration(){
   LOG_INFO("%30s: %10s","Socket Family", FLAGS_socket_family.c_str());
   LOG_INFO("%30s: %10lu","Statistics", FLAGS_stats_mode);
   LOG_INFO("%30s: %10lu","Max Connections", FLAGS_max_connections);
+  LOG_INFO("%30s: %10lu","Parallel Scan Degree", FLAGS_parallel_scan_degree);
 
   LOG_INFO(" ");
   LOG_INFO("%30s", "//===---------------------------------------------------===//");
@@ -70,6 +71,10 @@ DEFINE_string(socket_family,
 // RESOURCE USAGE
 //===----------------------------------------------------------------------===//
 
+DEFINE_uint64(parallel_scan_degree,
+              1,
+              "Number of threads a sequential scan uses (default: 1)");
+
 //===----------------------------------------------------------------------===//
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
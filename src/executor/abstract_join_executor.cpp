@@ -53,9 +53,38 @@ bool AbstractJoinExecutor::DInit() {
   join_type_ = node.GetJoinType();
   proj_schema_ = node.GetSchema();
 
+  compiled_predicate_.reset();
+  predicate_compiled_ = false;
+
   return true;
 }
 
+/**
+ * @brief Bind the compiled predicate to the left and right tiles.
+ * @return false if the predicate is not compiled or the tiles do not store
+ * its columns as compiled.
+ */
+bool AbstractJoinExecutor::BindCompiledPredicate(LogicalTile *left_tile,
+                                                 LogicalTile *right_tile) {
+  if (predicate_compiled_ == false) {
+    predicate_compiled_ = true;
+    if (left_tile->GetColumnCount() == 0 || right_tile->GetColumnCount() == 0)
+      return false;
+
+    std::unique_ptr<catalog::Schema> left_schema(
+        left_tile->GetPhysicalSchema());
+    std::unique_ptr<catalog::Schema> right_schema(
+        right_tile->GetPhysicalSchema());
+    compiled_predicate_ =
+        CompiledExpression::Compile(predicate_, left_schema.get(),
+                                    right_schema.get(), executor_context_);
+  }
+
+  return compiled_predicate_ != nullptr &&
+         compiled_predicate_->Bind(0, left_tile) == true &&
+         compiled_predicate_->Bind(1, right_tile) == true;
+}
+
 /**
  * @ brief Build the schema of the joined tile based on the projection info
  */
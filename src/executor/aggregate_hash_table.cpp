@@ -0,0 +1,314 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// aggregate_hash_table.cpp
+//
+// Identification: src/executor/aggregate_hash_table.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/aggregate_hash_table.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "common/abstract_tuple.h"
+#include "common/logger.h"
+#include "executor/aggregator.h"
+#include "murmur3/MurmurHash3.h"
+
+namespace peloton {
+namespace executor {
+
+constexpr size_t AggregateHashTable::INITIAL_SLOT_COUNT;
+constexpr size_t AggregateHashTable::CHUNK_SIZE;
+
+// Group blocks and the objects in them are aligned to 8 bytes
+static constexpr size_t GROUP_ALIGNMENT = 8;
+
+static inline size_t AlignGroupOffset(size_t offset) {
+  return (offset + GROUP_ALIGNMENT - 1) & ~(GROUP_ALIGNMENT - 1);
+}
+
+// Finalizer of MurmurHash3, spreads the bits of an integer key
+static inline uint64_t HashIntegerKey(int64_t key) {
+  uint64_t hash = static_cast<uint64_t>(key);
+  hash ^= hash >> 33;
+  hash *= UINT64_C(0xff51afd7ed558ccd);
+  hash ^= hash >> 33;
+  hash *= UINT64_C(0xc4ceb9fe1a85ec53);
+  hash ^= hash >> 33;
+  return hash;
+}
+
+AggregateHashTable::AggregateHashTable(
+    const std::vector<oid_t> &group_by_col_ids,
+    const std::vector<planner::AggregatePlan::AggTerm> &aggs,
+    size_t num_input_columns)
+    : group_by_col_ids_(group_by_col_ids),
+      aggs_(aggs),
+      num_input_columns_(num_input_columns),
+      slots_(INITIAL_SLOT_COUNT) {
+  static_assert(alignof(type::Value) <= GROUP_ALIGNMENT,
+                "type::Value is not sufficiently aligned in a group");
+  static_assert(sizeof(GroupHeader) % GROUP_ALIGNMENT == 0,
+                "GroupHeader must keep the first tuple values aligned");
+
+  // Layout: header, first tuple values, aggregators
+  size_t offset = sizeof(GroupHeader) + num_input_columns * sizeof(type::Value);
+  for (auto &agg : aggs) {
+    offset = AlignGroupOffset(offset);
+    aggregator_offsets_.push_back(offset);
+    offset += GetAttributeAggregatorSize(agg.aggtype);
+  }
+  group_size_ = AlignGroupOffset(offset);
+  groups_per_chunk_ = std::max(CHUNK_SIZE / group_size_, (size_t)1);
+}
+
+AggregateHashTable::~AggregateHashTable() {
+  for (size_t group_idx = 0; group_idx < group_count_; group_idx++) {
+    char *group = GetGroup(group_idx);
+
+    auto values = GetFirstTupleValues(group);
+    for (size_t col_id = 0; col_id < num_input_columns_; col_id++) {
+      values[col_id].~Value();
+    }
+
+    for (size_t aggno = 0; aggno < GetAggregatorCount(); aggno++) {
+      GetAggregator(group, aggno)->~AbstractAttributeAggregator();
+    }
+  }
+
+  for (auto chunk : group_chunks_) {
+    free(chunk);
+  }
+  for (auto chunk : key_chunks_) {
+    free(chunk);
+  }
+}
+
+char *AggregateHashTable::FindOrCreateGroup(const AbstractTuple *tuple) {
+  if (key_type_known_ == false) {
+    key_type_known_ = true;
+    int64_t integer_key;
+    use_integer_key_ =
+        (group_by_col_ids_.size() == 1 &&
+         GetIntegerKey(tuple->GetValue(group_by_col_ids_[0]), integer_key));
+    LOG_TRACE("Aggregate hash table uses %s keys",
+              use_integer_key_ ? "integer" : "serialized");
+  }
+
+  if (use_integer_key_ == true) {
+    return FindOrCreateIntegerGroup(tuple,
+                                    tuple->GetValue(group_by_col_ids_[0]));
+  }
+
+  SerializeKey(tuple);
+  const char *key = key_buffer_.data();
+  size_t key_length = key_buffer_.size();
+  uint64_t hash = static_cast<uint32_t>(
+      MurmurHash3_x64_128(key, static_cast<int>(key_length), 0));
+
+  size_t slot_idx = GetSlotIndex(hash);
+  while (slots_[slot_idx].group != nullptr) {
+    auto &slot = slots_[slot_idx];
+    if (slot.hash == hash) {
+      auto header = reinterpret_cast<GroupHeader *>(slot.group);
+      if (header->key_length == key_length &&
+          memcmp(header->key, key, key_length) == 0) {
+        return slot.group;
+      }
+    }
+    slot_idx = (slot_idx + 1) & (slots_.size() - 1);
+  }
+
+  // Copy the key out of the scratch buffer
+  if (key_chunks_.empty() || key_chunk_used_ + key_length > CHUNK_SIZE) {
+    key_chunks_.push_back(
+        static_cast<char *>(malloc(std::max(key_length, CHUNK_SIZE))));
+    key_chunk_used_ = 0;
+  }
+  char *key_copy = key_chunks_.back() + key_chunk_used_;
+  memcpy(key_copy, key, key_length);
+  key_chunk_used_ += key_length;
+
+  char *group = CreateGroup(tuple, hash, key_copy, key_length);
+  slots_[slot_idx].hash = hash;
+  slots_[slot_idx].group = group;
+
+  if (group_count_ * 2 > slots_.size()) {
+    Grow();
+  }
+  return group;
+}
+
+char *AggregateHashTable::FindOrCreateIntegerGroup(const AbstractTuple *tuple,
+                                                   const type::Value &value) {
+  int64_t integer_key;
+  bool is_integer = GetIntegerKey(value, integer_key);
+  PL_ASSERT(is_integer == true || value.IsNull() == true);
+
+  // NULLs form a single group
+  if (is_integer == false) {
+    if (null_group_ == nullptr) {
+      null_group_ = CreateGroup(tuple, 0, nullptr, 0);
+    }
+    return null_group_;
+  }
+
+  uint64_t hash = HashIntegerKey(integer_key);
+  size_t slot_idx = GetSlotIndex(hash);
+  while (slots_[slot_idx].group != nullptr) {
+    auto &slot = slots_[slot_idx];
+    if (slot.integer_key == integer_key) {
+      return slot.group;
+    }
+    slot_idx = (slot_idx + 1) & (slots_.size() - 1);
+  }
+
+  char *group = CreateGroup(tuple, hash, nullptr, 0);
+  slots_[slot_idx].hash = hash;
+  slots_[slot_idx].integer_key = integer_key;
+  slots_[slot_idx].group = group;
+
+  if (group_count_ * 2 > slots_.size()) {
+    Grow();
+  }
+  return group;
+}
+
+char *AggregateHashTable::CreateGroup(const AbstractTuple *tuple,
+                                      uint64_t hash, const char *key,
+                                      size_t key_length) {
+  if (group_count_ % groups_per_chunk_ == 0) {
+    group_chunks_.push_back(
+        static_cast<char *>(malloc(groups_per_chunk_ * group_size_)));
+  }
+  group_count_++;
+  char *group = GetGroup(group_count_ - 1);
+
+  auto header = reinterpret_cast<GroupHeader *>(group);
+  header->hash = hash;
+  header->key = key;
+  header->key_length = key_length;
+
+  // Make a deep copy of the first tuple we meet
+  auto values = GetFirstTupleValues(group);
+  for (size_t col_id = 0; col_id < num_input_columns_; col_id++) {
+    new (&values[col_id]) type::Value(tuple->GetValue(col_id));
+  }
+
+  for (size_t aggno = 0; aggno < aggs_.size(); aggno++) {
+    auto aggregator = GetAttributeAggregatorInstance(
+        aggs_[aggno].aggtype, group + aggregator_offsets_[aggno]);
+    aggregator->SetDistinct(aggs_[aggno].distinct);
+  }
+
+  return group;
+}
+
+void AggregateHashTable::Grow() {
+  std::vector<Slot> old_slots(slots_.size() * 2);
+  old_slots.swap(slots_);
+
+  // Hashes are kept in the slots, so no key is hashed again
+  for (auto &old_slot : old_slots) {
+    if (old_slot.group == nullptr) continue;
+
+    size_t slot_idx = GetSlotIndex(old_slot.hash);
+    while (slots_[slot_idx].group != nullptr) {
+      slot_idx = (slot_idx + 1) & (slots_.size() - 1);
+    }
+    slots_[slot_idx] = old_slot;
+  }
+}
+
+bool AggregateHashTable::GetIntegerKey(const type::Value &value,
+                                       int64_t &integer_key) const {
+  if (value.IsNull()) return false;
+
+  switch (value.GetTypeId()) {
+    case type::Type::TINYINT:
+      integer_key = value.GetAs<int8_t>();
+      return true;
+    case type::Type::SMALLINT:
+      integer_key = value.GetAs<int16_t>();
+      return true;
+    case type::Type::INTEGER:
+      integer_key = value.GetAs<int32_t>();
+      return true;
+    case type::Type::BIGINT:
+      integer_key = value.GetAs<int64_t>();
+      return true;
+    default:
+      return false;
+  }
+}
+
+void AggregateHashTable::SerializeKey(const AbstractTuple *tuple) {
+  key_buffer_.clear();
+
+  for (auto col_id : group_by_col_ids_) {
+    type::Value value = tuple->GetValue(col_id);
+
+    if (value.IsNull()) {
+      key_buffer_.push_back(1);
+      continue;
+    }
+    key_buffer_.push_back(0);
+
+    // Fixed-width values are widened to 8 bytes
+    int64_t fixed_value;
+    switch (value.GetTypeId()) {
+      case type::Type::BOOLEAN:
+        fixed_value = value.GetAs<int8_t>();
+        break;
+      case type::Type::TINYINT:
+      case type::Type::SMALLINT:
+      case type::Type::INTEGER:
+      case type::Type::BIGINT:
+        GetIntegerKey(value, fixed_value);
+        break;
+      case type::Type::DECIMAL: {
+        // -0.0 and 0.0 are the same group
+        double decimal_value = value.GetAs<double>() + 0.0;
+        memcpy(&fixed_value, &decimal_value, sizeof(fixed_value));
+        break;
+      }
+      case type::Type::TIMESTAMP:
+        fixed_value = static_cast<int64_t>(value.GetAs<uint64_t>());
+        break;
+      case type::Type::VARCHAR:
+      case type::Type::VARBINARY: {
+        uint32_t length = value.GetLength();
+        const char *data = value.GetData();
+        const char *length_bytes = reinterpret_cast<const char *>(&length);
+        key_buffer_.insert(key_buffer_.end(), length_bytes,
+                           length_bytes + sizeof(length));
+        key_buffer_.insert(key_buffer_.end(), data, data + length);
+        continue;
+      }
+      default: {
+        // Other types are rare as group-by keys, use their text form
+        std::string text = value.ToString();
+        uint32_t length = text.size();
+        const char *length_bytes = reinterpret_cast<const char *>(&length);
+        key_buffer_.insert(key_buffer_.end(), length_bytes,
+                           length_bytes + sizeof(length));
+        key_buffer_.insert(key_buffer_.end(), text.begin(), text.end());
+        continue;
+      }
+    }
+
+    const char *fixed_bytes = reinterpret_cast<const char *>(&fixed_value);
+    key_buffer_.insert(key_buffer_.end(), fixed_bytes,
+                       fixed_bytes + sizeof(fixed_value));
+  }
+}
+
+}  // namespace executor
+}  // namespace peloton
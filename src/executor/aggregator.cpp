@@ -59,6 +59,66 @@ AbstractAttributeAggregator *GetAttributeAggregatorInstance(ExpressionType agg_t
   return aggregator;
 }
 
+/*
+ * Construct an aggregator for the specified aggregate type in the provided
+ * storage, which must hold GetAttributeAggregatorSize(agg_type) bytes. The
+ * caller destroys the aggregator by calling its destructor.
+ */
+AbstractAttributeAggregator *GetAttributeAggregatorInstance(
+    ExpressionType agg_type, void *storage) {
+  AbstractAttributeAggregator *aggregator;
+
+  switch (agg_type) {
+    case ExpressionType::AGGREGATE_COUNT:
+      aggregator = new (storage) CountAggregator();
+      break;
+    case ExpressionType::AGGREGATE_COUNT_STAR:
+      aggregator = new (storage) CountStarAggregator();
+      break;
+    case ExpressionType::AGGREGATE_SUM:
+      aggregator = new (storage) SumAggregator();
+      break;
+    case ExpressionType::AGGREGATE_AVG:
+      aggregator = new (storage) AvgAggregator(false);
+      break;
+    case ExpressionType::AGGREGATE_MIN:
+      aggregator = new (storage) MinAggregator();
+      break;
+    case ExpressionType::AGGREGATE_MAX:
+      aggregator = new (storage) MaxAggregator();
+      break;
+    default: {
+      std::string message =
+          "Unknown aggregate type " + ExpressionTypeToString(agg_type);
+      throw UnknownTypeException(static_cast<int>(agg_type), message);
+    }
+  }
+
+  return aggregator;
+}
+
+size_t GetAttributeAggregatorSize(ExpressionType agg_type) {
+  switch (agg_type) {
+    case ExpressionType::AGGREGATE_COUNT:
+      return sizeof(CountAggregator);
+    case ExpressionType::AGGREGATE_COUNT_STAR:
+      return sizeof(CountStarAggregator);
+    case ExpressionType::AGGREGATE_SUM:
+      return sizeof(SumAggregator);
+    case ExpressionType::AGGREGATE_AVG:
+      return sizeof(AvgAggregator);
+    case ExpressionType::AGGREGATE_MIN:
+      return sizeof(MinAggregator);
+    case ExpressionType::AGGREGATE_MAX:
+      return sizeof(MaxAggregator);
+    default: {
+      std::string message =
+          "Unknown aggregate type " + ExpressionTypeToString(agg_type);
+      throw UnknownTypeException(static_cast<int>(agg_type), message);
+    }
+  }
+}
+
 /* Handle distinct */
 AbstractAttributeAggregator::~AbstractAttributeAggregator() {}
 
@@ -155,63 +215,15 @@ HashAggregator::HashAggregator(const planner::AggregatePlan *node,
                                executor::ExecutorContext *econtext,
                                size_t num_input_columns)
     : AbstractAggregator(node, output_table, econtext),
-      num_input_columns(num_input_columns) {}
-//  group_by_key_values.resize(node->GetGroupbyColIds().size(),
-//      type::ValueFactory::GetNullValueByType(type::Type::INTEGER));
-//}
-
-HashAggregator::~HashAggregator() {
-  for (auto entry : aggregates_map) {
-    // Clean up allocated storage
-    for (size_t aggno = 0; aggno < node->GetUniqueAggTerms().size(); aggno++) {
-      delete entry.second->aggregates[aggno];
-    }
-    delete[] entry.second->aggregates;
-    delete entry.second;
-  }
-}
-
-bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
-  AggregateList *aggregate_list;
-
-  // Configure a group-by-key and search for the required group.
-  group_by_key_values.clear();
-  for (oid_t column_itr = 0; column_itr < node->GetGroupbyColIds().size();
-       column_itr++) {
-    type::Value cur_tuple_val =
-        cur_tuple->GetValue(node->GetGroupbyColIds()[column_itr]);
-    group_by_key_values.push_back(cur_tuple_val);
-  }
-
-  auto map_itr = aggregates_map.find(group_by_key_values);
-
-  // Group not found. Make a new entry in the hash for this new group.
-  if (map_itr == aggregates_map.end()) {
-    LOG_TRACE("Group-by key not found. Start a new group.");
-    // Allocate new aggregate list
-    aggregate_list = new AggregateList();
-    aggregate_list->aggregates = new AbstractAttributeAggregator *[node->GetUniqueAggTerms().size()];
-    // Make a deep copy of the first tuple we meet
-    for (size_t col_id = 0; col_id < num_input_columns; col_id++) {
-      // first_tuple_values has the ownership
-      aggregate_list->first_tuple_values.push_back(cur_tuple->GetValue(col_id));
-    };
+      num_input_columns(num_input_columns),
+      aggregate_table(node->GetGroupbyColIds(), node->GetUniqueAggTerms(),
+                      num_input_columns) {}
 
-    for (oid_t aggno = 0; aggno < node->GetUniqueAggTerms().size(); aggno++) {
-      aggregate_list->aggregates[aggno] =
-          GetAttributeAggregatorInstance(node->GetUniqueAggTerms()[aggno].aggtype);
-
-      bool distinct = node->GetUniqueAggTerms()[aggno].distinct;
-      aggregate_list->aggregates[aggno]->SetDistinct(distinct);
-    }
+HashAggregator::~HashAggregator() {}
 
-    aggregates_map.insert(
-        HashAggregateMapType::value_type(group_by_key_values, aggregate_list));
-  }
-  // Otherwise, the list is the second item of the pair.
-  else {
-    aggregate_list = map_itr->second;
-  }
+bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
+  // Search for the group of the tuple, or start a new one
+  char *group = aggregate_table.FindOrCreateGroup(cur_tuple);
 
   // Update the aggregation calculation
   for (oid_t aggno = 0; aggno < node->GetUniqueAggTerms().size(); aggno++) {
@@ -222,18 +234,30 @@ bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
           cur_tuple, nullptr, this->executor_context);
     }
 
-    aggregate_list->aggregates[aggno]->Advance(value);
+    aggregate_table.GetAggregator(group, aggno)->Advance(value);
   }
 
   return true;
 }
 
 bool HashAggregator::Finalize() {
-  for (auto entry : aggregates_map) {
+  std::vector<AbstractAttributeAggregator *> aggregates(
+      aggregate_table.GetAggregatorCount());
+
+  for (size_t group_idx = 0; group_idx < aggregate_table.GetGroupCount();
+       group_idx++) {
+    char *group = aggregate_table.GetGroup(group_idx);
+
+    for (size_t aggno = 0; aggno < aggregates.size(); aggno++) {
+      aggregates[aggno] = aggregate_table.GetAggregator(group, aggno);
+    }
+
     // Construct a container for the first tuple
+    auto values = aggregate_table.GetFirstTupleValues(group);
+    first_tuple_values.assign(values, values + num_input_columns);
     expression::ContainerTuple<std::vector<type::Value>> first_tuple(
-        &entry.second->first_tuple_values);
-    if (Helper(node, entry.second->aggregates, output_table, &first_tuple,
+        &first_tuple_values);
+    if (Helper(node, aggregates.data(), output_table, &first_tuple,
                this->executor_context) == false) {
       return false;
     }
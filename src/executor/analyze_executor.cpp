@@ -0,0 +1,64 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// analyze_executor.cpp
+//
+// Identification: src/executor/analyze_executor.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/analyze_executor.h"
+
+#include "catalog/catalog.h"
+#include "common/logger.h"
+#include "concurrency/transaction.h"
+#include "executor/executor_context.h"
+#include "optimizer/stats_storage.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+
+namespace peloton {
+namespace executor {
+
+AnalyzeExecutor::AnalyzeExecutor(const planner::AbstractPlan *node,
+                                 ExecutorContext *executor_context)
+    : AbstractExecutor(node, executor_context) {}
+
+bool AnalyzeExecutor::DInit() {
+  LOG_TRACE("Initializing Analyze Executor...");
+  return true;
+}
+
+bool AnalyzeExecutor::DExecute() {
+  LOG_TRACE("Executing Analyze...");
+  const planner::AnalyzePlan &node = GetPlanNode<planner::AnalyzePlan>();
+  auto current_txn = executor_context_->GetTransaction();
+  auto &stats_storage = optimizer::StatsStorage::GetInstance();
+
+  if (node.GetTargetTable() != nullptr) {
+    stats_storage.AnalyzeTable(node.GetTargetTable(), current_txn);
+  } else {
+    auto catalog = catalog::Catalog::GetInstance();
+    for (oid_t database_offset = 0;
+         database_offset < catalog->GetDatabaseCount(); database_offset++) {
+      auto database = catalog->GetDatabaseWithOffset(database_offset);
+      if (database->GetDBName() == CATALOG_DATABASE_NAME) {
+        continue;
+      }
+      for (oid_t table_offset = 0; table_offset < database->GetTableCount();
+           table_offset++) {
+        stats_storage.AnalyzeTable(database->GetTable(table_offset),
+                                   current_txn);
+      }
+    }
+  }
+
+  current_txn->SetResult(ResultType::SUCCESS);
+  return false;
+}
+
+}  // namespace executor
+}  // namespace peloton
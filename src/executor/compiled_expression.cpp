@@ -0,0 +1,850 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression.cpp
+//
+// Identification: src/executor/compiled_expression.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/compiled_expression.h"
+
+#include <cmath>
+
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "common/logger.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "expression/abstract_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/parameter_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace executor {
+
+namespace {
+
+typedef CompiledExpression::IntegerFunction IntegerFunction;
+typedef CompiledExpression::DecimalFunction DecimalFunction;
+typedef CompiledExpression::TimestampFunction TimestampFunction;
+typedef CompiledExpression::BooleanFunction BooleanFunction;
+typedef CompiledExpression::ColumnBinding ColumnBinding;
+
+bool IsIntegerType(type::Type::TypeId type_id) {
+  switch (type_id) {
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsNumericType(type::Type::TypeId type_id) {
+  return IsIntegerType(type_id) || type_id == type::Type::DECIMAL;
+}
+
+// The NULL of an integer type is its smallest value, so the values of the
+// type are (null, max]
+int64_t GetIntegerNull(type::Type::TypeId type_id) {
+  switch (type_id) {
+    case type::Type::TINYINT:
+      return type::PELOTON_INT8_NULL;
+    case type::Type::SMALLINT:
+      return type::PELOTON_INT16_NULL;
+    case type::Type::INTEGER:
+      return type::PELOTON_INT32_NULL;
+    default:
+      return type::PELOTON_INT64_NULL;
+  }
+}
+
+int64_t GetIntegerMax(type::Type::TypeId type_id) {
+  switch (type_id) {
+    case type::Type::TINYINT:
+      return type::PELOTON_INT8_MAX;
+    case type::Type::SMALLINT:
+      return type::PELOTON_INT16_MAX;
+    case type::Type::INTEGER:
+      return type::PELOTON_INT32_MAX;
+    default:
+      return type::PELOTON_INT64_MAX;
+  }
+}
+
+// Swaps the sides of a comparison: (c < x) is (x > c)
+ExpressionType MirrorComparison(ExpressionType type) {
+  switch (type) {
+    case ExpressionType::COMPARE_LESSTHAN:
+      return ExpressionType::COMPARE_GREATERTHAN;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return ExpressionType::COMPARE_LESSTHAN;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return ExpressionType::COMPARE_LESSTHANOREQUALTO;
+    default:
+      return type;
+  }
+}
+
+bool IsOperand(const expression::AbstractExpression *expr) {
+  return expr->GetExpressionType() == ExpressionType::VALUE_CONSTANT ||
+         expr->GetExpressionType() == ExpressionType::VALUE_PARAMETER;
+}
+
+//===--------------------------------------------------------------------===//
+// Columns
+//===--------------------------------------------------------------------===//
+
+template <typename ColumnType>
+inline bool ReadColumn(const ColumnBinding *binding, const oid_t *tuple_ids,
+                       ColumnType null_value, ColumnType &value) {
+  oid_t tuple_id = tuple_ids[binding->tuple_idx];
+  if (binding->position_list != nullptr) {
+    tuple_id = binding->position_list[tuple_id];
+    // Padding of an outer join
+    if (tuple_id == NULL_OID) return false;
+  }
+  value = *reinterpret_cast<const ColumnType *>(binding->base +
+                                                tuple_id * binding->stride);
+  return value != null_value;
+}
+
+template <typename ColumnType, typename ResultType>
+std::function<bool(const oid_t *, ResultType &)> MakeColumn(
+    const ColumnBinding *binding, ColumnType null_value) {
+  return [binding, null_value](const oid_t *tuple_ids, ResultType &result) {
+    ColumnType value;
+    if (ReadColumn(binding, tuple_ids, null_value, value) == false) {
+      return false;
+    }
+    result = value;
+    return true;
+  };
+}
+
+BooleanFunction MakeBooleanColumn(const ColumnBinding *binding) {
+  return [binding](const oid_t *tuple_ids) {
+    int8_t value;
+    if (ReadColumn(binding, tuple_ids, type::PELOTON_BOOLEAN_NULL, value) ==
+        false) {
+      return type::CMP_NULL;
+    }
+    return type::GetCmpBool(value == 1);
+  };
+}
+
+//===--------------------------------------------------------------------===//
+// Operands
+//===--------------------------------------------------------------------===//
+
+template <typename ResultType>
+std::function<bool(const oid_t *, ResultType &)> MakeConstant(
+    ResultType value, bool is_null) {
+  return [value, is_null](UNUSED_ATTRIBUTE const oid_t *tuple_ids,
+                          ResultType &result) {
+    result = value;
+    return is_null == false;
+  };
+}
+
+// Integers are compared and combined with decimals as doubles
+DecimalFunction ToDecimal(const IntegerFunction &function) {
+  return [function](const oid_t *tuple_ids, double &result) {
+    int64_t value;
+    if (function(tuple_ids, value) == false) return false;
+    result = value;
+    return true;
+  };
+}
+
+//===--------------------------------------------------------------------===//
+// Comparisons
+//===--------------------------------------------------------------------===//
+
+// Both sides are evaluated, as in the interpreter
+template <typename T, typename Compare>
+BooleanFunction MakeComparison(
+    const std::function<bool(const oid_t *, T &)> &left,
+    const std::function<bool(const oid_t *, T &)> &right) {
+  return [left, right](const oid_t *tuple_ids) {
+    T left_value, right_value;
+    bool left_valid = left(tuple_ids, left_value);
+    bool right_valid = right(tuple_ids, right_value);
+    if (left_valid == false || right_valid == false) return type::CMP_NULL;
+    return type::GetCmpBool(Compare()(left_value, right_value));
+  };
+}
+
+// Specialized for a constant right side, which is the common case
+template <typename T, typename Compare>
+BooleanFunction MakeComparison(
+    const std::function<bool(const oid_t *, T &)> &left, T right_value) {
+  return [left, right_value](const oid_t *tuple_ids) {
+    T left_value;
+    if (left(tuple_ids, left_value) == false) return type::CMP_NULL;
+    return type::GetCmpBool(Compare()(left_value, right_value));
+  };
+}
+
+template <typename T, typename Right>
+BooleanFunction MakeComparison(
+    ExpressionType type, const std::function<bool(const oid_t *, T &)> &left,
+    const Right &right) {
+  switch (type) {
+    case ExpressionType::COMPARE_EQUAL:
+      return MakeComparison<T, std::equal_to<T>>(left, right);
+    case ExpressionType::COMPARE_NOTEQUAL:
+      return MakeComparison<T, std::not_equal_to<T>>(left, right);
+    case ExpressionType::COMPARE_LESSTHAN:
+      return MakeComparison<T, std::less<T>>(left, right);
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return MakeComparison<T, std::greater<T>>(left, right);
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return MakeComparison<T, std::less_equal<T>>(left, right);
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return MakeComparison<T, std::greater_equal<T>>(left, right);
+    default:
+      throw Exception("Invalid comparison expression type.");
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Arithmetic
+//===--------------------------------------------------------------------===//
+
+struct AddOperator {
+  static inline bool Apply(int64_t x, int64_t y, int64_t &result) {
+    return __builtin_add_overflow(x, y, &result) == false;
+  }
+  static inline double Apply(double x, double y) { return x + y; }
+};
+
+struct SubtractOperator {
+  static inline bool Apply(int64_t x, int64_t y, int64_t &result) {
+    return __builtin_sub_overflow(x, y, &result) == false;
+  }
+  static inline double Apply(double x, double y) { return x - y; }
+};
+
+struct MultiplyOperator {
+  static inline bool Apply(int64_t x, int64_t y, int64_t &result) {
+    return __builtin_mul_overflow(x, y, &result) == false;
+  }
+  static inline double Apply(double x, double y) { return x * y; }
+};
+
+struct DivideOperator {
+  static inline bool Apply(int64_t x, int64_t y, int64_t &result) {
+    if (y == 0) {
+      throw Exception(EXCEPTION_TYPE_DIVIDE_BY_ZERO, "Division by zero.");
+    }
+    result = x / y;
+    return true;
+  }
+  static inline double Apply(double x, double y) {
+    if (y == 0) {
+      throw Exception(EXCEPTION_TYPE_DIVIDE_BY_ZERO, "Division by zero.");
+    }
+    return x / y;
+  }
+};
+
+struct ModuloOperator {
+  static inline bool Apply(int64_t x, int64_t y, int64_t &result) {
+    if (y == 0) {
+      throw Exception(EXCEPTION_TYPE_DIVIDE_BY_ZERO, "Division by zero.");
+    }
+    result = x % y;
+    return true;
+  }
+  static inline double Apply(double x, double y) {
+    if (y == 0) {
+      throw Exception(EXCEPTION_TYPE_DIVIDE_BY_ZERO, "Division by zero.");
+    }
+    return x - trunc(x / y) * y;
+  }
+};
+
+// The result has to fit the wider of the operand types. Its NULL value
+// makes a NULL, as in a type::Value.
+template <typename Operator>
+IntegerFunction MakeIntegerArithmetic(const IntegerFunction &left,
+                                      const IntegerFunction &right,
+                                      int64_t null_value, int64_t max_value) {
+  return [left, right, null_value, max_value](const oid_t *tuple_ids,
+                                              int64_t &result) {
+    int64_t left_value, right_value;
+    bool left_valid = left(tuple_ids, left_value);
+    bool right_valid = right(tuple_ids, right_value);
+    if (left_valid == false || right_valid == false) return false;
+    if (Operator::Apply(left_value, right_value, result) == false ||
+        result < null_value || result > max_value) {
+      throw Exception(EXCEPTION_TYPE_OUT_OF_RANGE,
+                      "Numeric value out of range.");
+    }
+    return result != null_value;
+  };
+}
+
+template <typename Operator>
+DecimalFunction MakeDecimalArithmetic(const DecimalFunction &left,
+                                      const DecimalFunction &right) {
+  return [left, right](const oid_t *tuple_ids, double &result) {
+    double left_value, right_value;
+    bool left_valid = left(tuple_ids, left_value);
+    bool right_valid = right(tuple_ids, right_value);
+    if (left_valid == false || right_valid == false) return false;
+    result = Operator::Apply(left_value, right_value);
+    return result != type::PELOTON_DECIMAL_NULL;
+  };
+}
+
+template <typename Operator>
+void MakeArithmetic(type::Type::TypeId value_type,
+                    const IntegerFunction &left_integer,
+                    const IntegerFunction &right_integer,
+                    const DecimalFunction &left_decimal,
+                    const DecimalFunction &right_decimal,
+                    IntegerFunction &integer, DecimalFunction &decimal) {
+  if (value_type == type::Type::DECIMAL) {
+    decimal = MakeDecimalArithmetic<Operator>(left_decimal, right_decimal);
+  } else {
+    integer = MakeIntegerArithmetic<Operator>(left_integer, right_integer,
+                                              GetIntegerNull(value_type),
+                                              GetIntegerMax(value_type));
+  }
+}
+
+}  // namespace
+
+//===--------------------------------------------------------------------===//
+// Compilation
+//===--------------------------------------------------------------------===//
+
+std::unique_ptr<CompiledExpression> CompiledExpression::Compile(
+    const expression::AbstractExpression *expr,
+    const catalog::Schema *left_schema, const catalog::Schema *right_schema,
+    ExecutorContext *executor_context) {
+  std::unique_ptr<CompiledExpression> compiled(new CompiledExpression());
+  compiled->schemas_[0] = left_schema;
+  compiled->schemas_[1] = right_schema;
+  compiled->executor_context_ = executor_context;
+
+  Node node;
+  if (expr == nullptr || compiled->CompileNode(expr, node) == false) {
+    LOG_TRACE("Expression is not compiled");
+    return nullptr;
+  }
+
+  compiled->value_type_ = node.value_type;
+  compiled->integer_ = std::move(node.integer);
+  compiled->decimal_ = std::move(node.decimal);
+  compiled->timestamp_ = std::move(node.timestamp);
+  compiled->boolean_ = std::move(node.boolean);
+  return compiled;
+}
+
+std::unique_ptr<CompiledExpression> CompiledExpression::Compile(
+    const std::vector<const expression::AbstractExpression *> &conjuncts,
+    const catalog::Schema *left_schema, const catalog::Schema *right_schema,
+    ExecutorContext *executor_context) {
+  if (conjuncts.empty() == true) return nullptr;
+
+  std::unique_ptr<CompiledExpression> compiled(new CompiledExpression());
+  compiled->schemas_[0] = left_schema;
+  compiled->schemas_[1] = right_schema;
+  compiled->executor_context_ = executor_context;
+
+  std::vector<Node> children(conjuncts.size());
+  for (size_t i = 0; i < conjuncts.size(); i++) {
+    if (compiled->CompileNode(conjuncts[i], children[i]) == false) {
+      LOG_TRACE("Conjunct %lu is not compiled", i);
+      return nullptr;
+    }
+  }
+
+  Node node;
+  if (compiled->CompileConjunction(ExpressionType::CONJUNCTION_AND,
+                                   std::move(children), node) == false) {
+    return nullptr;
+  }
+
+  compiled->value_type_ = node.value_type;
+  compiled->boolean_ = std::move(node.boolean);
+  return compiled;
+}
+
+bool CompiledExpression::CompileNode(
+    const expression::AbstractExpression *expr, Node &node) {
+  switch (expr->GetExpressionType()) {
+    case ExpressionType::VALUE_TUPLE:
+      return CompileColumn(expr, node);
+
+    case ExpressionType::VALUE_CONSTANT:
+      return CompileValue(
+          static_cast<const expression::ConstantValueExpression *>(expr)
+              ->GetValue(),
+          node);
+
+    case ExpressionType::VALUE_PARAMETER: {
+      if (executor_context_ == nullptr) return false;
+      auto &params = executor_context_->GetParams();
+      auto value_idx =
+          static_cast<const expression::ParameterValueExpression *>(expr)
+              ->GetValueIdx();
+      if (value_idx < 0 || (size_t)value_idx >= params.size()) return false;
+      return CompileValue(params[value_idx], node);
+    }
+
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return CompileComparison(expr, node);
+
+    case ExpressionType::OPERATOR_PLUS:
+    case ExpressionType::OPERATOR_MINUS:
+    case ExpressionType::OPERATOR_MULTIPLY:
+    case ExpressionType::OPERATOR_DIVIDE:
+    case ExpressionType::OPERATOR_MOD:
+    case ExpressionType::OPERATOR_UNARY_MINUS:
+      return CompileArithmetic(expr, node);
+
+    case ExpressionType::CONJUNCTION_AND:
+    case ExpressionType::CONJUNCTION_OR: {
+      std::vector<Node> children(expr->GetChildrenSize());
+      for (size_t i = 0; i < children.size(); i++) {
+        if (CompileNode(expr->GetChild(i), children[i]) == false) {
+          return false;
+        }
+      }
+      return CompileConjunction(expr->GetExpressionType(),
+                                std::move(children), node);
+    }
+
+    case ExpressionType::OPERATOR_NOT: {
+      Node child;
+      if (expr->GetChildrenSize() != 1 ||
+          CompileNode(expr->GetChild(0), child) == false ||
+          child.value_type != type::Type::BOOLEAN) {
+        return false;
+      }
+      auto child_boolean = std::move(child.boolean);
+      node.value_type = type::Type::BOOLEAN;
+      node.boolean = [child_boolean](const oid_t *tuple_ids) {
+        switch (child_boolean(tuple_ids)) {
+          case type::CMP_TRUE:
+            return type::CMP_FALSE;
+          case type::CMP_FALSE:
+            return type::CMP_TRUE;
+          default:
+            return type::CMP_NULL;
+        }
+      };
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+bool CompiledExpression::CompileColumn(
+    const expression::AbstractExpression *expr, Node &node) {
+  auto tuple_expr = static_cast<const expression::TupleValueExpression *>(expr);
+  int tuple_idx = tuple_expr->GetTupleId();
+  int column_id = tuple_expr->GetColumnId();
+  if (tuple_idx < 0 || tuple_idx > 1 || schemas_[tuple_idx] == nullptr) {
+    return false;
+  }
+  auto schema = schemas_[tuple_idx];
+  if (column_id < 0 || (size_t)column_id >= schema->GetColumnCount() ||
+      schema->IsInlined(column_id) == false) {
+    return false;
+  }
+
+  ColumnBinding binding;
+  binding.tuple_idx = tuple_idx;
+  binding.column_id = column_id;
+  binding.column_type = schema->GetType(column_id);
+
+  node.value_type = binding.column_type;
+  switch (binding.column_type) {
+    case type::Type::BOOLEAN:
+      bindings_.push_back(binding);
+      node.boolean = MakeBooleanColumn(&bindings_.back());
+      return true;
+    case type::Type::TINYINT:
+      bindings_.push_back(binding);
+      node.integer = MakeColumn<int8_t, int64_t>(&bindings_.back(),
+                                                 type::PELOTON_INT8_NULL);
+      return true;
+    case type::Type::SMALLINT:
+      bindings_.push_back(binding);
+      node.integer = MakeColumn<int16_t, int64_t>(&bindings_.back(),
+                                                  type::PELOTON_INT16_NULL);
+      return true;
+    case type::Type::INTEGER:
+      bindings_.push_back(binding);
+      node.integer = MakeColumn<int32_t, int64_t>(&bindings_.back(),
+                                                  type::PELOTON_INT32_NULL);
+      return true;
+    case type::Type::BIGINT:
+      bindings_.push_back(binding);
+      node.integer = MakeColumn<int64_t, int64_t>(&bindings_.back(),
+                                                  type::PELOTON_INT64_NULL);
+      return true;
+    case type::Type::DECIMAL:
+      bindings_.push_back(binding);
+      node.decimal = MakeColumn<double, double>(&bindings_.back(),
+                                                type::PELOTON_DECIMAL_NULL);
+      return true;
+    case type::Type::TIMESTAMP:
+      bindings_.push_back(binding);
+      node.timestamp = MakeColumn<uint64_t, uint64_t>(
+          &bindings_.back(), type::PELOTON_TIMESTAMP_NULL);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool CompiledExpression::CompileValue(const type::Value &value, Node &node) {
+  bool is_null = value.IsNull();
+  node.value_type = value.GetTypeId();
+  switch (node.value_type) {
+    case type::Type::BOOLEAN: {
+      type::CmpBool result =
+          is_null ? type::CMP_NULL : type::GetCmpBool(value.IsTrue());
+      node.boolean = [result](UNUSED_ATTRIBUTE const oid_t *tuple_ids) {
+        return result;
+      };
+      return true;
+    }
+    case type::Type::TINYINT:
+      node.integer = MakeConstant<int64_t>(value.GetAs<int8_t>(), is_null);
+      return true;
+    case type::Type::SMALLINT:
+      node.integer = MakeConstant<int64_t>(value.GetAs<int16_t>(), is_null);
+      return true;
+    case type::Type::INTEGER:
+      node.integer = MakeConstant<int64_t>(value.GetAs<int32_t>(), is_null);
+      return true;
+    case type::Type::BIGINT:
+      node.integer = MakeConstant<int64_t>(value.GetAs<int64_t>(), is_null);
+      return true;
+    case type::Type::DECIMAL:
+      node.decimal = MakeConstant<double>(value.GetAs<double>(), is_null);
+      return true;
+    case type::Type::TIMESTAMP:
+      node.timestamp = MakeConstant<uint64_t>(value.GetAs<uint64_t>(), is_null);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool CompiledExpression::CompileComparison(
+    const expression::AbstractExpression *expr, Node &node) {
+  if (expr->GetChildrenSize() != 2) return false;
+
+  // Keep a constant operand on the right, where it is specialized
+  auto left = expr->GetChild(0);
+  auto right = expr->GetChild(1);
+  auto type = expr->GetExpressionType();
+  if (IsOperand(left) == true && IsOperand(right) == false) {
+    std::swap(left, right);
+    type = MirrorComparison(type);
+  }
+
+  Node left_node, right_node;
+  if (CompileNode(left, left_node) == false ||
+      CompileNode(right, right_node) == false) {
+    return false;
+  }
+  auto left_type = left_node.value_type;
+  auto right_type = right_node.value_type;
+
+  // A non-NULL constant is folded into the comparison
+  type::Value operand;
+  bool is_constant = false;
+  if (IsOperand(right) == true) {
+    if (right->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
+      operand = static_cast<const expression::ConstantValueExpression *>(right)
+                    ->GetValue();
+    } else {
+      operand = executor_context_->GetParams().at(
+          static_cast<const expression::ParameterValueExpression *>(right)
+              ->GetValueIdx());
+    }
+    is_constant = (operand.IsNull() == false);
+  }
+
+  node.value_type = type::Type::BOOLEAN;
+
+  // Pick the type both sides are compared in, following the promotion
+  // rules of type::Value comparisons
+  if (IsIntegerType(left_type) && IsIntegerType(right_type)) {
+    if (is_constant == true) {
+      int64_t value;
+      right_node.integer(nullptr, value);
+      node.boolean = MakeComparison(type, left_node.integer, value);
+    } else {
+      node.boolean = MakeComparison(type, left_node.integer, right_node.integer);
+    }
+  } else if (IsNumericType(left_type) && IsNumericType(right_type)) {
+    auto left_decimal = (left_type == type::Type::DECIMAL)
+                            ? left_node.decimal
+                            : ToDecimal(left_node.integer);
+    auto right_decimal = (right_type == type::Type::DECIMAL)
+                             ? right_node.decimal
+                             : ToDecimal(right_node.integer);
+    if (is_constant == true) {
+      double value;
+      right_decimal(nullptr, value);
+      node.boolean = MakeComparison(type, left_decimal, value);
+    } else {
+      node.boolean = MakeComparison(type, left_decimal, right_decimal);
+    }
+  } else if (left_type == type::Type::TIMESTAMP &&
+             right_type == type::Type::TIMESTAMP) {
+    if (is_constant == true) {
+      uint64_t value;
+      right_node.timestamp(nullptr, value);
+      node.boolean = MakeComparison(type, left_node.timestamp, value);
+    } else {
+      node.boolean =
+          MakeComparison(type, left_node.timestamp, right_node.timestamp);
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool CompiledExpression::CompileArithmetic(
+    const expression::AbstractExpression *expr, Node &node) {
+  auto type = expr->GetExpressionType();
+  Node left_node, right_node;
+
+  if (type == ExpressionType::OPERATOR_UNARY_MINUS) {
+    // Evaluated as 0 - x, like the interpreter does
+    if (expr->GetChildrenSize() != 1 ||
+        CompileValue(type::ValueFactory::GetIntegerValue(0), left_node) ==
+            false ||
+        CompileNode(expr->GetChild(0), right_node) == false) {
+      return false;
+    }
+    type = ExpressionType::OPERATOR_MINUS;
+  } else if (expr->GetChildrenSize() != 2 ||
+             CompileNode(expr->GetChild(0), left_node) == false ||
+             CompileNode(expr->GetChild(1), right_node) == false) {
+    return false;
+  }
+
+  auto left_type = left_node.value_type;
+  auto right_type = right_node.value_type;
+  if (IsNumericType(left_type) == false ||
+      IsNumericType(right_type) == false) {
+    return false;
+  }
+
+  // The result has the wider type of the two
+  node.value_type = std::max(left_type, right_type);
+
+  DecimalFunction left_decimal, right_decimal;
+  if (node.value_type == type::Type::DECIMAL) {
+    left_decimal = (left_type == type::Type::DECIMAL)
+                       ? left_node.decimal
+                       : ToDecimal(left_node.integer);
+    right_decimal = (right_type == type::Type::DECIMAL)
+                        ? right_node.decimal
+                        : ToDecimal(right_node.integer);
+  }
+
+  switch (type) {
+    case ExpressionType::OPERATOR_PLUS:
+      MakeArithmetic<AddOperator>(node.value_type, left_node.integer,
+                                  right_node.integer, left_decimal,
+                                  right_decimal, node.integer, node.decimal);
+      return true;
+    case ExpressionType::OPERATOR_MINUS:
+      MakeArithmetic<SubtractOperator>(
+          node.value_type, left_node.integer, right_node.integer,
+          left_decimal, right_decimal, node.integer, node.decimal);
+      return true;
+    case ExpressionType::OPERATOR_MULTIPLY:
+      MakeArithmetic<MultiplyOperator>(
+          node.value_type, left_node.integer, right_node.integer,
+          left_decimal, right_decimal, node.integer, node.decimal);
+      return true;
+    case ExpressionType::OPERATOR_DIVIDE:
+      MakeArithmetic<DivideOperator>(node.value_type, left_node.integer,
+                                     right_node.integer, left_decimal,
+                                     right_decimal, node.integer,
+                                     node.decimal);
+      return true;
+    case ExpressionType::OPERATOR_MOD:
+      MakeArithmetic<ModuloOperator>(node.value_type, left_node.integer,
+                                     right_node.integer, left_decimal,
+                                     right_decimal, node.integer,
+                                     node.decimal);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool CompiledExpression::CompileConjunction(ExpressionType type,
+                                            std::vector<Node> &&children,
+                                            Node &node) {
+  if (children.empty() == true) return false;
+  for (auto &child : children) {
+    if (child.value_type != type::Type::BOOLEAN) return false;
+  }
+
+  // Fold the children from the left
+  BooleanFunction result = std::move(children[0].boolean);
+  for (size_t i = 1; i < children.size(); i++) {
+    BooleanFunction left = std::move(result);
+    BooleanFunction right = std::move(children[i].boolean);
+    if (type == ExpressionType::CONJUNCTION_AND) {
+      result = [left, right](const oid_t *tuple_ids) {
+        auto left_value = left(tuple_ids);
+        if (left_value == type::CMP_FALSE) return type::CMP_FALSE;
+        auto right_value = right(tuple_ids);
+        if (right_value == type::CMP_FALSE) return type::CMP_FALSE;
+        if (left_value == type::CMP_TRUE && right_value == type::CMP_TRUE) {
+          return type::CMP_TRUE;
+        }
+        return type::CMP_NULL;
+      };
+    } else if (type == ExpressionType::CONJUNCTION_OR) {
+      result = [left, right](const oid_t *tuple_ids) {
+        auto left_value = left(tuple_ids);
+        if (left_value == type::CMP_TRUE) return type::CMP_TRUE;
+        auto right_value = right(tuple_ids);
+        if (right_value == type::CMP_TRUE) return type::CMP_TRUE;
+        if (left_value == type::CMP_FALSE && right_value == type::CMP_FALSE) {
+          return type::CMP_FALSE;
+        }
+        return type::CMP_NULL;
+      };
+    } else {
+      return false;
+    }
+  }
+
+  node.value_type = type::Type::BOOLEAN;
+  node.boolean = std::move(result);
+  return true;
+}
+
+//===--------------------------------------------------------------------===//
+// Evaluation
+//===--------------------------------------------------------------------===//
+
+bool CompiledExpression::Bind(oid_t tuple_idx,
+                              storage::TileGroup *tile_group) {
+  for (auto &binding : bindings_) {
+    if (binding.tuple_idx != tuple_idx) continue;
+
+    // Tiles are row-major, so the column is strided by the length of a
+    // tile tuple
+    oid_t tile_offset, tile_column_id;
+    tile_group->LocateTileAndColumn(binding.column_id, tile_offset,
+                                    tile_column_id);
+    auto tile = tile_group->GetTile(tile_offset);
+    auto tile_schema = tile->GetSchema();
+    if (tile_schema->GetType(tile_column_id) != binding.column_type ||
+        tile_schema->IsInlined(tile_column_id) == false) {
+      return false;
+    }
+    binding.base =
+        tile->GetTupleLocation(0) + tile_schema->GetOffset(tile_column_id);
+    binding.stride = tile_schema->GetLength();
+    binding.position_list = nullptr;
+  }
+  return true;
+}
+
+bool CompiledExpression::Bind(oid_t tuple_idx, LogicalTile *tile) {
+  for (auto &binding : bindings_) {
+    if (binding.tuple_idx != tuple_idx) continue;
+
+    if (binding.column_id >= tile->GetColumnCount()) return false;
+    auto &column_info = tile->GetColumnInfo(binding.column_id);
+    auto base_tile = column_info.base_tile.get();
+    auto tile_schema = base_tile->GetSchema();
+    oid_t tile_column_id = column_info.origin_column_id;
+    if (tile_schema->GetType(tile_column_id) != binding.column_type ||
+        tile_schema->IsInlined(tile_column_id) == false) {
+      return false;
+    }
+    binding.base = base_tile->GetTupleLocation(0) +
+                   tile_schema->GetOffset(tile_column_id);
+    binding.stride = tile_schema->GetLength();
+    binding.position_list =
+        tile->GetPositionList(column_info.position_list_idx).data();
+  }
+  return true;
+}
+
+type::Value CompiledExpression::Evaluate(const oid_t *tuple_ids) const {
+  switch (value_type_) {
+    case type::Type::BOOLEAN:
+      return type::ValueFactory::GetBooleanValue(boolean_(tuple_ids));
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT: {
+      int64_t result;
+      if (integer_(tuple_ids, result) == false) {
+        return type::ValueFactory::GetNullValueByType(value_type_);
+      }
+      switch (value_type_) {
+        case type::Type::TINYINT:
+          return type::ValueFactory::GetTinyIntValue((int8_t)result);
+        case type::Type::SMALLINT:
+          return type::ValueFactory::GetSmallIntValue((int16_t)result);
+        case type::Type::INTEGER:
+          return type::ValueFactory::GetIntegerValue((int32_t)result);
+        default:
+          return type::ValueFactory::GetBigIntValue(result);
+      }
+    }
+    case type::Type::DECIMAL: {
+      double result;
+      if (decimal_(tuple_ids, result) == false) {
+        return type::ValueFactory::GetNullValueByType(value_type_);
+      }
+      return type::ValueFactory::GetDecimalValue(result);
+    }
+    case type::Type::TIMESTAMP: {
+      uint64_t result;
+      if (timestamp_(tuple_ids, result) == false) {
+        return type::ValueFactory::GetNullValueByType(value_type_);
+      }
+      return type::ValueFactory::GetTimestampValue(result);
+    }
+    default:
+      throw Exception("Invalid compiled expression type.");
+  }
+}
+
+}  // namespace executor
+}  // namespace peloton
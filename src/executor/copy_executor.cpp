@@ -16,6 +16,7 @@
 
 #include "common/logger.h"
 #include "catalog/catalog.h"
+#include "catalog/manager.h"
 #include "executor/copy_executor.h"
 #include "executor/executor_context.h"
 #include "executor/logical_tile_factory.h"
@@ -24,12 +25,208 @@
 #include "logging/logging_util.h"
 #include "common/exception.h"
 #include "common/macros.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "type/value_factory.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
 
 namespace peloton {
 namespace executor {
 
+namespace {
+
+// The rows of one chunk of the file, loaded by one thread
+struct LoadChunk {
+  size_t begin = 0;
+  size_t end = 0;
+  std::vector<ItemPointer> locations;
+  std::vector<ItemPointer *> index_entry_ptrs;
+  std::string error_message;
+};
+
+// Whether the character at pos follows an odd number of backslashes
+bool IsEscaped(const char *data, size_t pos) {
+  size_t backslash_count = 0;
+  while (backslash_count < pos && data[pos - backslash_count - 1] == '\\') {
+    backslash_count++;
+  }
+  return backslash_count % 2 == 1;
+}
+
+// The start of the first row at or after offset
+size_t FindRowStart(const char *data, size_t size, size_t offset) {
+  if (offset == 0) return 0;
+  for (size_t pos = offset - 1; pos < size; pos++) {
+    if (data[pos] == '\n' && IsEscaped(data, pos) == false) {
+      return pos + 1;
+    }
+  }
+  return size;
+}
+
+// The value of a field for its column. The value of a varlen field points
+// into the field, which has to outlive it.
+type::Value ParseField(const std::string &field, bool is_null,
+                       const catalog::Schema *schema, oid_t column_id) {
+  auto type_id = schema->GetType(column_id);
+  if (is_null == true ||
+      (field.empty() == true && type_id != type::Type::VARCHAR &&
+       type_id != type::Type::VARBINARY)) {
+    if (schema->AllowNull(column_id) == false) {
+      throw ConstraintException("Not NULL constraint violated for column " +
+                                schema->GetColumn(column_id).GetName());
+    }
+    return type::ValueFactory::GetNullValueByType(type_id);
+  }
+
+  switch (type_id) {
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT: {
+      char *end = nullptr;
+      errno = 0;
+      long long value = strtoll(field.c_str(), &end, 10);
+      bool valid = (*end == '\0' && errno == 0);
+      if (type_id == type::Type::TINYINT) {
+        valid = valid && value >= type::PELOTON_INT8_MIN && value <= type::PELOTON_INT8_MAX;
+        if (valid == true) return type::ValueFactory::GetTinyIntValue(value);
+      } else if (type_id == type::Type::SMALLINT) {
+        valid =
+            valid && value >= type::PELOTON_INT16_MIN && value <= type::PELOTON_INT16_MAX;
+        if (valid == true) return type::ValueFactory::GetSmallIntValue(value);
+      } else if (type_id == type::Type::INTEGER) {
+        valid =
+            valid && value >= type::PELOTON_INT32_MIN && value <= type::PELOTON_INT32_MAX;
+        if (valid == true) return type::ValueFactory::GetIntegerValue(value);
+      } else {
+        valid = valid && value >= type::PELOTON_INT64_MIN;
+        if (valid == true) return type::ValueFactory::GetBigIntValue(value);
+      }
+      break;
+    }
+    case type::Type::DECIMAL: {
+      char *end = nullptr;
+      errno = 0;
+      double value = strtod(field.c_str(), &end);
+      if (*end == '\0' && errno == 0) {
+        return type::ValueFactory::GetDecimalValue(value);
+      }
+      break;
+    }
+    case type::Type::VARCHAR:
+      return type::ValueFactory::GetVarcharValue(field.c_str(), false);
+    case type::Type::VARBINARY:
+      return type::ValueFactory::GetVarbinaryValue(
+          reinterpret_cast<const unsigned char *>(field.data()), field.size(),
+          false);
+    default:
+      // Booleans and timestamps have their own spellings
+      return type::ValueFactory::GetVarcharValue(field.c_str(), false)
+          .CastAs(type_id);
+  }
+
+  throw ExecutorException("Invalid value \"" + field + "\" for column " +
+                          schema->GetColumn(column_id).GetName());
+}
+
+// Parse the rows of a chunk into tile groups of their own, then insert
+// them into the indexes. A field NULL is written as \N, and a backslash
+// escapes the next character, e.g. a delimiter or a newline in a field.
+void LoadRows(storage::DataTable *table, const char *data, char delimiter,
+              concurrency::Transaction *txn, LoadChunk *chunk) {
+  auto schema = table->GetSchema();
+  oid_t column_count = schema->GetColumnCount();
+  std::vector<std::string> fields(column_count);
+  std::vector<bool> nulls(column_count);
+  std::vector<type::Value> values(column_count);
+  std::shared_ptr<storage::TileGroup> tile_group;
+
+  try {
+    size_t pos = chunk->begin;
+    while (pos < chunk->end) {
+      // Split the row into its fields
+      oid_t field_count = 1;
+      fields[0].clear();
+      nulls[0] = false;
+      while (pos < chunk->end) {
+        char ch = data[pos++];
+        auto &field = fields[field_count - 1];
+        if (ch == '\\' && pos < chunk->end) {
+          ch = data[pos++];
+          if (ch == 'N' && field.empty() == true) {
+            nulls[field_count - 1] = true;
+            continue;
+          }
+        } else if (ch == delimiter) {
+          if (field_count == column_count) {
+            throw ExecutorException("Extra data after the last column");
+          }
+          fields[field_count].clear();
+          nulls[field_count] = false;
+          field_count++;
+          continue;
+        } else if (ch == '\n') {
+          break;
+        } else if (ch == '\r' && pos < chunk->end && data[pos] == '\n') {
+          continue;
+        }
+        field.push_back(ch);
+      }
+
+      // Skip empty lines
+      if (field_count == 1 && fields[0].empty() == true &&
+          nulls[0] == false && column_count > 1) {
+        continue;
+      }
+      if (field_count < column_count) {
+        throw ExecutorException("Missing data for column " +
+                                schema->GetColumn(field_count).GetName());
+      }
+
+      for (oid_t column_id = 0; column_id < column_count; column_id++) {
+        values[column_id] = ParseField(fields[column_id], nulls[column_id],
+                                       schema, column_id);
+      }
+
+      // Append the row to the tile group of this thread
+      oid_t tuple_slot = INVALID_OID;
+      if (tile_group.get() != nullptr) {
+        tuple_slot = tile_group->InsertTuple(nullptr);
+      }
+      if (tuple_slot == INVALID_OID) {
+        tile_group = table->AddBulkLoadTileGroup();
+        tuple_slot = tile_group->InsertTuple(nullptr);
+      }
+      // The row belongs to the load from now on, so that the unique indexes
+      // take it as occupied when a later row of the file has the same key
+      tile_group->GetHeader()->SetTransactionId(tuple_slot,
+                                                txn->GetTransactionId());
+      for (oid_t column_id = 0; column_id < column_count; column_id++) {
+        tile_group->SetValue(values[column_id], tuple_slot, column_id);
+      }
+      chunk->locations.emplace_back(tile_group->GetTileGroupId(), tuple_slot);
+    }
+  } catch (Exception &e) {
+    chunk->error_message = e.what();
+  }
+
+  // Index the rows once they are all in the table
+  if (table->InsertInIndexes(chunk->locations, txn,
+                             chunk->index_entry_ptrs) == false &&
+      chunk->error_message.empty() == true) {
+    chunk->error_message = "Index constraint violated";
+  }
+}
+
+}  // namespace
+
 /**
  * @brief Constructor for Copy executor.
  * @param node Copy node corresponding to this executor.
@@ -38,18 +235,51 @@ CopyExecutor::CopyExecutor(const planner::AbstractPlan *node,
                            ExecutorContext *executor_context)
     : AbstractExecutor(node, executor_context) {}
 
-CopyExecutor::~CopyExecutor() {}
+CopyExecutor::~CopyExecutor() {
+  if (file_data_ != nullptr) {
+    munmap(file_data_, file_size_);
+  }
+}
 
 /**
  * @brief Basic initialization.
  * @return true on success, false otherwise.
  */
 bool CopyExecutor::DInit() {
-  PL_ASSERT(children_.size() == 1);
-
   // Grab info from plan node and check it
   const planner::CopyPlan &node = GetPlanNode<planner::CopyPlan>();
 
+  // Map the file to load into memory, the loader threads split it at row
+  // boundaries
+  if (node.IsImport() == true) {
+    PL_ASSERT(children_.size() == 0);
+    int fd = open(node.file_path.c_str(), O_RDONLY);
+    struct stat file_stat;
+    if (fd < 0 || fstat(fd, &file_stat) != 0) {
+      if (fd >= 0) close(fd);
+      throw ExecutorException("Failed to open file " + node.file_path +
+                              ". Try absolute path and make sure you have the "
+                              "permission to access this file.");
+    }
+
+    file_size_ = file_stat.st_size;
+    if (file_size_ > 0) {
+      void *file_data =
+          mmap(nullptr, file_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (file_data == MAP_FAILED) {
+        close(fd);
+        throw ExecutorException("Failed to read file " + node.file_path);
+      }
+      file_data_ = static_cast<char *>(file_data);
+      madvise(file_data_, file_size_, MADV_SEQUENTIAL);
+    }
+    close(fd);
+    LOG_DEBUG("Mapped copy input file: %s", node.file_path.c_str());
+    return true;
+  }
+
+  PL_ASSERT(children_.size() == 1);
+
   bool success = logging::LoggingUtil::InitFileHandle(node.file_path.c_str(),
                                                       file_handle_, "w");
 
@@ -145,6 +375,95 @@ void CopyExecutor::Copy(const char *data, int len, bool end_of_line) {
   PL_ASSERT(buff_size <= COPY_BUFFER_SIZE);
 }
 
+/**
+ * Load the file into the target table. Each thread parses a chunk of the
+ * file into tile groups of its own and then inserts its rows into the
+ * indexes, so rows never go through the active tile groups or the indexes
+ * one at a time. The rows are added to the transaction at the end, so the
+ * load is committed, logged or aborted as one.
+ */
+bool CopyExecutor::ImportFile() {
+  const planner::CopyPlan &node = GetPlanNode<planner::CopyPlan>();
+  auto target_table = node.target_table;
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+
+  if (target_table == nullptr) {
+    transaction_manager.SetTransactionResult(current_txn,
+                                             peloton::ResultType::FAILURE);
+    return false;
+  }
+
+  // One chunk per thread, but no smaller than COPY_LOAD_CHUNK_SIZE
+  size_t max_thread_count = load_thread_count_;
+  if (max_thread_count == 0) {
+    max_thread_count =
+        std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  size_t thread_count = std::min<size_t>(
+      max_thread_count, file_size_ / COPY_LOAD_CHUNK_SIZE + 1);
+  std::vector<LoadChunk> chunks(thread_count);
+  for (size_t chunk_itr = 0; chunk_itr < thread_count; chunk_itr++) {
+    chunks[chunk_itr].begin = FindRowStart(
+        file_data_, file_size_, file_size_ / thread_count * chunk_itr);
+    if (chunk_itr > 0) {
+      chunks[chunk_itr - 1].end = chunks[chunk_itr].begin;
+    }
+  }
+  chunks.back().end = file_size_;
+
+  std::vector<std::thread> threads;
+  for (size_t chunk_itr = 1; chunk_itr < thread_count; chunk_itr++) {
+    threads.emplace_back(LoadRows, target_table, file_data_, node.delimiter,
+                         current_txn, &chunks[chunk_itr]);
+  }
+  LoadRows(target_table, file_data_, node.delimiter, current_txn, &chunks[0]);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // Add the rows to the transaction, so that they are cleaned up if it
+  // aborts. Rows without an index entry never made it into all the indexes,
+  // they are given up so that they don't keep their keys occupied.
+  auto &manager = catalog::Manager::GetInstance();
+  bool has_indexes = (target_table->GetIndexCount() > 0);
+  size_t row_count = 0;
+  std::string error_message;
+  for (auto &chunk : chunks) {
+    for (size_t row_itr = 0; row_itr < chunk.locations.size(); row_itr++) {
+      auto &location = chunk.locations[row_itr];
+      auto index_entry_ptr = chunk.index_entry_ptrs[row_itr];
+      if (has_indexes == true && index_entry_ptr == nullptr) {
+        manager.GetTileGroupPtr(location.block)
+            ->GetHeader()
+            ->SetTransactionId(location.offset, INVALID_TXN_ID);
+        continue;
+      }
+      transaction_manager.PerformInsert(current_txn, location,
+                                        index_entry_ptr);
+      row_count++;
+    }
+    if (error_message.empty() == true) {
+      error_message = chunk.error_message;
+    }
+  }
+  target_table->IncreaseTupleCount(row_count);
+
+  if (error_message.empty() == false) {
+    LOG_ERROR("Failed to copy %s into table %s: %s", node.file_path.c_str(),
+              target_table->GetName().c_str(), error_message.c_str());
+    transaction_manager.SetTransactionResult(current_txn,
+                                             peloton::ResultType::FAILURE);
+    return false;
+  }
+
+  LOG_DEBUG("Loaded %lu rows with %lu threads", row_count, thread_count);
+  executor_context_->num_processed += row_count;
+  return true;
+}
+
 /**
  * @return true on success, false otherwise.
  */
@@ -154,6 +473,11 @@ bool CopyExecutor::DExecute() {
     return false;
   }
 
+  if (GetPlanNode<planner::CopyPlan>().IsImport() == true) {
+    done = true;
+    return ImportFile();
+  }
+
   while (children_[0]->Execute() == true) {
     // Get input a tile
     std::unique_ptr<LogicalTile> logical_tile(children_[0]->GetOutput());
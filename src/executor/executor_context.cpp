@@ -46,11 +46,11 @@ void ExecutorContext::ClearParams() {
   params_.clear();
 }
 
-type::EphemeralPool *ExecutorContext::GetPool() {
+type::ArenaPool *ExecutorContext::GetPool() {
 
   // construct pool if needed
   if (pool_.get() == nullptr) {
-    pool_.reset(new type::EphemeralPool());
+    pool_.reset(new type::ArenaPool());
   }
 
   // return pool
@@ -78,25 +78,14 @@ bool HashExecutor::DExecute() {
       column_ids_.push_back(tuple_value->GetColumnId());
     }
 
-    // Construct the hash table by going over each child logical tile and
-    // hashing
-    for (size_t child_tile_itr = 0; child_tile_itr < child_tiles_.size();
-         child_tile_itr++) {
-      auto tile = child_tiles_[child_tile_itr].get();
-
-      // Go over all tuples in the logical tile
-      for (oid_t tuple_id : *tile) {
-        // Key : container tuple with a subset of tuple attributes
-        // Value : < child_tile offset, tuple offset >
-        auto key = HashMapType::key_type(tile, tuple_id, &column_ids_);
-        if (hash_table_.find(key) != hash_table_.end()){
-           //If data is already present, remove from output
-           //but leave data for hash joins.
-           tile->RemoveVisibility(tuple_id);
-        }
-        hash_table_[key].insert(
-                    std::make_pair(child_tile_itr, tuple_id));
-      }
+    // Construct the hash table over all child logical tiles
+    std::vector<JoinHashTable::Entry> duplicates;
+    hash_table_.Build(child_tiles_, column_ids_, duplicates);
+
+    // If data is already present, remove from output
+    // but leave data for hash joins.
+    for (auto &duplicate : duplicates) {
+      child_tiles_[duplicate.tile_idx]->RemoveVisibility(duplicate.tuple_id);
     }
 
     done_ = true;
@@ -17,8 +17,11 @@
 #include "common/logger.h"
 #include "executor/logical_tile_factory.h"
 #include "executor/hash_join_executor.h"
+#include "executor/seq_scan_executor.h"
 #include "expression/abstract_expression.h"
 #include "common/container_tuple.h"
+#include "common/init.h"
+#include "common/thread_pool.h"
 
 namespace peloton {
 namespace executor {
@@ -78,111 +81,136 @@ bool HashJoinExecutor::DExecute() {
         BufferRightTile(children_[1]->GetOutput());
       }
       right_child_done_ = true;
-    }
 
-    // Get next tile from LEFT child
-    if (children_[0]->Execute() == false) {
-      LOG_TRACE("Did not get left tile \n");
-      left_child_done_ = true;
-      continue;
+      // Let a scan of the left table drop tuples that cannot find a match
+      if (CanDropUnmatchedLeftRows() == true &&
+          right_result_tiles_.size() > 0 &&
+          children_[0]->GetRawNode() != nullptr &&
+          children_[0]->GetRawNode()->GetPlanNodeType() ==
+              PlanNodeType::SEQSCAN) {
+        reinterpret_cast<SeqScanExecutor *>(children_[0])->SetJoinFilter(
+            &hash_executor_->GetHashTable().GetBloomFilter(),
+            &hash_executor_->GetHashKeyIds());
+      }
     }
 
-    BufferLeftTile(children_[0]->GetOutput());
-    LOG_TRACE("Got left tile \n");
+    // Get all the tiles from LEFT child
+    while (children_[0]->Execute()) {
+      BufferLeftTile(children_[0]->GetOutput());
 
-    if (right_result_tiles_.size() == 0) {
-      LOG_TRACE("Did not get any right tiles \n");
-      return BuildOuterJoinOutput();
+      // Without right tiles, no more left tiles are needed unless they show
+      // up in the output of an outer join
+      if (right_result_tiles_.size() == 0 &&
+          CanDropUnmatchedLeftRows() == true) {
+        break;
+      }
     }
+    LOG_TRACE("Got %lu left tiles \n", left_result_tiles_.size());
+    left_child_done_ = true;
 
-    LogicalTile *left_tile = left_result_tiles_.back().get();
+    if (right_result_tiles_.size() == 0 || left_result_tiles_.size() == 0) {
+      LOG_TRACE("Did not get any right or left tiles \n");
+      continue;
+    }
 
     //===------------------------------------------------------------------===//
-    // Build Join Tile
+    // Build Join Tiles
     //===------------------------------------------------------------------===//
 
-    // Get the hash table from the hash executor
-    auto &hash_table = hash_executor_->GetHashTable();
-    auto &hashed_col_ids = hash_executor_->GetHashKeyIds();
-
-    oid_t prev_tile = INVALID_OID;
-    std::unique_ptr<LogicalTile> output_tile;
-    LogicalTile::PositionListsBuilder pos_lists_builder;
+    ProbeHashTable();
+  }
+}
 
-    // Go over the left tile
-    for (auto left_tile_itr : *left_tile) {
+/**
+ * @brief Partition the left tiles like the hash table and probe the
+ * partitions in parallel. The join tiles are then built from the matches.
+ */
+void HashJoinExecutor::ProbeHashTable() {
+  // Get the hash table from the hash executor
+  auto &hash_table = hash_executor_->GetHashTable();
+  auto &hashed_col_ids = hash_executor_->GetHashKeyIds();
+
+  JoinHashTable::PartitionedEntries left_partitions;
+  hash_table.Partition(left_result_tiles_, hashed_col_ids,
+                       CanDropUnmatchedLeftRows(), left_partitions);
+
+  // Find matching tuples in the hash table built on top of the right table
+  std::vector<std::vector<JoinMatch>> partition_matches(
+      left_partitions.size());
+  thread_pool.RunTasks(left_partitions.size(), [&](size_t partition_idx) {
+    auto &matches = partition_matches[partition_idx];
+
+    for (auto &left_entry : left_partitions[partition_idx]) {
       const expression::ContainerTuple<executor::LogicalTile> left_tuple(
-          left_tile, left_tile_itr, &hashed_col_ids);
-
-      // Find matching tuples in the hash table built on top of the right table
-      auto right_tuples = hash_table.find(left_tuple);
-
-      if (right_tuples != hash_table.end()) {
-    	// Not yet supported due to assertion in gettomg right_tuples->first
-//    	if (predicate_ != nullptr) {
-//    		auto eval = predicate_->Evaluate(&left_tuple, &right_tuples->first,
-//					executor_context_);
-//			if (eval.IsFalse())
-//				continue;
-//    	}
-
-        RecordMatchedLeftRow(left_result_tiles_.size() - 1, left_tile_itr);
-
-        // Go over the matching right tuples
-        for (auto &location : right_tuples->second) {
-          // Check if we got a new right tile itr
-          if (prev_tile != location.first) {
-            // Check if we have any join tuples
-            if (pos_lists_builder.Size() > 0) {
-              LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
-              output_tile->SetPositionListsAndVisibility(
-                  pos_lists_builder.Release());
-              buffered_output_tiles.push_back(output_tile.release());
+          left_result_tiles_[left_entry.tile_idx].get(), left_entry.tuple_id,
+          &hashed_col_ids);
+
+      hash_table.FindMatches(
+          partition_idx, left_entry.hash,
+          [&](const JoinHashTable::Entry &right_entry) {
+            const expression::ContainerTuple<executor::LogicalTile>
+                right_tuple(right_result_tiles_[right_entry.tile_idx].get(),
+                            right_entry.tuple_id, &hashed_col_ids);
+            if (left_tuple.EqualsNoSchemaCheck(right_tuple) == true) {
+              matches.push_back({left_entry.tile_idx, left_entry.tuple_id,
+                                 right_entry.tile_idx, right_entry.tuple_id});
             }
+          });
+    }
+  });
 
-            // Get the logical tile from right child
-            LogicalTile *right_tile = right_result_tiles_[location.first].get();
-
-            // Build output logical tile
-            output_tile = BuildOutputLogicalTile(left_tile, right_tile);
+  for (auto &matches : partition_matches) {
+    BuildJoinTiles(matches);
+  }
+}
 
-            // Build position lists
-            pos_lists_builder =
-                LogicalTile::PositionListsBuilder(left_tile, right_tile);
+/**
+ * @brief Build join tiles from matches, one per run of matches between the
+ * same left and right tiles.
+ */
+void HashJoinExecutor::BuildJoinTiles(const std::vector<JoinMatch> &matches) {
+  size_t prev_left_tile = INVALID_OID;
+  size_t prev_right_tile = INVALID_OID;
+  std::unique_ptr<LogicalTile> output_tile;
+  LogicalTile::PositionListsBuilder pos_lists_builder;
+
+  for (auto &match : matches) {
+    // Check if we got a new pair of tiles
+    if (prev_left_tile != match.left_tile_idx ||
+        prev_right_tile != match.right_tile_idx) {
+      // Check if we have any join tuples
+      if (pos_lists_builder.Size() > 0) {
+        LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
+        output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
+        buffered_output_tiles.push_back(output_tile.release());
+      }
 
-            pos_lists_builder.SetRightSource(
-                &right_result_tiles_[location.first]->GetPositionLists());
-          }
+      LogicalTile *left_tile = left_result_tiles_[match.left_tile_idx].get();
+      LogicalTile *right_tile = right_result_tiles_[match.right_tile_idx].get();
 
-          // Add join tuple
-          pos_lists_builder.AddRow(left_tile_itr, location.second);
+      // Build output logical tile
+      output_tile = BuildOutputLogicalTile(left_tile, right_tile);
 
-          RecordMatchedRightRow(location.first, location.second);
+      // Build position lists
+      pos_lists_builder =
+          LogicalTile::PositionListsBuilder(left_tile, right_tile);
 
-          // Cache prev logical tile itr
-          prev_tile = location.first;
-        }
-      }
+      prev_left_tile = match.left_tile_idx;
+      prev_right_tile = match.right_tile_idx;
     }
 
-    // Check if we have any join tuples
-    if (pos_lists_builder.Size() > 0) {
-      LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
-      output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
-      buffered_output_tiles.push_back(output_tile.release());
-    }
+    // Add join tuple
+    pos_lists_builder.AddRow(match.left_tuple_id, match.right_tuple_id);
 
-    // Check if we have any buffered output tiles
-    if (buffered_output_tiles.empty() == false) {
-      auto output_tile = buffered_output_tiles.front();
-      SetOutput(output_tile);
-      buffered_output_tiles.pop_front();
+    RecordMatchedLeftRow(match.left_tile_idx, match.left_tuple_id);
+    RecordMatchedRightRow(match.right_tile_idx, match.right_tuple_id);
+  }
 
-      return true;
-    } else {
-      // Try again
-      continue;
-    }
+  // Check if we have any join tuples
+  if (pos_lists_builder.Size() > 0) {
+    LOG_TRACE("Join tile size : %lu \n", pos_lists_builder.Size());
+    output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
+    buffered_output_tiles.push_back(output_tile.release());
   }
 }
 
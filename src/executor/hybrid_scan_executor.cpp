@@ -203,8 +203,13 @@ bool HybridScanExecutor::SeqScanUtil() {
       upper_bound_block = reverse_iter->block;
     }
 
+    // Check the visibility of the whole tile group at once
+    std::vector<oid_t> visible_tuples;
+    transaction_manager.GetVisibleTuples(current_txn, tile_group_header,
+                                         active_tuple_count, visible_tuples);
+
     std::vector<oid_t> position_list;
-    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+    for (oid_t tuple_id : visible_tuples) {
       ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
       if (type_ == HybridScanType::HYBRID && item_pointers_.size() > 0 &&
           location.block <= upper_bound_block) {
@@ -213,37 +218,25 @@ bool HybridScanExecutor::SeqScanUtil() {
         }
       }
 
-      // Check transaction visibility
-      if (transaction_manager.IsVisible(current_txn, tile_group_header,
-                                        tuple_id) == VisibilityType::OK) {
-        // If the tuple is visible, then perform predicate evaluation.
-        if (predicate_ == nullptr) {
-          position_list.push_back(tuple_id);
-        } else {
-          expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
-                                                               tuple_id);
-          auto eval =
-              predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
-          if (eval == true) {
-            position_list.push_back(tuple_id);
-          }
-        }
-      } else {
+      // The tuple is visible, so perform predicate evaluation.
+      if (predicate_ != nullptr) {
         expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
                                                              tuple_id);
         auto eval =
             predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
-        if (eval == true) {
-          position_list.push_back(tuple_id);
-          auto res = transaction_manager.PerformRead(current_txn, location,
-                                                     acquire_owner);
-          if (!res) {
-            transaction_manager.SetTransactionResult(current_txn,
-                                                     ResultType::FAILURE);
-            return res;
-          }
+        if (eval == false) {
+          continue;
         }
       }
+
+      position_list.push_back(tuple_id);
+      auto res = transaction_manager.PerformRead(current_txn, location,
+                                                 acquire_owner);
+      if (!res) {
+        transaction_manager.SetTransactionResult(current_txn,
+                                                 ResultType::FAILURE);
+        return res;
+      }
     }
 
     // Don't return empty tiles
@@ -12,6 +12,7 @@
 
 #include "executor/index_scan_executor.h"
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
 #include <utility>
@@ -47,7 +48,10 @@ IndexScanExecutor::IndexScanExecutor(const planner::AbstractPlan *node,
     : AbstractScanExecutor(node, executor_context) {}
 
 IndexScanExecutor::~IndexScanExecutor() {
-  // Nothing to do here
+  // Free the tiles of the last batch the parent did not ask for
+  for (oid_t tile_itr = result_itr_; tile_itr < result_.size(); tile_itr++) {
+    delete result_[tile_itr];
+  }
 }
 
 /**
@@ -73,6 +77,7 @@ bool IndexScanExecutor::DInit() {
   result_.clear();
   done_ = false;
   key_ready_ = false;
+  index_cursor_.reset();
 
   column_ids_ = node.GetColumnIds();
   key_column_ids_ = node.GetKeyColumnIds();
@@ -117,89 +122,100 @@ bool IndexScanExecutor::DInit() {
 }
 
 /**
- * @brief Creates logical tile(s) after scanning index.
+ * @brief Creates logical tile(s) from the next batch of the index scan.
  * @return true on success, false otherwise.
  */
 bool IndexScanExecutor::DExecute() {
   LOG_TRACE("Index Scan executor :: 0 child");
 
-  if (!done_) {
+  for (;;) {
+    while (result_itr_ < result_.size()) {  // Avoid returning empty tiles
+      if (result_[result_itr_]->GetTupleCount() == 0) {
+        delete result_[result_itr_];
+        result_itr_++;
+        continue;
+      } else {
+        LOG_TRACE("Information %s", result_[result_itr_]->GetInfo().c_str());
+        SetOutput(result_[result_itr_]);
+        result_itr_++;
+        return true;
+      }
+
+    }  // end while
+
+    if (done_) return false;
+
+    // All the tiles of the last batch are returned, read the next one
+    if (FetchIndexBatch() == false) {
+      LOG_TRACE("no more tuples are retrieved from index.");
+      done_ = true;
+      return false;
+    }
+
+    result_.clear();
+    result_itr_ = START_OID;
+
+    bool status;
     if (index_->GetIndexType() == IndexConstraintType::PRIMARY_KEY) {
-      auto status = ExecPrimaryIndexLookup();
-      if (status == false) return false;
+      status = ExecPrimaryIndexLookup();
     } else {
-      auto status = ExecSecondaryIndexLookup();
-      if (status == false) return false;
+      status = ExecSecondaryIndexLookup();
+    }
+    if (status == false) {
+      done_ = true;
+      return false;
     }
   }
-  // Already performed the index lookup
-  PL_ASSERT(done_);
+}
 
-  while (result_itr_ < result_.size()) {  // Avoid returning empty tiles
-    if (result_[result_itr_]->GetTupleCount() == 0) {
-      result_itr_++;
-      continue;
+bool IndexScanExecutor::FetchIndexBatch() {
+  size_t batch_size = INDEX_SCAN_BATCH_SIZE;
+
+  if (index_cursor_ == nullptr) {
+    if (0 == key_column_ids_.size()) {
+      index_cursor_ = index_->OpenScan(values_, key_column_ids_, expr_types_,
+                                       ScanDirectionType::FORWARD, nullptr);
+    } else if (limit_ && descend_) {
+      // Only the index knows how to find the last entries
+      LOG_TRACE("DESCENDING SCAN LIMIT");
+      std::vector<ItemPointer *> tuple_location_ptrs;
+      index_->ScanLimit(values_, key_column_ids_, expr_types_,
+                        ScanDirectionType::BACKWARD, tuple_location_ptrs,
+                        &index_predicate_.GetConjunctionList()[0],
+                        limit_number_, limit_offset_);
+      index_cursor_.reset(
+          new index::ResultScanCursor(std::move(tuple_location_ptrs)));
     } else {
-      LOG_TRACE("Information %s", result_[result_itr_]->GetInfo().c_str());
-      SetOutput(result_[result_itr_]);
-      result_itr_++;
-      return true;
+      index_cursor_ = index_->OpenScan(
+          values_, key_column_ids_, expr_types_, ScanDirectionType::FORWARD,
+          &index_predicate_.GetConjunctionList()[0]);
+    }
+
+    // Limit clause accelerate: the first batch holds just the tuples the
+    // limit asks for. More are read only if some of them are not visible.
+    if (limit_) {
+      batch_size = std::max<int64_t>(
+          1, std::min<int64_t>(batch_size, limit_number_ + limit_offset_));
     }
+  }
+
+  tuple_location_ptrs_.clear();
+  bool status = index_cursor_->Next(tuple_location_ptrs_, batch_size);
 
-  }  // end while
+  LOG_TRACE("tuple_location_ptrs:%lu", tuple_location_ptrs_.size());
 
-  return false;
+  return status;
 }
 
 bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   LOG_TRACE("Exec primary index lookup");
   PL_ASSERT(!done_);
 
-  std::vector<ItemPointer *> tuple_location_ptrs;
-
   // Grab info from plan node
   bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
 
   PL_ASSERT(index_->GetIndexType() == IndexConstraintType::PRIMARY_KEY);
 
-  if (0 == key_column_ids_.size()) {
-    index_->ScanAllKeys(tuple_location_ptrs);
-  } else {
-    // Limit clause accelerate
-    if (limit_) {
-      // invoke index scan limit
-      if (!descend_) {
-        LOG_TRACE("ASCENDING SCAN LIMIT in Primary Index");
-        index_->ScanLimit(values_, key_column_ids_, expr_types_,
-                          ScanDirectionType::FORWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
-      } else {
-        LOG_TRACE("DESCENDING SCAN LIMIT in Primary Index");
-        index_->ScanLimit(values_, key_column_ids_, expr_types_,
-                          ScanDirectionType::BACKWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
-
-        LOG_TRACE("1-Result size is %lu", result_.size());
-      }
-    }
-    // Normal SQL (without limit)
-    else {
-      LOG_TRACE("Index Scan in Primary Index");
-      index_->Scan(values_, key_column_ids_, expr_types_,
-                   ScanDirectionType::FORWARD, tuple_location_ptrs,
-                   &index_predicate_.GetConjunctionList()[0]);
-    }
-
-    LOG_TRACE("tuple_location_ptrs:%lu", tuple_location_ptrs.size());
-  }
-
-  if (tuple_location_ptrs.size() == 0) {
-    LOG_TRACE("no tuple is retrieved from index.");
-    return false;
-  }
-
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
@@ -213,10 +229,10 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
 #endif
 
   // for every tuple that is found in the index.
-  for (auto tuple_location_ptr : tuple_location_ptrs) {
+  for (auto tuple_location_ptr : tuple_location_ptrs_) {
     ItemPointer tuple_location = *tuple_location_ptr;
-    auto tile_group = manager.GetTileGroup(tuple_location.block);
-    auto tile_group_header = tile_group.get()->GetHeader();
+    auto tile_group = manager.GetTileGroupPtr(tuple_location.block);
+    auto tile_group_header = tile_group->GetHeader();
     size_t chain_length = 0;
 
 #ifdef LOG_TRACE_ENABLED
@@ -248,7 +264,7 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         if (predicate_ != nullptr) {
           LOG_TRACE("perform prediate evaluate");
           expression::ContainerTuple<storage::TileGroup> tuple(
-              tile_group.get(), tuple_location.offset);
+              tile_group, tuple_location.offset);
           eval =
               predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
         }
@@ -290,8 +306,8 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
           // from scratch.
           tuple_location =
               *(tile_group_header->GetIndirection(tuple_location.offset));
-          tile_group = manager.GetTileGroup(tuple_location.block);
-          tile_group_header = tile_group.get()->GetHeader();
+          tile_group = manager.GetTileGroupPtr(tuple_location.block);
+          tile_group_header = tile_group->GetHeader();
           chain_length = 0;
           continue;
         }
@@ -315,8 +331,8 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         }
 
         // search for next version.
-        tile_group = manager.GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
+        tile_group = manager.GetTileGroupPtr(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
         continue;
       }
     }
@@ -344,7 +360,7 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   // Construct a logical tile for each block
   for (auto tuples : visible_tuples) {
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuples.first);
+    auto tile_group = manager.GetTileGroupPtr(tuples.first);
 
     std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
     // Add relevant columns to logical tile
@@ -357,8 +373,6 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
     result_.push_back(logical_tile.release());
   }
 
-  done_ = true;
-
   LOG_TRACE("Result tiles : %lu", result_.size());
 
   return true;
@@ -369,49 +383,9 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   PL_ASSERT(!done_);
   PL_ASSERT(index_->GetIndexType() != IndexConstraintType::PRIMARY_KEY);
 
-  std::vector<ItemPointer *> tuple_location_ptrs;
-
   // Grab info from plan node
   bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
 
-  if (0 == key_column_ids_.size()) {
-    index_->ScanAllKeys(tuple_location_ptrs);
-  } else {
-    // Limit clause accelerate
-    if (limit_) {
-      // invoke index scan limit
-      if (!descend_) {
-        LOG_TRACE("ASCENDING SCAN LIMIT in Secondary Index");
-        index_->ScanLimit(values_, key_column_ids_, expr_types_,
-                          ScanDirectionType::FORWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
-      } else {
-        LOG_TRACE("DESCENDING SCAN LIMIT in Secondary Index");
-        index_->ScanLimit(values_, key_column_ids_, expr_types_,
-                          ScanDirectionType::BACKWARD, tuple_location_ptrs,
-                          &index_predicate_.GetConjunctionList()[0],
-                          limit_number_, limit_offset_);
-
-        if (tuple_location_ptrs.size() == 0) {
-          LOG_TRACE("2-Result size is %lu", tuple_location_ptrs.size());
-        }
-      }
-    }
-    // Normal SQL (without limit)
-    else {
-      LOG_TRACE("Index Scan in Primary Index");
-      index_->Scan(values_, key_column_ids_, expr_types_,
-                   ScanDirectionType::FORWARD, tuple_location_ptrs,
-                   &index_predicate_.GetConjunctionList()[0]);
-    }
-  }
-
-  if (tuple_location_ptrs.size() == 0) {
-    LOG_TRACE("no tuple is retrieved from index.");
-    return false;
-  }
-
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
@@ -427,7 +401,7 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   // we got for each tuple and check whether its the same to avoid having
   // to go back to the catalog each time.
   oid_t last_block = INVALID_OID;
-  std::shared_ptr<storage::TileGroup> tile_group;
+  storage::TileGroup *tile_group = nullptr;
   storage::TileGroupHeader *tile_group_header = nullptr;
 
 #ifdef LOG_TRACE_ENABLED
@@ -435,11 +409,11 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   int num_blocks_reused = 0;
 #endif
 
-  for (auto tuple_location_ptr : tuple_location_ptrs) {
+  for (auto tuple_location_ptr : tuple_location_ptrs_) {
     ItemPointer tuple_location = *tuple_location_ptr;
     if (tuple_location.block != last_block) {
-      tile_group = manager.GetTileGroup(tuple_location.block);
-      tile_group_header = tile_group.get()->GetHeader();
+      tile_group = manager.GetTileGroupPtr(tuple_location.block);
+      tile_group_header = tile_group->GetHeader();
     }
 #ifdef LOG_TRACE_ENABLED
     else
@@ -473,7 +447,7 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 
         // Further check if the version has the secondary key
         expression::ContainerTuple<storage::TileGroup> candidate_tuple(
-            tile_group.get(), tuple_location.offset);
+            tile_group, tuple_location.offset);
 
         LOG_TRACE("candidate_tuple size: %s",
                   candidate_tuple.GetInfo().c_str());
@@ -536,8 +510,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
           // from scratch.
           tuple_location =
               *(tile_group_header->GetIndirection(tuple_location.offset));
-          tile_group = manager.GetTileGroup(tuple_location.block);
-          tile_group_header = tile_group.get()->GetHeader();
+          tile_group = manager.GetTileGroupPtr(tuple_location.block);
+          tile_group_header = tile_group->GetHeader();
           chain_length = 0;
           continue;
         }
@@ -565,8 +539,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
         }
 
         // search for next version.
-        tile_group = manager.GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
+        tile_group = manager.GetTileGroupPtr(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
       }
     }
     LOG_TRACE("Traverse length: %d\n", (int)chain_length);
@@ -587,7 +561,7 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   // Construct a logical tile for each block
   for (auto tuples : visible_tuples) {
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuples.first);
+    auto tile_group = manager.GetTileGroupPtr(tuples.first);
 
     std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
     // Add relevant columns to logical tile
@@ -600,8 +574,6 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
     result_.push_back(logical_tile.release());
   }
 
-  done_ = true;
-
   LOG_TRACE("Result tiles : %lu", result_.size());
 
   return true;
@@ -609,25 +581,25 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 
 void IndexScanExecutor::CheckOpenRangeWithReturnedTuples(
     std::vector<ItemPointer> &tuple_locations) {
-  while (left_open_) {
+  // The low boundary is at the head of the first batch that has tuples
+  auto tuple_location_itr = tuple_locations.begin();
+  while (left_open_ && tuple_location_itr != tuple_locations.end()) {
     LOG_TRACE("Range left open!");
-    auto tuple_location_itr = tuple_locations.begin();
 
-    if (tuple_location_itr == tuple_locations.end() ||
-        CheckKeyConditions(*tuple_location_itr) == true)
+    if (CheckKeyConditions(*tuple_location_itr) == true)
       left_open_ = false;
     else
-      tuple_locations.erase(tuple_location_itr);
+      tuple_location_itr++;
   }
+  tuple_locations.erase(tuple_locations.begin(), tuple_location_itr);
 
-  while (right_open_) {
+  // We cannot tell which batch is the last one, so the tail of every batch
+  // is checked against the high boundary
+  if (right_open_) {
     LOG_TRACE("Range right open!");
-    auto tuple_location_itr = tuple_locations.rbegin();
 
-    if (tuple_location_itr == tuple_locations.rend() ||
-        CheckKeyConditions(*tuple_location_itr) == true)
-      right_open_ = false;
-    else
+    while (tuple_locations.empty() == false &&
+           CheckKeyConditions(tuple_locations.back()) == false)
       tuple_locations.pop_back();
   }
 }
@@ -641,8 +613,8 @@ bool IndexScanExecutor::CheckKeyConditions(const ItemPointer &tuple_location) {
 
   auto &manager = catalog::Manager::GetInstance();
 
-  auto tile_group = manager.GetTileGroup(tuple_location.block);
-  expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+  auto tile_group = manager.GetTileGroupPtr(tuple_location.block);
+  expression::ContainerTuple<storage::TileGroup> tuple(tile_group,
                                                        tuple_location.offset);
 
   // This is the end of loop
@@ -832,6 +804,8 @@ void IndexScanExecutor::ResetState() {
 
   done_ = false;
 
+  index_cursor_.reset();
+
   const planner::IndexScanPlan &node = GetPlanNode<planner::IndexScanPlan>();
 
   left_open_ = node.GetLeftOpen();
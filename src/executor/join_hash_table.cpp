@@ -0,0 +1,169 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_hash_table.cpp
+//
+// Identification: src/executor/join_hash_table.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/join_hash_table.h"
+
+#include <algorithm>
+
+#include "common/container_tuple.h"
+#include "common/init.h"
+#include "common/logger.h"
+#include "common/thread_pool.h"
+#include "executor/logical_tile.h"
+
+namespace peloton {
+namespace executor {
+
+constexpr size_t JoinBloomFilter::BITS_PER_KEY;
+constexpr size_t JoinBloomFilter::HASH_COUNT;
+constexpr uint32_t JoinHashTable::END_OF_CHAIN;
+constexpr size_t JoinHashTable::L2_CACHE_SIZE;
+constexpr size_t JoinHashTable::MAX_RADIX_BITS;
+
+static inline size_t NextPowerOfTwo(size_t value) {
+  size_t power = 1;
+  while (power < value) power <<= 1;
+  return power;
+}
+
+void JoinBloomFilter::Init(size_t key_count) {
+  size_t bit_count = NextPowerOfTwo(std::max(key_count * BITS_PER_KEY,
+                                             static_cast<size_t>(512)));
+  words_.assign(bit_count / 64, 0);
+  bit_mask_ = bit_count - 1;
+}
+
+void JoinHashTable::Build(
+    const std::vector<std::unique_ptr<LogicalTile>> &tiles,
+    const std::vector<oid_t> &key_column_ids, std::vector<Entry> &duplicates) {
+  PartitionedEntries tile_entries;
+  HashTiles(tiles, key_column_ids, tile_entries);
+
+  size_t tuple_count = 0;
+  for (auto &entries : tile_entries) {
+    tuple_count += entries.size();
+  }
+
+  // Use enough partitions for the table of a partition to stay in L2
+  size_t partition_tuple_count =
+      L2_CACHE_SIZE / (sizeof(Entry) + 3 * sizeof(uint32_t));
+  radix_bits_ = 0;
+  while (radix_bits_ < MAX_RADIX_BITS &&
+         (partition_tuple_count << radix_bits_) < tuple_count) {
+    radix_bits_++;
+  }
+  partitions_.clear();
+  partitions_.resize(static_cast<size_t>(1) << radix_bits_);
+
+  LOG_TRACE("Join hash table : %lu tuples in %lu partitions", tuple_count,
+            partitions_.size());
+
+  // Scatter the tuples in their input order, so that a duplicate key always
+  // comes after the tuple that keeps it
+  bloom_filter_.Init(tuple_count);
+  for (auto &entries : tile_entries) {
+    for (auto &entry : entries) {
+      partitions_[GetPartitionIndex(entry.hash)].entries.push_back(entry);
+      bloom_filter_.Insert(entry.hash);
+    }
+  }
+
+  PartitionedEntries partition_duplicates(partitions_.size());
+  thread_pool.RunTasks(partitions_.size(), [&](size_t partition_idx) {
+    BuildPartition(partitions_[partition_idx], tiles, key_column_ids,
+                   partition_duplicates[partition_idx]);
+  });
+
+  for (auto &entries : partition_duplicates) {
+    duplicates.insert(duplicates.end(), entries.begin(), entries.end());
+  }
+}
+
+void JoinHashTable::Partition(
+    const std::vector<std::unique_ptr<LogicalTile>> &tiles,
+    const std::vector<oid_t> &key_column_ids, bool use_filter,
+    PartitionedEntries &partitions) const {
+  PartitionedEntries tile_entries;
+  HashTiles(tiles, key_column_ids, tile_entries);
+
+  partitions.clear();
+  partitions.resize(partitions_.size());
+  for (auto &entries : tile_entries) {
+    for (auto &entry : entries) {
+      if (use_filter == true && bloom_filter_.MayContain(entry.hash) == false) {
+        continue;
+      }
+      partitions[GetPartitionIndex(entry.hash)].push_back(entry);
+    }
+  }
+}
+
+void JoinHashTable::HashTiles(
+    const std::vector<std::unique_ptr<LogicalTile>> &tiles,
+    const std::vector<oid_t> &key_column_ids,
+    PartitionedEntries &tile_entries) {
+  tile_entries.clear();
+  tile_entries.resize(tiles.size());
+
+  thread_pool.RunTasks(tiles.size(), [&](size_t tile_idx) {
+    LogicalTile *tile = tiles[tile_idx].get();
+    auto &entries = tile_entries[tile_idx];
+    entries.reserve(tile->GetTupleCount());
+
+    for (oid_t tuple_id : *tile) {
+      expression::ContainerTuple<LogicalTile> key(tile, tuple_id,
+                                                  &key_column_ids);
+      entries.push_back(
+          {MixHash(key.HashCode()), static_cast<uint32_t>(tile_idx),
+           tuple_id});
+    }
+  });
+}
+
+void JoinHashTable::BuildPartition(
+    HashPartition &partition,
+    const std::vector<std::unique_ptr<LogicalTile>> &tiles,
+    const std::vector<oid_t> &key_column_ids, std::vector<Entry> &duplicates) {
+  auto &entries = partition.entries;
+  size_t bucket_count = NextPowerOfTwo(std::max(entries.size(), (size_t)1));
+  partition.buckets.assign(bucket_count, END_OF_CHAIN);
+  partition.bucket_mask = bucket_count - 1;
+  partition.next.resize(entries.size());
+
+  for (uint32_t entry_idx = 0; entry_idx < entries.size(); entry_idx++) {
+    auto &entry = entries[entry_idx];
+    auto &bucket = partition.buckets[entry.hash & partition.bucket_mask];
+
+    // The latest tuple of a key is at the front of its chain, so a run of
+    // duplicates is found right away
+    expression::ContainerTuple<LogicalTile> key(
+        tiles[entry.tile_idx].get(), entry.tuple_id, &key_column_ids);
+    for (uint32_t other_idx = bucket; other_idx != END_OF_CHAIN;
+         other_idx = partition.next[other_idx]) {
+      auto &other = entries[other_idx];
+      if (other.hash != entry.hash) continue;
+
+      expression::ContainerTuple<LogicalTile> other_key(
+          tiles[other.tile_idx].get(), other.tuple_id, &key_column_ids);
+      if (key.EqualsNoSchemaCheck(other_key) == true) {
+        duplicates.push_back(entry);
+        break;
+      }
+    }
+
+    partition.next[entry_idx] = bucket;
+    bucket = entry_idx;
+  }
+}
+
+}  // namespace executor
+}  // namespace peloton
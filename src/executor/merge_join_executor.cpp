@@ -135,6 +135,9 @@ bool MergeJoinExecutor::DExecute() {
   // Build position lists
   LogicalTile::PositionListsBuilder pos_lists_builder(left_tile, right_tile);
 
+  bool use_compiled_predicate =
+      predicate_ != nullptr && BindCompiledPredicate(left_tile, right_tile);
+
   while ((left_end_row > left_start_row) && (right_end_row > right_start_row)) {
     expression::ContainerTuple<executor::LogicalTile> left_tuple(
         left_tile, left_start_row);
@@ -180,11 +183,17 @@ bool MergeJoinExecutor::DExecute() {
 
     // Join predicate exists
     if (predicate_ != nullptr) {
-      auto eval = predicate_->Evaluate(&left_tuple,
-                                      &right_tuple, executor_context_);
-      if (eval.IsFalse()) {
-      //if (predicate_->Evaluate(&left_tuple, &right_tuple, executor_context_)
-      //        .IsFalse()) {
+      bool predicate_false;
+      if (use_compiled_predicate == true) {
+        oid_t tuple_ids[2] = {static_cast<oid_t>(left_start_row),
+                              static_cast<oid_t>(right_start_row)};
+        predicate_false = compiled_predicate_->EvaluatePredicate(tuple_ids) ==
+                          type::CMP_FALSE;
+      } else {
+        predicate_false = predicate_->Evaluate(&left_tuple, &right_tuple,
+                                               executor_context_).IsFalse();
+      }
+      if (predicate_false) {
         // Join predicate is false. Advance both.
         left_start_row = left_end_row;
         left_end_row = Advance(left_tile, left_start_row, true);
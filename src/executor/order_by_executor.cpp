@@ -11,7 +11,9 @@
 //===----------------------------------------------------------------------===//
 
 #include <algorithm>
+#include <cstring>
 
+#include "common/exception.h"
 #include "common/logger.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
@@ -20,10 +22,37 @@
 
 #include "planner/order_by_plan.h"
 #include "storage/tile.h"
+#include "type/serializeio.h"
 
 namespace peloton {
 namespace executor {
 
+size_t OrderByExecutor::memory_budget_ = ORDER_BY_MEMORY_BUDGET;
+
+namespace {
+
+// Less-than for normalized sort keys. The keys are prefix-free, so equal
+// prefixes only happen for equal keys.
+inline bool KeyLess(const char *a, size_t a_length, const char *b,
+                    size_t b_length) {
+  int ret = memcmp(a, b, std::min(a_length, b_length));
+  return ret < 0 || (ret == 0 && a_length < b_length);
+}
+
+inline bool KeyLess(const std::string &a, const std::string &b) {
+  return KeyLess(a.data(), a.size(), b.data(), b.size());
+}
+
+// Big endian, so that the bytes compare like the number
+template <typename T>
+inline void AppendBigEndian(std::string &key, T value) {
+  for (int shift = (sizeof(T) - 1) * 8; shift >= 0; shift -= 8) {
+    key.push_back(static_cast<char>((value >> shift) & 0xff));
+  }
+}
+
+}  // namespace
+
 /**
  * @brief Constructor
  * @param node  OrderByNode plan node corresponding to this executor
@@ -34,6 +63,23 @@ OrderByExecutor::OrderByExecutor(const planner::AbstractPlan *node,
 
 OrderByExecutor::~OrderByExecutor() {}
 
+bool OrderByExecutor::sort_run_t::Next() {
+  uint32_t key_length, tuple_length;
+  if (fread(&key_length, sizeof(key_length), 1, file) != 1) {
+    return false;
+  }
+  key.resize(key_length);
+  if (fread(&key[0], 1, key_length, file) != key_length ||
+      fread(&tuple_length, sizeof(tuple_length), 1, file) != 1) {
+    throw ExecutorException("Failed to read a sort run");
+  }
+  tuple.resize(tuple_length);
+  if (fread(&tuple[0], 1, tuple_length, file) != tuple_length) {
+    throw ExecutorException("Failed to read a sort run");
+  }
+  return true;
+}
+
 bool OrderByExecutor::DInit() {
   PL_ASSERT(children_.size() == 1);
 
@@ -63,6 +109,10 @@ bool OrderByExecutor::DExecute() {
 
   if (!sort_done_) DoSort();
 
+  if (runs_.empty() == false) {
+    return MergeRuns();
+  }
+
   if (!(num_tuples_returned_ < sort_buffer_.size())) {
     return false;
   }
@@ -108,125 +158,315 @@ bool OrderByExecutor::DExecute() {
   return true;
 }
 
-bool OrderByExecutor::DoSort() {
-  PL_ASSERT(children_.size() == 1);
-  PL_ASSERT(children_[0] != nullptr);
-  PL_ASSERT(!sort_done_);
-  PL_ASSERT(executor_context_ != nullptr);
-
-  // Extract all data from child
-  while (children_[0]->Execute()) {
-    input_tiles_.emplace_back(children_[0]->GetOutput());
+/**
+ * The key of a column starts with a byte that puts NULLs first, followed by
+ * the value in an order-preserving encoding. The bytes of a descending
+ * column are inverted, which puts its NULLs last. Strings end with a zero
+ * byte, so no key is a prefix of another.
+ */
+void OrderByExecutor::EncodeSortKey(LogicalTile *tile, oid_t tuple_id,
+                                    std::string &key) const {
+  for (oid_t id = 0; id < sort_key_ids_.size(); id++) {
+    type::Value val = tile->GetValue(tuple_id, sort_key_ids_[id]);
+    size_t begin = key.size();
+
+    if (val.IsNull() == true) {
+      key.push_back(0);
+    } else {
+      key.push_back(1);
+      switch (val.GetTypeId()) {
+        case type::Type::BOOLEAN:
+          key.push_back(val.GetAs<int8_t>());
+          break;
+        case type::Type::TINYINT:
+          AppendBigEndian<uint8_t>(key, val.GetAs<int8_t>() ^ 0x80);
+          break;
+        case type::Type::SMALLINT:
+          AppendBigEndian<uint16_t>(key, val.GetAs<int16_t>() ^ 0x8000);
+          break;
+        case type::Type::INTEGER:
+          AppendBigEndian<uint32_t>(key, val.GetAs<int32_t>() ^ 0x80000000);
+          break;
+        case type::Type::BIGINT:
+          AppendBigEndian<uint64_t>(
+              key, val.GetAs<int64_t>() ^ (UINT64_C(1) << 63));
+          break;
+        case type::Type::TIMESTAMP:
+          AppendBigEndian<uint64_t>(key, val.GetAs<uint64_t>());
+          break;
+        case type::Type::DECIMAL: {
+          double decimal = val.GetAs<double>();
+          uint64_t bits;
+          PL_MEMCPY(&bits, &decimal, sizeof(bits));
+          // Negative numbers order backwards
+          if ((bits >> 63) != 0) {
+            bits = ~bits;
+          } else {
+            bits |= (UINT64_C(1) << 63);
+          }
+          AppendBigEndian<uint64_t>(key, bits);
+          break;
+        }
+        case type::Type::VARCHAR: {
+          // Strings compare up to their terminator
+          const char *data = val.GetData();
+          key.append(data, strnlen(data, val.GetLength()));
+          key.push_back(0);
+          break;
+        }
+        case type::Type::VARBINARY: {
+          // Escape zero bytes, so that the terminator is the smallest
+          const char *data = val.GetData();
+          for (uint32_t byte_itr = 0; byte_itr < val.GetLength(); byte_itr++) {
+            key.push_back(data[byte_itr]);
+            if (data[byte_itr] == 0) key.push_back(1);
+          }
+          key.push_back(0);
+          key.push_back(0);
+          break;
+        }
+        default:
+          throw ExecutorException(
+              "ORDER BY is not supported for type " +
+              type::Type::GetInstance(val.GetTypeId())->ToString());
+      }
+    }
 
-    // increase the counter
-    num_tuples_get_ += input_tiles_.back()->GetTupleCount();
-
-    // Optimization for ordered output
-    if (underling_ordered_ && limit_) {
-      LOG_TRACE("underling_ordered and limit both work");
-      // We already get enough tuples, break while
-      if (num_tuples_get_ >= (limit_offset_ + limit_number_)) {
-        LOG_TRACE("num_tuples_get_ (%lu) are enough", num_tuples_get_);
-        break;
+    if (descend_flags_[id] == true) {
+      for (size_t byte_itr = begin; byte_itr < key.size(); byte_itr++) {
+        key[byte_itr] = ~key[byte_itr];
       }
     }
   }
+}
+
+void OrderByExecutor::AddTopKEntry(const std::string &key,
+                                   const ItemPointer &item_pointer) {
+  auto comp = [](const top_k_entry_t &a, const top_k_entry_t &b) {
+    return KeyLess(a.key, b.key);
+  };
+  size_t top_k = limit_offset_ + limit_number_;
+
+  if (top_k_heap_.size() < top_k) {
+    top_k_heap_.push_back(top_k_entry_t{key, item_pointer});
+    std::push_heap(top_k_heap_.begin(), top_k_heap_.end(), comp);
+  } else if (top_k > 0 && KeyLess(key, top_k_heap_.front().key)) {
+    // Replace the largest key, reusing its buffer
+    std::pop_heap(top_k_heap_.begin(), top_k_heap_.end(), comp);
+    top_k_heap_.back().key.assign(key);
+    top_k_heap_.back().item_pointer = item_pointer;
+    std::push_heap(top_k_heap_.begin(), top_k_heap_.end(), comp);
+  }
+}
 
-  /** Number of valid tuples to be sorted. */
-  size_t count = 0;
-  for (auto &tile : input_tiles_) {
-    count += tile->GetTupleCount();
+void OrderByExecutor::SpillRun() {
+  const char *keys = sort_keys_.data();
+  std::sort(sort_buffer_.begin(), sort_buffer_.end(),
+            [keys](const sort_buffer_entry_t &a, const sort_buffer_entry_t &b) {
+              return KeyLess(keys + a.key_offset, a.key_length,
+                             keys + b.key_offset, b.key_length);
+            });
+
+  std::unique_ptr<sort_run_t> run(new sort_run_t());
+  run->file = tmpfile();
+  if (run->file == nullptr) {
+    throw ExecutorException("Failed to create a sort run file");
   }
 
-  if (count == 0) return true;
+  CopySerializeOutput tuple_output;
+  for (auto &entry : sort_buffer_) {
+    auto &tile = input_tiles_[entry.item_pointer.block];
+    tuple_output.Reset();
+    for (oid_t col = 0; col < input_schema_->GetColumnCount(); col++) {
+      tile->GetValue(entry.item_pointer.offset, col).SerializeTo(tuple_output);
+    }
+
+    uint32_t key_length = entry.key_length;
+    uint32_t tuple_length = tuple_output.Size();
+    if (fwrite(&key_length, sizeof(key_length), 1, run->file) != 1 ||
+        fwrite(keys + entry.key_offset, 1, key_length, run->file) !=
+            key_length ||
+        fwrite(&tuple_length, sizeof(tuple_length), 1, run->file) != 1 ||
+        fwrite(tuple_output.Data(), 1, tuple_length, run->file) != tuple_length) {
+      throw ExecutorException("Failed to write a sort run");
+    }
+  }
+  LOG_TRACE("Spilled a run of %lu tuples", sort_buffer_.size());
+
+  num_tuples_spilled_ += sort_buffer_.size();
+  runs_.push_back(std::move(run));
+
+  // The tuples are on disk now
+  sort_buffer_.clear();
+  sort_keys_.clear();
+  input_tiles_.clear();
+}
+
+bool OrderByExecutor::MergeRuns() {
+  if (merge_heap_.empty() == true) {
+    return false;
+  }
+
+  // The smallest key on top
+  auto comp = [](const sort_run_t *a, const sort_run_t *b) {
+    return KeyLess(b->key, a->key);
+  };
+
+  size_t tile_size = std::min(size_t(DEFAULT_TUPLES_PER_TILEGROUP),
+                              num_tuples_spilled_ - num_tuples_returned_);
+
+  std::shared_ptr<storage::Tile> ptile(storage::TileFactory::GetTile(
+      BackendType::MM, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
+      nullptr, *input_schema_, nullptr, tile_size));
+
+  for (size_t id = 0; id < tile_size; id++) {
+    PL_ASSERT(merge_heap_.empty() == false);
+    std::pop_heap(merge_heap_.begin(), merge_heap_.end(), comp);
+    auto run = merge_heap_.back();
+
+    ReferenceSerializeInput input(run->tuple.data(), run->tuple.size());
+    for (oid_t col = 0; col < input_schema_->GetColumnCount(); col++) {
+      type::Value val = type::Value::DeserializeFrom(
+          input, input_schema_->GetType(col), nullptr);
+      ptile->SetValue(val, id, col);
+    }
+
+    if (run->Next() == true) {
+      std::push_heap(merge_heap_.begin(), merge_heap_.end(), comp);
+    } else {
+      merge_heap_.pop_back();
+    }
+  }
+
+  std::vector<std::shared_ptr<storage::Tile>> singleton({ptile});
+  std::unique_ptr<LogicalTile> ltile(LogicalTileFactory::WrapTiles(singleton));
+  SetOutput(ltile.release());
+
+  num_tuples_returned_ += tile_size;
+  return true;
+}
+
+bool OrderByExecutor::DoSort() {
+  PL_ASSERT(children_.size() == 1);
+  PL_ASSERT(children_[0] != nullptr);
+  PL_ASSERT(!sort_done_);
+  PL_ASSERT(executor_context_ != nullptr);
 
   // Grab data from plan node
   const planner::OrderByPlan &node = GetPlanNode<planner::OrderByPlan>();
   descend_flags_ = node.GetDescendFlags();
+  sort_key_ids_ = node.GetSortKeys();
 
-  // Extract the schema for sort keys.
+  // With a limit, only the first limit_offset_ + limit_number_ tuples are
+  // kept
+  bool top_k = (limit_ == true && underling_ordered_ == false);
 
-  std::unique_ptr<catalog::Schema> physical_schema;
-  physical_schema.reset(input_tiles_[0]->GetPhysicalSchema());
-  std::vector<catalog::Column> sort_key_columns;
-  std::vector<catalog::Column> output_key_columns;
-  for (auto id : node.GetSortKeys()) {
-    sort_key_columns.push_back(physical_schema->GetColumn(id));
-  }
-  for (auto id : node.GetOutputColumnIds()) {
-    output_key_columns.push_back(physical_schema->GetColumn(id));
-  }
-  sort_key_tuple_schema_.reset(new catalog::Schema(sort_key_columns));
-  input_schema_.reset(new catalog::Schema(output_key_columns));
-  auto executor_pool = executor_context_->GetPool();
-
-  // Extract all valid tuples into a single std::vector (the sort buffer)
-  sort_buffer_.reserve(count);
-  for (oid_t tile_id = 0; tile_id < input_tiles_.size(); tile_id++) {
-    for (oid_t tuple_id : *input_tiles_[tile_id]) {
-      // Extract the sort key tuple
-      std::unique_ptr<storage::Tuple> tuple(
-          new storage::Tuple(sort_key_tuple_schema_.get(), true));
-      for (oid_t id = 0; id < node.GetSortKeys().size(); id++) {
-        type::Value val =
-            (input_tiles_[tile_id]->GetValue(tuple_id, node.GetSortKeys()[id]));
-        tuple->SetValue(id, val, executor_pool);
+  // Bytes held in memory for each tuple, besides its key
+  size_t tuple_size = 0;
+
+  std::string key;
+  while (children_[0]->Execute()) {
+    std::unique_ptr<LogicalTile> tile(children_[0]->GetOutput());
+    size_t tuple_count = tile->GetTupleCount();
+    if (tuple_count == 0) continue;
+
+    // Extract the schema of the output
+    if (input_schema_.get() == nullptr) {
+      std::unique_ptr<catalog::Schema> physical_schema(
+          tile->GetPhysicalSchema());
+      std::vector<catalog::Column> output_key_columns;
+      for (auto id : node.GetOutputColumnIds()) {
+        output_key_columns.push_back(physical_schema->GetColumn(id));
       }
-      // Inert the sort key tuple into sort buffer
-      sort_buffer_.emplace_back(sort_buffer_entry_t(
-          ItemPointer(tile_id, tuple_id), std::move(tuple)));
+      input_schema_.reset(new catalog::Schema(output_key_columns));
+      tuple_size = sizeof(sort_buffer_entry_t) + input_schema_->GetLength();
     }
-  }
-
-  PL_ASSERT(count == sort_buffer_.size());
 
-  // If the underlying result has the same order, it is not necessary to sort
-  // the result again. Instead, go to the end.
-  if (underling_ordered_) {
-    LOG_TRACE("underling_ordered works and already get all tuples (%lu)",
-              count);
-    sort_done_ = true;
-    return true;
-  }
+    // increase the counter
+    num_tuples_get_ += tuple_count;
+    oid_t tile_id = input_tiles_.size();
+    input_tiles_.emplace_back(tile.release());
+    auto input_tile = input_tiles_.back().get();
+
+    // If the underlying result has the same order, it is not necessary to
+    // sort the result again
+    if (underling_ordered_) {
+      for (oid_t tuple_id : *input_tile) {
+        sort_buffer_.push_back(
+            sort_buffer_entry_t{ItemPointer(tile_id, tuple_id), 0, 0});
+      }
 
-  // Prepare the compare function
-  // Note: This is a less-than comparer, NOT an equality comparer.
-  struct TupleComparer {
-    TupleComparer(std::vector<bool> &_descend_flags)
-        : descend_flags(_descend_flags) {}
-
-    bool operator()(const storage::Tuple *ta, const storage::Tuple *tb) {
-      for (oid_t id = 0; id < descend_flags.size(); id++) {
-        type::Value va = (ta->GetValue(id));
-        type::Value vb = (tb->GetValue(id));
-        if (!descend_flags[id]) {
-          if (va.CompareLessThan(vb) == type::CMP_TRUE)
-            return true;
-          else {
-            if (va.CompareGreaterThan(vb) == type::CMP_TRUE) return false;
-          }
-        } else {
-          if (vb.CompareLessThan(va) == type::CMP_TRUE)
-            return true;
-          else {
-            if (vb.CompareGreaterThan(va) == type::CMP_TRUE) return false;
-          }
+      // Optimization for ordered output
+      if (limit_) {
+        LOG_TRACE("underling_ordered and limit both work");
+        // We already get enough tuples, break while
+        if (num_tuples_get_ >= (limit_offset_ + limit_number_)) {
+          LOG_TRACE("num_tuples_get_ (%lu) are enough", num_tuples_get_);
+          break;
         }
       }
-      return false;  // Will return false if all keys equal
+      continue;
     }
 
-    std::vector<bool> descend_flags;
-  };
+    for (oid_t tuple_id : *input_tile) {
+      key.clear();
+      EncodeSortKey(input_tile, tuple_id, key);
+      if (top_k == true) {
+        AddTopKEntry(key, ItemPointer(tile_id, tuple_id));
+      } else {
+        sort_buffer_.push_back(sort_buffer_entry_t{
+            ItemPointer(tile_id, tuple_id), sort_keys_.size(), key.size()});
+        sort_keys_.append(key);
+      }
+    }
 
-  TupleComparer comp(descend_flags_);
+    // Spill the tuples so far once they outgrow the memory budget
+    if (top_k == false &&
+        sort_keys_.size() + sort_buffer_.size() * tuple_size >
+            memory_budget_) {
+      SpillRun();
+    }
+  }
 
-  // Finally ... sort it !
-  std::sort(
-      sort_buffer_.begin(), sort_buffer_.end(),
-      [&comp](const sort_buffer_entry_t &a, const sort_buffer_entry_t &b) {
-        return comp(a.tuple.get(), b.tuple.get());
-      });
+  if (top_k == true) {
+    // The heap sorts into ascending order
+    std::sort_heap(top_k_heap_.begin(), top_k_heap_.end(),
+                   [](const top_k_entry_t &a, const top_k_entry_t &b) {
+                     return KeyLess(a.key, b.key);
+                   });
+    sort_buffer_.reserve(top_k_heap_.size());
+    for (auto &entry : top_k_heap_) {
+      sort_buffer_.push_back(sort_buffer_entry_t{entry.item_pointer, 0, 0});
+    }
+    top_k_heap_.clear();
+    LOG_TRACE("Kept %lu of %lu tuples", sort_buffer_.size(), num_tuples_get_);
+  } else if (runs_.empty() == false) {
+    // Merge the runs, including what is left in memory
+    if (sort_buffer_.empty() == false) {
+      SpillRun();
+    }
+    for (auto &run : runs_) {
+      rewind(run->file);
+      if (run->Next() == true) {
+        merge_heap_.push_back(run.get());
+      }
+    }
+    std::make_heap(merge_heap_.begin(), merge_heap_.end(),
+                   [](const sort_run_t *a, const sort_run_t *b) {
+                     return KeyLess(b->key, a->key);
+                   });
+    LOG_TRACE("Merging %lu runs of %lu tuples", runs_.size(),
+              num_tuples_spilled_);
+  } else if (underling_ordered_ == false) {
+    // Finally ... sort it !
+    const char *keys = sort_keys_.data();
+    std::sort(
+        sort_buffer_.begin(), sort_buffer_.end(),
+        [keys](const sort_buffer_entry_t &a, const sort_buffer_entry_t &b) {
+          return KeyLess(keys + a.key_offset, a.key_length,
+                         keys + b.key_offset, b.key_length);
+        });
+  }
 
   sort_done_ = true;
 
@@ -46,6 +46,22 @@ peloton_status PlanExecutor::ExecutePlan(
     const planner::AbstractPlan *plan, concurrency::Transaction *txn,
     const std::vector<type::Value> &params, std::vector<StatementResult> &result,
     const std::vector<int> &result_format) {
+  result.clear();
+  return ExecutePlan(plan, txn, params,
+                     [&result, &result_format](executor::LogicalTile *tile) {
+                       AddResultTile(tile, result_format, result);
+                     });
+}
+
+/**
+ * @brief Build a executor tree and execute it, handing every result tile to
+ * the callback as soon as the tree returns it.
+ * @return status of execution.
+ */
+peloton_status PlanExecutor::ExecutePlan(
+    const planner::AbstractPlan *plan, concurrency::Transaction *txn,
+    const std::vector<type::Value> &params,
+    const ResultTileCallback &result_callback) {
   peloton_status p_status;
   if (plan == nullptr) return p_status;
 
@@ -74,7 +90,6 @@ peloton_status PlanExecutor::ExecutePlan(
 
   if (status == true) {
     LOG_TRACE("Running the executor tree");
-    result.clear();
 
     // Execute the tree until we get result tiles from root node
     while (status == true) {
@@ -86,22 +101,7 @@ peloton_status PlanExecutor::ExecutePlan(
       if (logical_tile.get() != nullptr) {
         LOG_TRACE("Final Answer: %s",
                   logical_tile->GetInfo().c_str());  // Printing the answers
-        std::vector<std::vector<std::string>> answer_tuples;
-        answer_tuples = std::move(
-            logical_tile->GetAllValuesAsStrings(result_format, false));
-
-        // Construct the returned results
-        for (auto &tuple : answer_tuples) {
-          unsigned int col_index = 0;
-          for (unsigned int i = 0; i < logical_tile->GetColumnCount(); i++) {
-            auto res = StatementResult();
-            PlanExecutor::copyFromTo(tuple[col_index++], res.second);
-            if (tuple[col_index - 1].c_str() != nullptr) {
-              LOG_TRACE("column content: %s", tuple[col_index - 1].c_str());
-            }
-            result.push_back(std::move(res));
-          }
-        }
+        result_callback(logical_tile.get());
       }
     }
 
@@ -121,6 +121,27 @@ peloton_status PlanExecutor::ExecutePlan(
   return p_status;
 }
 
+void PlanExecutor::AddResultTile(executor::LogicalTile *logical_tile,
+                                 const std::vector<int> &result_format,
+                                 std::vector<StatementResult> &result) {
+  std::vector<std::vector<std::string>> answer_tuples;
+  answer_tuples =
+      std::move(logical_tile->GetAllValuesAsStrings(result_format, false));
+
+  // Construct the returned results
+  for (auto &tuple : answer_tuples) {
+    unsigned int col_index = 0;
+    for (unsigned int i = 0; i < logical_tile->GetColumnCount(); i++) {
+      auto res = StatementResult();
+      PlanExecutor::copyFromTo(tuple[col_index++], res.second);
+      if (tuple[col_index - 1].c_str() != nullptr) {
+        LOG_TRACE("column content: %s", tuple[col_index - 1].c_str());
+      }
+      result.push_back(std::move(res));
+    }
+  }
+}
+
 /**
  * @brief Build a executor tree and execute it.
  * Use std::vector<type::Value> as params to make it more elegant for
@@ -340,6 +361,11 @@ executor::AbstractExecutor *BuildExecutorTree(
       child_executor = new executor::CopyExecutor(plan, executor_context);
       break;
 
+    case PlanNodeType::ANALYZE:
+      LOG_TRACE("Adding Analyze Executer");
+      child_executor = new executor::AnalyzeExecutor(plan, executor_context);
+      break;
+
     default:
       LOG_ERROR("Unsupported plan node type : %s",
                 PlanNodeTypeToString(plan_node_type).c_str());
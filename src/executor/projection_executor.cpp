@@ -19,6 +19,7 @@
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "common/container_tuple.h"
+#include "executor/executor_context.h"
 #include "storage/tile.h"
 #include "storage/data_table.h"
 
@@ -45,9 +46,59 @@ bool ProjectionExecutor::DInit() {
   this->project_info_ = node.GetProjectInfo();
   this->schema_ = node.GetSchema();
 
+  compiled_targets_.clear();
+  targets_compiled_ = false;
+
   return true;
 }
 
+void ProjectionExecutor::CompileTargets(LogicalTile *source_tile) {
+  targets_compiled_ = true;
+  if (source_tile->GetColumnCount() == 0) return;
+
+  std::unique_ptr<catalog::Schema> source_schema(
+      source_tile->GetPhysicalSchema());
+  bool any_compiled = false;
+  for (auto &target : project_info_->GetTargetList()) {
+    compiled_targets_.push_back(CompiledExpression::Compile(
+        target.second, source_schema.get(), nullptr, executor_context_));
+    if (compiled_targets_.back() != nullptr) any_compiled = true;
+  }
+
+  // Nothing to gain over ProjectInfo::Evaluate()
+  if (any_compiled == false) compiled_targets_.clear();
+}
+
+void ProjectionExecutor::ProjectTuple(storage::Tuple *dest,
+                                      LogicalTile *source_tile,
+                                      oid_t tuple_id) const {
+  type::AbstractPool *pool = nullptr;
+  if (executor_context_ != nullptr) pool = executor_context_->GetPool();
+  expression::ContainerTuple<LogicalTile> tuple(source_tile, tuple_id);
+  oid_t tuple_ids[2] = {tuple_id, INVALID_OID};
+
+  // (A) Execute target list
+  auto &target_list = project_info_->GetTargetList();
+  for (size_t target_itr = 0; target_itr < target_list.size(); target_itr++) {
+    auto &compiled_target = compiled_targets_[target_itr];
+    if (compiled_target != nullptr) {
+      dest->SetValue(target_list[target_itr].first,
+                     compiled_target->Evaluate(tuple_ids), pool);
+    } else {
+      dest->SetValue(target_list[target_itr].first,
+                     target_list[target_itr].second->Evaluate(
+                         &tuple, nullptr, executor_context_),
+                     pool);
+    }
+  }
+
+  // (B) Execute direct map
+  for (auto &dm : project_info_->GetDirectMapList()) {
+    PL_ASSERT(dm.second.first == 0);
+    dest->SetValue(dm.first, tuple.GetValue(dm.second.second), pool);
+  }
+}
+
 /**
  * @brief Create projected tuples based on one or two input.
  * Newly-created physical tiles are needed.
@@ -71,6 +122,17 @@ bool ProjectionExecutor::DExecute() {
     std::unique_ptr<LogicalTile> source_tile(children_[0]->GetOutput());
     auto num_tuples = source_tile->GetTupleCount();
 
+    if (targets_compiled_ == false) CompileTargets(source_tile.get());
+
+    // Read the columns of the compiled targets from this tile
+    bool use_compiled = (compiled_targets_.empty() == false);
+    for (auto &compiled_target : compiled_targets_) {
+      if (compiled_target != nullptr &&
+          compiled_target->Bind(0, source_tile.get()) == false) {
+        use_compiled = false;
+      }
+    }
+
     // Create new physical tile where we store projected tuples
     std::shared_ptr<storage::Tile> dest_tile(
         storage::TileFactory::GetTempTile(*schema_, num_tuples));
@@ -81,7 +143,11 @@ bool ProjectionExecutor::DExecute() {
       storage::Tuple *buffer = new storage::Tuple(schema_, true);
       expression::ContainerTuple<LogicalTile> tuple(source_tile.get(),
                                                     old_tuple_id);
-      project_info_->Evaluate(buffer, &tuple, nullptr, executor_context_);
+      if (use_compiled == true) {
+        ProjectTuple(buffer, source_tile.get(), old_tuple_id);
+      } else {
+        project_info_->Evaluate(buffer, &tuple, nullptr, executor_context_);
+      }
 
       // Insert projected tuple into the new tile
       dest_tile.get()->InsertTuple(new_tuple_id, buffer);
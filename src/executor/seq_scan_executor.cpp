@@ -12,10 +12,13 @@
 
 #include "executor/seq_scan_executor.h"
 
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <vector>
 #include <numeric>
+#include <algorithm>
+#include <iterator>
 
 #include "type/types.h"
 #include "executor/logical_tile.h"
@@ -23,6 +26,9 @@
 #include "executor/executor_context.h"
 #include "expression/abstract_expression.h"
 #include "common/container_tuple.h"
+#include "common/init.h"
+#include "common/thread_pool.h"
+#include "configuration/configuration.h"
 #include "storage/data_table.h"
 #include "storage/tile_group_header.h"
 #include "storage/tile.h"
@@ -33,6 +39,8 @@
 namespace peloton {
 namespace executor {
 
+constexpr oid_t SeqScanExecutor::MORSELS_PER_WORKER;
+
 /**
  * @brief Constructor for seqscan executor.
  * @param node Seqscan node corresponding to this executor.
@@ -57,6 +65,10 @@ bool SeqScanExecutor::DInit() {
   
   current_tile_group_offset_ = START_OID;
 
+  // Set by a hash join once it has built its hash table
+  join_filter_ = nullptr;
+  join_key_column_ids_ = nullptr;
+
   if (target_table_ != nullptr) {
     table_tile_group_count_ = target_table_->GetTileGroupCount();
 
@@ -64,6 +76,37 @@ bool SeqScanExecutor::DInit() {
       column_ids_.resize(target_table_->GetSchema()->GetColumnCount());
       std::iota(column_ids_.begin(), column_ids_.end(), 0);
     }
+
+    // Filter tile groups on as many threads as the pool can back
+    size_t scan_degree = std::min(
+        std::max(FLAGS_parallel_scan_degree, (uint64_t)1),
+        (uint64_t)thread_pool.GetPoolSize() + 1);
+    workers_.clear();
+    workers_.resize(scan_degree);
+    scanned_tile_groups_.clear();
+
+    // Evaluate the predicate a tile column at a time when possible, and
+    // compile what is left. Every worker needs its own evaluators for their
+    // scratch masks and column bindings
+    if (predicate_ != nullptr) {
+      auto schema = target_table_->GetSchema();
+      for (auto &worker : workers_) {
+        worker.vectorized_predicate.reset(
+            new VectorizedPredicate(predicate_, schema, executor_context_));
+        if (worker.vectorized_predicate->IsVectorized() == false) {
+          worker.vectorized_predicate.reset();
+          worker.compiled_predicate = CompiledExpression::Compile(
+              predicate_, schema, nullptr, executor_context_);
+        } else if (worker.vectorized_predicate->HasResidual()) {
+          worker.compiled_predicate = CompiledExpression::Compile(
+              worker.vectorized_predicate->GetResidual(), schema, nullptr,
+              executor_context_);
+        }
+      }
+    }
+  } else {
+    compiled_child_predicate_.reset();
+    child_predicate_compiled_ = false;
   }
 
   return true;
@@ -85,7 +128,27 @@ bool SeqScanExecutor::DExecute() {
     while (children_[0]->Execute()) {
       std::unique_ptr<LogicalTile> tile(children_[0]->GetOutput());
 
-      if (predicate_ != nullptr) {
+      // Compile the predicate for the schema of the first tile
+      if (predicate_ != nullptr && child_predicate_compiled_ == false &&
+          tile->GetColumnCount() > 0) {
+        std::unique_ptr<catalog::Schema> schema(tile->GetPhysicalSchema());
+        compiled_child_predicate_ = CompiledExpression::Compile(
+            predicate_, schema.get(), nullptr, executor_context_);
+        child_predicate_compiled_ = true;
+      }
+
+      if (compiled_child_predicate_ != nullptr &&
+          compiled_child_predicate_->Bind(0, tile.get()) == true) {
+        // Invalidate tuples that don't satisfy the predicate.
+        oid_t tuple_ids[2] = {INVALID_OID, INVALID_OID};
+        for (oid_t tuple_id : *tile) {
+          tuple_ids[0] = tuple_id;
+          if (compiled_child_predicate_->EvaluatePredicate(tuple_ids) ==
+              type::CMP_FALSE) {
+            tile->RemoveVisibility(tuple_id);
+          }
+        }
+      } else if (predicate_ != nullptr) {
         // Invalidate tuples that don't satisfy the predicate.
         for (oid_t tuple_id : *tile) {
           expression::ContainerTuple<LogicalTile> tuple(tile.get(), tuple_id);
@@ -122,58 +185,34 @@ bool SeqScanExecutor::DExecute() {
     bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
     auto current_txn = executor_context_->GetTransaction();
 
-    // Retrieve next tile group.
-    while (current_tile_group_offset_ < table_tile_group_count_) {
-      auto tile_group =
-          target_table_->GetTileGroup(current_tile_group_offset_++);
-      auto tile_group_header = tile_group->GetHeader();
+    for (;;) {
+      // Filter the next tile groups when all filtered ones are returned
+      if (scanned_tile_groups_.empty() == true) {
+        if (current_tile_group_offset_ >= table_tile_group_count_) {
+          break;
+        }
+        ScanNextMorsels();
+        continue;
+      }
 
-      oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+      auto tile_group = scanned_tile_groups_.front().tile_group;
+      std::vector<oid_t> position_list(
+          std::move(scanned_tile_groups_.front().position_list));
+      scanned_tile_groups_.pop_front();
 
-      // Construct position list by looping through tile group
-      // and applying the predicate.
-      std::vector<oid_t> position_list;
-      for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      // The read set of the transaction is not thread-safe, so reads are
+      // performed here, in table order.
+      for (oid_t tuple_id : position_list) {
         ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
-
-
-        auto visibility = transaction_manager.IsVisible(current_txn, tile_group_header, tuple_id);
-
-        // check transaction visibility
-        if (visibility == VisibilityType::OK) {
-          // if the tuple is visible, then perform predicate evaluation.
-          if (predicate_ == nullptr) {
-            position_list.push_back(tuple_id);
-            auto res = transaction_manager.PerformRead(current_txn, location, acquire_owner);
-            if (!res) {
-              transaction_manager.SetTransactionResult(current_txn, ResultType::FAILURE);
-              return res;
-            }
-          } else {
-            expression::ContainerTuple<storage::TileGroup> tuple(
-                tile_group.get(), tuple_id);
-            LOG_TRACE("Evaluate predicate for a tuple");
-            auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_);
-            LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
-            if (eval.IsTrue()) {
-              position_list.push_back(tuple_id);
-              auto res = transaction_manager.PerformRead(current_txn, location, acquire_owner);
-              if (!res) {
-                transaction_manager.SetTransactionResult(current_txn, ResultType::FAILURE);
-                return res;
-              } else {
-                LOG_TRACE("Sequential Scan Predicate Satisfied");
-              }
-            }
-          }
+        auto res = transaction_manager.PerformRead(current_txn, location,
+                                                   acquire_owner);
+        if (!res) {
+          transaction_manager.SetTransactionResult(current_txn,
+                                                   ResultType::FAILURE);
+          return res;
         }
       }
 
-      // Don't return empty tiles
-      if (position_list.size() == 0) {
-        continue;
-      }
-
       // Construct logical tile.
       std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
       logical_tile->AddColumns(tile_group, column_ids_);
@@ -188,5 +227,136 @@ bool SeqScanExecutor::DExecute() {
   return false;
 }
 
+/**
+ * @brief Filter the next morsels of tile groups, one tile group per morsel.
+ * The workers take morsels in turn, and the filtered tile groups are
+ * gathered in table order. Empty ones are skipped.
+ */
+void SeqScanExecutor::ScanNextMorsels() {
+  oid_t begin_offset = current_tile_group_offset_;
+  oid_t end_offset = std::min<oid_t>(
+      table_tile_group_count_,
+      begin_offset + workers_.size() * MORSELS_PER_WORKER);
+  current_tile_group_offset_ = end_offset;
+
+  std::vector<ScannedTileGroup> scanned(end_offset - begin_offset);
+  std::atomic<oid_t> next_offset(begin_offset);
+  thread_pool.RunTasks(workers_.size(), [&](size_t worker_idx) {
+    for (;;) {
+      oid_t offset = next_offset.fetch_add(1);
+      if (offset >= end_offset) break;
+
+      auto &scanned_tile_group = scanned[offset - begin_offset];
+      // The tile group stays valid as long as the transaction runs
+      scanned_tile_group.tile_group = target_table_->GetTileGroupPtr(offset);
+      FilterTileGroup(scanned_tile_group.tile_group, workers_[worker_idx],
+                      scanned_tile_group.position_list);
+    }
+  });
+
+  for (auto &scanned_tile_group : scanned) {
+    // Don't return empty tiles
+    if (scanned_tile_group.position_list.size() == 0) {
+      continue;
+    }
+    scanned_tile_groups_.push_back(std::move(scanned_tile_group));
+  }
+}
+
+/**
+ * @brief Collect the tuples of a tile group that are visible to the
+ * transaction and satisfy the predicate. Safe to call from several threads
+ * with different workers.
+ */
+void SeqScanExecutor::FilterTileGroup(storage::TileGroup *tile_group,
+                                      ScanWorker &worker,
+                                      std::vector<oid_t> &position_list) const {
+  concurrency::TransactionManager &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  auto tile_group_header = tile_group->GetHeader();
+
+  oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+  // Check the visibility of the whole tile group at once.
+  transaction_manager.GetVisibleTuples(current_txn, tile_group_header,
+                                       active_tuple_count,
+                                       worker.visible_tuples);
+
+  // Filter the tile group on its columns, and only evaluate the rest of
+  // the predicate on visible tuples that pass.
+  auto &vectorized_predicate = worker.vectorized_predicate;
+  const std::vector<oid_t> *candidate_tuples = &worker.visible_tuples;
+  if (vectorized_predicate != nullptr) {
+    vectorized_predicate->Evaluate(tile_group, active_tuple_count,
+                                   worker.selection_vector);
+    worker.candidate_tuples.clear();
+    std::set_intersection(worker.visible_tuples.begin(),
+                          worker.visible_tuples.end(),
+                          worker.selection_vector.begin(),
+                          worker.selection_vector.end(),
+                          std::back_inserter(worker.candidate_tuples));
+    candidate_tuples = &worker.candidate_tuples;
+  }
+
+  // Evaluate the rest of the predicate compiled, on the columns of this
+  // tile group
+  auto &compiled_predicate = worker.compiled_predicate;
+  bool use_compiled = (compiled_predicate != nullptr &&
+                       compiled_predicate->Bind(0, tile_group) == true);
+  oid_t tuple_ids[2] = {INVALID_OID, INVALID_OID};
+
+  // Construct position list by applying the predicate.
+  for (oid_t tuple_id : *candidate_tuples) {
+    if (use_compiled == true) {
+      tuple_ids[0] = tuple_id;
+      if (compiled_predicate->EvaluatePredicate(tuple_ids) !=
+          type::CMP_TRUE) {
+        continue;
+      }
+    } else if (vectorized_predicate != nullptr) {
+      if (vectorized_predicate->HasResidual()) {
+        expression::ContainerTuple<storage::TileGroup> tuple(tile_group,
+                                                             tuple_id);
+        if (vectorized_predicate->EvaluateResidual(
+                &tuple, executor_context_) == false) {
+          continue;
+        }
+      }
+    } else if (predicate_ != nullptr) {
+      expression::ContainerTuple<storage::TileGroup> tuple(tile_group,
+                                                           tuple_id);
+      LOG_TRACE("Evaluate predicate for a tuple");
+      auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_);
+      LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
+      if (eval.IsTrue() == false) {
+        continue;
+      }
+    }
+
+    if (join_filter_ != nullptr &&
+        PassesJoinFilter(tile_group, tuple_id) == false) {
+      continue;
+    }
+
+    position_list.push_back(tuple_id);
+  }
+}
+
+/**
+ * @brief Check the join key of a tuple against the pushed down bloom filter.
+ * The key is hashed the same way as the hash join hashes its tuples.
+ */
+bool SeqScanExecutor::PassesJoinFilter(storage::TileGroup *tile_group,
+                                       oid_t tuple_id) const {
+  size_t key_hash = 0;
+  for (auto key_column_id : *join_key_column_ids_) {
+    type::Value value =
+        tile_group->GetValue(tuple_id, column_ids_[key_column_id]);
+    value.HashCombine(key_hash);
+  }
+  return join_filter_->MayContain(JoinHashTable::MixHash(key_hash));
+}
+
 }  // namespace executor
 }  // namespace peloton
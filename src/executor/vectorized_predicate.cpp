@@ -0,0 +1,395 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// vectorized_predicate.cpp
+//
+// Identification: src/executor/vectorized_predicate.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/vectorized_predicate.h"
+
+#include <functional>
+
+#include "catalog/schema.h"
+#include "common/exception.h"
+#include "common/logger.h"
+#include "executor/executor_context.h"
+#include "expression/abstract_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/parameter_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace executor {
+
+namespace {
+
+bool IsIntegerType(type::Type::TypeId type_id) {
+  switch (type_id) {
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+int64_t GetIntegerOperand(const type::Value &value) {
+  switch (value.GetTypeId()) {
+    case type::Type::TINYINT:
+      return value.GetAs<int8_t>();
+    case type::Type::SMALLINT:
+      return value.GetAs<int16_t>();
+    case type::Type::INTEGER:
+      return value.GetAs<int32_t>();
+    case type::Type::BIGINT:
+      return value.GetAs<int64_t>();
+    default:
+      throw Exception("Invalid integer operand type.");
+  }
+}
+
+// Swaps the sides of a comparison: (c < col) is (col > c)
+ExpressionType MirrorComparison(ExpressionType type) {
+  switch (type) {
+    case ExpressionType::COMPARE_LESSTHAN:
+      return ExpressionType::COMPARE_GREATERTHAN;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return ExpressionType::COMPARE_LESSTHAN;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return ExpressionType::COMPARE_LESSTHANOREQUALTO;
+    default:
+      return type;
+  }
+}
+
+/*
+ * CompareColumn() - Compare every value of a strided column with operand
+ *
+ * The loop has no branches and no calls, so it is vectorized by the
+ * compiler. NULLs are stored as a sentinel value and never satisfy a
+ * comparison.
+ */
+template <typename ColumnType, typename DomainType, typename Compare>
+void CompareColumn(const char *base, size_t stride, oid_t tuple_count,
+                   ColumnType null_value, DomainType operand, uint8_t *mask) {
+  Compare compare;
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    ColumnType value =
+        *reinterpret_cast<const ColumnType *>(base + tuple_id * stride);
+    mask[tuple_id] = (value != null_value) &
+                     compare(static_cast<DomainType>(value), operand);
+  }
+}
+
+template <typename ColumnType, typename DomainType>
+void CompareColumn(ExpressionType type, const char *base, size_t stride,
+                   oid_t tuple_count, ColumnType null_value,
+                   DomainType operand, uint8_t *mask) {
+  switch (type) {
+    case ExpressionType::COMPARE_EQUAL:
+      CompareColumn<ColumnType, DomainType, std::equal_to<DomainType>>(
+          base, stride, tuple_count, null_value, operand, mask);
+      break;
+    case ExpressionType::COMPARE_NOTEQUAL:
+      CompareColumn<ColumnType, DomainType, std::not_equal_to<DomainType>>(
+          base, stride, tuple_count, null_value, operand, mask);
+      break;
+    case ExpressionType::COMPARE_LESSTHAN:
+      CompareColumn<ColumnType, DomainType, std::less<DomainType>>(
+          base, stride, tuple_count, null_value, operand, mask);
+      break;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      CompareColumn<ColumnType, DomainType, std::greater<DomainType>>(
+          base, stride, tuple_count, null_value, operand, mask);
+      break;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      CompareColumn<ColumnType, DomainType, std::less_equal<DomainType>>(
+          base, stride, tuple_count, null_value, operand, mask);
+      break;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      CompareColumn<ColumnType, DomainType, std::greater_equal<DomainType>>(
+          base, stride, tuple_count, null_value, operand, mask);
+      break;
+    default:
+      throw Exception("Invalid comparison type for vectorized predicate.");
+  }
+}
+
+}  // namespace
+
+VectorizedPredicate::VectorizedPredicate(
+    const expression::AbstractExpression *predicate,
+    const catalog::Schema *schema, ExecutorContext *executor_context)
+    : schema_(schema), executor_context_(executor_context) {
+  root_.type = ExpressionType::CONJUNCTION_AND;
+  if (predicate != nullptr) {
+    AddConjunct(predicate);
+  }
+  LOG_TRACE("Vectorized %lu conjuncts, %lu residual conjuncts",
+            root_.children.size(), residual_.size());
+}
+
+void VectorizedPredicate::AddConjunct(
+    const expression::AbstractExpression *expr) {
+  if (expr->GetExpressionType() == ExpressionType::CONJUNCTION_AND) {
+    for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+      AddConjunct(expr->GetChild(i));
+    }
+    return;
+  }
+
+  Node node;
+  if (BuildNode(expr, node) == true) {
+    root_.children.push_back(std::move(node));
+  } else {
+    residual_.push_back(expr);
+  }
+}
+
+bool VectorizedPredicate::BuildNode(
+    const expression::AbstractExpression *expr, Node &node) {
+  switch (expr->GetExpressionType()) {
+    case ExpressionType::CONJUNCTION_AND:
+    case ExpressionType::CONJUNCTION_OR: {
+      node.type = expr->GetExpressionType();
+      node.children.resize(expr->GetChildrenSize());
+      for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+        if (BuildNode(expr->GetChild(i), node.children[i]) == false) {
+          return false;
+        }
+      }
+      return node.children.size() > 0;
+    }
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return BuildComparison(expr, node);
+    default:
+      return false;
+  }
+}
+
+bool VectorizedPredicate::BuildComparison(
+    const expression::AbstractExpression *expr, Node &node) {
+  if (expr->GetChildrenSize() != 2) return false;
+
+  // The column may be on either side of the comparison
+  auto left = expr->GetChild(0);
+  auto right = expr->GetChild(1);
+  node.type = expr->GetExpressionType();
+  if (left->GetExpressionType() != ExpressionType::VALUE_TUPLE) {
+    std::swap(left, right);
+    node.type = MirrorComparison(node.type);
+  }
+  if (left->GetExpressionType() != ExpressionType::VALUE_TUPLE) return false;
+
+  auto tuple_expr =
+      static_cast<const expression::TupleValueExpression *>(left);
+  if (tuple_expr->GetTupleId() != 0 || tuple_expr->GetColumnId() < 0 ||
+      (size_t)tuple_expr->GetColumnId() >= schema_->GetColumnCount()) {
+    return false;
+  }
+  node.column_id = tuple_expr->GetColumnId();
+  node.column_type = schema_->GetType(node.column_id);
+  if (schema_->IsInlined(node.column_id) == false) return false;
+
+  type::Value value;
+  if (GetOperandValue(right, value) == false || value.IsNull()) {
+    return false;
+  }
+  auto value_type = value.GetTypeId();
+
+  // Pick the type both sides are compared in, following the promotion
+  // rules of type::Value comparisons
+  if (IsIntegerType(node.column_type)) {
+    if (IsIntegerType(value_type)) {
+      node.domain = CompareDomain::INTEGER;
+      node.operand.integer = GetIntegerOperand(value);
+    } else if (value_type == type::Type::DECIMAL) {
+      node.domain = CompareDomain::DECIMAL;
+      node.operand.decimal = value.GetAs<double>();
+    } else {
+      return false;
+    }
+  } else if (node.column_type == type::Type::DECIMAL) {
+    node.domain = CompareDomain::DECIMAL;
+    if (IsIntegerType(value_type)) {
+      node.operand.decimal = (double)GetIntegerOperand(value);
+    } else if (value_type == type::Type::DECIMAL) {
+      node.operand.decimal = value.GetAs<double>();
+    } else {
+      return false;
+    }
+  } else if (node.column_type == type::Type::TIMESTAMP &&
+             value_type == type::Type::TIMESTAMP) {
+    node.domain = CompareDomain::TIMESTAMP;
+    node.operand.timestamp = value.GetAs<uint64_t>();
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+bool VectorizedPredicate::GetOperandValue(
+    const expression::AbstractExpression *expr, type::Value &value) const {
+  switch (expr->GetExpressionType()) {
+    case ExpressionType::VALUE_CONSTANT:
+      value = static_cast<const expression::ConstantValueExpression *>(expr)
+                  ->GetValue();
+      return true;
+    case ExpressionType::VALUE_PARAMETER: {
+      if (executor_context_ == nullptr) return false;
+      auto &params = executor_context_->GetParams();
+      auto value_idx =
+          static_cast<const expression::ParameterValueExpression *>(expr)
+              ->GetValueIdx();
+      if (value_idx < 0 || (size_t)value_idx >= params.size()) return false;
+      value = params[value_idx];
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+void VectorizedPredicate::Evaluate(storage::TileGroup *tile_group,
+                                   oid_t tuple_count,
+                                   std::vector<oid_t> &selection_vector) {
+  selection_vector.resize(tuple_count);
+  if (tuple_count == 0) return;
+
+  // Nested nodes may grow masks_, so only hold on to the mask buffer
+  if (masks_.empty()) masks_.resize(1);
+  masks_[0].resize(tuple_count);
+  uint8_t *mask = masks_[0].data();
+  EvaluateNode(root_, tile_group, tuple_count, 0, mask);
+
+  // Compact the mask into tuple offsets without branching
+  oid_t selected_count = 0;
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    selection_vector[selected_count] = tuple_id;
+    selected_count += mask[tuple_id];
+  }
+  selection_vector.resize(selected_count);
+}
+
+bool VectorizedPredicate::EvaluateResidual(
+    const AbstractTuple *tuple, ExecutorContext *executor_context) const {
+  for (auto expr : residual_) {
+    if (expr->Evaluate(tuple, nullptr, executor_context).IsTrue() == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void VectorizedPredicate::EvaluateNode(const Node &node,
+                                       storage::TileGroup *tile_group,
+                                       oid_t tuple_count, size_t depth,
+                                       uint8_t *mask) {
+  if (node.children.empty()) {
+    EvaluateComparison(node, tile_group, tuple_count, mask);
+    return;
+  }
+
+  EvaluateNode(node.children[0], tile_group, tuple_count, depth + 1, mask);
+  if (node.children.size() == 1) return;
+
+  // Masks of nested nodes must not overwrite the one of their parent
+  if (masks_.size() <= depth + 1) masks_.resize(depth + 2);
+  masks_[depth + 1].resize(tuple_count);
+  uint8_t *child_mask = masks_[depth + 1].data();
+
+  bool is_and = (node.type == ExpressionType::CONJUNCTION_AND);
+  for (size_t i = 1; i < node.children.size(); i++) {
+    EvaluateNode(node.children[i], tile_group, tuple_count, depth + 1,
+                 child_mask);
+    if (is_and) {
+      for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+        mask[tuple_id] &= child_mask[tuple_id];
+      }
+    } else {
+      for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+        mask[tuple_id] |= child_mask[tuple_id];
+      }
+    }
+  }
+}
+
+void VectorizedPredicate::EvaluateComparison(const Node &node,
+                                             storage::TileGroup *tile_group,
+                                             oid_t tuple_count,
+                                             uint8_t *mask) const {
+  // Locate the column inside its tile. Tiles are row-major, so the column
+  // is strided by the length of a tile tuple
+  oid_t tile_offset, tile_column_id;
+  tile_group->LocateTileAndColumn(node.column_id, tile_offset,
+                                  tile_column_id);
+  auto tile = tile_group->GetTile(tile_offset);
+  auto tile_schema = tile->GetSchema();
+  const char *base =
+      tile->GetTupleLocation(0) + tile_schema->GetOffset(tile_column_id);
+  size_t stride = tile_schema->GetLength();
+
+#define VECTORIZED_COMPARE(ColumnType, null_value)                          \
+  switch (node.domain) {                                                    \
+    case CompareDomain::INTEGER:                                            \
+      CompareColumn<ColumnType, int64_t>(node.type, base, stride,           \
+                                         tuple_count, null_value,           \
+                                         node.operand.integer, mask);       \
+      break;                                                                \
+    case CompareDomain::DECIMAL:                                            \
+      CompareColumn<ColumnType, double>(node.type, base, stride,            \
+                                        tuple_count, null_value,            \
+                                        node.operand.decimal, mask);        \
+      break;                                                                \
+    case CompareDomain::TIMESTAMP:                                          \
+      CompareColumn<ColumnType, uint64_t>(node.type, base, stride,          \
+                                          tuple_count, null_value,          \
+                                          node.operand.timestamp, mask);    \
+      break;                                                                \
+  }
+
+  switch (node.column_type) {
+    case type::Type::TINYINT:
+      VECTORIZED_COMPARE(int8_t, type::PELOTON_INT8_NULL);
+      break;
+    case type::Type::SMALLINT:
+      VECTORIZED_COMPARE(int16_t, type::PELOTON_INT16_NULL);
+      break;
+    case type::Type::INTEGER:
+      VECTORIZED_COMPARE(int32_t, type::PELOTON_INT32_NULL);
+      break;
+    case type::Type::BIGINT:
+      VECTORIZED_COMPARE(int64_t, type::PELOTON_INT64_NULL);
+      break;
+    case type::Type::DECIMAL:
+      VECTORIZED_COMPARE(double, type::PELOTON_DECIMAL_NULL);
+      break;
+    case type::Type::TIMESTAMP:
+      VECTORIZED_COMPARE(uint64_t, type::PELOTON_TIMESTAMP_NULL);
+      break;
+    default:
+      throw Exception("Invalid column type for vectorized predicate.");
+  }
+
+#undef VECTORIZED_COMPARE
+}
+
+}  // namespace executor
+}  // namespace peloton
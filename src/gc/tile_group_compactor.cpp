@@ -0,0 +1,340 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor.cpp
+//
+// Identification: src/gc/tile_group_compactor.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "gc/tile_group_compactor.h"
+
+#include <algorithm>
+
+#include "catalog/catalog.h"
+#include "catalog/manager.h"
+#include "catalog/schema.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "configuration/configuration.h"
+#include "statistics/backend_stats_context.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_factory.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace gc {
+
+TileGroupCompactor &TileGroupCompactor::GetInstance() {
+  static TileGroupCompactor compactor;
+  return compactor;
+}
+
+void TileGroupCompactor::CompactTables() {
+  // tables that have candidates at the start of the pass
+  std::unordered_set<oid_t> candidate_tables;
+  {
+    std::lock_guard<std::mutex> candidate_lock(candidate_mutex_);
+    for (auto &entry : candidate_tile_groups_) {
+      candidate_tables.insert(entry.first);
+    }
+  }
+
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database_count = catalog->GetDatabaseCount();
+
+  // skip the catalog database
+  for (oid_t database_idx = 1; database_idx < database_count; database_idx++) {
+    auto database = catalog->GetDatabaseWithOffset(database_idx);
+    auto table_count = database->GetTableCount();
+
+    for (oid_t table_idx = 0; table_idx < table_count; table_idx++) {
+      storage::DataTable *table = database->GetTable(table_idx);
+      PL_ASSERT(table);
+      candidate_tables.erase(table->GetOid());
+      CompactTable(table);
+    }
+  }
+
+  // the candidates of catalog tables and dropped tables are never compacted
+  std::lock_guard<std::mutex> candidate_lock(candidate_mutex_);
+  for (auto table_id : candidate_tables) {
+    candidate_tile_groups_.erase(table_id);
+  }
+}
+
+void TileGroupCompactor::AddCandidate(const oid_t table_id,
+                                      const oid_t tile_group_id) {
+  std::lock_guard<std::mutex> candidate_lock(candidate_mutex_);
+  candidate_tile_groups_[table_id].insert(tile_group_id);
+}
+
+size_t TileGroupCompactor::CompactTable(storage::DataTable *table) {
+  std::lock_guard<std::mutex> lock(compaction_mutex_);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+  cid_t max_committed_cid = txn_manager.GetMaxCommittedCid();
+  bool compactable = (table->GetIndexCount() > 0);
+  oid_t table_id = table->GetOid();
+
+  int64_t relocated_tuple_count = 0;
+  size_t released_tile_group_count = 0;
+
+  std::vector<oid_t> candidates;
+  {
+    std::lock_guard<std::mutex> candidate_lock(candidate_mutex_);
+    auto entry = candidate_tile_groups_.find(table_id);
+    if (entry != candidate_tile_groups_.end()) {
+      candidates.assign(entry->second.begin(), entry->second.end());
+    }
+  }
+
+  // candidates that are gone, and candidates whose free slots were reused
+  std::vector<oid_t> dropped_candidates;
+  std::vector<std::shared_ptr<storage::TileGroup>> unused_candidates;
+
+  for (auto tile_group_id : candidates) {
+    auto tile_group = manager.GetTileGroup(tile_group_id);
+    // dropped or already released
+    if (tile_group == nullptr || compactable == false ||
+        tile_group->GetHeader()->GetCompactingCid() == INVALID_CID) {
+      dropped_candidates.push_back(tile_group_id);
+      continue;
+    }
+    auto tile_group_header = tile_group->GetHeader();
+    auto compacting_cid = tile_group_header->GetCompactingCid();
+
+    oid_t allocated_count = tile_group->GetAllocatedTupleCount();
+    oid_t used_count = tile_group_header->GetCurrentNextTupleSlot();
+
+    // Count the live tuples, and whether any slot is used or owned by a
+    // transaction
+    oid_t live_count = 0;
+    bool empty = true;
+    bool owned = false;
+    for (oid_t tuple_id = 0; tuple_id < used_count; tuple_id++) {
+      auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+      if (tuple_txn_id == INVALID_TXN_ID) {
+        continue;
+      }
+      empty = false;
+      if (tuple_txn_id != INITIAL_TXN_ID) {
+        owned = true;
+      } else if (tile_group_header->GetBeginCommitId(tuple_id) != MAX_CID &&
+                 tile_group_header->GetEndCommitId(tuple_id) == MAX_CID) {
+        live_count++;
+      }
+    }
+
+    bool sparse = (used_count == allocated_count &&
+                   live_count <= COMPACTION_FILL_THRESHOLD * allocated_count);
+
+    // Step 1: pick the tile group
+    if (tile_group_header->IsCompacting() == false) {
+      if (sparse == true) {
+        LOG_TRACE("Compacting tile group %u", tile_group_id);
+        tile_group_header->SetCompactingCid(txn_manager.GetCurrentCommitId());
+      } else {
+        unused_candidates.push_back(tile_group);
+      }
+      continue;
+    }
+
+    // Wait for the transactions that may have claimed one of its slots
+    // before it was picked
+    if (compacting_cid >= max_committed_cid) {
+      continue;
+    }
+
+    // Step 3: release the tile group once its slots and garbage are gone
+    if (empty == true) {
+      if (tile_group_header->GetPendingGarbageCount() != 0) {
+        continue;
+      }
+      if (drained_tile_groups_.count(tile_group_id) == 0) {
+        // check again after the transactions running now, one of which may
+        // be about to recycle an aborted version
+        drained_tile_groups_.insert(tile_group_id);
+        tile_group_header->SetCompactingCid(txn_manager.GetCurrentCommitId());
+        continue;
+      }
+      drained_tile_groups_.erase(tile_group_id);
+      ReleaseTileGroup(tile_group.get());
+      released_tile_group_count++;
+      dropped_candidates.push_back(tile_group_id);
+      continue;
+    }
+    drained_tile_groups_.erase(tile_group_id);
+
+    // The tuples of a bulk load may have filled it since it was picked
+    if (sparse == false) {
+      tile_group_header->SetCompactingCid(MAX_CID);
+      continue;
+    }
+
+    // Step 2: move its live tuples out
+    if (live_count > 0 && owned == false) {
+      if (RelocateTuples(table, tile_group.get()) == true) {
+        relocated_tuple_count += live_count;
+      }
+    }
+  }
+
+  if (dropped_candidates.empty() == false ||
+      unused_candidates.empty() == false) {
+    std::lock_guard<std::mutex> candidate_lock(candidate_mutex_);
+    auto &table_candidates = candidate_tile_groups_[table_id];
+    for (auto tile_group_id : dropped_candidates) {
+      table_candidates.erase(tile_group_id);
+    }
+    // The GC adds a tile group again when its free slots reach the count,
+    // which it may have done since the pass looked at it
+    for (auto &tile_group : unused_candidates) {
+      if (tile_group->GetHeader()->GetFreeSlotCount() <
+          GetCandidateFreeSlotCount(tile_group->GetAllocatedTupleCount())) {
+        table_candidates.erase(tile_group->GetTileGroupId());
+      }
+    }
+    if (table_candidates.empty() == true) {
+      candidate_tile_groups_.erase(table_id);
+    }
+  }
+
+  LOG_TRACE("Table %u: %lu candidates, %lu tile groups released", table_id,
+            candidates.size(), released_tile_group_count);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    RecordFragmentation(table, relocated_tuple_count,
+                        released_tile_group_count);
+  }
+
+  return released_tile_group_count;
+}
+
+void TileGroupCompactor::RecordFragmentation(
+    storage::DataTable *table, int64_t relocated_tuple_count,
+    size_t released_tile_group_count) {
+  int64_t tile_group_count = 0;
+  int64_t slot_count = 0;
+  int64_t live_tuple_count = 0;
+  int64_t sparse_tile_group_count = 0;
+
+  auto table_tile_group_count = table->GetTileGroupCount();
+  for (oid_t tile_group_offset = START_OID;
+       tile_group_offset < table_tile_group_count; tile_group_offset++) {
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+    if (tile_group == nullptr) {
+      continue;
+    }
+    auto tile_group_header = tile_group->GetHeader();
+    // already released
+    if (tile_group_header->GetCompactingCid() == INVALID_CID) {
+      continue;
+    }
+
+    int64_t allocated_count = tile_group->GetAllocatedTupleCount();
+    int64_t used_count = std::min<int64_t>(
+        tile_group_header->GetCurrentNextTupleSlot(), allocated_count);
+    tile_group_count++;
+    slot_count += allocated_count;
+
+    // The used slots that are neither free nor garbage hold live tuples, or
+    // versions being written
+    int64_t live_count = used_count -
+                         tile_group_header->GetFreeSlotCount() -
+                         tile_group_header->GetPendingGarbageCount();
+    live_count = std::max<int64_t>(live_count, 0);
+    live_tuple_count += live_count;
+
+    if (used_count == allocated_count &&
+        live_count <= COMPACTION_FILL_THRESHOLD * allocated_count) {
+      sparse_tile_group_count++;
+    }
+  }
+
+  auto &fragmentation =
+      stats::BackendStatsContext::GetInstance()
+          ->GetTableMetric(table->GetDatabaseOid(), table->GetOid())
+          ->GetTableFragmentation();
+  fragmentation.SetSnapshot(tile_group_count, slot_count, live_tuple_count,
+                            sparse_tile_group_count);
+  fragmentation.IncrementRelocatedTuples(relocated_tuple_count);
+  fragmentation.IncrementReleasedTileGroups(released_tile_group_count);
+}
+
+bool TileGroupCompactor::RelocateTuples(storage::DataTable *table,
+                                        storage::TileGroup *tile_group) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  auto tile_group_header = tile_group->GetHeader();
+  auto tile_group_id = tile_group->GetTileGroupId();
+  oid_t column_count = table->GetSchema()->GetColumnCount();
+  oid_t used_count = tile_group_header->GetCurrentNextTupleSlot();
+
+  for (oid_t tuple_id = 0; tuple_id < used_count; tuple_id++) {
+    if (txn_manager.IsVisible(txn, tile_group_header, tuple_id) !=
+        VisibilityType::OK) {
+      continue;
+    }
+
+    // Lock the version like a SELECT FOR UPDATE, which fails if a
+    // transaction has written it since the pass looked at it
+    ItemPointer old_location(tile_group_id, tuple_id);
+    if (tile_group_header->GetIndirection(tuple_id) == nullptr ||
+        txn_manager.PerformRead(txn, old_location, true) == false) {
+      txn_manager.SetTransactionResult(txn, ResultType::FAILURE);
+      txn_manager.AbortTransaction(txn);
+      return false;
+    }
+
+    // Copy the tuple into a new version. The GC does not hand out slots of
+    // tile groups being compacted, so it lands in another tile group.
+    ItemPointer new_location = table->AcquireVersion();
+    if (new_location.IsNull() == true) {
+      txn_manager.SetTransactionResult(txn, ResultType::FAILURE);
+      txn_manager.AbortTransaction(txn);
+      return false;
+    }
+    auto new_tile_group = manager.GetTileGroup(new_location.block);
+    PL_ASSERT(new_tile_group->GetHeader()->IsCompacting() == false);
+    for (oid_t column_id = 0; column_id < column_count; column_id++) {
+      type::Value value = tile_group->GetValue(tuple_id, column_id);
+      new_tile_group->SetValue(value, new_location.offset, column_id);
+    }
+
+    // the new version takes over the indirection
+    txn_manager.PerformUpdate(txn, old_location, new_location);
+  }
+
+  return txn_manager.CommitTransaction(txn) == ResultType::SUCCESS;
+}
+
+void TileGroupCompactor::ReleaseTileGroup(storage::TileGroup *tile_group) {
+  auto tile_group_id = tile_group->GetTileGroupId();
+  LOG_TRACE("Releasing tile group %u", tile_group_id);
+
+  // An empty tile group with a single slot takes over the id. Its slot is
+  // claimed, so nothing is ever inserted into it.
+  std::shared_ptr<storage::TileGroup> empty_tile_group(
+      storage::TileGroupFactory::GetTileGroup(
+          tile_group->GetDatabaseId(), tile_group->GetTableId(),
+          tile_group_id, tile_group->GetAbstractTable(),
+          tile_group->GetTileSchemas(), tile_group->GetColumnMap(), 1));
+  auto empty_tile_group_header = empty_tile_group->GetHeader();
+  empty_tile_group_header->GetNextEmptyTupleSlot();
+  empty_tile_group_header->SetCompactingCid(INVALID_CID);
+
+  // the old tile group is freed once no transaction can still be reading it
+  catalog::Manager::GetInstance().AddTileGroup(tile_group_id,
+                                               empty_tile_group);
+}
+
+}  // namespace gc
+}  // namespace peloton
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "gc/transaction_level_gc_manager.h"
+#include "gc/tile_group_compactor.h"
 #include "storage/tuple.h"
 #include "storage/database.h"
 #include "storage/tile_group.h"
@@ -49,6 +50,7 @@ bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location) {
 void TransactionLevelGCManager::Running(const int &thread_id) {
   PL_ASSERT(is_running_ == true);
   uint32_t backoff_shifts = 0;
+  auto last_compaction = std::chrono::steady_clock::now();
   while (true) {
     auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
     auto max_cid = txn_manager.GetMaxCommittedCid();
@@ -61,6 +63,17 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
     if (is_running_ == false) {
       return;
     }
+
+    // the first thread also compacts sparse tile groups
+    if (thread_id == 0) {
+      auto now = std::chrono::steady_clock::now();
+      if (now - last_compaction >=
+          std::chrono::milliseconds(COMPACTION_INTERVAL_MS)) {
+        TileGroupCompactor::GetInstance().CompactTables();
+        last_compaction = now;
+      }
+    }
+
     if (reclaimed_count == 0 && unlinked_count == 0) {
       // sleep at most 0.8192 s
       if (backoff_shifts < 13) {
@@ -77,6 +90,16 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
 
 
 void TransactionLevelGCManager::RecycleTransaction(std::shared_ptr<GCSet> gc_set, const cid_t &timestamp) {
+  // Count the garbage in its tile groups, which the compactor must not
+  // release before it is reset
+  auto &manager = catalog::Manager::GetInstance();
+  for (auto &entry : *(gc_set.get())) {
+    auto tile_group = manager.GetTileGroup(entry.first);
+    if (tile_group != nullptr) {
+      tile_group->GetHeader()->IncreasePendingGarbageCount(entry.second.size());
+    }
+  }
+
   // Add the garbage context to the lock-free queue
   std::shared_ptr<GarbageContext> gc_context(new GarbageContext(gc_set, timestamp));
   unlink_queues_[HashToThread(gc_context->timestamp_)]->Enqueue(gc_context);
@@ -174,7 +197,7 @@ void TransactionLevelGCManager::AddToRecycleMap(std::shared_ptr<GarbageContext>
 
     // During the resetting, a table may be deconstructed because of the DROP TABLE request
     if (tile_group == nullptr) {
-      return;
+      continue;
     }
 
     PL_ASSERT(tile_group != nullptr);
@@ -184,6 +207,10 @@ void TransactionLevelGCManager::AddToRecycleMap(std::shared_ptr<GarbageContext>
     PL_ASSERT(table != nullptr);
 
     oid_t table_id = table->GetOid();
+    auto tile_group_header = tile_group->GetHeader();
+    size_t candidate_free_slot_count =
+        TileGroupCompactor::GetCandidateFreeSlotCount(
+            tile_group->GetAllocatedTupleCount());
 
     for (auto &element : entry.second) {
 
@@ -191,9 +218,24 @@ void TransactionLevelGCManager::AddToRecycleMap(std::shared_ptr<GarbageContext>
       ItemPointer location(entry.first, element.first); 
       
       // If the tuple being reset no longer exists, just skip it
-      if (ResetTuple(location) == false) {
+      bool reset = ResetTuple(location);
+      tile_group_header->DecreasePendingGarbageCount(1);
+      if (reset == false) {
         continue;
       }
+
+      // a tile group whose slots are mostly free is handed to the compactor
+      auto free_slot_count = tile_group_header->IncreaseFreeSlotCount(1);
+      if (free_slot_count == candidate_free_slot_count) {
+        TileGroupCompactor::GetInstance().AddCandidate(
+            table_id, tile_group->GetTileGroupId());
+      }
+
+      // the slots of a tile group being compacted are not reused
+      if (tile_group_header->IsCompacting() == true) {
+        continue;
+      }
+
       // if the entry for table_id exists.
       if (recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
         recycle_queue_map_[table_id]->Enqueue(location);
@@ -215,7 +257,18 @@ ItemPointer TransactionLevelGCManager::ReturnFreeSlot(const oid_t &table_id) {
   PL_ASSERT(recycle_queue_map_.find(table_id) != recycle_queue_map_.end());
   auto recycle_queue = recycle_queue_map_[table_id];
 
-  if (recycle_queue->Dequeue(location) == true) {
+  auto &manager = catalog::Manager::GetInstance();
+  while (recycle_queue->Dequeue(location) == true) {
+    // drop the slots of tile groups picked by the compactor since they were
+    // recycled
+    auto tile_group = manager.GetTileGroup(location.block);
+    if (tile_group == nullptr ||
+        tile_group->GetHeader()->IsCompacting() == true) {
+      continue;
+    }
+
+    tile_group->GetHeader()->DecreaseFreeSlotCount(1);
+
     LOG_TRACE("Reuse tuple(%u, %u) in table %u", location.block,
               location.offset, table_id);
     return location;
@@ -244,12 +297,7 @@ void TransactionLevelGCManager::DeleteFromIndexes(const std::shared_ptr<GarbageC
         // so we can safely get indirection from the indirection array.
         auto tile_group = catalog::Manager::GetInstance().GetTileGroup(entry.first);
         if (tile_group != nullptr){
-          auto tile_group_header = catalog::Manager::GetInstance()
-                                       .GetTileGroup(entry.first)
-                                       ->GetHeader();
-          ItemPointer *indirection = tile_group_header->GetIndirection(element.first);
-
-          DeleteTupleFromIndexes(indirection);
+          DeleteTupleFromIndexes(tile_group.get(), element.first);
         }
       }
     }
@@ -258,26 +306,23 @@ void TransactionLevelGCManager::DeleteFromIndexes(const std::shared_ptr<GarbageC
 }
 
 // delete a tuple from all its indexes it belongs to.
-void TransactionLevelGCManager::DeleteTupleFromIndexes(ItemPointer *indirection) {
+void TransactionLevelGCManager::DeleteTupleFromIndexes(storage::TileGroup *tile_group,
+                                                       const oid_t &tuple_id) {
+  ItemPointer *indirection = tile_group->GetHeader()->GetIndirection(tuple_id);
   // do nothing if indirection is null
   if (indirection == nullptr){
     return;
   }
   LOG_TRACE("Deleting indirection %p from index", indirection);
-  
-  ItemPointer location = *indirection;
-
-  auto &manager = catalog::Manager::GetInstance();
-  auto tile_group = manager.GetTileGroup(location.block);
-
-  PL_ASSERT(tile_group != nullptr);
 
   storage::DataTable *table =
     dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
   PL_ASSERT(table != nullptr);
 
-  // construct the expired version.
-  expression::ContainerTuple<storage::TileGroup> expired_tuple(tile_group.get(), location.offset);
+  // construct the expired version. the key is built from its own values, as
+  // the version the indirection points to may be the empty version of a
+  // delete.
+  expression::ContainerTuple<storage::TileGroup> expired_tuple(tile_group, tuple_id);
 
   // unlink the version from all the indexes.
   for (size_t idx = 0; idx < table->GetIndexCount(); ++idx) {
@@ -84,6 +84,9 @@ class configuration {
 
   // asynchronous_mode
   AsynchronousType asynchronous_mode;
+
+  // number of threads used to replay the log
+  int recovery_thread_count;
 };
 
 void Usage(FILE *out);
@@ -31,6 +31,7 @@
 #define TABLE_METRIC_NAME "table_metric"
 #define INDEX_METRIC_NAME "index_metric"
 #define QUERY_METRIC_NAME "query_metric"
+#define COLUMN_STATS_NAME "column_stats"
 
 #define QUERY_NUM_PARAM_COL_NAME "num_params"
 #define QUERY_PARAM_TYPE_COL_NAME "param_types"
@@ -161,6 +162,9 @@ class Catalog {
   // Initialize the schema of the query metrics table
   std::unique_ptr<catalog::Schema> InitializeQueryMetricsSchema();
 
+  // Initialize the schema of the column statistics table
+  std::unique_ptr<catalog::Schema> InitializeColumnStatsSchema();
+
   // Get table from a database with its name
   storage::DataTable *GetTableWithName(std::string database_name,
                                        std::string table_name);
@@ -172,6 +176,12 @@ class Catalog {
   // Get the number of databases currently in the catalog
   oid_t GetDatabaseCount();
 
+  // The version of the catalog, bumped whenever a database, table or index
+  // is added or dropped
+  static uint64_t GetVersion() { return version_.load(); }
+
+  static void IncrementVersion() { version_++; }
+
   void PrintCatalogs();
 
   // Get a new id for database, table, etc.
@@ -201,8 +211,32 @@ class Catalog {
                                          std::string &database_name,
                                          concurrency::Transaction *txn);
 
-  // A vector of the database pointers in the catalog
-  std::vector<storage::Database *> databases_;
+  // The databases, hashed by name and oid. Writers replace the whole set
+  // under catalog_mutex_, so readers only load the current one.
+  struct DatabaseSet {
+    std::vector<storage::Database *> databases;
+    std::unordered_map<std::string, storage::Database *> databases_by_name;
+    std::unordered_map<oid_t, storage::Database *> databases_by_oid;
+  };
+
+  std::shared_ptr<const DatabaseSet> GetDatabaseSet() const {
+    return std::atomic_load(&databases_);
+  }
+
+  // Publish a new set with the given databases
+  void SetDatabases(std::vector<storage::Database *> &&databases);
+
+  // Publish a new set with the database added or removed. The caller holds
+  // catalog_mutex_.
+  void PushDatabase(storage::Database *database);
+  void EraseDatabase(storage::Database *database);
+
+  // The databases in the catalog
+  std::shared_ptr<const DatabaseSet> databases_;
+
+  std::mutex catalog_mutex_;
+
+  static std::atomic<uint64_t> version_;
 
   // The id variable that get assigned to objects. Initialized with (START_OID
   // +
@@ -76,5 +76,12 @@ std::unique_ptr<storage::Tuple> GetQueryMetricsCatalogTuple(
     stats::QueryMetric::QueryParamBuf val_buf, int64_t reads, int64_t updates,
     int64_t deletes, int64_t inserts, int64_t latency, int64_t cpu_time,
     int64_t time_stamp, type::AbstractPool *pool);
+
+std::unique_ptr<storage::Tuple> GetColumnStatsCatalogTuple(
+    const catalog::Schema *schema, oid_t table_id, oid_t column_id,
+    oid_t database_id, int64_t num_rows, double null_fraction,
+    double distinct_count, std::string most_common_values,
+    std::string most_common_frequencies, std::string histogram_bounds,
+    int64_t time_stamp, type::AbstractPool *pool);
 }
 }
@@ -62,6 +62,14 @@ class Manager {
 
   std::shared_ptr<storage::TileGroup> GetTileGroup(const oid_t oid);
 
+  // Look up a tile group without touching its reference count. A dropped
+  // tile group is only freed once the epoch manager reports that every
+  // transaction that could have looked it up has finished, so the pointer
+  // stays valid until the calling transaction ends.
+  storage::TileGroup *GetTileGroupPtr(const oid_t oid) {
+    return tile_group_ptr_locator_.Find(oid);
+  }
+
   void ClearTileGroup(void);
 
 
@@ -96,8 +104,20 @@ class Manager {
 
   LockFreeArray<std::shared_ptr<storage::TileGroup>> tile_group_locator_;
 
+  // Raw pointers of the tile groups in the locator
+  LockFreeArray<storage::TileGroup *> tile_group_ptr_locator_;
+
   static std::shared_ptr<storage::TileGroup> empty_tile_group_;
 
+  // Keep a dropped tile group alive until no reader can hold it
+  void RetireTileGroup(std::shared_ptr<storage::TileGroup> tile_group);
+
+  // Dropped tile groups, with the epoch they were dropped in
+  std::vector<std::pair<size_t, std::shared_ptr<storage::TileGroup>>>
+      retired_tile_groups_;
+
+  std::mutex retired_tile_groups_mutex_;
+
   //===--------------------------------------------------------------------===//
   // Data members for indirection array allocation
   //===--------------------------------------------------------------------===//
@@ -13,6 +13,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <thread>
 
@@ -75,10 +82,72 @@ class ThreadPool {
     dedicated_threads_[thread_id].reset(new std::thread(std::thread(func, params...)));
   }
 
+  // run task(0), ..., task(task_count - 1) and wait for all of them.
+  // the calling thread takes part in running the tasks, so this works even
+  // when the pool has no threads. the first exception thrown by a task is
+  // rethrown to the caller once all the tasks are done.
+  void RunTasks(const size_t &task_count,
+                const std::function<void(size_t)> &task) {
+    if (task_count == 0) return;
+
+    std::shared_ptr<TaskGroup> task_group(new TaskGroup(task_count, task));
+
+    // pool threads that start after all tasks are taken return right away.
+    size_t helper_count = std::min(pool_size_, task_count - 1);
+    for (size_t i = 0; i < helper_count; ++i) {
+      io_service_.post([task_group]() { task_group->Run(); });
+    }
+
+    task_group->Run();
+    task_group->Wait();
+  }
+
+  size_t GetPoolSize() const { return pool_size_; }
+
  private:
   ThreadPool(const ThreadPool &);
   ThreadPool &operator=(const ThreadPool &);
 
+  // a set of tasks run by RunTasks.
+  struct TaskGroup {
+    TaskGroup(const size_t &count, const std::function<void(size_t)> &func)
+        : task_count(count), task(func) {}
+
+    // keep taking tasks until there are none left.
+    void Run() {
+      for (;;) {
+        size_t task_id = next_task.fetch_add(1, std::memory_order_relaxed);
+        if (task_id >= task_count) return;
+
+        try {
+          task(task_id);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (error == nullptr) error = std::current_exception();
+        }
+
+        if (done_count.fetch_add(1) + 1 == task_count) {
+          std::lock_guard<std::mutex> lock(mutex);
+          done_cv.notify_all();
+        }
+      }
+    }
+
+    void Wait() {
+      std::unique_lock<std::mutex> lock(mutex);
+      done_cv.wait(lock, [this]() { return done_count.load() == task_count; });
+      if (error != nullptr) std::rethrow_exception(error);
+    }
+
+    const size_t task_count;
+    const std::function<void(size_t)> task;
+    std::atomic<size_t> next_task = ATOMIC_VAR_INIT(0);
+    std::atomic<size_t> done_count = ATOMIC_VAR_INIT(0);
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    std::exception_ptr error;
+  };
+
  private:
   // number of threads in the thread pool.
   size_t pool_size_;
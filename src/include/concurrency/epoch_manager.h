@@ -157,6 +157,13 @@ public:
     return max_cid_ro_;
   }
 
+  size_t GetCurrentEpoch() const { return current_epoch_.load(); }
+
+  // No transaction runs in an epoch older than this one
+  size_t GetReclaimTail() const { return reclaim_tail_.load(); }
+
+  bool IsRunning() const { return is_running_; }
+
 private:
   void Running() {
     
@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.h
+//
+// Identification: src/include/concurrency/read_write_set.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/item_pointer.h"
+#include "type/types.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// Read Write Set
+//===--------------------------------------------------------------------===//
+
+// The tuples a transaction has accessed and how, in the order of their
+// first access. Entries live in a flat vector. Small sets are searched
+// linearly, and larger ones get an open addressing index of entry
+// positions. The buffers are recycled across the transactions of a thread,
+// so recording an access does not allocate once a thread is warmed up.
+class ReadWriteSet {
+ public:
+  struct Entry {
+    ItemPointer location;
+    RWType type;
+  };
+
+  ReadWriteSet(const ReadWriteSet &) = delete;
+  ReadWriteSet &operator=(const ReadWriteSet &) = delete;
+
+  ReadWriteSet();
+
+  ~ReadWriteSet();
+
+  // Return the access type of the location, or nullptr if it is not in the
+  // set. The pointer is valid until the next Insert().
+  RWType *Find(const ItemPointer &location);
+
+  // Add a location that is not in the set yet
+  void Insert(const ItemPointer &location, RWType type);
+
+  inline std::vector<Entry>::const_iterator begin() const {
+    return entries_.begin();
+  }
+
+  inline std::vector<Entry>::const_iterator end() const {
+    return entries_.end();
+  }
+
+  inline size_t size() const { return entries_.size(); }
+
+  inline bool empty() const { return entries_.empty(); }
+
+ private:
+  // Sets up to this size have no index
+  static constexpr size_t LINEAR_SEARCH_SIZE = 16;
+
+  static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+  static inline uint64_t HashLocation(const ItemPointer &location) {
+    uint64_t hash = (static_cast<uint64_t>(location.block) << 32) |
+                    location.offset;
+    hash ^= hash >> 33;
+    hash *= UINT64_C(0xff51afd7ed558ccd);
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  // Rebuild the index with room for twice the entries
+  void BuildIndex();
+
+  void IndexEntry(uint32_t entry_idx);
+
+  std::vector<Entry> entries_;
+
+  // Positions of the entries, empty while the set is small
+  std::vector<uint32_t> index_;
+};
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -26,11 +26,13 @@ namespace concurrency {
 
 class TimestampOrderingTransactionManager : public TransactionManager {
  public:
-  TimestampOrderingTransactionManager() {}
+  TimestampOrderingTransactionManager(bool epoch_commit_id = false)
+      : TransactionManager(epoch_commit_id) {}
 
   virtual ~TimestampOrderingTransactionManager() {}
 
-  static TimestampOrderingTransactionManager &GetInstance();
+  static TimestampOrderingTransactionManager &GetInstance(
+      ConcurrencyType protocol = ConcurrencyType::TIMESTAMP_ORDERING);
 
   // This method is used for avoiding concurrent inserts.
   virtual bool IsOccupied(
@@ -42,6 +44,11 @@ class TimestampOrderingTransactionManager : public TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id);
 
+  virtual void GetVisibleTuples(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t tuple_count, std::vector<oid_t> &visible_tuples);
+
   // This method test whether the current transaction is the owner of a tuple.
   virtual bool IsOwner(Transaction *const current_txn,
                        const storage::TileGroupHeader *const tile_group_header,
@@ -21,6 +21,7 @@
 #include "common/exception.h"
 #include "common/item_pointer.h"
 #include "common/printable.h"
+#include "concurrency/read_write_set.h"
 #include "type/types.h"
 
 namespace peloton {
@@ -17,6 +17,7 @@
 #include <unordered_map>
 #include <list>
 #include <utility>
+#include <vector>
 
 #include "storage/tile_group_header.h"
 #include "concurrency/transaction.h"
@@ -42,10 +43,16 @@ class Transaction;
 
 class TransactionManager {
  public:
-  TransactionManager() {
+  // With epoch_commit_id set, commit ids are not taken one at a time from
+  // a shared counter. Instead, each thread leases a batch of counter values
+  // and prefixes them with the current epoch.
+  TransactionManager(bool epoch_commit_id = false)
+      : epoch_commit_id_(epoch_commit_id) {
     next_txn_id_ = ATOMIC_VAR_INIT(START_TXN_ID);
     next_cid_ = ATOMIC_VAR_INIT(START_CID);
     maximum_grant_cid_ = ATOMIC_VAR_INIT(MAX_CID);
+    cid_epoch_base_ = ATOMIC_VAR_INIT(0);
+    lease_generation_ = ATOMIC_VAR_INIT(0);
   }
 
   virtual ~TransactionManager() {}
@@ -53,14 +60,22 @@ class TransactionManager {
   txn_id_t GetNextTransactionId() { return next_txn_id_++; }
 
   cid_t GetNextCommitId() {
-    cid_t temp_cid = next_cid_++;
+    cid_t temp_cid =
+        (epoch_commit_id_ == true) ? GetNextEpochCommitId() : next_cid_++;
     // wait if we do not yet have a grant for this commit id
     while (temp_cid > maximum_grant_cid_.load())
       ;
     return temp_cid;
   }
 
-  cid_t GetCurrentCommitId() { return next_cid_.load(); }
+  cid_t GetCurrentCommitId() {
+    if (epoch_commit_id_ == true) {
+      return MakeEpochCommitId(GetCommitIdEpoch(), next_cid_.load());
+    }
+    return next_cid_.load();
+  }
+
+  bool IsEpochCommitId() const { return epoch_commit_id_; }
 
   // This method is used for avoiding concurrent inserts.
   virtual bool IsOccupied(
@@ -72,6 +87,13 @@ class TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id) = 0;
 
+  // This method collects the slots in [0, tuple_count) of a tile group that
+  // are visible to the current transaction, in ascending order.
+  virtual void GetVisibleTuples(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t tuple_count, std::vector<oid_t> &visible_tuples) = 0;
+
   // This method test whether the current transaction is the owner of a tuple.
   virtual bool IsOwner(
       Transaction *const current_txn, 
@@ -132,7 +154,15 @@ class TransactionManager {
   }
 
   // for use by recovery
-  void SetNextCid(cid_t cid) { next_cid_ = cid; }
+  void SetNextCid(cid_t cid) {
+    if (epoch_commit_id_ == true) {
+      // later commit ids start in an epoch after the one of cid
+      cid_epoch_base_ = (cid >> EPOCH_CID_SHIFT) + 1;
+      lease_generation_++;
+      return;
+    }
+    next_cid_ = cid;
+  }
 
   void SetMaxGrantCid(cid_t cid) { maximum_grant_cid_ = cid; }
 
@@ -151,6 +181,8 @@ class TransactionManager {
   void ResetStates() {
     next_txn_id_ = START_TXN_ID;
     next_cid_ = START_CID;
+    cid_epoch_base_ = 0;
+    lease_generation_++;
   }
 
   // this function generates the maximum commit id of committed transactions.
@@ -174,9 +206,37 @@ class TransactionManager {
       std::make_pair(INVALID_CID, INVALID_CID);
 
  private:
+  // An epoch-based commit id keeps the epoch in its upper bits and a
+  // counter value in its lower bits, so commit ids of a later epoch are
+  // always larger.
+  static constexpr int EPOCH_CID_SHIFT = 32;
+
+  // Number of counter values a thread leases at once
+  static constexpr cid_t COMMIT_ID_LEASE_SIZE = 64;
+
+  static inline cid_t MakeEpochCommitId(cid_t epoch, cid_t counter) {
+    return (epoch << EPOCH_CID_SHIFT) |
+           (counter & ((cid_t(1) << EPOCH_CID_SHIFT) - 1));
+  }
+
+  cid_t GetCommitIdEpoch() const {
+    return cid_epoch_base_.load() +
+           EpochManagerFactory::GetInstance().GetCurrentEpoch();
+  }
+
+  cid_t GetNextEpochCommitId();
+
   std::atomic<txn_id_t> next_txn_id_;
   std::atomic<cid_t> next_cid_;
   std::atomic<cid_t> maximum_grant_cid_;
+
+  const bool epoch_commit_id_;
+
+  // Added to the epoch of the epoch manager, for use by recovery
+  std::atomic<cid_t> cid_epoch_base_;
+
+  // Bumped to invalidate the leases held by threads
+  std::atomic<uint64_t> lease_generation_;
 };
 }  // End storage namespace
 }  // End peloton namespace
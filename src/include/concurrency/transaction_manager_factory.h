@@ -25,6 +25,9 @@ class TransactionManagerFactory {
       case ConcurrencyType::TIMESTAMP_ORDERING:
         return TimestampOrderingTransactionManager::GetInstance();
 
+      case ConcurrencyType::TIMESTAMP_ORDERING_EPOCH:
+        return TimestampOrderingTransactionManager::GetInstance(protocol_);
+
       default:
         return TimestampOrderingTransactionManager::GetInstance();
     }
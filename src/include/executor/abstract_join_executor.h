@@ -14,8 +14,10 @@
 
 #include "catalog/schema.h"
 #include "executor/abstract_executor.h"
+#include "executor/compiled_expression.h"
 #include "planner/project_info.h"
 
+#include <memory>
 #include <vector>
 #include <unordered_set>
 
@@ -102,6 +104,10 @@ class AbstractJoinExecutor : public AbstractExecutor {
   std::vector<std::vector<oid_t>> BuildPostitionLists(LogicalTile *left_tile,
                                                       LogicalTile *right_tile);
 
+  // Bind the compiled join predicate to a pair of tiles, compiling it on
+  // first use. Returns false if the predicate must be interpreted.
+  bool BindCompiledPredicate(LogicalTile *left_tile, LogicalTile *right_tile);
+
   void BufferLeftTile(LogicalTile *left_tile);
   void BufferRightTile(LogicalTile *right_tile);
 
@@ -171,6 +177,11 @@ class AbstractJoinExecutor : public AbstractExecutor {
   /** @brief Join predicate. */
   const expression::AbstractExpression *predicate_ = nullptr;
 
+  /** @brief Compiled join predicate, nullptr if not compiled. */
+  std::unique_ptr<CompiledExpression> compiled_predicate_;
+
+  bool predicate_compiled_ = false;
+
   /** @brief Projection info */
   const planner::ProjectInfo *proj_info_ = nullptr;
 
@@ -0,0 +1,164 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// aggregate_hash_table.h
+//
+// Identification: src/include/executor/aggregate_hash_table.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "planner/aggregate_plan.h"
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+
+class AbstractTuple;
+
+namespace executor {
+
+class AbstractAttributeAggregator;
+
+/**
+ * Hash table that maps the group-by key of a tuple to the state of its group.
+ *
+ * The group-by values of a tuple are serialized into a byte key: fixed-width
+ * values take a null byte and 8 bytes, varlen values a null byte, a length
+ * and their bytes. The table uses open addressing with linear probing, and
+ * every slot keeps the hash of its key so that probing rarely has to touch
+ * the key and growing never rehashes it. If there is a single group-by
+ * column of an integer type, the key is the integer itself and is stored
+ * in the slot.
+ *
+ * The state of a group is a fixed-size block carved from an arena: a deep
+ * copy of the first tuple of the group, which is used for the pass-through
+ * columns, followed by the attribute aggregators, which are constructed in
+ * place. Keys are copied into a separate arena.
+ */
+class AggregateHashTable {
+ public:
+  AggregateHashTable(const AggregateHashTable &) = delete;
+  AggregateHashTable &operator=(const AggregateHashTable &) = delete;
+
+  AggregateHashTable(const std::vector<oid_t> &group_by_col_ids,
+                     const std::vector<planner::AggregatePlan::AggTerm> &aggs,
+                     size_t num_input_columns);
+
+  ~AggregateHashTable();
+
+  /*
+   * FindOrCreateGroup() - Return the group of the tuple, creating a new
+   *                       group if the tuple is the first of its group
+   */
+  char *FindOrCreateGroup(const AbstractTuple *tuple);
+
+  inline size_t GetGroupCount() const { return group_count_; }
+
+  // Groups are numbered in the order they were created
+  inline char *GetGroup(size_t group_idx) const {
+    PL_ASSERT(group_idx < group_count_);
+    return group_chunks_[group_idx / groups_per_chunk_] +
+           (group_idx % groups_per_chunk_) * group_size_;
+  }
+
+  // Values of the first tuple of the group, one per input column
+  inline type::Value *GetFirstTupleValues(char *group) const {
+    return reinterpret_cast<type::Value *>(group + sizeof(GroupHeader));
+  }
+
+  inline AbstractAttributeAggregator *GetAggregator(char *group,
+                                                    size_t aggno) const {
+    return reinterpret_cast<AbstractAttributeAggregator *>(
+        group + aggregator_offsets_[aggno]);
+  }
+
+  inline size_t GetAggregatorCount() const {
+    return aggregator_offsets_.size();
+  }
+
+ private:
+  // Serialized keys are compared with their hash, length and bytes
+  struct GroupHeader {
+    uint64_t hash;
+    const char *key;
+    size_t key_length;
+  };
+
+  // A slot is empty if it has no group
+  struct Slot {
+    uint64_t hash;
+    int64_t integer_key;
+    char *group;
+  };
+
+  static constexpr size_t INITIAL_SLOT_COUNT = 256;
+
+  static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+  // Serialize the group-by values of the tuple into key_buffer_
+  void SerializeKey(const AbstractTuple *tuple);
+
+  // Whether the group-by value is an integer, and if so its integer key
+  bool GetIntegerKey(const type::Value &value, int64_t &integer_key) const;
+
+  char *FindOrCreateIntegerGroup(const AbstractTuple *tuple,
+                                 const type::Value &value);
+
+  char *CreateGroup(const AbstractTuple *tuple, uint64_t hash,
+                    const char *key, size_t key_length);
+
+  // Double the number of slots
+  void Grow();
+
+  inline size_t GetSlotIndex(uint64_t hash) const {
+    return hash & (slots_.size() - 1);
+  }
+
+  const std::vector<oid_t> &group_by_col_ids_;
+
+  const std::vector<planner::AggregatePlan::AggTerm> &aggs_;
+
+  const size_t num_input_columns_;
+
+  // Whether the single group-by column holds integers. Decided on the first
+  // tuple, since the plan does not carry the input types
+  bool use_integer_key_ = false;
+
+  bool key_type_known_ = false;
+
+  // Group of the NULL key in integer key mode
+  char *null_group_ = nullptr;
+
+  std::vector<Slot> slots_;
+
+  size_t group_count_ = 0;
+
+  // Layout of a group
+  size_t group_size_;
+
+  size_t groups_per_chunk_;
+
+  std::vector<size_t> aggregator_offsets_;
+
+  // Arena of fixed-size group blocks
+  std::vector<char *> group_chunks_;
+
+  // Arena of serialized keys
+  std::vector<char *> key_chunks_;
+
+  size_t key_chunk_used_ = 0;
+
+  // Scratch space for the key of the current tuple
+  std::vector<char> key_buffer_;
+};
+
+}  // namespace executor
+}  // namespace peloton
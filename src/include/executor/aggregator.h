@@ -12,11 +12,11 @@
 
 #pragma once
 
-#include <unordered_map>
 #include <unordered_set>
 
 #include "common/container_tuple.h"
 #include "executor/abstract_executor.h"
+#include "executor/aggregate_hash_table.h"
 #include "planner/aggregate_plan.h"
 #include "type/value_factory.h"
 
@@ -229,6 +229,13 @@ class MinAggregator : public AbstractAttributeAggregator {
 AbstractAttributeAggregator *GetAttributeAggregatorInstance(
     ExpressionType agg_type);
 
+/** brief Construct an aggregator for the specified aggregate in storage */
+AbstractAttributeAggregator *GetAttributeAggregatorInstance(
+    ExpressionType agg_type, void *storage);
+
+/** brief Size of the aggregator for the specified aggregate */
+size_t GetAttributeAggregatorSize(ExpressionType agg_type);
+
 /*
  * Interface for an aggregator (not an an individual attribute aggregate)
  *
@@ -278,49 +285,11 @@ class HashAggregator : public AbstractAggregator {
  private:
   const size_t num_input_columns;
 
-  /** List of aggregates for a specific group. */
-  struct AggregateList {
-    // Keep a deep copy of the first tuple we met of this group
-    std::vector<type::Value> first_tuple_values;
-
-    // The aggregates for each column for this group
-    AbstractAttributeAggregator **aggregates;
-  };
-
-  /** Hash function of internal hash table */
-  struct ValueVectorHasher
-      : std::unary_function<std::vector<type::Value>, std::size_t> {
-    // Generate a 64-bit number for the a vector of value
-    size_t operator()(const std::vector<type::Value> &values) const {
-      size_t seed = 0;
-      for (auto v : values) {
-        v.HashCombine(seed);
-      }
-      return seed;
-    }
-  };
-
-  struct ValueVectorCmp {
-    bool operator()(const std::vector<type::Value> &lhs,
-                    const std::vector<type::Value> &rhs) const {
-      for (size_t i = 0; i < lhs.size() && i < rhs.size(); i++) {
-        if (lhs[i].CompareNotEquals(rhs[i]) == type::CMP_TRUE) return false;
-      }
-      if (lhs.size() == rhs.size()) return true;
-      return false;
-    }
-  };
-
-  // Default equal_to should works well
-  typedef std::unordered_map<std::vector<type::Value>, AggregateList *,
-                             ValueVectorHasher, ValueVectorCmp>
-      HashAggregateMapType;
-
-  /** @brief Group by key values used */
-  std::vector<type::Value> group_by_key_values;
+  /** @brief Groups and their aggregates */
+  AggregateHashTable aggregate_table;
 
-  /** @brief Hash table */
-  HashAggregateMapType aggregates_map;
+  /** @brief Values of the first tuple of the group being finalized */
+  std::vector<type::Value> first_tuple_values;
 };
 
 /**
@@ -0,0 +1,42 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// analyze_executor.h
+//
+// Identification: src/include/executor/analyze_executor.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "executor/abstract_executor.h"
+#include "planner/analyze_plan.h"
+
+namespace peloton {
+namespace executor {
+
+// Collect the statistics of the target table, or of every table outside the
+// catalog database, for the optimizer
+class AnalyzeExecutor : public AbstractExecutor {
+ public:
+  AnalyzeExecutor(const AnalyzeExecutor &) = delete;
+  AnalyzeExecutor &operator=(const AnalyzeExecutor &) = delete;
+  AnalyzeExecutor(AnalyzeExecutor &&) = delete;
+  AnalyzeExecutor &operator=(AnalyzeExecutor &&) = delete;
+
+  AnalyzeExecutor(const planner::AbstractPlan *node,
+                  ExecutorContext *executor_context);
+
+  ~AnalyzeExecutor() {}
+
+ protected:
+  bool DInit();
+
+  bool DExecute();
+};
+
+}  // namespace executor
+}  // namespace peloton
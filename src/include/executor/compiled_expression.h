@@ -0,0 +1,175 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression.h
+//
+// Identification: src/include/executor/compiled_expression.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace catalog {
+class Schema;
+}
+
+namespace expression {
+class AbstractExpression;
+}
+
+namespace storage {
+class TileGroup;
+}
+
+namespace executor {
+
+class ExecutorContext;
+class LogicalTile;
+
+/**
+ * An expression tree compiled into closures whose types are resolved when
+ * the tree is compiled.
+ *
+ * Comparisons, arithmetic, AND / OR / NOT, fixed-width columns, constants
+ * and parameters are supported. Every node becomes a closure that returns
+ * an unboxed integer, decimal, timestamp or CmpBool, specialized for its
+ * operator and operand types. Columns are read straight from tile storage,
+ * so evaluating a tuple neither builds type::Values nor dispatches through
+ * type::Type. Trees with anything else are not compiled, and the caller
+ * falls back to AbstractExpression::Evaluate().
+ *
+ * The results, NULL handling and errors follow the interpreter. Unlike the
+ * interpreter, AND and OR do not evaluate their right side once the left
+ * side decides the result.
+ *
+ * Columns are read from the tile group or logical tile last bound to their
+ * side, and tuples are given by their offsets in those tiles.
+ */
+class CompiledExpression {
+ public:
+  CompiledExpression(const CompiledExpression &) = delete;
+  CompiledExpression &operator=(const CompiledExpression &) = delete;
+
+  /*
+   * Compile() - Compile an expression over tuples of the given schemas,
+   *             or return nullptr if it is not supported. right_schema may
+   *             be nullptr if the expression only reads the left tuple.
+   */
+  static std::unique_ptr<CompiledExpression> Compile(
+      const expression::AbstractExpression *expr,
+      const catalog::Schema *left_schema, const catalog::Schema *right_schema,
+      ExecutorContext *executor_context);
+
+  /*
+   * Compile() - Compile the AND of several predicates
+   */
+  static std::unique_ptr<CompiledExpression> Compile(
+      const std::vector<const expression::AbstractExpression *> &conjuncts,
+      const catalog::Schema *left_schema, const catalog::Schema *right_schema,
+      ExecutorContext *executor_context);
+
+  /*
+   * Bind() - Read the columns of a side from a tile group or a logical
+   *          tile. Returns false if its columns are not stored as compiled,
+   *          in which case it must be evaluated by the interpreter.
+   */
+  bool Bind(oid_t tuple_idx, storage::TileGroup *tile_group);
+
+  bool Bind(oid_t tuple_idx, LogicalTile *tile);
+
+  type::Type::TypeId GetValueType() const { return value_type_; }
+
+  /*
+   * EvaluatePredicate() - Evaluate a boolean expression on the tuples at
+   *                       tuple_ids[0] and tuple_ids[1] of the bound tiles
+   */
+  inline type::CmpBool EvaluatePredicate(const oid_t *tuple_ids) const {
+    return boolean_(tuple_ids);
+  }
+
+  /*
+   * Evaluate() - Evaluate the expression into a value of GetValueType()
+   */
+  type::Value Evaluate(const oid_t *tuple_ids) const;
+
+  // Closures of the nodes, by the type of their result. They return false,
+  // or CMP_NULL, for NULL.
+  typedef std::function<bool(const oid_t *, int64_t &)> IntegerFunction;
+  typedef std::function<bool(const oid_t *, double &)> DecimalFunction;
+  typedef std::function<bool(const oid_t *, uint64_t &)> TimestampFunction;
+  typedef std::function<type::CmpBool(const oid_t *)> BooleanFunction;
+
+  // Where a column of the bound tile is read from
+  struct ColumnBinding {
+    oid_t tuple_idx;
+    oid_t column_id;
+    type::Type::TypeId column_type;
+
+    // The column of the tuple at offset 0, and the length of a tuple
+    const char *base = nullptr;
+    size_t stride = 0;
+
+    // Maps the tuple offsets of a logical tile to the base tile
+    const oid_t *position_list = nullptr;
+  };
+
+ private:
+  // A compiled node. Only the closure of value_type is set; integer types
+  // share one closure, and value_type gives their range.
+  struct Node {
+    type::Type::TypeId value_type = type::Type::INVALID;
+    IntegerFunction integer;
+    DecimalFunction decimal;
+    TimestampFunction timestamp;
+    BooleanFunction boolean;
+  };
+
+  CompiledExpression() {}
+
+  bool CompileNode(const expression::AbstractExpression *expr, Node &node);
+
+  bool CompileComparison(const expression::AbstractExpression *expr,
+                         Node &node);
+
+  bool CompileArithmetic(const expression::AbstractExpression *expr,
+                         Node &node);
+
+  bool CompileConjunction(ExpressionType type, std::vector<Node> &&children,
+                          Node &node);
+
+  bool CompileColumn(const expression::AbstractExpression *expr, Node &node);
+
+  bool CompileValue(const type::Value &value, Node &node);
+
+  const catalog::Schema *schemas_[2] = {nullptr, nullptr};
+
+  ExecutorContext *executor_context_ = nullptr;
+
+  // Bindings of the columns read by the closures, which keep pointers to
+  // them. A deque does not move its elements when it grows.
+  std::deque<ColumnBinding> bindings_;
+
+  type::Type::TypeId value_type_ = type::Type::INVALID;
+
+  IntegerFunction integer_;
+  DecimalFunction decimal_;
+  TimestampFunction timestamp_;
+  BooleanFunction boolean_;
+};
+
+}  // namespace executor
+}  // namespace peloton
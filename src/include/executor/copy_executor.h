@@ -18,6 +18,8 @@
 #include "wire/packet_manager.h"
 
 #define COPY_BUFFER_SIZE 65536
+// Bytes of the file each loader thread gets at least
+#define COPY_LOAD_CHUNK_SIZE (1 << 20)
 #define INVALID_COL_ID -1
 
 namespace peloton {
@@ -37,11 +39,20 @@ class CopyExecutor : public AbstractExecutor {
 
   inline size_t GetTotalBytesWritten() { return total_bytes_written; }
 
+  // By default a file is loaded with up to a thread per core
+  inline void SetLoadThreadCount(size_t load_thread_count) {
+    load_thread_count_ = load_thread_count;
+  }
+
  protected:
   bool DInit();
 
   bool DExecute();
 
+  // Load the rows of the file into the target table, with a thread per
+  // chunk of the file
+  bool ImportFile();
+
   // Initialize the column ids for query parameters
   void InitParamColIds();
 
@@ -79,6 +90,14 @@ class CopyExecutor : public AbstractExecutor {
   // Total number of bytes written
   size_t total_bytes_written = 0;
 
+  // The file to load, mapped into memory
+  char *file_data_ = nullptr;
+
+  size_t file_size_ = 0;
+
+  // The most threads loading the file, 0 for a thread per core
+  size_t load_thread_count_ = 0;
+
   // The special column ids in query_metric table
   unsigned int num_param_col_id = INVALID_COL_ID;
   unsigned int param_type_col_id = INVALID_COL_ID;
@@ -13,7 +13,7 @@
 
 #pragma once
 
-#include "type/ephemeral_pool.h"
+#include "type/arena_pool.h"
 #include "type/value.h"
 
 namespace peloton {
@@ -53,7 +53,7 @@ class ExecutorContext {
   void ClearParams();
 
   // Get a pool
-  type::EphemeralPool *GetPool();
+  type::ArenaPool *GetPool();
 
   // num of tuple processed
   uint32_t num_processed = 0;
@@ -70,7 +70,7 @@ class ExecutorContext {
   std::vector<type::Value> params_;
 
   // pool
-  std::unique_ptr<type::EphemeralPool> pool_;
+  std::unique_ptr<type::ArenaPool> pool_;
 
 };
 
@@ -37,6 +37,24 @@ class HashJoinExecutor : public AbstractJoinExecutor {
   bool DExecute();
 
  private:
+  /** @brief A pair of matching tuples of the left and right tiles */
+  struct JoinMatch {
+    uint32_t left_tile_idx;
+    oid_t left_tuple_id;
+    uint32_t right_tile_idx;
+    oid_t right_tuple_id;
+  };
+
+  void ProbeHashTable();
+
+  void BuildJoinTiles(const std::vector<JoinMatch> &matches);
+
+  /** @brief Whether left tuples without a match can be dropped early */
+  inline bool CanDropUnmatchedLeftRows() const {
+    return (join_type_ == JoinType::INNER || join_type_ == JoinType::RIGHT ||
+            join_type_ == JoinType::SEMI);
+  }
+
   HashExecutor *hash_executor_ = nullptr;
 
   bool hashed_ = false;
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "executor/abstract_scan_executor.h"
@@ -21,6 +22,7 @@ namespace peloton {
 
 namespace index {
 class Index;
+class IndexScanCursor;
 }
 
 namespace storage {
@@ -29,6 +31,10 @@ class AbstractTable;
 
 namespace executor {
 
+// The number of index entries the executor pulls from the index at a time.
+// The tuples of each batch are returned before the next one is read.
+#define INDEX_SCAN_BATCH_SIZE 1024
+
 class IndexScanExecutor : public AbstractScanExecutor {
   IndexScanExecutor(const IndexScanExecutor &) = delete;
   IndexScanExecutor &operator=(const IndexScanExecutor &) = delete;
@@ -53,13 +59,19 @@ class IndexScanExecutor : public AbstractScanExecutor {
   //===--------------------------------------------------------------------===//
   // Helper
   //===--------------------------------------------------------------------===//
+  // Pull the next batch of entries from the index, opening the scan on the
+  // first call. Return false once the index has no more entries
+  bool FetchIndexBatch();
+
+  // Build the result tiles from the visible versions of the entries of the
+  // last batch
   bool ExecPrimaryIndexLookup();
   bool ExecSecondaryIndexLookup();
 
   // When the required scan range has open boundaries, the tuples found by the
   // index might not be exact since the index can only give back tuples in a
-  // close range. This function prune the head and the tail of the returned
-  // tuple list to get the correct result.
+  // close range. This function prune the head of the first batch and the tail
+  // of every batch to get the correct result.
   void CheckOpenRangeWithReturnedTuples(
       std::vector<ItemPointer> &tuple_locations);
 
@@ -71,15 +83,21 @@ class IndexScanExecutor : public AbstractScanExecutor {
   // Executor State
   //===--------------------------------------------------------------------===//
 
-  /** @brief Result of index scan. */
+  /** @brief Result tiles of the last batch. */
   std::vector<LogicalTile *> result_;
 
   /** @brief Result itr */
   oid_t result_itr_ = INVALID_OID;
 
-  /** @brief Computed the result */
+  /** @brief The index has no more entries */
   bool done_ = false;
 
+  /** @brief Open scan on the index */
+  std::unique_ptr<index::IndexScanCursor> index_cursor_;
+
+  /** @brief Entries of the last batch */
+  std::vector<ItemPointer *> tuple_location_ptrs_;
+
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
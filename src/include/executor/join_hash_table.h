@@ -0,0 +1,189 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_hash_table.h
+//
+// Identification: src/include/executor/join_hash_table.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "type/types.h"
+
+namespace peloton {
+namespace executor {
+
+class LogicalTile;
+
+/**
+ * Bloom filter over the key hashes of the build side of a hash join.
+ *
+ * It only looks at the hash of a key, so a tuple can be checked against it
+ * without materializing anything but its key values. The scan that feeds
+ * the probe side uses it to drop tuples that cannot find a match.
+ */
+class JoinBloomFilter {
+ public:
+  // Size the filter for the given number of keys
+  void Init(size_t key_count);
+
+  inline void Insert(uint64_t hash) {
+    uint64_t step = (hash >> 32) | 1;
+    for (size_t i = 0; i < HASH_COUNT; i++) {
+      uint64_t bit = (hash + i * step) & bit_mask_;
+      words_[bit >> 6] |= UINT64_C(1) << (bit & 63);
+    }
+  }
+
+  inline bool MayContain(uint64_t hash) const {
+    uint64_t step = (hash >> 32) | 1;
+    for (size_t i = 0; i < HASH_COUNT; i++) {
+      uint64_t bit = (hash + i * step) & bit_mask_;
+      if ((words_[bit >> 6] & (UINT64_C(1) << (bit & 63))) == 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  static constexpr size_t BITS_PER_KEY = 8;
+
+  static constexpr size_t HASH_COUNT = 3;
+
+  std::vector<uint64_t> words_;
+
+  uint64_t bit_mask_ = 0;
+};
+
+/**
+ * Radix-partitioned hash table over the buffered tiles of the build side of
+ * a hash join.
+ *
+ * Tuples are split into partitions on the high bits of their key hash, and
+ * the number of partitions is chosen so that the hash table of a partition
+ * fits in the L2 cache. Every partition is a bucket array with chains
+ * threaded through its tuple array, so a partition holds no pointers and
+ * is built by a single thread without synchronization. The probe side is
+ * partitioned the same way, so that partitions can be probed in parallel.
+ *
+ * Tuples are referenced by the index of their tile in the buffered tiles
+ * and their tuple id in the tile.
+ */
+class JoinHashTable {
+ public:
+  JoinHashTable(const JoinHashTable &) = delete;
+  JoinHashTable &operator=(const JoinHashTable &) = delete;
+
+  JoinHashTable() {}
+
+  struct Entry {
+    uint64_t hash;
+    uint32_t tile_idx;
+    oid_t tuple_id;
+  };
+
+  typedef std::vector<std::vector<Entry>> PartitionedEntries;
+
+  /*
+   * Build() - Build the table over the visible tuples of the tiles. Tuples
+   *           whose key is held by an earlier tuple are added as well, and
+   *           are also returned in duplicates
+   */
+  void Build(const std::vector<std::unique_ptr<LogicalTile>> &tiles,
+             const std::vector<oid_t> &key_column_ids,
+             std::vector<Entry> &duplicates);
+
+  /*
+   * Partition() - Split the visible tuples of the tiles into the partitions
+   *               of the table. With use_filter, tuples whose key fails the
+   *               bloom filter are dropped
+   */
+  void Partition(const std::vector<std::unique_ptr<LogicalTile>> &tiles,
+                 const std::vector<oid_t> &key_column_ids, bool use_filter,
+                 PartitionedEntries &partitions) const;
+
+  /*
+   * FindMatches() - Call match on every tuple of the partition with the
+   *                 given hash. The caller compares the keys
+   */
+  template <typename MatchFunc>
+  inline void FindMatches(size_t partition_idx, uint64_t hash,
+                          MatchFunc match) const {
+    auto &partition = partitions_[partition_idx];
+    uint32_t entry_idx = partition.buckets[hash & partition.bucket_mask];
+    while (entry_idx != END_OF_CHAIN) {
+      auto &entry = partition.entries[entry_idx];
+      if (entry.hash == hash) {
+        match(entry);
+      }
+      entry_idx = partition.next[entry_idx];
+    }
+  }
+
+  inline size_t GetPartitionCount() const { return partitions_.size(); }
+
+  inline const JoinBloomFilter &GetBloomFilter() const {
+    return bloom_filter_;
+  }
+
+  // Mix the combined hash of the key values, whose high bits are weak
+  static inline uint64_t MixHash(size_t key_hash) {
+    uint64_t hash = static_cast<uint64_t>(key_hash);
+    hash ^= hash >> 33;
+    hash *= UINT64_C(0xff51afd7ed558ccd);
+    hash ^= hash >> 33;
+    hash *= UINT64_C(0xc4ceb9fe1a85ec53);
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+ private:
+  struct HashPartition {
+    std::vector<Entry> entries;
+    // Next entry in the chain of every entry
+    std::vector<uint32_t> next;
+    // First entry of every bucket
+    std::vector<uint32_t> buckets;
+    uint64_t bucket_mask = 0;
+  };
+
+  static constexpr uint32_t END_OF_CHAIN = UINT32_MAX;
+
+  static constexpr size_t L2_CACHE_SIZE = 256 * 1024;
+
+  static constexpr size_t MAX_RADIX_BITS = 10;
+
+  inline size_t GetPartitionIndex(uint64_t hash) const {
+    return (radix_bits_ == 0) ? 0 : (hash >> (64 - radix_bits_));
+  }
+
+  // Hash the keys of the visible tuples, one task per tile
+  static void HashTiles(const std::vector<std::unique_ptr<LogicalTile>> &tiles,
+                        const std::vector<oid_t> &key_column_ids,
+                        PartitionedEntries &tile_entries);
+
+  // Build the chains of a partition, collecting the duplicate keys
+  static void BuildPartition(
+      HashPartition &partition,
+      const std::vector<std::unique_ptr<LogicalTile>> &tiles,
+      const std::vector<oid_t> &key_column_ids,
+      std::vector<Entry> &duplicates);
+
+  size_t radix_bits_ = 0;
+
+  std::vector<HashPartition> partitions_;
+
+  JoinBloomFilter bloom_filter_;
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -73,6 +73,9 @@ class LogicalTile : public Printable {
   void AddColumns(const std::shared_ptr<storage::TileGroup> &tile_group,
                   const std::vector<oid_t> &column_ids);
 
+  void AddColumns(storage::TileGroup *tile_group,
+                  const std::vector<oid_t> &column_ids);
+
   void ProjectColumns(const std::vector<oid_t> &original_column_ids,
                       const std::vector<oid_t> &column_ids);
 
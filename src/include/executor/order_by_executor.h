@@ -12,16 +12,28 @@
 
 #pragma once
 
+#include <cstdio>
+
 #include "type/types.h"
 #include "executor/abstract_executor.h"
 #include "storage/tuple.h"
 
+// Bytes of sort keys and rows to keep in memory before spilling a sorted run
+#define ORDER_BY_MEMORY_BUDGET (64 * 1024 * 1024)
+
 namespace peloton {
 namespace executor {
 
 /**
  * @warning This is a pipeline breaker and a materialization point.
  *
+ * The sort keys of the tuples are encoded into byte strings that compare
+ * with memcmp() in the order of the tuples. With a limit, only the
+ * limit_offset_ + limit_number_ smallest keys are kept in a bounded heap.
+ * Without a limit, the input is sorted in memory up to the memory budget,
+ * and larger inputs are sorted into runs on disk that are merged when the
+ * output is produced.
+ *
  * TODO Currently, we store all input tiles and sort result in memory
  * until this executor is destroyed, which is sometimes necessary.
  * But can we let it release the RAM earlier as long as the executor
@@ -39,6 +51,12 @@ class OrderByExecutor : public AbstractExecutor {
 
   ~OrderByExecutor();
 
+  static void SetMemoryBudget(const size_t memory_budget) {
+    memory_budget_ = memory_budget;
+  }
+
+  static size_t GetMemoryBudget() { return memory_budget_; }
+
  protected:
   bool DInit();
 
@@ -47,32 +65,47 @@ class OrderByExecutor : public AbstractExecutor {
  private:
   bool DoSort();
 
+  // Append the normalized sort key of a tuple to key
+  void EncodeSortKey(LogicalTile *tile, oid_t tuple_id,
+                     std::string &key) const;
+
+  // Keep the key if it is one of the limit_offset_ + limit_number_ smallest
+  void AddTopKEntry(const std::string &key, const ItemPointer &item_pointer);
+
+  // Sort the buffered tuples and write them to a new run on disk
+  void SpillRun();
+
+  // Produce the next tile of the merged runs
+  bool MergeRuns();
+
   bool sort_done_ = false;
 
-  /**
-   * IMPORTANT This type must be move-constructible and move-assignable
-   * in order to be correctly sorted by STL sort
-   */
   struct sort_buffer_entry_t {
     ItemPointer item_pointer;
-    std::unique_ptr<storage::Tuple> tuple;
 
-    sort_buffer_entry_t(ItemPointer ipt, std::unique_ptr<storage::Tuple> &&tp)
-        : item_pointer(ipt), tuple(std::move(tp)) {}
+    // The sort key in sort_keys_
+    size_t key_offset;
+    size_t key_length;
+  };
+
+  // A tuple with its sort key, for the bounded heap of a limit
+  struct top_k_entry_t {
+    std::string key;
+    ItemPointer item_pointer;
+  };
 
-    sort_buffer_entry_t(sort_buffer_entry_t &&rhs) {
-      item_pointer = rhs.item_pointer;
-      tuple = std::move(rhs.tuple);
-    }
+  // A run of sorted tuples on disk, with the tuple it is at
+  struct sort_run_t {
+    FILE *file = nullptr;
+    std::string key;
+    std::string tuple;
 
-    sort_buffer_entry_t &operator=(sort_buffer_entry_t &&rhs) {
-      item_pointer = rhs.item_pointer;
-      tuple = std::move(rhs.tuple);
-      return *this;
+    ~sort_run_t() {
+      if (file != nullptr) fclose(file);
     }
 
-    sort_buffer_entry_t(const sort_buffer_entry_t &) = delete;
-    sort_buffer_entry_t &operator=(const sort_buffer_entry_t &) = delete;
+    // Read the next tuple, false at the end of the run
+    bool Next();
   };
 
   /** All tiles returned by child. */
@@ -84,8 +117,22 @@ class OrderByExecutor : public AbstractExecutor {
   /** All valid tuples in sorted order */
   std::vector<sort_buffer_entry_t> sort_buffer_;
 
-  /** Tuples in sort_buffer only contains the sort keys */
-  std::unique_ptr<catalog::Schema> sort_key_tuple_schema_;
+  /** The sort keys of the tuples in sort_buffer_ */
+  std::string sort_keys_;
+
+  /** Max-heap of the smallest keys, with a limit */
+  std::vector<top_k_entry_t> top_k_heap_;
+
+  /** Runs spilled to disk */
+  std::vector<std::unique_ptr<sort_run_t>> runs_;
+
+  /** Min-heap of the runs that are not exhausted, by their current key */
+  std::vector<sort_run_t *> merge_heap_;
+
+  /** Number of tuples in the runs */
+  size_t num_tuples_spilled_ = 0;
+
+  std::vector<oid_t> sort_key_ids_;
 
   std::vector<bool> descend_flags_;
 
@@ -109,6 +156,8 @@ class OrderByExecutor : public AbstractExecutor {
 
   // Copied from plan node
   uint64_t limit_offset_ = 0;
+
+  static size_t memory_budget_;
 };
 
 } /* namespace executor */
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "common/statement.h"
 #include "executor/abstract_executor.h"
 #include "type/types.h"
@@ -24,6 +26,10 @@ namespace bridge {
 // Plan Executor
 //===--------------------------------------------------------------------===//
 
+// Receives the result tiles of a plan one at a time, as the root executor
+// returns them. The tile is destroyed once the callback returns.
+typedef std::function<void(executor::LogicalTile *)> ResultTileCallback;
+
 typedef struct peloton_status {
   peloton::ResultType m_result;
   int *m_result_slots;
@@ -84,6 +90,23 @@ class PlanExecutor {
                                     std::vector<StatementResult> &result,
                                     const std::vector<int> &result_format);
 
+  /*
+   * @brief Same as above, but hands every result tile to result_callback
+   * instead of collecting the whole result, so that the caller can stream it
+   */
+  static peloton_status ExecutePlan(const planner::AbstractPlan *plan,
+                                    concurrency::Transaction *txn,
+                                    const std::vector<type::Value> &params,
+                                    const ResultTileCallback &result_callback);
+
+  /*
+   * @brief Append the visible rows of a result tile to result, as strings in
+   * the given formats, one StatementResult per column value
+   */
+  static void AddResultTile(executor::LogicalTile *logical_tile,
+                            const std::vector<int> &result_format,
+                            std::vector<StatementResult> &result);
+
   /*
    * @brief When a peloton node recvs a query plan, this function is invoked
    * @param plan and params
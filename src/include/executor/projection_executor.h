@@ -13,7 +13,11 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "executor/abstract_executor.h"
+#include "executor/compiled_expression.h"
 #include "planner/project_info.h"
 
 namespace peloton {
@@ -35,6 +39,13 @@ class ProjectionExecutor : public AbstractExecutor {
   bool DExecute();
 
  private:
+  // Compile the target list for the schema of the source tiles
+  void CompileTargets(LogicalTile *source_tile);
+
+  // Project a tuple with the compiled targets
+  void ProjectTuple(storage::Tuple *dest, LogicalTile *source_tile,
+                    oid_t tuple_id) const;
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -44,6 +55,11 @@ class ProjectionExecutor : public AbstractExecutor {
 
   /** @brief Schema of projected tuples. */
   const catalog::Schema *schema_ = nullptr;
+
+  /** @brief Compiled target list expressions, nullptr if not compiled. */
+  std::vector<std::unique_ptr<CompiledExpression>> compiled_targets_;
+
+  bool targets_compiled_ = false;
 };
 
 } /* namespace executor */
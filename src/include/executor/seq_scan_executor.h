@@ -12,8 +12,15 @@
 
 #pragma once
 
+#include <deque>
+#include <memory>
+#include <vector>
+
 #include "planner/seq_scan_plan.h"
 #include "executor/abstract_scan_executor.h"
+#include "executor/compiled_expression.h"
+#include "executor/join_hash_table.h"
+#include "executor/vectorized_predicate.h"
 
 namespace peloton {
 namespace executor {
@@ -28,7 +35,21 @@ class SeqScanExecutor : public AbstractScanExecutor {
   explicit SeqScanExecutor(const planner::AbstractPlan *node,
                            ExecutorContext *executor_context);
 
-  void ResetState() { current_tile_group_offset_ = START_OID; }
+  void ResetState() {
+    current_tile_group_offset_ = START_OID;
+    scanned_tile_groups_.clear();
+  }
+
+  /**
+   * @brief Drop tuples whose join key fails the bloom filter of a hash join.
+   * Only applies when scanning a table.
+   * @param key_column_ids Offsets of the key columns in the output tiles.
+   */
+  void SetJoinFilter(const JoinBloomFilter *join_filter,
+                     const std::vector<oid_t> *key_column_ids) {
+    join_filter_ = join_filter;
+    join_key_column_ids_ = key_column_ids;
+  }
 
  protected:
   bool DInit();
@@ -36,6 +57,32 @@ class SeqScanExecutor : public AbstractScanExecutor {
   bool DExecute();
 
  private:
+  /** @brief Scratch state of a thread that filters tile groups. */
+  struct ScanWorker {
+    std::unique_ptr<VectorizedPredicate> vectorized_predicate;
+    // The rest of the predicate, compiled when possible
+    std::unique_ptr<CompiledExpression> compiled_predicate;
+    std::vector<oid_t> visible_tuples;
+    std::vector<oid_t> selection_vector;
+    std::vector<oid_t> candidate_tuples;
+  };
+
+  /** @brief A filtered tile group, waiting to be returned. */
+  struct ScannedTileGroup {
+    storage::TileGroup *tile_group = nullptr;
+    std::vector<oid_t> position_list;
+  };
+
+  /** @brief Tile groups every worker filters before the scan gathers. */
+  static constexpr oid_t MORSELS_PER_WORKER = 4;
+
+  void ScanNextMorsels();
+
+  void FilterTileGroup(storage::TileGroup *tile_group, ScanWorker &worker,
+                       std::vector<oid_t> &position_list) const;
+
+  bool PassesJoinFilter(storage::TileGroup *tile_group, oid_t tuple_id) const;
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -52,6 +99,22 @@ class SeqScanExecutor : public AbstractScanExecutor {
 
   /** @brief Pointer to table to scan from. */
   storage::DataTable *target_table_ = nullptr;
+
+  /** @brief One worker per thread of the scan. */
+  std::vector<ScanWorker> workers_;
+
+  /** @brief Filtered tile groups, in table order. */
+  std::deque<ScannedTileGroup> scanned_tile_groups_;
+
+  /** @brief Bloom filter pushed down by a hash join, if any. */
+  const JoinBloomFilter *join_filter_ = nullptr;
+
+  const std::vector<oid_t> *join_key_column_ids_ = nullptr;
+
+  /** @brief Compiled predicate for the tiles of a child, if any. */
+  std::unique_ptr<CompiledExpression> compiled_child_predicate_;
+
+  bool child_predicate_compiled_ = false;
 };
 
 }  // namespace executor
@@ -0,0 +1,141 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// vectorized_predicate.h
+//
+// Identification: src/include/executor/vectorized_predicate.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+
+class AbstractTuple;
+
+namespace catalog {
+class Schema;
+}
+
+namespace expression {
+class AbstractExpression;
+}
+
+namespace storage {
+class TileGroup;
+}
+
+namespace executor {
+
+class ExecutorContext;
+
+/**
+ * Batch-at-a-time evaluation of a scan predicate over a tile group.
+ *
+ * The top-level conjuncts of the predicate that only compare a
+ * fixed-width column of the scanned table against a constant or a
+ * parameter (optionally combined with AND / OR) are evaluated on whole
+ * tile columns into a byte mask, which is then compacted into a selection
+ * vector of tuple offsets. The comparison loops read raw column storage
+ * without materializing a type::Value and are simple enough for the
+ * compiler to vectorize.
+ *
+ * All remaining conjuncts form the residual predicate, which the caller
+ * evaluates per tuple on the selected tuples only.
+ */
+class VectorizedPredicate {
+ public:
+  VectorizedPredicate(const VectorizedPredicate &) = delete;
+  VectorizedPredicate &operator=(const VectorizedPredicate &) = delete;
+
+  VectorizedPredicate(const expression::AbstractExpression *predicate,
+                      const catalog::Schema *schema,
+                      ExecutorContext *executor_context);
+
+  // Whether any part of the predicate can be evaluated on columns
+  inline bool IsVectorized() const { return root_.children.size() > 0; }
+
+  // Whether the residual predicate needs to be checked per tuple
+  inline bool HasResidual() const { return residual_.size() > 0; }
+
+  // The conjuncts of the residual predicate
+  inline const std::vector<const expression::AbstractExpression *> &
+  GetResidual() const {
+    return residual_;
+  }
+
+  /*
+   * Evaluate() - Collect the offsets of the tuples in [0, tuple_count)
+   *              that satisfy the vectorized part of the predicate
+   */
+  void Evaluate(storage::TileGroup *tile_group, oid_t tuple_count,
+                std::vector<oid_t> &selection_vector);
+
+  /*
+   * EvaluateResidual() - Evaluate the remaining conjuncts on a single tuple
+   */
+  bool EvaluateResidual(const AbstractTuple *tuple,
+                        ExecutorContext *executor_context) const;
+
+ private:
+  // Type in which a column and its operand are compared
+  enum class CompareDomain { INTEGER, DECIMAL, TIMESTAMP };
+
+  union Operand {
+    int64_t integer;
+    double decimal;
+    uint64_t timestamp;
+  };
+
+  // A comparison leaf, or an AND / OR over other nodes
+  struct Node {
+    ExpressionType type = ExpressionType::INVALID;
+    oid_t column_id = INVALID_OID;
+    type::Type::TypeId column_type = type::Type::INVALID;
+    CompareDomain domain = CompareDomain::INTEGER;
+    Operand operand;
+    std::vector<Node> children;
+  };
+
+  void AddConjunct(const expression::AbstractExpression *expr);
+
+  bool BuildNode(const expression::AbstractExpression *expr, Node &node);
+
+  bool BuildComparison(const expression::AbstractExpression *expr,
+                       Node &node);
+
+  bool GetOperandValue(const expression::AbstractExpression *expr,
+                       type::Value &value) const;
+
+  // Writes 1 for every tuple for which the node is true, 0 otherwise
+  void EvaluateNode(const Node &node, storage::TileGroup *tile_group,
+                    oid_t tuple_count, size_t depth, uint8_t *mask);
+
+  void EvaluateComparison(const Node &node, storage::TileGroup *tile_group,
+                          oid_t tuple_count, uint8_t *mask) const;
+
+  const catalog::Schema *schema_;
+
+  ExecutorContext *executor_context_;
+
+  // Vectorized conjuncts, combined with AND
+  Node root_;
+
+  // Conjuncts that are evaluated per tuple
+  std::vector<const expression::AbstractExpression *> residual_;
+
+  // Scratch masks, one per nesting level of the predicate tree
+  std::vector<std::vector<uint8_t>> masks_;
+};
+
+}  // namespace executor
+}  // namespace peloton
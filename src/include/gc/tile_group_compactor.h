@@ -0,0 +1,126 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor.h
+//
+// Identification: src/include/gc/tile_group_compactor.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cmath>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "type/types.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+class TileGroup;
+}
+
+namespace gc {
+
+// A full tile group is compacted once its live tuples fill no more than
+// this fraction of its slots
+#define COMPACTION_FILL_THRESHOLD 0.25
+
+// Time between two compaction passes of the GC
+#define COMPACTION_INTERVAL_MS 1000
+
+/**
+ * Moves the live tuples out of sparse tile groups and gives their memory
+ * back.
+ *
+ * The GC only reuses the slots it can keep in its recycle queues, so after
+ * heavy deletes a table keeps tile groups that are mostly empty. The GC
+ * counts the free slots of each tile group as it resets and hands them out,
+ * and passes a tile group to AddCandidate() once at most
+ * COMPACTION_FILL_THRESHOLD of its slots are not free. A pass over a table
+ * only looks at these candidates, and takes each of them through three
+ * steps:
+ *
+ * 1. A full tile group whose live tuples fill at most
+ *    COMPACTION_FILL_THRESHOLD of its slots is picked. The GC stops
+ *    handing out its free slots.
+ * 2. Once every transaction that was running when it was picked has ended,
+ *    a transaction updates each of its live tuples with an identical copy
+ *    in another tile group. The new version takes over the indirection of
+ *    the old one, so the indexes, which point to the indirection, find the
+ *    tuple without being changed.
+ * 3. Once the GC has reset every slot, including the old versions left by
+ *    step 2, the tile group is replaced in the catalog::Manager by an empty
+ *    tile group with one slot and the same id. The tiles and the header of
+ *    the old one go back through StorageManager::Release() when the last
+ *    reader drops it. The table keeps the id, so the offsets of its other
+ *    tile groups don't move under concurrent scans.
+ *
+ * A candidate is dropped once it is released, or once it has neither been
+ * picked nor enough free slots.
+ *
+ * Only tables with an index are compacted, as the tuples of the others have
+ * no indirection. Passes are serialized; the GC runs one every
+ * COMPACTION_INTERVAL_MS and records the fragmentation of each table in its
+ * stats::TableMetric.
+ */
+class TileGroupCompactor {
+ public:
+  TileGroupCompactor(const TileGroupCompactor &) = delete;
+  TileGroupCompactor &operator=(const TileGroupCompactor &) = delete;
+
+  static TileGroupCompactor &GetInstance();
+
+  // Run a pass over the tables of all databases
+  void CompactTables();
+
+  // Run a pass over a table. Returns the number of tile groups released.
+  size_t CompactTable(storage::DataTable *table);
+
+  // Called by the GC when the free slots of a tile group reach
+  // GetCandidateFreeSlotCount()
+  void AddCandidate(const oid_t table_id, const oid_t tile_group_id);
+
+  // Number of free slots at which a tile group of slot_count slots becomes
+  // a candidate
+  static size_t GetCandidateFreeSlotCount(const size_t slot_count) {
+    return static_cast<size_t>(
+        std::ceil((1 - COMPACTION_FILL_THRESHOLD) * slot_count));
+  }
+
+ private:
+  TileGroupCompactor() {}
+
+  // Record the fragmentation of the table from the counters of its tile
+  // groups
+  void RecordFragmentation(storage::DataTable *table,
+                           int64_t relocated_tuple_count,
+                           size_t released_tile_group_count);
+
+  // Move the live tuples to other tile groups. Returns false if the
+  // transaction moving them failed.
+  bool RelocateTuples(storage::DataTable *table,
+                      storage::TileGroup *tile_group);
+
+  void ReleaseTileGroup(storage::TileGroup *tile_group);
+
+  std::mutex compaction_mutex_;
+
+  // Candidate tile groups of each table
+  std::mutex candidate_mutex_;
+  std::unordered_map<oid_t, std::unordered_set<oid_t>> candidate_tile_groups_;
+
+  // Picked tile groups that were found without any used slot once. They are
+  // released if they are still empty after the transactions running at that
+  // time have ended.
+  std::unordered_set<oid_t> drained_tile_groups_;
+};
+
+}  // namespace gc
+}  // namespace peloton
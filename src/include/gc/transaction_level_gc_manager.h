@@ -134,7 +134,8 @@ private:
 
   void DeleteFromIndexes(const std::shared_ptr<GarbageContext>& garbage_ctx);
 
-  void DeleteTupleFromIndexes(ItemPointer *indirection);
+  void DeleteTupleFromIndexes(storage::TileGroup *tile_group,
+                              const oid_t &tuple_id);
 
 private:
   //===--------------------------------------------------------------------===//
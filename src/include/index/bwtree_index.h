@@ -93,6 +93,13 @@ class BWTreeIndex : public Index {
 
   void ScanAllKeys(std::vector<ValueType> &result);
 
+  std::unique_ptr<IndexScanCursor> OpenScan(
+      const std::vector<type::Value> &values,
+      const std::vector<oid_t> &key_column_ids,
+      const std::vector<ExpressionType> &expr_types,
+      ScanDirectionType scan_direction,
+      const ConjunctionScanPredicate *csp_p);
+
   void ScanKey(const storage::Tuple *key,
                std::vector<ValueType> &result);
 
@@ -0,0 +1,195 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index.h
+//
+// Identification: src/include/index/hash_index.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <string>
+#include <map>
+
+#include "catalog/manager.h"
+#include "common/platform.h"
+#include "type/types.h"
+#include "index/index.h"
+
+#include "libcuckoo/cuckoohash_map.hh"
+
+#define HASH_INDEX_TYPE                                               \
+  HashIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker, \
+            KeyHashFunc, ValueEqualityChecker>
+
+#define HASH_INDEX_TEMPLATE_ARGUMENTS                                     \
+  template <typename KeyType, typename ValueType, typename KeyComparator, \
+            typename KeyEqualityChecker, typename KeyHashFunc,            \
+            typename ValueEqualityChecker>
+
+namespace peloton {
+namespace index {
+
+/*
+ * class HashValueList - Values mapped by a single key of a hash index
+ *
+ * Hash indexes are mostly built on primary and unique keys where a key
+ * maps to exactly one value. The first value is therefore stored inline in
+ * the hash table slot, and only additional values spill into a vector
+ */
+template <typename ValueType>
+class HashValueList {
+ public:
+  HashValueList() : size{0}, first_value{} {}
+
+  explicit HashValueList(const ValueType &value)
+      : size{1}, first_value{value} {}
+
+  inline size_t GetSize() const { return size; }
+
+  inline const ValueType &GetValue(size_t index) const {
+    PL_ASSERT(index < size);
+    return (index == 0) ? first_value : overflow_values[index - 1];
+  }
+
+  inline void Append(const ValueType &value) {
+    if (size == 0) {
+      first_value = value;
+    } else {
+      overflow_values.push_back(value);
+    }
+    size++;
+  }
+
+  /*
+   * Remove() - Remove the value at the given index
+   *
+   * The order of values is not preserved
+   */
+  inline void Remove(size_t index) {
+    PL_ASSERT(index < size);
+    if (size > 1) {
+      const ValueType &last_value = overflow_values.back();
+      if (index == 0) {
+        first_value = last_value;
+      } else {
+        overflow_values[index - 1] = last_value;
+      }
+      overflow_values.pop_back();
+    }
+    size--;
+  }
+
+  // Number of bytes allocated outside of the hash table slot
+  inline size_t GetOverflowBytes() const {
+    return overflow_values.capacity() * sizeof(ValueType);
+  }
+
+ private:
+  size_t size;
+  ValueType first_value;
+  std::vector<ValueType> overflow_values;
+};
+
+/**
+ * Hash index implementation on top of libcuckoo.
+ *
+ * Only equality lookups are answered from the hash table. Range and
+ * full scans walk the whole table under libcuckoo's table lock and filter
+ * keys with KeyComparator, and return tuples in no particular order, so
+ * the optimizer should prefer an ordered index for those predicates.
+ *
+ * libcuckoo has no conditional erase, so writers of the same key are
+ * serialized on a striped spinlock. This makes removing a key whose
+ * last value was deleted, and conditional insert, atomic with respect to
+ * other writers. Readers only take libcuckoo's bucket locks.
+ *
+ * @see Index
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator,
+          typename KeyEqualityChecker, typename KeyHashFunc,
+          typename ValueEqualityChecker>
+class HashIndex : public Index {
+  friend class IndexFactory;
+
+  using ValueList = HashValueList<ValueType>;
+
+  using MapType =
+      cuckoohash_map<KeyType, ValueList, KeyHashFunc, KeyEqualityChecker>;
+
+  // Number of key slots allocated when the index is created. The table
+  // is expanded by libcuckoo as it fills up
+  static constexpr size_t INITIAL_SIZE = 1024;
+
+  // Number of striped write locks
+  static constexpr size_t LOCK_STRIPE_COUNT = 1024;
+
+ public:
+  HashIndex(IndexMetadata *metadata);
+
+  ~HashIndex();
+
+  bool InsertEntry(const storage::Tuple *key, ItemPointer *value);
+
+  bool DeleteEntry(const storage::Tuple *key, ItemPointer *value);
+
+  bool CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
+                       std::function<bool(const void *)> predicate);
+
+  void Scan(const std::vector<type::Value> &values,
+            const std::vector<oid_t> &key_column_ids,
+            const std::vector<ExpressionType> &expr_types,
+            ScanDirectionType scan_direction, std::vector<ValueType> &result,
+            const ConjunctionScanPredicate *csp_p);
+
+  void ScanLimit(const std::vector<type::Value> &values,
+                 const std::vector<oid_t> &key_column_ids,
+                 const std::vector<ExpressionType> &expr_types,
+                 ScanDirectionType scan_direction,
+                 std::vector<ValueType> &result,
+                 const ConjunctionScanPredicate *csp_p, uint64_t limit,
+                 uint64_t offset);
+
+  void ScanAllKeys(std::vector<ValueType> &result);
+
+  void ScanKey(const storage::Tuple *key, std::vector<ValueType> &result);
+
+  std::string GetTypeName() const;
+
+  size_t GetMemoryFootprint();
+
+  // Memory is freed by libcuckoo as soon as an entry is erased
+  bool NeedGC() { return false; }
+
+  void PerformGC() { return; }
+
+ protected:
+  inline Spinlock &GetWriteLock(const KeyType &key) {
+    return write_locks[hash_func(key) % LOCK_STRIPE_COUNT];
+  }
+
+  // Appends the values of the key to result without copying the list
+  void GetValue(const KeyType &key, std::vector<ValueType> &result);
+
+  // equality checker, comparator and hash function
+  KeyComparator comparator;
+  KeyEqualityChecker equals;
+  KeyHashFunc hash_func;
+
+  // Bytes allocated by value lists outside of the table
+  std::atomic<size_t> overflow_bytes;
+
+  // container
+  MapType container;
+
+  Spinlock write_locks[LOCK_STRIPE_COUNT];
+};
+
+}  // End index namespace
+}  // End peloton namespace
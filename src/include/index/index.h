@@ -17,6 +17,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "common/item_pointer.h"
@@ -191,6 +192,46 @@ class IndexMetadata : public Printable {
   static bool index_default_visibility;
 };
 
+/////////////////////////////////////////////////////////////////////
+// IndexScanCursor class definition
+/////////////////////////////////////////////////////////////////////
+
+/*
+ * class IndexScanCursor - Hands out the entries of an index scan in batches
+ *
+ * The caller pulls the next batch whenever it is ready for more entries,
+ * so that the entries of a large range never have to be held all at once,
+ * and a scan whose consumer is satisfied early just stops. The predicate
+ * the scan is opened with must outlive the cursor.
+ */
+class IndexScanCursor {
+ public:
+  virtual ~IndexScanCursor() {}
+
+  // Append at most batch_size entries to the result. Return false once the
+  // scan has no more entries
+  virtual bool Next(std::vector<ItemPointer *> &result, size_t batch_size) = 0;
+};
+
+/*
+ * class ResultScanCursor - A cursor over entries already collected
+ *
+ * Indices that cannot suspend a scan collect the entries first and hand
+ * them out through this cursor
+ */
+class ResultScanCursor : public IndexScanCursor {
+ public:
+  ResultScanCursor(std::vector<ItemPointer *> entries)
+      : entries_(std::move(entries)) {}
+
+  bool Next(std::vector<ItemPointer *> &result, size_t batch_size);
+
+ private:
+  std::vector<ItemPointer *> entries_;
+
+  size_t next_entry_ = 0;
+};
+
 /////////////////////////////////////////////////////////////////////
 // Index class definition
 /////////////////////////////////////////////////////////////////////
@@ -280,6 +321,15 @@ class Index : public Printable {
 
   virtual void ScanAllKeys(std::vector<ItemPointer *> &result) = 0;
 
+  // Open a cursor over the entries Scan() would return, or over all the
+  // entries if csp_p is nullptr. By default the entries are collected up
+  // front; ordered indices override this to read them as they are pulled
+  virtual std::unique_ptr<IndexScanCursor> OpenScan(
+      const std::vector<type::Value> &value_list,
+      const std::vector<oid_t> &tuple_column_id_list,
+      const std::vector<ExpressionType> &expr_list,
+      ScanDirectionType scan_direction, const ConjunctionScanPredicate *csp_p);
+
   virtual void ScanKey(const storage::Tuple *key,
                        std::vector<ItemPointer *> &result) = 0;
 
@@ -47,6 +47,14 @@ class IndexFactory {
   static Index *GetSkipListIntsKeyIndex(IndexMetadata *metadata);
 
   static Index *GetSkipListGenericKeyIndex(IndexMetadata *metadata);
+
+  //===--------------------------------------------------------------------===//
+  // PELOTON::HASH
+  //===--------------------------------------------------------------------===//
+
+  static Index *GetHashIntsKeyIndex(IndexMetadata *metadata);
+
+  static Index *GetHashGenericKeyIndex(IndexMetadata *metadata);
 };
 
 }  // End index namespace
@@ -12,6 +12,16 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+
 namespace peloton {
 namespace index {
 
@@ -21,10 +31,916 @@ namespace index {
 #define SKIPLIST_TEMPLATE_ARGUMENTS                                       \
   template <typename KeyType, typename ValueType, typename KeyComparator, \
             typename KeyEqualityChecker, typename ValueEqualityChecker>
+
+/*
+ * class SkipList - Lock-free concurrent skip list multimap
+ *
+ * Every distinct key is stored in exactly one tower node. The values mapped
+ * by a key live in an immutable value list hanging off the node; writers
+ * build a new list and CAS it onto the node, so all modifications to the
+ * same key (including conditional insert) are serialized by a single CAS.
+ *
+ * When the last value of a key is removed, the value list pointer is CASed
+ * to nullptr, which makes the node logically deleted. The deleting thread
+ * then marks the next pointers of the tower top-down and unlinks it
+ * (Herlihy-Shavit style). Unlinked nodes and replaced value lists are
+ * handed to an epoch based garbage collector and are only freed after all
+ * threads that could have observed them have left their epoch.
+ *
+ * Garbage collection is not done by an internal thread; the owner of the
+ * skip list should call PerformGarbageCollection() periodically (the index
+ * wrapper exposes this through Index::PerformGC()).
+ */
 template <typename KeyType, typename ValueType, typename KeyComparator,
           typename KeyEqualityChecker, typename ValueEqualityChecker>
 class SkipList {
-  // TODO: Add your declarations here
+ public:
+  class ForwardIterator;
+
+  using KeyValuePair = std::pair<KeyType, ValueType>;
+
+  // Maximum height of a tower. With the promotion probability of 1/4
+  // used by GetRandomHeight() this is enough for 4^16 keys
+  static constexpr int MAX_HEIGHT = 16;
+
+  // Used to pad per-epoch counters into separate cache lines
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+ private:
+  /*
+   * struct ValueList - Immutable list of values mapped by a single key
+   *
+   * The value array is allocated inline with the header
+   */
+  struct ValueList {
+    size_t size;
+    ValueType values[1];
+  };
+
+  /*
+   * struct SkipListNode - A tower in the skip list
+   *
+   * The array of next pointers is allocated inline and has exactly
+   * height elements. The lowest bit of a next pointer is used as the
+   * deletion mark of that level
+   */
+  struct SkipListNode {
+    KeyType key;
+
+    // nullptr means the node is logically deleted
+    std::atomic<const ValueList *> value_list_p;
+
+    int height;
+
+    // Set after the node has been linked on all levels. A node must
+    // not be marked for deletion before this is set
+    std::atomic<bool> fully_linked;
+
+    std::atomic<SkipListNode *> next_p[1];
+
+    SkipListNode(const KeyType &p_key, int p_height)
+        : key{p_key},
+          value_list_p{nullptr},
+          height{p_height},
+          fully_linked{false} {
+      for (int level = 1; level < height; level++) {
+        new (&next_p[level]) std::atomic<SkipListNode *>{nullptr};
+      }
+      next_p[0].store(nullptr);
+    }
+  };
+
+  /*
+   * class EpochManager - Defers freeing of unlinked memory
+   *
+   * The global epoch counter only moves forward. A thread joins the
+   * current epoch by incrementing the counter of its slot (epoch % 3) and
+   * re-validating the global epoch. Garbage is attached to the slot of the
+   * epoch in which it was retired, and the slot is freed when the global
+   * epoch is advanced onto it again, i.e. two epochs after all threads of
+   * the retire epoch and the epoch before it have left.
+   */
+  class EpochManager {
+   public:
+    static constexpr int EPOCH_SLOT_COUNT = 3;
+
+    /*
+     * struct GarbageNode - A linked list of garbages
+     *
+     * Exactly one of node_p and value_list_p is not nullptr
+     */
+    struct GarbageNode {
+      SkipListNode *node_p;
+      const ValueList *value_list_p;
+      GarbageNode *next_p;
+    };
+
+    /*
+     * struct EpochSlot - Thread counter and garbage list of an epoch
+     *
+     * Slots are padded to avoid false sharing between epochs
+     */
+    struct EpochSlot {
+      std::atomic<int> active_thread_count;
+      std::atomic<GarbageNode *> garbage_list_p;
+      char padding[CACHE_LINE_SIZE - sizeof(std::atomic<int>) -
+                   sizeof(std::atomic<GarbageNode *>)];
+    };
+
+    EpochManager(SkipList *p_list_p)
+        : list_p{p_list_p}, global_epoch{0}, gc_running{false} {
+      for (int i = 0; i < EPOCH_SLOT_COUNT; i++) {
+        slots[i].active_thread_count.store(0);
+        slots[i].garbage_list_p.store(nullptr);
+      }
+    }
+
+    /*
+     * Destructor - Frees all remaining garbage
+     *
+     * No thread could be using the skip list at this point
+     */
+    ~EpochManager() {
+      for (int i = 0; i < EPOCH_SLOT_COUNT; i++) {
+        FreeGarbageList(slots[i].garbage_list_p.exchange(nullptr));
+      }
+    }
+
+    /*
+     * JoinEpoch() - Let current thread join the current epoch
+     *
+     * Memory retired on or after the returned epoch will not be freed
+     * before LeaveEpoch() is called with it
+     */
+    inline uint64_t JoinEpoch() {
+      while (true) {
+        uint64_t epoch = global_epoch.load();
+        EpochSlot &slot = slots[epoch % EPOCH_SLOT_COUNT];
+        slot.active_thread_count.fetch_add(1);
+
+        // If the epoch has moved on between the load and the increment
+        // then the slot might already be in use for a later epoch
+        if (global_epoch.load() == epoch) {
+          return epoch;
+        }
+
+        slot.active_thread_count.fetch_sub(1);
+      }
+    }
+
+    /*
+     * LeaveEpoch() - Leave an epoch a thread has once joined
+     */
+    inline void LeaveEpoch(uint64_t epoch) {
+      slots[epoch % EPOCH_SLOT_COUNT].active_thread_count.fetch_sub(1);
+    }
+
+    /*
+     * AddGarbageNode() - Retire a node or a value list
+     *
+     * The caller must be inside an epoch, which guarantees that the slot
+     * of the current epoch is not being freed concurrently
+     */
+    void AddGarbageNode(SkipListNode *node_p, const ValueList *value_list_p) {
+      GarbageNode *garbage_node_p = new GarbageNode{node_p, value_list_p,
+                                                    nullptr};
+
+      EpochSlot &slot = slots[global_epoch.load() % EPOCH_SLOT_COUNT];
+      garbage_node_p->next_p = slot.garbage_list_p.load();
+      while (slot.garbage_list_p.compare_exchange_weak(
+                 garbage_node_p->next_p, garbage_node_p) == false) {
+        // next_p has been updated with the current head; retry
+      }
+    }
+
+    /*
+     * NeedGarbageCollection() - Whether there is any retired memory
+     */
+    bool NeedGarbageCollection() const {
+      for (int i = 0; i < EPOCH_SLOT_COUNT; i++) {
+        if (slots[i].garbage_list_p.load() != nullptr) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /*
+     * PerformGarbageCollection() - Try to advance the global epoch
+     *
+     * The epoch can only be advanced if no thread is still in the previous
+     * epoch. On success the garbage retired two epochs ago (which shares
+     * the slot of the new epoch) is freed. Only one thread does this at
+     * a time; concurrent callers simply return
+     */
+    void PerformGarbageCollection() {
+      bool expected = false;
+      if (gc_running.compare_exchange_strong(expected, true) == false) {
+        return;
+      }
+
+      uint64_t epoch = global_epoch.load();
+      EpochSlot &prev_slot =
+          slots[(epoch + EPOCH_SLOT_COUNT - 1) % EPOCH_SLOT_COUNT];
+
+      if (prev_slot.active_thread_count.load() == 0) {
+        EpochSlot &next_slot = slots[(epoch + 1) % EPOCH_SLOT_COUNT];
+
+        // Detach the garbage before publishing the new epoch, since after
+        // that worker threads start retiring into this slot again
+        GarbageNode *garbage_list_p = next_slot.garbage_list_p.exchange(nullptr);
+        global_epoch.store(epoch + 1);
+
+        FreeGarbageList(garbage_list_p);
+      }
+
+      gc_running.store(false);
+    }
+
+   private:
+    void FreeGarbageList(GarbageNode *garbage_node_p) {
+      while (garbage_node_p != nullptr) {
+        GarbageNode *next_p = garbage_node_p->next_p;
+
+        if (garbage_node_p->node_p != nullptr) {
+          list_p->FreeNode(garbage_node_p->node_p);
+        } else {
+          list_p->FreeValueList(garbage_node_p->value_list_p);
+        }
+
+        delete garbage_node_p;
+        garbage_node_p = next_p;
+      }
+    }
+
+    SkipList *list_p;
+    std::atomic<uint64_t> global_epoch;
+    std::atomic<bool> gc_running;
+    EpochSlot slots[EPOCH_SLOT_COUNT];
+  };
+
+ public:
+  /*
+   * Constructor
+   */
+  SkipList(KeyComparator p_key_cmp_obj = KeyComparator{},
+           KeyEqualityChecker p_key_eq_obj = KeyEqualityChecker{},
+           ValueEqualityChecker p_value_eq_obj = ValueEqualityChecker{})
+      : key_cmp_obj{p_key_cmp_obj},
+        key_eq_obj{p_key_eq_obj},
+        value_eq_obj{p_value_eq_obj},
+        memory_footprint{0},
+        epoch_manager{this} {
+    head_node_p = CreateNode(KeyType{}, MAX_HEIGHT);
+  }
+
+  /*
+   * Destructor - Frees all nodes and value lists still reachable
+   *
+   * Memory that has already been unlinked is freed by the epoch manager
+   */
+  ~SkipList() {
+    SkipListNode *node_p = GetUnmarked(head_node_p->next_p[0].load());
+    while (node_p != nullptr) {
+      SkipListNode *next_p = GetUnmarked(node_p->next_p[0].load());
+
+      // Nodes whose next pointer is marked have been (or are being) retired
+      if (IsMarked(node_p->next_p[0].load()) == false) {
+        const ValueList *value_list_p = node_p->value_list_p.load();
+        if (value_list_p != nullptr) {
+          FreeValueList(value_list_p);
+        }
+        FreeNode(node_p);
+      }
+
+      node_p = next_p;
+    }
+
+    FreeNode(head_node_p);
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Key and value comparison
+  ///////////////////////////////////////////////////////////////////
+
+  inline bool KeyCmpLess(const KeyType &key1, const KeyType &key2) const {
+    return key_cmp_obj(key1, key2);
+  }
+
+  inline bool KeyCmpEqual(const KeyType &key1, const KeyType &key2) const {
+    return key_eq_obj(key1, key2);
+  }
+
+  inline bool KeyCmpLessEqual(const KeyType &key1, const KeyType &key2) const {
+    return KeyCmpLess(key2, key1) == false;
+  }
+
+  inline bool ValueCmpEqual(const ValueType &v1, const ValueType &v2) const {
+    return value_eq_obj(v1, v2);
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Modification
+  ///////////////////////////////////////////////////////////////////
+
+  /*
+   * Insert() - Insert a key-value pair
+   *
+   * Returns false if the exact key-value pair already exists
+   */
+  bool Insert(const KeyType &key, const ValueType &value) {
+    bool predicate_satisfied = false;
+    return ConditionalInsert(key, value,
+                             [](const void *) { return false; },
+                             &predicate_satisfied);
+  }
+
+  /*
+   * ConditionalInsert() - Insert a key-value pair if no existing value of
+   *                       the key satisfies the predicate
+   *
+   * If the predicate is satisfied by any existing value then
+   * *predicate_satisfied is set to true and false is returned. If the
+   * key-value pair already exists false is returned as well
+   */
+  bool ConditionalInsert(const KeyType &key, const ValueType &value,
+                         std::function<bool(const void *)> predicate,
+                         bool *predicate_satisfied) {
+    uint64_t epoch = epoch_manager.JoinEpoch();
+
+    SkipListNode *preds[MAX_HEIGHT];
+    SkipListNode *succs[MAX_HEIGHT];
+
+    // Allocated lazily and reused if the insert CAS fails
+    SkipListNode *new_node_p = nullptr;
+    bool ret = false;
+
+    *predicate_satisfied = false;
+
+    while (true) {
+      if (FindNode(key, preds, succs) == true) {
+        SkipListNode *node_p = succs[0];
+        const ValueList *value_list_p = node_p->value_list_p.load();
+
+        // The node is being removed by another thread. Retry until it has
+        // been unlinked and then insert a new node
+        if (value_list_p == nullptr) {
+          continue;
+        }
+
+        bool found = false;
+        for (size_t i = 0; i < value_list_p->size; i++) {
+          if (predicate(value_list_p->values[i]) == true) {
+            *predicate_satisfied = true;
+            found = true;
+            break;
+          }
+
+          if (ValueCmpEqual(value_list_p->values[i], value) == true) {
+            found = true;
+            break;
+          }
+        }
+
+        if (found == true) {
+          ret = false;
+          break;
+        }
+
+        const ValueList *new_value_list_p =
+            CopyValueList(value_list_p, value_list_p->size, &value);
+        if (node_p->value_list_p.compare_exchange_strong(
+                value_list_p, new_value_list_p) == true) {
+          epoch_manager.AddGarbageNode(nullptr, value_list_p);
+          ret = true;
+          break;
+        }
+
+        FreeValueList(new_value_list_p);
+        continue;
+      }
+
+      if (new_node_p == nullptr) {
+        new_node_p = CreateNode(key, GetRandomHeight());
+        new_node_p->value_list_p.store(CopyValueList(nullptr, 0, &value));
+      }
+
+      for (int level = 0; level < new_node_p->height; level++) {
+        new_node_p->next_p[level].store(succs[level]);
+      }
+
+      // The node becomes visible once it is linked on the lowest level
+      SkipListNode *expected_p = succs[0];
+      if (preds[0]->next_p[0].compare_exchange_strong(expected_p,
+                                                      new_node_p) == false) {
+        continue;
+      }
+
+      LinkUpperLevels(new_node_p, preds, succs);
+
+      new_node_p = nullptr;
+      ret = true;
+      break;
+    }
+
+    // The key has been inserted by another thread in the meantime
+    if (new_node_p != nullptr) {
+      FreeValueList(new_node_p->value_list_p.load());
+      FreeNode(new_node_p);
+    }
+
+    epoch_manager.LeaveEpoch(epoch);
+    return ret;
+  }
+
+  /*
+   * Delete() - Remove a key-value pair
+   *
+   * Returns false if the key-value pair does not exist
+   */
+  bool Delete(const KeyType &key, const ValueType &value) {
+    uint64_t epoch = epoch_manager.JoinEpoch();
+
+    SkipListNode *preds[MAX_HEIGHT];
+    SkipListNode *succs[MAX_HEIGHT];
+    bool ret = false;
+
+    while (true) {
+      if (FindNode(key, preds, succs) == false) {
+        ret = false;
+        break;
+      }
+
+      SkipListNode *node_p = succs[0];
+      const ValueList *value_list_p = node_p->value_list_p.load();
+
+      // Another thread has removed the last value
+      if (value_list_p == nullptr) {
+        ret = false;
+        break;
+      }
+
+      size_t value_index = value_list_p->size;
+      for (size_t i = 0; i < value_list_p->size; i++) {
+        if (ValueCmpEqual(value_list_p->values[i], value) == true) {
+          value_index = i;
+          break;
+        }
+      }
+
+      if (value_index == value_list_p->size) {
+        ret = false;
+        break;
+      }
+
+      const ValueList *new_value_list_p = nullptr;
+      if (value_list_p->size > 1) {
+        new_value_list_p = CopyValueList(value_list_p, value_index, nullptr);
+      }
+
+      if (node_p->value_list_p.compare_exchange_strong(
+              value_list_p, new_value_list_p) == false) {
+        if (new_value_list_p != nullptr) {
+          FreeValueList(new_value_list_p);
+        }
+        continue;
+      }
+
+      epoch_manager.AddGarbageNode(nullptr, value_list_p);
+
+      // We removed the last value, so this thread owns the removal
+      if (new_value_list_p == nullptr) {
+        RemoveNode(node_p, preds, succs);
+      }
+
+      ret = true;
+      break;
+    }
+
+    epoch_manager.LeaveEpoch(epoch);
+    return ret;
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Lookup
+  ///////////////////////////////////////////////////////////////////
+
+  /*
+   * GetValue() - Append all values mapped by the key to the vector
+   */
+  void GetValue(const KeyType &key, std::vector<ValueType> &value_list) {
+    uint64_t epoch = epoch_manager.JoinEpoch();
+
+    SkipListNode *node_p = FindGreaterOrEqual(key);
+    if (node_p != nullptr && KeyCmpEqual(node_p->key, key) == true) {
+      const ValueList *value_list_p = node_p->value_list_p.load();
+      if (value_list_p != nullptr) {
+        value_list.insert(value_list.end(), value_list_p->values,
+                          value_list_p->values + value_list_p->size);
+      }
+    }
+
+    epoch_manager.LeaveEpoch(epoch);
+  }
+
+  /*
+   * Begin() - Return an iterator positioned at the smallest key
+   */
+  ForwardIterator Begin() {
+    return ForwardIterator{this, nullptr};
+  }
+
+  /*
+   * Begin() - Return an iterator positioned at the first key that is
+   *           greater than or equal to the search key
+   */
+  ForwardIterator Begin(const KeyType &start_key) {
+    return ForwardIterator{this, &start_key};
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Garbage Collection Interface
+  ///////////////////////////////////////////////////////////////////
+
+  bool NeedGarbageCollection() {
+    return epoch_manager.NeedGarbageCollection();
+  }
+
+  void PerformGarbageCollection() {
+    epoch_manager.PerformGarbageCollection();
+  }
+
+  /*
+   * GetMemoryFootprint() - Bytes currently allocated for nodes and value
+   *                        lists, including retired but not yet freed ones
+   */
+  size_t GetMemoryFootprint() const { return memory_footprint.load(); }
+
+  /*
+   * class ForwardIterator - Iterates key-value pairs in key order
+   *
+   * The iterator stays inside an epoch for its whole lifetime, so it
+   * should not be kept around longer than the scan that uses it. Values of
+   * the same key are read from one snapshot of the node's value list
+   */
+  class ForwardIterator {
+   public:
+    ForwardIterator(SkipList *p_list_p, const KeyType *start_key_p)
+        : list_p{p_list_p},
+          epoch{p_list_p->epoch_manager.JoinEpoch()},
+          node_p{nullptr},
+          value_list_p{nullptr},
+          value_index{0} {
+      if (start_key_p == nullptr) {
+        node_p = GetUnmarked(list_p->head_node_p->next_p[0].load());
+      } else {
+        node_p = list_p->FindGreaterOrEqual(*start_key_p);
+      }
+
+      SkipToValidNode();
+    }
+
+    ForwardIterator(ForwardIterator &&other)
+        : list_p{other.list_p},
+          epoch{other.epoch},
+          node_p{other.node_p},
+          value_list_p{other.value_list_p},
+          value_index{other.value_index},
+          current_pair{std::move(other.current_pair)} {
+      other.list_p = nullptr;
+    }
+
+    ForwardIterator(const ForwardIterator &) = delete;
+    ForwardIterator &operator=(const ForwardIterator &) = delete;
+
+    ~ForwardIterator() {
+      if (list_p != nullptr) {
+        list_p->epoch_manager.LeaveEpoch(epoch);
+      }
+    }
+
+    inline bool IsEnd() const { return node_p == nullptr; }
+
+    inline const KeyValuePair *operator->() const { return &current_pair; }
+
+    inline const KeyValuePair &operator*() const { return current_pair; }
+
+    /*
+     * Prefix operator++ - Move to the next key-value pair
+     */
+    inline ForwardIterator &operator++() {
+      PL_ASSERT(IsEnd() == false);
+
+      value_index++;
+      if (value_index < value_list_p->size) {
+        current_pair.second = value_list_p->values[value_index];
+      } else {
+        node_p = GetUnmarked(node_p->next_p[0].load());
+        SkipToValidNode();
+      }
+
+      return *this;
+    }
+
+    /*
+     * Postfix operator++ - Same as prefix version, but does not return
+     *                      the old iterator since it is not copyable
+     */
+    inline void operator++(int) { ++(*this); }
+
+   private:
+    /*
+     * SkipToValidNode() - Starting from node_p, move to the first node
+     *                     that is not logically deleted
+     */
+    void SkipToValidNode() {
+      while (node_p != nullptr) {
+        value_list_p = node_p->value_list_p.load();
+        if (value_list_p != nullptr) {
+          value_index = 0;
+          current_pair.first = node_p->key;
+          current_pair.second = value_list_p->values[0];
+          return;
+        }
+
+        node_p = GetUnmarked(node_p->next_p[0].load());
+      }
+    }
+
+    SkipList *list_p;
+    uint64_t epoch;
+    SkipListNode *node_p;
+    const ValueList *value_list_p;
+    size_t value_index;
+    KeyValuePair current_pair;
+  };
+
+ private:
+  ///////////////////////////////////////////////////////////////////
+  // Marked pointer helpers
+  ///////////////////////////////////////////////////////////////////
+
+  static inline bool IsMarked(SkipListNode *node_p) {
+    return (reinterpret_cast<uintptr_t>(node_p) & 0x1UL) != 0;
+  }
+
+  static inline SkipListNode *GetMarked(SkipListNode *node_p) {
+    return reinterpret_cast<SkipListNode *>(
+        reinterpret_cast<uintptr_t>(node_p) | 0x1UL);
+  }
+
+  static inline SkipListNode *GetUnmarked(SkipListNode *node_p) {
+    return reinterpret_cast<SkipListNode *>(
+        reinterpret_cast<uintptr_t>(node_p) & ~0x1UL);
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Memory management
+  ///////////////////////////////////////////////////////////////////
+
+  static inline size_t GetNodeSize(int height) {
+    return sizeof(SkipListNode) +
+           (height - 1) * sizeof(std::atomic<SkipListNode *>);
+  }
+
+  static inline size_t GetValueListSize(size_t value_count) {
+    return sizeof(ValueList) + (value_count - 1) * sizeof(ValueType);
+  }
+
+  SkipListNode *CreateNode(const KeyType &key, int height) {
+    size_t node_size = GetNodeSize(height);
+    memory_footprint.fetch_add(node_size);
+
+    void *memory_p = ::operator new(node_size);
+    return new (memory_p) SkipListNode{key, height};
+  }
+
+  void FreeNode(SkipListNode *node_p) {
+    memory_footprint.fetch_sub(GetNodeSize(node_p->height));
+
+    node_p->~SkipListNode();
+    ::operator delete(node_p);
+  }
+
+  /*
+   * CopyValueList() - Build a new value list from an old one
+   *
+   * If new_value_p is not nullptr it is appended to a copy of the first
+   * count values. Otherwise the value at index count is skipped
+   */
+  const ValueList *CopyValueList(const ValueList *value_list_p, size_t count,
+                                 const ValueType *new_value_p) {
+    size_t old_size = (value_list_p == nullptr) ? 0 : value_list_p->size;
+    size_t new_size = (new_value_p != nullptr) ? (old_size + 1) : (old_size - 1);
+    size_t list_size = GetValueListSize(new_size);
+    memory_footprint.fetch_add(list_size);
+
+    ValueList *new_list_p = static_cast<ValueList *>(::operator new(list_size));
+    new_list_p->size = new_size;
+
+    if (new_value_p != nullptr) {
+      for (size_t i = 0; i < old_size; i++) {
+        new (&new_list_p->values[i]) ValueType{value_list_p->values[i]};
+      }
+      new (&new_list_p->values[old_size]) ValueType{*new_value_p};
+    } else {
+      size_t j = 0;
+      for (size_t i = 0; i < old_size; i++) {
+        if (i != count) {
+          new (&new_list_p->values[j++]) ValueType{value_list_p->values[i]};
+        }
+      }
+    }
+
+    return new_list_p;
+  }
+
+  void FreeValueList(const ValueList *value_list_p) {
+    memory_footprint.fetch_sub(GetValueListSize(value_list_p->size));
+
+    for (size_t i = 0; i < value_list_p->size; i++) {
+      value_list_p->values[i].~ValueType();
+    }
+    ::operator delete(const_cast<ValueList *>(value_list_p));
+  }
+
+  /*
+   * GetRandomHeight() - Geometric distribution with p = 1/4
+   *
+   * Uses a thread local xorshift generator to avoid contention
+   */
+  static int GetRandomHeight() {
+    static thread_local uint64_t seed =
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) | 0x1UL;
+
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+
+    int height = 1;
+    uint64_t bits = seed;
+    while (height < MAX_HEIGHT && (bits & 0x3UL) == 0) {
+      height++;
+      bits >>= 2;
+    }
+
+    return height;
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Traversal
+  ///////////////////////////////////////////////////////////////////
+
+  /*
+   * FindNode() - Find the predecessor and successor of a key on all levels
+   *
+   * succs[level] is the first unmarked node whose key is greater than or
+   * equal to the search key, and preds[level] is the node before it. Marked
+   * nodes encountered on the way are unlinked. Returns true if succs[0]
+   * holds the search key.
+   *
+   * The caller must be inside an epoch
+   */
+  bool FindNode(const KeyType &key, SkipListNode **preds,
+                SkipListNode **succs) {
+    bool restart = true;
+
+    while (restart == true) {
+      restart = false;
+      SkipListNode *pred_p = head_node_p;
+
+      for (int level = MAX_HEIGHT - 1; level >= 0; level--) {
+        SkipListNode *curr_p = pred_p->next_p[level].load();
+
+        // The predecessor has been deleted under our feet
+        if (IsMarked(curr_p) == true) {
+          restart = true;
+          break;
+        }
+
+        while (curr_p != nullptr) {
+          SkipListNode *succ_p = curr_p->next_p[level].load();
+
+          if (IsMarked(succ_p) == true) {
+            SkipListNode *expected_p = curr_p;
+            if (pred_p->next_p[level].compare_exchange_strong(
+                    expected_p, GetUnmarked(succ_p)) == false) {
+              restart = true;
+              break;
+            }
+
+            curr_p = GetUnmarked(succ_p);
+            continue;
+          }
+
+          if (KeyCmpLess(curr_p->key, key) == false) {
+            break;
+          }
+
+          pred_p = curr_p;
+          curr_p = succ_p;
+        }
+
+        if (restart == true) {
+          break;
+        }
+
+        preds[level] = pred_p;
+        succs[level] = curr_p;
+      }
+    }
+
+    return (succs[0] != nullptr) && KeyCmpEqual(succs[0]->key, key);
+  }
+
+  /*
+   * FindGreaterOrEqual() - Read-only search for the first node whose key is
+   *                        greater than or equal to the search key
+   *
+   * The returned node might be logically deleted. This never writes to
+   * shared memory, which keeps lookups and scans cheap. The caller must be
+   * inside an epoch
+   */
+  SkipListNode *FindGreaterOrEqual(const KeyType &key) {
+    SkipListNode *pred_p = head_node_p;
+    SkipListNode *curr_p = nullptr;
+
+    for (int level = MAX_HEIGHT - 1; level >= 0; level--) {
+      curr_p = GetUnmarked(pred_p->next_p[level].load());
+
+      while (curr_p != nullptr && KeyCmpLess(curr_p->key, key) == true) {
+        pred_p = curr_p;
+        curr_p = GetUnmarked(curr_p->next_p[level].load());
+      }
+    }
+
+    return curr_p;
+  }
+
+  /*
+   * LinkUpperLevels() - Link a node already visible on level 0 into the
+   *                     remaining levels of its tower
+   */
+  void LinkUpperLevels(SkipListNode *node_p, SkipListNode **preds,
+                       SkipListNode **succs) {
+    for (int level = 1; level < node_p->height; level++) {
+      while (true) {
+        SkipListNode *expected_p = succs[level];
+        if (preds[level]->next_p[level].compare_exchange_strong(
+                expected_p, node_p) == true) {
+          break;
+        }
+
+        // The neighbourhood has changed; refresh it. Nobody marks this
+        // node before it is fully linked so its next pointers stay clean
+        FindNode(node_p->key, preds, succs);
+        node_p->next_p[level].store(succs[level]);
+      }
+    }
+
+    node_p->fully_linked.store(true);
+  }
+
+  /*
+   * RemoveNode() - Mark and unlink a node whose value list became empty
+   *
+   * Only the thread which CASed the value list to nullptr calls this
+   */
+  void RemoveNode(SkipListNode *node_p, SkipListNode **preds,
+                  SkipListNode **succs) {
+    // The inserting thread might still be linking the upper levels
+    while (node_p->fully_linked.load() == false) {
+      std::this_thread::yield();
+    }
+
+    // Mark top-down so that the node disappears from level 0 last
+    for (int level = node_p->height - 1; level >= 0; level--) {
+      SkipListNode *succ_p = node_p->next_p[level].load();
+      while (IsMarked(succ_p) == false) {
+        node_p->next_p[level].compare_exchange_weak(succ_p, GetMarked(succ_p));
+      }
+    }
+
+    // Traversing to the key unlinks the marked node on all levels
+    FindNode(node_p->key, preds, succs);
+
+    epoch_manager.AddGarbageNode(node_p, nullptr);
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // Data members
+  ///////////////////////////////////////////////////////////////////
+
+  KeyComparator key_cmp_obj;
+  KeyEqualityChecker key_eq_obj;
+  ValueEqualityChecker value_eq_obj;
+
+  std::atomic<size_t> memory_footprint;
+
+  // Sentinel tower of MAX_HEIGHT; its key is never compared
+  SkipListNode *head_node_p;
+
+  EpochManager epoch_manager;
 };
 
 }  // End index namespace
@@ -78,14 +78,15 @@ class SkipListIndex : public Index {
 
   std::string GetTypeName() const;
 
-  // TODO: Implement this
-  size_t GetMemoryFootprint() { return 0; }
+  size_t GetMemoryFootprint() { return container.GetMemoryFootprint(); }
 
-  // TODO: Implement this
-  bool NeedGC() { return false; }
+  bool NeedGC() { return container.NeedGarbageCollection(); }
 
-  // TODO: Implement this
-  void PerformGC() { return; }
+  void PerformGC() {
+    container.PerformGarbageCollection();
+
+    return;
+  }
 
  protected:
   // equality checker and comparator
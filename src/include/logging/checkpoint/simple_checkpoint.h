@@ -13,11 +13,15 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <thread>
 
 #include "logging/checkpoint.h"
 
+// Tile groups of a table written to one checkpoint file
+#define CHECKPOINT_TILE_GROUPS_PER_FILE 16
+
 namespace peloton {
 namespace logging {
 
@@ -28,6 +32,14 @@ class BackendLogger;
 // Simple Checkpoint
 //===--------------------------------------------------------------------===//
 
+/**
+ * A checkpoint is a set of files, written and loaded in parallel. Each file
+ * holds a range of tile groups of one table, as the tuples visible at the
+ * checkpoint cid. A tile group is written as one block of its tuple slots
+ * followed by the values of each column in turn. The checkpoint is complete
+ * once its manifest, which holds the cid and the number of files, is
+ * written.
+ */
 class SimpleCheckpoint : public Checkpoint {
  public:
   SimpleCheckpoint(const SimpleCheckpoint &) = delete;
@@ -42,9 +54,8 @@ class SimpleCheckpoint : public Checkpoint {
 
   cid_t DoRecovery();
 
-  // Internal functions
-  void InsertTuple(cid_t commit_id);
-
+  // Build a log record for each tuple of a table visible at the checkpoint
+  // cid
   void Scan(storage::DataTable *target_table, oid_t database_oid);
 
   // Getters and Setters
@@ -57,18 +68,33 @@ class SimpleCheckpoint : public Checkpoint {
   }
 
  private:
-  void CreateFile();
+  // A range of tile groups of a table, written to one file
+  struct CheckpointPart {
+    storage::DataTable *table;
+    oid_t database_oid;
+    oid_t begin_offset;
+    oid_t end_offset;
+  };
+
+  // Run a task for each part on as many threads as there are cores
+  static bool ForEachPart(size_t part_count,
+                          const std::function<bool(size_t)> &task);
+
+  std::string GetPartFileName(int version, size_t part_idx);
 
-  void Persist();
+  bool WritePart(const CheckpointPart &part, size_t part_idx);
 
-  void Cleanup();
+  bool WriteManifest(size_t part_count);
+
+  bool ReadPart(size_t part_idx, cid_t commit_id, oid_t &max_tile_group_id);
+
+  // Remove the files of the checkpoints with versions in the given range
+  void RemoveFiles(int min_version, int max_version);
 
   void InitVersionNumber();
 
   std::vector<std::shared_ptr<LogRecord>> records_;
 
-  FileHandle file_handle_ = INVALID_FILE_HANDLE;
-
   std::unique_ptr<BackendLogger> logger_;
 
   // Keep tracking max oid for setting next_oid in manager
@@ -15,7 +15,9 @@
 
 #include <iostream>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <mutex>
 #include <vector>
 #include <unistd.h>
 #include <map>
@@ -50,6 +52,9 @@ class FrontendLogger : public Logger {
 
   void AddBackendLogger(BackendLogger *backend_logger);
 
+  // called by a backend logger after it logged a commit record
+  void NotifyCommitLogged();
+
   //===--------------------------------------------------------------------===//
   // Virtual Functions
   //===--------------------------------------------------------------------===//
@@ -97,6 +102,11 @@ class FrontendLogger : public Logger {
     max_seen_commit_id = 0;
     global_queue.clear();
 
+    pending_commit_count_ = 0;
+    unsynced_commit_count_ = 0;
+    group_commit_wait_ = std::chrono::microseconds::zero();
+    fsync_duration_ = std::chrono::microseconds::zero();
+
     backend_loggers.clear();
     backend_loggers_lock.Unlock();
   }
@@ -113,6 +123,12 @@ class FrontendLogger : public Logger {
   void SetNoWrite(bool no_write) { no_write_ = no_write; }
 
  protected:
+  // wait until a batch of commits is ready to be flushed (group commit)
+  void WaitForGroupCommit();
+
+  // called after a sync made the collected commits durable
+  void GroupCommitSynced(std::chrono::microseconds sync_duration);
+
   // Associated backend loggers
   std::vector<BackendLogger *> backend_loggers;
 
@@ -141,6 +157,29 @@ class FrontendLogger : public Logger {
   bool test_mode_ = false;
 
   bool is_distinguished_logger = false;
+
+  //===--------------------------------------------------------------------===//
+  // Group commit
+  //===--------------------------------------------------------------------===//
+
+  // commits logged by backends that were not collected yet
+  std::atomic<size_t> pending_commit_count_{0};
+
+  // time (in us since the steady clock epoch) the oldest pending commit
+  // was logged
+  std::atomic<int64_t> first_pending_commit_time_{0};
+
+  // commits collected since the last sync
+  size_t unsynced_commit_count_ = 0;
+
+  // how long to wait for a batch to fill up, adapted after each sync
+  std::chrono::microseconds group_commit_wait_{0};
+
+  // moving average of the sync duration
+  std::chrono::microseconds fsync_duration_{0};
+
+  std::mutex group_commit_mutex_;
+  std::condition_variable group_commit_cv_;
 };
 
 }  // namespace logging
@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// log_file_reader.h
+//
+// Identification: src/include/logging/log_file_reader.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "logging/records/transaction_record.h"
+#include "logging/records/tuple_record.h"
+#include "type/types.h"
+
+namespace peloton {
+
+namespace catalog {
+class Schema;
+}
+
+namespace storage {
+class Tuple;
+}
+
+namespace type {
+class AbstractPool;
+}
+
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// LogFileReader
+//===--------------------------------------------------------------------===//
+
+/**
+ * Sequential reader over a whole log file used during recovery.
+ *
+ * The file is mapped into memory (or, if that fails, read with a few large
+ * reads) when it is opened, so that records are parsed directly from memory
+ * instead of issuing several stdio calls per record. A torn write at the end
+ * of the file shows up as a read that returns false / LOGRECORD_TYPE_INVALID.
+ */
+class LogFileReader {
+ public:
+  LogFileReader(const LogFileReader &) = delete;
+  LogFileReader &operator=(const LogFileReader &) = delete;
+
+  LogFileReader();
+
+  ~LogFileReader();
+
+  // Map the file into memory. Returns false if it could not be opened
+  bool Open(const std::string &file_name);
+
+  void Close();
+
+  // Advance the read position without parsing, e.g. over the file header
+  bool Skip(size_t length);
+
+  inline size_t GetPosition() const { return position_; }
+
+  inline size_t GetSize() const { return size_; }
+
+  LogRecordType ReadRecordType();
+
+  bool ReadTransactionRecordHeader(TransactionRecord &txn_record);
+
+  bool ReadTupleRecordHeader(TupleRecord &tuple_record);
+
+  storage::Tuple *ReadTupleRecordBody(const catalog::Schema *schema,
+                                      type::AbstractPool *pool);
+
+  bool SkipTupleRecordBody();
+
+ private:
+  // Size of the next length-prefixed frame, 0 if the frame is torn
+  size_t GetNextFrameSize() const;
+
+  // Start of the file contents
+  const char *data_;
+
+  size_t size_;
+
+  size_t position_;
+
+  // Whether data_ is a mapping that must be unmapped on close
+  bool is_mapped_;
+
+  // Fallback buffer when the file cannot be mapped
+  std::vector<char> buffer_;
+
+  // Size of the reads used to fill the fallback buffer
+  static constexpr size_t READ_BLOCK_SIZE = 4 * 1024 * 1024;
+};
+
+}  // namespace logging
+}  // namespace peloton
@@ -12,8 +12,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <future>
 #include <map>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 #include "backend_logger.h"
@@ -107,6 +110,9 @@ class LogManager {
   // wait for the flush of a frontend logger (for worker thread)
   void WaitForFlush(cid_t cid);
 
+  // get a future that becomes ready once the given commit is durable
+  std::shared_future<void> GetDurabilityFuture(cid_t cid);
+
   // get the current persistent flushed commit
   cid_t GetPersistentFlushedCommitId();
 
@@ -240,6 +246,43 @@ class LogManager {
 
   inline bool GetNoWrite() const { return no_write_; }
 
+  // get the number of threads a frontend logger uses to replay its log
+  inline unsigned int GetRecoveryThreadCount() const {
+    return recovery_thread_count_;
+  }
+
+  // set the number of threads a frontend logger uses to replay its log
+  inline void SetRecoveryThreadCount(unsigned int recovery_thread_count) {
+    recovery_thread_count_ = std::max(recovery_thread_count, 1u);
+  }
+
+  // In group commit mode a frontend logger flushes as soon as a batch of
+  // commits is complete or the batch has waited for the latency budget,
+  // and syncs the log on every flush
+  inline void SetGroupCommit(bool group_commit) {
+    group_commit_ = group_commit;
+  }
+
+  inline bool GetGroupCommit() const { return group_commit_; }
+
+  // set the longest time (in us) a commit may wait for its batch to fill up
+  inline void SetGroupCommitLatencyBudget(int64_t latency_budget) {
+    group_commit_latency_budget_ = std::max(latency_budget, INT64_C(1));
+  }
+
+  inline int64_t GetGroupCommitLatencyBudget() const {
+    return group_commit_latency_budget_;
+  }
+
+  // set the number of commits after which a batch is flushed immediately
+  inline void SetGroupCommitMaxBatchSize(size_t max_batch_size) {
+    group_commit_max_batch_size_ = std::max(max_batch_size, (size_t)1);
+  }
+
+  inline size_t GetGroupCommitMaxBatchSize() const {
+    return group_commit_max_batch_size_;
+  }
+
  private:
   LogManager();
   ~LogManager();
@@ -267,6 +310,17 @@ class LogManager {
   // default capacity for log buffer
   size_t log_buffer_capacity_ = LOG_FILE_LEN;
 
+  // number of recovery threads per frontend logger
+  unsigned int recovery_thread_count_ =
+      std::max(std::thread::hardware_concurrency(), 1u);
+
+  // group commit configuration
+  bool group_commit_ = false;
+
+  int64_t group_commit_latency_budget_ = 1000;
+
+  size_t group_commit_max_batch_size_ = 64;
+
   // There is only one frontend_logger of some type
   // either write ahead or write behind logging
   std::vector<std::unique_ptr<FrontendLogger>> frontend_loggers;
@@ -279,9 +333,10 @@ class LogManager {
   std::mutex logging_status_mutex;
   std::condition_variable logging_status_cv;
 
-  // To wait for flush
+  // To wait for flush. Backends waiting for a commit to become durable
+  // register a promise keyed by its commit id
   std::mutex flush_notify_mutex;
-  std::condition_variable flush_notify_cv;
+  std::multimap<cid_t, std::promise<void>> durability_promises_;
 
   // To update catalog and txn managers
   std::mutex update_managers_mutex;
@@ -80,10 +80,6 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   bool FileSwitchCondIsTrue();
 
-  void OpenNextLogFile();
-
-  LogRecordType GetNextLogRecordTypeForRecovery();
-
   void TruncateLog(cid_t);
 
   void InitLogDirectory();
@@ -98,6 +94,12 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   int GetLogFileCursor() { return log_file_cursor_; }
 
+  // number of log records read by the last recovery
+  size_t GetRecoveredRecordCount() const { return recovered_record_count_; }
+
+  // number of log file bytes read by the last recovery
+  size_t GetRecoveredByteCount() const { return recovered_byte_count_; }
+
   int GetLogFileCounter() { return log_file_counter_; }
 
   void InitSelf();
@@ -107,12 +109,34 @@ class WriteAheadFrontendLogger : public FrontendLogger {
  private:
   std::string GetLogFileName(void);
 
+  // A log record of a log file that has to be considered for replay
+  struct RecoveryRecord {
+    LogRecordType type;
+    cid_t log_id;
+    TupleRecord *tuple_record;
+  };
+
+  // The records of one log file, in log order
+  struct RecoveryLogFile {
+    std::vector<RecoveryRecord> records;
+    // whether parsing stopped at a torn or corrupt record
+    bool is_torn = false;
+    size_t record_count = 0;
+    size_t byte_count = 0;
+  };
+
+  void ParseLogFile(int log_file_itr, cid_t start_commit_id,
+                    cid_t max_commit_id, RecoveryLogFile &log_file);
+
+  size_t GetRecoveryPartition(TupleRecord *record) const;
+
+  void ReplayCommittedTransactions();
+
+  void ReplayTupleRecord(TupleRecord *record, oid_t &max_tg);
+
   bool RecoverTableIndexHelper(storage::DataTable *target_table,
                                cid_t start_cid);
 
-  void InsertIndexEntry(storage::Tuple *tuple, storage::DataTable *table,
-                        ItemPointer target_location);
-
   //===--------------------------------------------------------------------===//
   // Member Variables
   //===--------------------------------------------------------------------===//
@@ -123,6 +147,14 @@ class WriteAheadFrontendLogger : public FrontendLogger {
   // Txn table during recovery
   std::map<txn_id_t, std::vector<TupleRecord *>> recovery_txn_table;
 
+  // Records of committed txns, partitioned by table and kept in commit
+  // order within a partition. Partitions are replayed in parallel
+  std::vector<std::vector<TupleRecord *>> recovery_partitions_;
+
+  size_t recovered_record_count_ = 0;
+
+  size_t recovered_byte_count_ = 0;
+
   // Keep tracking max oid for setting next_oid in manager
   // For active processing after recovery
   oid_t max_oid = 0;
@@ -36,6 +36,10 @@ class LoggingUtil {
 
   static void FFlushFsync(FileHandle &file_handle);
 
+  static void FFlushFdatasync(FileHandle &file_handle);
+
+  static bool PreallocateFile(FileHandle &file_handle, size_t size);
+
   static bool InitFileHandle(const char *name, FileHandle &file_handle,
                              const char *mode);
 
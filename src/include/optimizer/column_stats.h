@@ -0,0 +1,118 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_stats.h
+//
+// Identification: src/include/optimizer/column_stats.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace optimizer {
+
+// Most common values kept per column
+#define STATS_MCV_COUNT 10
+
+// Buckets of the equi-depth histogram of a column
+#define STATS_HISTOGRAM_BUCKETS 100
+
+// Selectivity of predicates the statistics say nothing about
+#define DEFAULT_SELECTIVITY (1.0 / 3)
+
+//===--------------------------------------------------------------------===//
+// ColumnStats
+//===--------------------------------------------------------------------===//
+
+// The distribution of the values of a column, as found by ANALYZE.
+//
+// The most common values are kept with the fraction of the rows that hold
+// them. The other non-null values are described by an equi-depth histogram:
+// the bounds split them into buckets that hold the same number of rows.
+// Fractions are of all the rows of the table, nulls included.
+class ColumnStats {
+ public:
+  ColumnStats(type::Type::TypeId type, double null_fraction,
+              double distinct_count,
+              std::vector<type::Value> most_common_values,
+              std::vector<double> most_common_frequencies,
+              std::vector<type::Value> histogram_bounds);
+
+  // Build the statistics from a sample of the rows. The non-null values of
+  // the column are passed in; they are reordered.
+  static std::shared_ptr<ColumnStats> Build(
+      type::Type::TypeId type, std::vector<type::Value> &sample_values,
+      size_t sample_row_count, double null_fraction, double distinct_count);
+
+  //===--------------------------------------------------------------------===//
+  // Accessors
+  //===--------------------------------------------------------------------===//
+
+  inline type::Type::TypeId GetType() const { return type_; }
+
+  inline double GetNullFraction() const { return null_fraction_; }
+
+  inline double GetDistinctCount() const { return distinct_count_; }
+
+  inline const std::vector<type::Value> &GetMostCommonValues() const {
+    return most_common_values_;
+  }
+
+  inline const std::vector<double> &GetMostCommonFrequencies() const {
+    return most_common_frequencies_;
+  }
+
+  inline const std::vector<type::Value> &GetHistogramBounds() const {
+    return histogram_bounds_;
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Selectivity
+  //===--------------------------------------------------------------------===//
+
+  // Fraction of the rows equal to the value
+  double GetEqualSelectivity(const type::Value &value) const;
+
+  // Fraction of the rows less than the value
+  double GetLessThanSelectivity(const type::Value &value) const;
+
+  // Fraction of the rows that satisfy "column <compare_type> value"
+  double GetSelectivity(ExpressionType compare_type,
+                        const type::Value &value) const;
+
+  const std::string GetInfo() const;
+
+ private:
+  // Where the value falls in the histogram, from 0 below the first bound to
+  // 1 above the last one
+  double GetHistogramPosition(const type::Value &value) const;
+
+  type::Type::TypeId type_;
+
+  double null_fraction_;
+
+  double distinct_count_;
+
+  std::vector<type::Value> most_common_values_;
+
+  std::vector<double> most_common_frequencies_;
+
+  // Fraction of the rows that are neither null nor a most common value
+  double histogram_fraction_;
+
+  std::vector<type::Value> histogram_bounds_;
+};
+
+}  // namespace optimizer
+}  // namespace peloton
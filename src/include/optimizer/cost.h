@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// cost.h
+//
+// Identification: src/include/optimizer/cost.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "type/types.h"
+
+namespace peloton {
+
+namespace expression {
+class AbstractExpression;
+}
+
+namespace optimizer {
+
+class Stats;
+
+// The costs are in units of reading a tuple from a tile. Everything lives in
+// memory, so they weigh CPU work and memory traffic rather than pages.
+
+// Reading a tuple and checking its visibility
+#define DEFAULT_TUPLE_COST 0.01
+// Evaluating a predicate, a projection or a hash on a tuple
+#define DEFAULT_OPERATOR_COST 0.0025
+// Reaching a tuple through an index: a tree hop and a random access
+#define DEFAULT_INDEX_TUPLE_COST 0.02
+// Copying a tuple into a hash table or a sort buffer
+#define DEFAULT_MEMORY_TUPLE_COST 0.005
+
+//===--------------------------------------------------------------------===//
+// Cost
+//===--------------------------------------------------------------------===//
+
+// Cardinality estimation and the cost formulas of the physical operators.
+// Costs only count the work of the operator itself, not its inputs.
+class Cost {
+ public:
+  // Fraction of the tuples that satisfy the predicate. Comparisons between a
+  // column and a constant use the column statistics; unbound columns are
+  // looked up in the given table. The rest fall back to DEFAULT_SELECTIVITY.
+  static double GetSelectivity(const Stats &stats,
+                               const expression::AbstractExpression *predicate,
+                               oid_t table_id = INVALID_OID);
+
+  // Number of terms of a conjunction
+  static size_t GetPredicateCount(
+      const expression::AbstractExpression *predicate);
+
+  // Rows of an equi-join whose predicate is not known. The key of the smaller
+  // input is taken to be unique, as in a foreign key join.
+  static double GetJoinRows(double left_rows, double right_rows);
+
+  static double SeqScanCost(double table_rows, size_t predicate_count);
+
+  // Descend the index, then fetch the matching tuples and check the rest of
+  // the predicate on them
+  static double IndexScanCost(double table_rows, double matched_rows,
+                              size_t predicate_count);
+
+  // Compare every pair of tuples
+  static double NLJoinCost(double left_rows, double right_rows,
+                           double output_rows);
+
+  // Build a hash table on the right input and probe it with the left one
+  static double HashJoinCost(double left_rows, double right_rows,
+                             double output_rows);
+
+  static double SortCost(double rows);
+
+  // Hash aggregation keeps a slot per group
+  static double AggregateCost(double rows, double group_count,
+                              size_t aggregate_count);
+};
+
+}  // namespace optimizer
+}  // namespace peloton
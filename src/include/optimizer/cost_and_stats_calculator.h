@@ -53,6 +53,9 @@ class CostAndStatsCalculator : public OperatorVisitor {
   void Visit(const PhysicalOuterHashJoin *) override;
 
  private:
+  // Both kinds of join produce the same rows and differ in cost
+  void CalculateJoin(bool hash_join);
+
   ColumnManager &manager_;
 
   // We cannot use reference here because otherwise we have to initialize them
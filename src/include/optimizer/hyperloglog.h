@@ -0,0 +1,54 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hyperloglog.h
+//
+// Identification: src/include/optimizer/hyperloglog.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "type/value.h"
+
+namespace peloton {
+namespace optimizer {
+
+// Number of bits of the hash that pick a register. 2^12 registers estimate
+// the distinct count with a standard error of about 1.6%.
+#define HLL_PRECISION 12
+
+//===--------------------------------------------------------------------===//
+// HyperLogLog
+//===--------------------------------------------------------------------===//
+
+// Estimates the number of distinct values added to it in fixed space
+// (Flajolet et al., "HyperLogLog: the analysis of a near-optimal cardinality
+// estimation algorithm"). Sketches built over different parts of a table are
+// merged into the sketch of the whole table.
+class HyperLogLog {
+ public:
+  HyperLogLog();
+
+  void Add(const type::Value &value) { AddHash(value.Hash()); }
+
+  void AddHash(uint64_t hash);
+
+  // Add the values of another sketch to this one
+  void Merge(const HyperLogLog &other);
+
+  double Estimate() const;
+
+ private:
+  // Largest number of leading zeros plus one seen in each register
+  std::vector<uint8_t> registers_;
+};
+
+}  // namespace optimizer
+}  // namespace peloton
@@ -50,6 +50,7 @@ class QueryToOperatorTransformer : public SqlNodeVisitor {
   void Visit(const parser::TransactionStatement *op) override;
   void Visit(const parser::UpdateStatement *op) override;
   void Visit(const parser::CopyStatement *op) override;
+  void Visit(const parser::AnalyzeStatement *op) override;
 
  private:
   ColumnManager &manager_;
@@ -12,7 +12,10 @@
 
 #pragma once
 
-#include "optimizer/tuple_sample.h"
+#include <memory>
+#include <unordered_map>
+
+#include "optimizer/table_stats.h"
 
 namespace peloton {
 namespace optimizer {
@@ -20,12 +23,30 @@ namespace optimizer {
 //===--------------------------------------------------------------------===//
 // Stats
 //===--------------------------------------------------------------------===//
+
+// What is known about the output of an operator: the number of rows it
+// produces and the statistics ANALYZE collected for the tables it reads
 class Stats {
  public:
-  Stats(TupleSample *sample) : sample_(sample){};
+  Stats(double num_rows) : num_rows_(num_rows){};
+
+  inline double GetNumRows() const { return num_rows_; }
+
+  inline void SetNumRows(double num_rows) { num_rows_ = num_rows; }
+
+  void AddTableStats(std::shared_ptr<TableStats> table_stats);
+
+  // Take the table statistics of the input of an operator
+  void AddTableStats(const Stats &input_stats);
+
+  // Return nullptr if the table has not been analyzed
+  std::shared_ptr<ColumnStats> GetColumnStats(oid_t table_id,
+                                              oid_t column_id) const;
 
  private:
-  TupleSample *sample_;
+  double num_rows_;
+
+  std::unordered_map<oid_t, std::shared_ptr<TableStats>> table_stats_;
 };
 
 } /* namespace optimizer */
@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// stats_storage.h
+//
+// Identification: src/include/optimizer/stats_storage.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "optimizer/table_stats.h"
+
+namespace peloton {
+
+namespace concurrency {
+class Transaction;
+}
+
+namespace storage {
+class DataTable;
+}
+
+namespace optimizer {
+
+// An analyzed table is analyzed again once this many tuples plus this
+// fraction of its rows have been written since, as in the autovacuum
+// daemon of Postgres
+#define STATS_REFRESH_THRESHOLD 50
+#define STATS_REFRESH_SCALE_FACTOR 0.1
+
+//===--------------------------------------------------------------------===//
+// StatsStorage
+//===--------------------------------------------------------------------===//
+
+// The statistics ANALYZE has collected, for the optimizer.
+//
+// The latest statistics of each table are kept in memory. ANALYZE also
+// records them, a row per column, in the column_stats table of the catalog
+// database, where they can be queried.
+class StatsStorage {
+ public:
+  StatsStorage(const StatsStorage &) = delete;
+  StatsStorage &operator=(const StatsStorage &) = delete;
+
+  static StatsStorage &GetInstance();
+
+  // Collect the statistics of a table and store them. A transaction is
+  // started if none is given.
+  std::shared_ptr<TableStats> AnalyzeTable(storage::DataTable *table,
+                                           concurrency::Transaction *txn);
+
+  // Return nullptr if the table has not been analyzed
+  std::shared_ptr<TableStats> GetTableStats(oid_t table_id);
+
+  // Analyze the table again if enough tuples were written to it since the
+  // last time. Only tables analyzed before are refreshed. The stats
+  // aggregator calls this with the number of tuples inserted, updated and
+  // deleted since the system started.
+  void RefreshTableStats(storage::DataTable *table, int64_t modified_count);
+
+  // Forget the statistics of a dropped table
+  void DropTableStats(oid_t table_id, concurrency::Transaction *txn);
+
+ private:
+  StatsStorage() {}
+
+  // Record the statistics in the catalog
+  void InsertColumnStats(const TableStats &table_stats,
+                         concurrency::Transaction *txn);
+
+  std::mutex stats_mutex_;
+
+  std::unordered_map<oid_t, std::shared_ptr<TableStats>> table_stats_;
+
+  // The modified count of each table when it was analyzed, once the stats
+  // aggregator has reported it
+  std::unordered_map<oid_t, int64_t> analyzed_modified_counts_;
+};
+
+}  // namespace optimizer
+}  // namespace peloton
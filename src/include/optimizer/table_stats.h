@@ -0,0 +1,84 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// table_stats.h
+//
+// Identification: src/include/optimizer/table_stats.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "optimizer/column_stats.h"
+#include "type/types.h"
+
+namespace peloton {
+
+namespace concurrency {
+class Transaction;
+}
+
+namespace storage {
+class DataTable;
+}
+
+namespace optimizer {
+
+// Rows sampled by ANALYZE to build the histograms and most common values
+#define ANALYZE_SAMPLE_SIZE 30000
+
+//===--------------------------------------------------------------------===//
+// TableStats
+//===--------------------------------------------------------------------===//
+
+// The row count of a table and the statistics of each of its columns
+class TableStats {
+ public:
+  TableStats(oid_t database_id, oid_t table_id, double num_rows,
+             std::vector<std::shared_ptr<ColumnStats>> column_stats);
+
+  // Build the statistics of the tuples visible to the transaction.
+  //
+  // The tile groups are split among the threads of the pool. Each thread
+  // keeps a reservoir sample of the tuples it visits, counts their nulls
+  // and feeds every value to a HyperLogLog sketch per column. The samples
+  // are merged in proportion to the tuples each thread saw, so the result
+  // is a uniform sample of the table. Reads are not recorded in the
+  // transaction; the statistics don't need to be serializable.
+  static std::shared_ptr<TableStats> Collect(storage::DataTable *table,
+                                             concurrency::Transaction *txn,
+                                             size_t sample_size =
+                                                 ANALYZE_SAMPLE_SIZE);
+
+  inline oid_t GetDatabaseId() const { return database_id_; }
+
+  inline oid_t GetTableId() const { return table_id_; }
+
+  inline double GetNumRows() const { return num_rows_; }
+
+  inline size_t GetColumnCount() const { return column_stats_.size(); }
+
+  // Return nullptr if the column is not known
+  std::shared_ptr<ColumnStats> GetColumnStats(oid_t column_id) const;
+
+  const std::string GetInfo() const;
+
+ private:
+  oid_t database_id_;
+
+  oid_t table_id_;
+
+  double num_rows_;
+
+  std::vector<std::shared_ptr<ColumnStats>> column_stats_;
+};
+
+}  // namespace optimizer
+}  // namespace peloton
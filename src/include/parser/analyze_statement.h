@@ -0,0 +1,35 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// analyze_statement.h
+//
+// Identification: src/include/parser/analyze_statement.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "parser/sql_statement.h"
+#include "common/sql_node_visitor.h"
+
+namespace peloton {
+namespace parser {
+
+/**
+ * @struct AnalyzeStatement
+ * @brief Represents "ANALYZE [table]". Without a table all the tables are
+ * analyzed.
+ */
+struct AnalyzeStatement : TableRefStatement {
+  AnalyzeStatement() : TableRefStatement(StatementType::ANALYZE) {}
+
+  virtual void Accept(SqlNodeVisitor* v) const override {
+    v->Visit(this);
+  }
+};
+
+}  // End parser namespace
+}  // End peloton namespace
@@ -14,6 +14,7 @@
 
 // This is just for convenience
 
+#include "analyze_statement.h"
 #include "copy_statement.h"
 #include "create_statement.h"
 #include "delete_statement.h"
@@ -40,10 +40,24 @@ class CopyPlan : public AbstractPlan {
     LOG_DEBUG("Creating a Copy Plan");
   }
 
+  // Load the rows of the file into the target table
+  CopyPlan(char *file_path, storage::DataTable *target_table, char delimiter)
+      : file_path(file_path),
+        copy_type(CopyType::IMPORT_CSV),
+        target_table(target_table),
+        delimiter(delimiter) {
+    LOG_DEBUG("Creating a Copy From Plan");
+  }
+
   inline PlanNodeType GetPlanNodeType() const { return PlanNodeType::COPY; }
 
   const std::string GetInfo() const { return "CopyPlan"; }
 
+  inline bool IsImport() const {
+    return copy_type == CopyType::IMPORT_CSV ||
+           copy_type == CopyType::IMPORT_TSV;
+  }
+
   // TODO: Implement copy mechanism
   std::unique_ptr<AbstractPlan> Copy() const { return nullptr; }
 
@@ -52,6 +66,14 @@ class CopyPlan : public AbstractPlan {
 
   // Whether the copying requires deserialization of parameters
   bool deserialize_parameters = false;
+
+  CopyType copy_type = CopyType::EXPORT_OTHER;
+
+  // The table to load, for imports
+  storage::DataTable *target_table = nullptr;
+
+  // Field delimiter between columns, for imports
+  char delimiter = ',';
 };
 
 }  // namespace planner
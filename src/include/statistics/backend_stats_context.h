@@ -21,6 +21,7 @@
 #include "statistics/table_metric.h"
 #include "statistics/index_metric.h"
 #include "statistics/latency_metric.h"
+#include "statistics/histogram_metric.h"
 #include "statistics/database_metric.h"
 #include "statistics/query_metric.h"
 #include "container/cuckoo_map.h"
@@ -80,6 +81,18 @@ class BackendStatsContext {
   // Returns the latency metric
   LatencyMetric& GetTxnLatencyMetric();
 
+  // Returns the histogram of how long (us) commits wait to become durable
+  HistogramMetric& GetCommitLatencyHistogram();
+
+  // Returns the histogram of the number of commits made durable per fsync
+  HistogramMetric& GetCommitsPerFsyncHistogram();
+
+  // Returns the number of simple queries planned from the plan cache
+  CounterMetric& GetPlanCacheHits() { return plan_cache_hits_; }
+
+  // Returns the number of simple queries that missed the plan cache
+  CounterMetric& GetPlanCacheMisses() { return plan_cache_misses_; }
+
   // Increment the read stat for given tile group
   void IncrementTableReads(oid_t tile_group_id);
 
@@ -111,6 +124,9 @@ class BackendStatsContext {
   // Increment the abortion stat for given database
   void IncrementTxnAborted(oid_t database_id);
 
+  // Increment the plan cache stat for a hit or a miss
+  void IncrementPlanCacheLookups(bool hit);
+
   // Initialize the query stat
   void InitQueryMetric(const std::shared_ptr<Statement> statement,
                        const std::shared_ptr<QueryMetric::QueryParams> params);
@@ -174,6 +190,16 @@ class BackendStatsContext {
   // Latencies recorded by this worker
   LatencyMetric txn_latencies_;
 
+  // Durable commit latencies recorded by this worker
+  HistogramMetric commit_latencies_;
+
+  // Group commit sizes recorded by this (logger) thread
+  HistogramMetric commits_per_fsync_;
+
+  // Plan cache lookups of this worker
+  CounterMetric plan_cache_hits_{MetricType::COUNTER_METRIC};
+  CounterMetric plan_cache_misses_{MetricType::COUNTER_METRIC};
+
   // Whether this context is registered to the global aggregator
   bool is_registered_to_aggregator_;
 
@@ -46,7 +46,7 @@ class CounterMetric : public AbstractMetric {
 
   inline void Reset() { count_ = 0; }
 
-  inline int64_t GetCounter() { return count_; }
+  inline int64_t GetCounter() const { return count_; }
 
   inline bool operator==(const CounterMetric &other) {
     return count_ == other.count_;
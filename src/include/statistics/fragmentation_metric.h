@@ -0,0 +1,148 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// fragmentation_metric.h
+//
+// Identification: src/include/statistics/fragmentation_metric.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <sstream>
+
+#include "type/types.h"
+#include "statistics/abstract_metric.h"
+
+namespace peloton {
+namespace stats {
+
+/**
+ * Metric for the free space in the tile groups of a table and for the work
+ * of the tile group compactor on it.
+ *
+ * The counts of tile groups, slots and live tuples are a snapshot taken by
+ * the last compaction pass over the table. Only the thread running the
+ * compactor sets them, so aggregating the metrics of all threads adds them
+ * to zero.
+ */
+class FragmentationMetric : public AbstractMetric {
+ public:
+  FragmentationMetric(MetricType type);
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  // Record a snapshot of the tile groups of the table
+  inline void SetSnapshot(int64_t tile_group_count, int64_t slot_count,
+                          int64_t live_tuple_count,
+                          int64_t sparse_tile_group_count) {
+    tile_group_count_ = tile_group_count;
+    slot_count_ = slot_count;
+    live_tuple_count_ = live_tuple_count;
+    sparse_tile_group_count_ = sparse_tile_group_count;
+  }
+
+  inline void IncrementRelocatedTuples(int64_t count) {
+    relocated_tuple_count_ += count;
+  }
+
+  inline void IncrementReleasedTileGroups(int64_t count) {
+    released_tile_group_count_ += count;
+  }
+
+  inline int64_t GetTileGroupCount() const { return tile_group_count_; }
+
+  inline int64_t GetSlotCount() const { return slot_count_; }
+
+  inline int64_t GetLiveTupleCount() const { return live_tuple_count_; }
+
+  inline int64_t GetSparseTileGroupCount() const {
+    return sparse_tile_group_count_;
+  }
+
+  inline int64_t GetRelocatedTupleCount() const {
+    return relocated_tuple_count_;
+  }
+
+  inline int64_t GetReleasedTileGroupCount() const {
+    return released_tile_group_count_;
+  }
+
+  // Returns the fraction of slots that do not hold a live tuple
+  inline double GetFragmentation() const {
+    if (slot_count_ == 0) {
+      return 0;
+    }
+    return 1 - (double)live_tuple_count_ / slot_count_;
+  }
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  inline void Reset() {
+    SetSnapshot(0, 0, 0, 0);
+    relocated_tuple_count_ = 0;
+    released_tile_group_count_ = 0;
+  }
+
+  inline bool operator==(const FragmentationMetric &other) {
+    return tile_group_count_ == other.tile_group_count_ &&
+           slot_count_ == other.slot_count_ &&
+           live_tuple_count_ == other.live_tuple_count_ &&
+           sparse_tile_group_count_ == other.sparse_tile_group_count_ &&
+           relocated_tuple_count_ == other.relocated_tuple_count_ &&
+           released_tile_group_count_ == other.released_tile_group_count_;
+  }
+
+  inline bool operator!=(const FragmentationMetric &other) {
+    return !(*this == other);
+  }
+
+  // Adds the counts of the source metric to this metric
+  void Aggregate(AbstractMetric &source);
+
+  // Returns a string representation of this metric
+  inline const std::string GetInfo() const {
+    std::stringstream ss;
+    ss << "[ tile_groups=" << tile_group_count_ << ", slots=" << slot_count_
+       << ", live_tuples=" << live_tuple_count_
+       << ", sparse_tile_groups=" << sparse_tile_group_count_
+       << ", fragmentation=" << GetFragmentation()
+       << ", relocated_tuples=" << relocated_tuple_count_
+       << ", released_tile_groups=" << released_tile_group_count_ << " ]";
+    return ss.str();
+  }
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  // Tile groups that have not been released
+  int64_t tile_group_count_ = 0;
+
+  // Slots allocated by these tile groups
+  int64_t slot_count_ = 0;
+
+  // Slots holding a committed version that is not updated or deleted
+  int64_t live_tuple_count_ = 0;
+
+  // Full tile groups filled below the compaction threshold
+  int64_t sparse_tile_group_count_ = 0;
+
+  // Tuples moved out of sparse tile groups
+  int64_t relocated_tuple_count_ = 0;
+
+  // Tile groups released by the compactor
+  int64_t released_tile_group_count_ = 0;
+};
+
+}  // namespace stats
+}  // namespace peloton
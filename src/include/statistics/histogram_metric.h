@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// histogram_metric.h
+//
+// Identification: src/include/statistics/histogram_metric.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+#include "common/macros.h"
+#include "type/types.h"
+#include "statistics/abstract_metric.h"
+
+namespace peloton {
+namespace stats {
+
+/**
+ * Metric that counts values in power-of-two buckets, e.g. commit latencies
+ * or the number of commits made durable by one fsync.
+ *
+ * Bucket 0 counts zeros and bucket i counts values in [2^(i-1), 2^i).
+ * Recording a value is a relaxed atomic increment, so unlike LatencyMetric
+ * it never drops a measurement and can be shared by several threads.
+ */
+class HistogramMetric : public AbstractMetric {
+ public:
+  static constexpr size_t BUCKET_COUNT = 48;
+
+  HistogramMetric(MetricType type, const std::string &name,
+                  const std::string &unit);
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  inline void Record(uint64_t value) {
+    buckets_[GetBucket(value)].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  // Returns the number of values recorded
+  uint64_t GetCount() const;
+
+  // Returns the number of values recorded in the given bucket
+  inline uint64_t GetBucketCount(size_t bucket) const {
+    PL_ASSERT(bucket < BUCKET_COUNT);
+    return buckets_[bucket].load(std::memory_order_relaxed);
+  }
+
+  // Returns the average of the values recorded
+  double GetAverage() const;
+
+  // Returns the upper bound of the bucket that holds the given quantile
+  uint64_t GetPercentile(double quantile) const;
+
+  // Returns the smallest value counted in the given bucket
+  static inline uint64_t GetBucketLowerBound(size_t bucket) {
+    return (bucket == 0) ? 0 : (UINT64_C(1) << (bucket - 1));
+  }
+
+  // Returns the largest value counted in the given bucket
+  static inline uint64_t GetBucketUpperBound(size_t bucket) {
+    return (bucket == 0) ? 0 : (UINT64_C(1) << bucket) - 1;
+  }
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  void Reset();
+
+  // Adds the counts of the source histogram to this histogram
+  void Aggregate(AbstractMetric &source);
+
+  // Returns a string representation of this histogram
+  const std::string GetInfo() const;
+
+ private:
+  static inline size_t GetBucket(uint64_t value) {
+    if (value == 0) return 0;
+    size_t bucket = 64 - __builtin_clzll(value);
+    return (bucket < BUCKET_COUNT) ? bucket : BUCKET_COUNT - 1;
+  }
+
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  // What is measured, e.g. "COMMIT LATENCY"
+  std::string name_;
+
+  // Unit of the values, e.g. "us"
+  std::string unit_;
+
+  std::atomic<uint64_t> buckets_[BUCKET_COUNT];
+
+  // Sum of all values recorded, for the average
+  std::atomic<uint64_t> sum_;
+};
+
+}  // namespace stats
+}  // namespace peloton
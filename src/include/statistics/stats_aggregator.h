@@ -165,6 +165,10 @@ class StatsAggregator {
   // Write all query metrics to a metric table
   void UpdateQueryMetrics(int64_t time_stamp, concurrency::Transaction *txn);
 
+  // Refresh the optimizer statistics of the tables written to since they
+  // were analyzed
+  void RefreshTableStats();
+
   // Aggregate stats periodically
   void RunAggregator();
 };
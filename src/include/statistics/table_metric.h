@@ -18,6 +18,7 @@
 #include "type/types.h"
 #include "statistics/abstract_metric.h"
 #include "statistics/access_metric.h"
+#include "statistics/fragmentation_metric.h"
 
 namespace peloton {
 namespace stats {
@@ -37,6 +38,10 @@ class TableMetric : public AbstractMetric {
 
   inline AccessMetric &GetTableAccess() { return table_access_; }
 
+  inline FragmentationMetric &GetTableFragmentation() {
+    return table_fragmentation_;
+  }
+
   inline std::string GetName() { return table_name_; }
 
   inline oid_t GetDatabaseId() { return database_id_; }
@@ -47,12 +52,16 @@ class TableMetric : public AbstractMetric {
   // HELPER FUNCTIONS
   //===--------------------------------------------------------------------===//
 
-  inline void Reset() { table_access_.Reset(); }
+  inline void Reset() {
+    table_access_.Reset();
+    table_fragmentation_.Reset();
+  }
 
   inline bool operator==(const TableMetric &other) {
     return database_id_ == other.database_id_ && table_id_ == other.table_id_ &&
            table_name_ == other.table_name_ &&
-           table_access_ == other.table_access_;
+           table_access_ == other.table_access_ &&
+           table_fragmentation_ == other.table_fragmentation_;
   }
 
   inline bool operator!=(const TableMetric &other) { return !(*this == other); }
@@ -67,6 +76,7 @@ class TableMetric : public AbstractMetric {
     ;
     ss << "-----------------------------" << std::endl;
     ss << table_access_.GetInfo() << std::endl;
+    ss << table_fragmentation_.GetInfo() << std::endl;
     return ss.str();
   }
 
@@ -86,6 +96,9 @@ class TableMetric : public AbstractMetric {
 
   // The number of tuple accesses
   AccessMetric table_access_{ACCESS_METRIC};
+
+  // The free space in the tile groups
+  FragmentationMetric table_fragmentation_{FRAGMENTATION_METRIC};
 };
 
 }  // namespace stats
@@ -121,6 +121,22 @@ class DataTable : public AbstractTable {
   // aggregate_executor.
   ItemPointer InsertTuple(const Tuple *tuple);
 
+  //===--------------------------------------------------------------------===//
+  // BULK LOAD
+  //===--------------------------------------------------------------------===//
+
+  // add a tile group that is filled by one loader only. it is not one of the
+  // active tile groups, so other inserts never claim its slots.
+  std::shared_ptr<TileGroup> AddBulkLoadTileGroup();
+
+  // insert the loaded tuples into the indexes, one index after the other.
+  // the index entry of each tuple is returned in index_entry_ptrs, nullptr
+  // for the tuples after a violated constraint. several loaders may call it
+  // at the same time with their own tuples.
+  bool InsertInIndexes(const std::vector<ItemPointer> &locations,
+                       concurrency::Transaction *transaction,
+                       std::vector<ItemPointer *> &index_entry_ptrs);
+
   //===--------------------------------------------------------------------===//
   // TILE GROUP
   //===--------------------------------------------------------------------===//
@@ -138,6 +154,11 @@ class DataTable : public AbstractTable {
   std::shared_ptr<storage::TileGroup> GetTileGroupById(
       const oid_t &tile_group_id) const;
 
+  // Same as GetTileGroup(), without a reference. See
+  // catalog::Manager::GetTileGroupPtr() for how long it stays valid.
+  storage::TileGroup *GetTileGroupPtr(
+      const std::size_t &tile_group_offset) const;
+
   size_t GetTileGroupCount() const;
 
   // Get a tile group with given layout
@@ -292,7 +313,7 @@ class DataTable : public AbstractTable {
                                 ItemPointer *index_entry_ptr);
 
   // check the foreign key constraints
-  bool CheckForeignKeyConstraints(const storage::Tuple *tuple);
+  bool CheckForeignKeyConstraints(const AbstractTuple *tuple);
 
  public:
   static size_t default_active_tilegroup_count_;
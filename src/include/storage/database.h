@@ -14,7 +14,9 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 
 #include "common/printable.h"
 #include "storage/data_table.h"
@@ -83,8 +85,23 @@ class Database : public Printable {
   // database name
   std::string database_name;
 
+  // The tables, hashed by name and oid. Writers replace the whole set under
+  // database_mutex, so readers only load the current one.
+  struct TableSet {
+    std::vector<storage::DataTable *> tables;
+    std::unordered_map<std::string, storage::DataTable *> tables_by_name;
+    std::unordered_map<oid_t, storage::DataTable *> tables_by_oid;
+  };
+
+  std::shared_ptr<const TableSet> GetTableSet() const {
+    return std::atomic_load(&table_set);
+  }
+
+  // Publish a new set with the given tables
+  void SetTables(std::vector<storage::DataTable *> &&tables);
+
   // TABLES
-  std::vector<storage::DataTable *> tables;
+  std::shared_ptr<const TableSet> table_set;
 
   std::mutex database_mutex;
 };
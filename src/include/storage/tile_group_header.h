@@ -13,6 +13,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <queue>
@@ -59,6 +60,17 @@ class TileGroup;
  * of the version chain header.
  *  ReservedField: unused space for future usage.
  *
+ *  A full tile group whose versions are all committed and live can be
+ *  frozen: scans whose snapshot is not older than the newest begin
+ *  timestamp then treat every slot as visible without reading the header.
+ *  Every change of a TxnID moves the write generation forward, which
+ *  thaws the tile group again.
+ *
+ *  A full tile group that has become sparse can be picked by the
+ *  gc::TileGroupCompactor. Its free slots are then no longer reused, its
+ *  live versions are moved to other tile groups, and it is released once
+ *  the GC has reset all of its slots.
+ *
  */
 
 #define TUPLE_HEADER_LOCATION data + (tuple_slot_id * header_entry_size)
@@ -82,6 +94,8 @@ class TileGroupHeader : public Printable {
     oid_t val = other.next_tuple_slot;
     next_tuple_slot = val;
 
+    write_generation++;
+
     return *this;
   }
 
@@ -182,6 +196,7 @@ class TileGroupHeader : public Printable {
   }
   inline void SetTransactionId(const oid_t &tuple_slot_id,
                                const txn_id_t &transaction_id) const {
+    write_generation++;
     *((txn_id_t *)(TUPLE_HEADER_LOCATION)) = transaction_id;
   }
 
@@ -214,12 +229,14 @@ class TileGroupHeader : public Printable {
   inline txn_id_t SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                          const txn_id_t &old_txn_id,
                                          const txn_id_t &new_txn_id) const {
+    write_generation++;
     txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_LOCATION);
     return __sync_val_compare_and_swap(txn_id_ptr, old_txn_id, new_txn_id);
   }
 
   inline bool SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                      const txn_id_t &transaction_id) const {
+    write_generation++;
     txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_LOCATION);
     return __sync_bool_compare_and_swap(txn_id_ptr, INITIAL_TXN_ID,
                                         transaction_id);
@@ -227,6 +244,86 @@ class TileGroupHeader : public Printable {
 
   void PrintVisibility(txn_id_t txn_id, cid_t at_cid);
 
+  //===--------------------------------------------------------------------===//
+  // Batch visibility
+  //===--------------------------------------------------------------------===//
+
+  // Must be read before the header columns that a freeze is based on
+  inline uint64_t GetWriteGeneration() const { return write_generation.load(); }
+
+  /*
+   * GetVisibleTuples() - Classify the slots in [start_tuple_id, end_tuple_id)
+   *                      for a snapshot by scanning the TxnID and commit id
+   *                      columns only
+   *
+   * Committed versions visible at snapshot_cid are appended to
+   * visible_tuples. Versions that are owned by a transaction are appended to
+   * undecided_tuples and have to be checked by the transaction manager.
+   * Empty and aborted slots are skipped.
+   *
+   * Returns true if every slot holds a committed version that has not been
+   * updated or deleted, and sets max_begin_cid to the newest begin
+   * timestamp among them.
+   */
+  bool GetVisibleTuples(const cid_t snapshot_cid, const oid_t start_tuple_id,
+                        const oid_t end_tuple_id,
+                        std::vector<oid_t> &visible_tuples,
+                        std::vector<oid_t> &undecided_tuples,
+                        cid_t &max_begin_cid) const;
+
+  /*
+   * IsFrozen() - Whether every slot is visible to a snapshot at snapshot_cid
+   */
+  bool IsFrozen(const cid_t snapshot_cid) const;
+
+  /*
+   * Freeze() - Mark a full tile group as frozen
+   *
+   * generation is the write generation read before GetVisibleTuples()
+   * reported all slots to be committed and live. Nothing happens if the
+   * header has been written since then.
+   */
+  void Freeze(const uint64_t generation, const cid_t max_begin_cid) const;
+
+  //===--------------------------------------------------------------------===//
+  // Compaction
+  //===--------------------------------------------------------------------===//
+
+  // Whether the compactor has picked the tile group
+  inline bool IsCompacting() const { return compacting_cid != MAX_CID; }
+
+  // Commit id at which the compactor picked the tile group. MAX_CID if it
+  // has not, INVALID_CID in the empty tile group that replaced a released
+  // one.
+  inline cid_t GetCompactingCid() const { return compacting_cid.load(); }
+
+  inline void SetCompactingCid(const cid_t cid) { compacting_cid = cid; }
+
+  // Number of slots held by garbage that the GC has not reset yet
+  inline size_t GetPendingGarbageCount() const {
+    return pending_garbage_count.load();
+  }
+
+  inline void IncreasePendingGarbageCount(const size_t count) {
+    pending_garbage_count.fetch_add(count);
+  }
+
+  inline void DecreasePendingGarbageCount(const size_t count) {
+    pending_garbage_count.fetch_sub(count);
+  }
+
+  // Number of slots reset by the GC that have not been handed out again
+  inline size_t GetFreeSlotCount() const { return free_slot_count.load(); }
+
+  // Returns the new count
+  inline size_t IncreaseFreeSlotCount(const size_t count) {
+    return free_slot_count.fetch_add(count) + count;
+  }
+
+  inline void DecreaseFreeSlotCount(const size_t count) {
+    free_slot_count.fetch_sub(count);
+  }
+
   // Getter for spin lock
 
   Spinlock &GetHeaderLock() { return tile_header_lock; }
@@ -259,6 +356,12 @@ class TileGroupHeader : public Printable {
   static const size_t reserved_field_offset =
       indirection_offset + sizeof(ItemPointer);
 
+  // frozen_generation of a tile group that has never been frozen
+  static const uint64_t INVALID_GENERATION = UINT64_MAX;
+
+  // frozen_generation while a freeze is being published
+  static const uint64_t FREEZING_GENERATION = UINT64_MAX - 1;
+
  private:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -284,6 +387,24 @@ class TileGroupHeader : public Printable {
   std::atomic<oid_t> next_tuple_slot;
 
   Spinlock tile_header_lock;
+
+  // bumped whenever the TxnID of a slot changes
+  mutable std::atomic<uint64_t> write_generation;
+
+  // write generation the tile group was frozen at
+  mutable std::atomic<uint64_t> frozen_generation;
+
+  // newest begin timestamp of a frozen tile group
+  mutable std::atomic<cid_t> frozen_cid;
+
+  // commit id at which the compactor picked the tile group
+  std::atomic<cid_t> compacting_cid;
+
+  // slots of garbage recycled by the GC but not reset yet
+  std::atomic<size_t> pending_garbage_count;
+
+  // slots reset by the GC and not reused yet
+  std::atomic<size_t> free_slot_count;
 };
 
 }  // End storage namespace
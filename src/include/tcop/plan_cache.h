@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_cache.h
+//
+// Identification: src/include/tcop/plan_cache.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+#define PLAN_CACHE_MAX_QUERIES 1024
+#define PLAN_CACHE_MAX_IDLE_STATEMENTS 8
+
+namespace peloton {
+
+class Statement;
+
+namespace tcop {
+
+//===--------------------------------------------------------------------===//
+// Plan Cache
+//===--------------------------------------------------------------------===//
+
+// Server-wide cache of prepared statements for simple queries, keyed by the
+// query text with its literals replaced by parameters. Binding parameters
+// modifies a plan, so a cached statement is used by one query at a time:
+// Acquire() takes an idle statement out of the cache and Release() puts it
+// back after the query. Queries that run at the same time get statements of
+// their own, and the cache keeps a few idle ones per query.
+class PlanCache {
+ public:
+  PlanCache(const PlanCache &) = delete;
+  PlanCache &operator=(const PlanCache &) = delete;
+
+  PlanCache(size_t max_queries = PLAN_CACHE_MAX_QUERIES,
+            size_t max_idle_statements = PLAN_CACHE_MAX_IDLE_STATEMENTS);
+
+  static PlanCache &GetInstance();
+
+  // Replace the literals of a SELECT, INSERT, UPDATE or DELETE with
+  // parameters $1, $2, ... The parameterized query goes to query_string and
+  // the values of the literals to params. key identifies the plan, i.e. the
+  // query string and the types of the literals. Returns false if the query
+  // has to be planned with its literals, e.g. the literals of LIMIT, the SET
+  // clause of an UPDATE and inserts of several rows.
+  static bool ParameterizeQuery(const std::string &query, std::string &key,
+                                std::string &query_string,
+                                std::vector<type::Value> &params);
+
+  // Take an idle statement of the key out of the cache, or return nullptr.
+  // version is set for the Release() of the statement.
+  std::shared_ptr<Statement> Acquire(const std::string &key,
+                                     uint64_t &version);
+
+  // Put a statement back into the cache after its query. The statement is
+  // dropped if the cache was invalidated after Acquire() returned version.
+  void Release(const std::string &key,
+               const std::shared_ptr<Statement> &statement, uint64_t version);
+
+  // Drop the statements that reference the table
+  void InvalidateTable(oid_t table_id);
+
+  // Drop all statements, e.g. after DDL
+  void Clear();
+
+  // Number of queries with cached statements
+  size_t GetQueryCount();
+
+ private:
+  struct Entry {
+    std::vector<std::shared_ptr<Statement>> idle_statements;
+    std::set<oid_t> table_ids;
+    std::list<std::string>::iterator lru_itr;
+  };
+
+  std::mutex cache_mutex_;
+
+  // Key -> idle statements
+  std::unordered_map<std::string, Entry> entries_;
+
+  // Keys, most recently used first
+  std::list<std::string> lru_keys_;
+
+  // Bumped by every invalidation
+  uint64_t version_ = 0;
+
+  size_t max_queries_;
+
+  size_t max_idle_statements_;
+};
+
+}  // End tcop namespace
+}  // End peloton namespace
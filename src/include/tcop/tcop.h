@@ -61,17 +61,39 @@ class TrafficCop {
       const std::vector<int> &result_format, std::vector<StatementResult> &result,
       int &rows_change, std::string &error_message);
 
+  // ExecPrepStmt - Same as above, but hands the result tiles to
+  // result_callback as they are produced instead of collecting them
+  ResultType ExecuteStatement(
+      const std::shared_ptr<Statement> &statement,
+      const std::vector<type::Value> &params, const bool unnamed,
+      std::shared_ptr<stats::QueryMetric::QueryParams> param_stats,
+      const bridge::ResultTileCallback &result_callback, int &rows_change,
+      std::string &error_message);
+
   // ExecutePrepStmt - Helper to handle txn-specifics for the plan-tree of a
   // statement
   bridge::peloton_status ExecuteStatementPlan(
       const planner::AbstractPlan *plan, const std::vector<type::Value> &params,
       std::vector<StatementResult> &result, const std::vector<int> &result_format);
 
+  bridge::peloton_status ExecuteStatementPlan(
+      const planner::AbstractPlan *plan, const std::vector<type::Value> &params,
+      const bridge::ResultTileCallback &result_callback);
+
   // InitBindPrepStmt - Prepare and bind a query from a query string
   std::shared_ptr<Statement> PrepareStatement(const std::string &statement_name,
                                               const std::string &query_string,
                                               std::string &error_message);
 
+  // Prepare a simple query with the server-wide plan cache. The literals of
+  // the query are returned in params and are bound to the plan. The
+  // statement is handed back with ReleaseCachedStatement() after it ran.
+  std::shared_ptr<Statement> PrepareCachedStatement(
+      const std::string &query_string, std::vector<type::Value> &params,
+      std::string &error_message);
+
+  void ReleaseCachedStatement(const std::shared_ptr<Statement> &statement);
+
   std::vector<FieldInfo> GenerateTupleDescriptor(
       parser::SQLStatement *select_stmt);
 
@@ -93,6 +115,11 @@ class TrafficCop {
   typedef std::pair<concurrency::Transaction *, ResultType> TcopTxnState;
   std::stack<TcopTxnState> tcop_txn_state_;
 
+  // Plan cache key and version of the statement from
+  // PrepareCachedStatement(), the key is empty if it is not cached
+  std::string cached_statement_key_;
+  uint64_t cached_statement_version_ = 0;
+
  private:
   static TcopTxnState &GetDefaultTxnState();
 
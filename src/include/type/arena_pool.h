@@ -0,0 +1,88 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// arena_pool.h
+//
+// Identification: src/include/type/arena_pool.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/platform.h"
+#include "type/abstract_pool.h"
+
+namespace peloton {
+namespace type {
+
+// A memory pool that carves allocations out of large chunks and releases
+// all of them at once when it is destroyed. Every thread bumps a pointer
+// through a chunk of its own, so an allocation takes no lock and needs no
+// bookkeeping; the lock is only taken to hand out a new chunk. The pool
+// keeps the chunk of each thread, so a thread can allocate from any number
+// of pools in turn without giving up its chunks.
+//
+// Free() does not give memory back, so the pool suits memory that lives as
+// long as the pool, like the values of a query.
+class ArenaPool : public AbstractPool {
+public:
+  ArenaPool();
+
+  // Destroy this pool, and all memory it owns.
+  ~ArenaPool();
+
+  // Allocate a contiguous block of memory of the given size, aligned to 8
+  // bytes.
+  void *Allocate(size_t size);
+
+  // Memory is only released when the pool is destroyed.
+  void Free(UNUSED_ATTRIBUTE void *ptr) {}
+
+  // Number of bytes held by the pool, in chunks.
+  size_t GetReservedSize() const { return reserved_size_.load(); }
+
+  // Allocations are carved from chunks of this size.
+  static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+  // Threads past this many allocate from a chunk they share, under the lock.
+  static constexpr size_t MAX_THREAD_COUNT = 64;
+
+private:
+  // The chunk a thread currently allocates from
+  struct ThreadChunk {
+    char *next = nullptr;
+    char *end = nullptr;
+  } CACHE_ALIGNED;
+
+  void *AllocateShared(size_t size);
+
+  char *AllocateChunk(size_t size);
+
+  // Add a chunk to the pool, with the chunk lock held
+  char *AddChunk(size_t size);
+
+  // The chunk of every thread, by the slot of the thread
+  ThreadChunk thread_chunks_[MAX_THREAD_COUNT];
+
+  // The chunk of the threads without a slot, protected by the chunk lock
+  ThreadChunk shared_chunk_;
+
+  // All chunks of the pool
+  std::vector<char *> chunks_;
+
+  // Spin lock protecting the chunk list
+  Spinlock chunk_lock_;
+
+  std::atomic<size_t> reserved_size_;
+};
+
+}  // namespace type
+}  // namespace peloton
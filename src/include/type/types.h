@@ -381,7 +381,8 @@ enum SqlStateErrorCode {
 
 enum class ConcurrencyType {
   INVALID = INVALID_TYPE_ID,
-  TIMESTAMP_ORDERING = 1  // timestamp ordering
+  TIMESTAMP_ORDERING = 1,        // timestamp ordering
+  TIMESTAMP_ORDERING_EPOCH = 2   // timestamp ordering, epoch-based commit ids
 };
 
 //===--------------------------------------------------------------------===//
@@ -546,6 +547,7 @@ enum class PlanNodeType {
   // Utility
   RESULT = 70,
   COPY = 71,
+  ANALYZE = 72,
 
   // Test
   MOCK = 80
@@ -583,7 +585,8 @@ enum class StatementType {
   RENAME = 11,                // rename statement type
   ALTER = 12,                 // alter statement type
   TRANSACTION = 13,           // transaction statement type,
-  COPY = 14                   // copy type
+  COPY = 14,                  // copy type
+  ANALYZE = 15                // analyze type
 };
 std::string StatementTypeToString(StatementType type);
 StatementType StringToStatementType(const std::string &str);
@@ -929,6 +932,10 @@ enum MetricType {
   QUERY_METRIC = 9,
   // Statistics for CPU
   PROCESSOR_METRIC = 10,
+  // Distribution of values, e.g. commit latencies
+  HISTOGRAM_METRIC = 11,
+  // Free space in the tile groups of a table
+  FRAGMENTATION_METRIC = 12,
 };
 
 static const int INVALID_FILE_DESCRIPTOR = -1;
@@ -1048,10 +1055,6 @@ std::ostream &operator<<(std::ostream &os, const RWType &type);
 
 enum class GCSetType { COMMITTED, ABORTED };
 
-// block -> offset -> type
-typedef std::unordered_map<oid_t, std::unordered_map<oid_t, RWType>>
-    ReadWriteSet;
-
 // block -> offset -> is_index_deletion
 typedef std::unordered_map<oid_t, std::unordered_map<oid_t, bool>>
     GCSet;
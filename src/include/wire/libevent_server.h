@@ -40,6 +40,11 @@
 #define QUEUE_SIZE 100
 #define MASTER_THREAD_ID -1
 
+// How long a query waits for the client to take its result rows before the
+// connection is given up. The query holds the worker thread of the
+// connection meanwhile, so the wait must stay short.
+#define STREAM_WRITE_TIMEOUT_MS 1000
+
 namespace peloton {
 namespace wire {
 
@@ -207,6 +212,12 @@ class LibeventSocket {
 
   WriteState WritePackets();
 
+  // Writes the queued responses while a query is still running, waiting for
+  // the socket to become writable when the client falls behind. Returns
+  // false if the connection failed, or if the client did not take the
+  // responses within STREAM_WRITE_TIMEOUT_MS.
+  bool StreamResponses();
+
   void PrintWriteBuffer();
 
   void CloseSocket();
@@ -20,7 +20,15 @@
 
 #define BUFFER_INIT_SIZE 100
 
+// Length of a NULL field in a DataRow message
+#define NULL_CONTENT_SIZE -1
+
 namespace peloton {
+
+namespace storage {
+class Tile;
+}
+
 namespace wire {
 
 class LibeventSocket;
@@ -145,6 +153,34 @@ extern void PacketPutCbytes(OutputPacket *pkt, const uchar *b, int len);
 /* packet_put_bytes - used to write a uchar vector into a packet */
 extern void PacketPutBytes(OutputPacket *pkt, const std::vector<uchar> &data);
 
+/* packet_put_int64 - used to write a 64-bit int into a packet */
+extern void PacketPutInt64(OutputPacket *pkt, int64_t n);
+
+/*
+* packet_set_int - overwrite the 32-bit int at offset of the packet, e.g. a
+* 	message length that is known only after the message is written
+*/
+extern void PacketSetInt(OutputPacket *pkt, size_t offset, int n);
+
+/*
+* packet_put_tile_field - write the value of a column of a tile tuple as a
+* 	DataRow field: its length, or -1 for NULL, followed by the value in
+* 	the text (format 0) or binary (format 1) format of PostgreSQL. Binary
+* 	values and strings are copied from the tile memory without building
+* 	a Value.
+*/
+extern void PacketPutTileField(OutputPacket *pkt, storage::Tile *tile,
+                               oid_t tuple_offset, oid_t column_id,
+                               int format);
+
+/*
+* has_binary_format - whether fields described with the given PostgreSQL
+* 	type are written in the binary format when the client asks for it.
+* 	Fields of the other types are sent as text, and must be described
+* 	with the text format code.
+*/
+extern bool HasBinaryFormat(PostgresValueType field_type);
+
 /*
 * Unmarshallers
 */
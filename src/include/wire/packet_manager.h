@@ -13,6 +13,7 @@
 #pragma once
 
 #include <boost/assign/list_of.hpp>
+#include <functional>
 #include <iostream>
 #include <mutex>
 #include <string>
@@ -25,9 +26,6 @@
 #include "tcop/tcop.h"
 #include "wire/marshal.h"
 
-// Packet content macros
-#define NULL_CONTENT_SIZE -1
-
 namespace peloton {
 
 namespace wire {
@@ -96,6 +94,12 @@ class PacketManager {
   // so that we don't have to new packet each time
   ResponseBuffer responses;
 
+  // Set by the socket of the connection. Writes the responses queued so far
+  // to the client, waiting until the socket takes them, so that a query
+  // streams its result rows instead of buffering all of them. Returns false
+  // if the connection failed.
+  std::function<bool()> stream_responses;
+
  private:
   //===--------------------------------------------------------------------===//
   // PROTOCOL HANDLING FUNCTIONS
@@ -108,11 +112,17 @@ class PacketManager {
   // Sends ready for query packet to the frontend
   void SendReadyForQuery(NetworkTransactionStateType txn_status);
 
-  // Sends the attribute headers required by SELECT queries
-  void PutTupleDescriptor(const std::vector<FieldInfo>& tuple_descriptor);
-
-  // Send each row, one packet at a time, used by SELECT queries
-  void SendDataRows(std::vector<StatementResult>& results, int colcount,
+  // Sends the attribute headers required by SELECT queries, with the format
+  // codes of the columns. Columns without a format code are text.
+  void PutTupleDescriptor(
+      const std::vector<FieldInfo>& tuple_descriptor,
+      const std::vector<int>& result_format = std::vector<int>());
+
+  // Send the rows of a result tile, used by SELECT queries. All rows of the
+  // tile are coalesced into one packet, and queued rows are streamed to the
+  // client once they fill the socket buffer.
+  void SendDataRows(executor::LogicalTile* tile,
+                    const std::vector<int>& result_format, int colcount,
                     int& rows_affected);
 
   // Used to send a packet that indicates the completion of a query. Also has
@@ -165,6 +175,13 @@ class PacketManager {
   // global txn state
   NetworkTransactionStateType txn_state_;
 
+  // Bytes of result rows queued since they were last streamed
+  size_t queued_row_bytes_ = 0;
+
+  // Set when streaming failed. The rest of the result is dropped, and the
+  // connection is closed once the query is done.
+  bool stream_failed_ = false;
+
   // state to mang skipped queries
   bool skipped_stmt_ = false;
   std::string skipped_query_string_;
@@ -20,6 +20,69 @@
 namespace peloton {
 namespace index {
 
+/*
+ * class BWTreeScanCursor - Reads the entries of a scan from a BwTree iterator
+ *
+ * The iterator keeps a snapshot of the leaf page it is on, so the scan can
+ * be suspended between two batches without holding on to an epoch
+ */
+template <typename MapType, typename KeyType>
+class BWTreeScanCursor : public IndexScanCursor {
+ public:
+  // Scan all the entries
+  BWTreeScanCursor(MapType *container, IndexMetadata *metadata)
+      : container_(container),
+        metadata_(metadata),
+        scan_itr_(container->Begin()),
+        bounded_(false) {}
+
+  // Scan the entries from the low key to the high key, both included
+  BWTreeScanCursor(MapType *container, IndexMetadata *metadata,
+                   const KeyType &low_key, const KeyType &high_key)
+      : container_(container),
+        metadata_(metadata),
+        scan_itr_(container->Begin(low_key)),
+        high_key_(high_key),
+        bounded_(true) {}
+
+  bool Next(std::vector<ItemPointer *> &result, size_t batch_size) {
+    size_t entry_count = 0;
+
+    while (entry_count < batch_size && finished_ == false) {
+      if (scan_itr_.IsEnd() == true ||
+          (bounded_ == true &&
+           container_->KeyCmpLessEqual(scan_itr_->first, high_key_) == false)) {
+        finished_ = true;
+        break;
+      }
+
+      result.push_back(scan_itr_->second);
+      scan_itr_++;
+      entry_count++;
+    }
+
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+          entry_count, metadata_);
+    }
+
+    return (entry_count > 0);
+  }
+
+ private:
+  MapType *container_;
+
+  IndexMetadata *metadata_;
+
+  typename MapType::ForwardIterator scan_itr_;
+
+  KeyType high_key_;
+
+  bool bounded_;
+
+  bool finished_ = false;
+};
+
 BWTREE_TEMPLATE_ARGUMENTS
 BWTREE_INDEX_TYPE::BWTreeIndex(IndexMetadata *metadata)
     :  // Base class
@@ -273,6 +336,42 @@ void BWTREE_INDEX_TYPE::ScanKey(const storage::Tuple *key,
   return;
 }
 
+/*
+ * OpenScan() - Opens a cursor that reads the index as batches are pulled
+ *
+ * Full and interval scans keep an iterator into the tree between batches.
+ * Point queries fetch the few values of the key at once, as Scan() does
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+std::unique_ptr<IndexScanCursor> BWTREE_INDEX_TYPE::OpenScan(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, const ConjunctionScanPredicate *csp_p) {
+  // This is a hack - we do not support backward scan
+  if (scan_direction == ScanDirectionType::INVALID) {
+    throw Exception("Invalid scan direction \n");
+  }
+
+  using ScanCursor = BWTreeScanCursor<MapType, KeyType>;
+
+  if (csp_p == nullptr || csp_p->IsFullIndexScan() == true) {
+    return std::unique_ptr<IndexScanCursor>(
+        new ScanCursor(&container, metadata));
+  } else if (csp_p->IsPointQuery() == true) {
+    return Index::OpenScan(value_list, tuple_column_id_list, expr_list,
+                           scan_direction, csp_p);
+  }
+
+  KeyType index_low_key;
+  KeyType index_high_key;
+  index_low_key.SetFromKey(csp_p->GetLowKey());
+  index_high_key.SetFromKey(csp_p->GetHighKey());
+
+  return std::unique_ptr<IndexScanCursor>(
+      new ScanCursor(&container, metadata, index_low_key, index_high_key));
+}
+
 BWTREE_TEMPLATE_ARGUMENTS
 std::string BWTREE_INDEX_TYPE::GetTypeName() const { return "BWTree"; }
 
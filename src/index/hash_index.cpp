@@ -0,0 +1,364 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index.cpp
+//
+// Identification: src/index/hash_index.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+#include "index/hash_index.h"
+
+#include "common/logger.h"
+#include "index/index_key.h"
+#include "index/scan_optimizer.h"
+#include "statistics/stats_aggregator.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace index {
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+HASH_INDEX_TYPE::HashIndex(IndexMetadata *metadata)
+    :  // Base class
+      Index{metadata},
+      // Key "less than" relation comparator (only used for range fallback)
+      comparator{},
+      // Key equality checker
+      equals{},
+      // Key hash function
+      hash_func{},
+      overflow_bytes{0},
+      container{INITIAL_SIZE, DEFAULT_MINIMUM_LOAD_FACTOR,
+                NO_MAXIMUM_HASHPOWER, hash_func, equals} {
+  return;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+HASH_INDEX_TYPE::~HashIndex() {}
+
+/*
+ * InsertEntry() - insert a key-value pair into the map
+ *
+ * If the key value pair already exists in the map, just return false
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::InsertEntry(const storage::Tuple *key,
+                                  ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  ValueEqualityChecker value_equals;
+  bool ret = true;
+
+  Spinlock &write_lock = GetWriteLock(index_key);
+  write_lock.Lock();
+
+  container.upsert(index_key, [&](ValueList &value_list) {
+    for (size_t i = 0; i < value_list.GetSize(); i++) {
+      if (value_equals(value_list.GetValue(i), value) == true) {
+        ret = false;
+        return;
+      }
+    }
+
+    size_t old_bytes = value_list.GetOverflowBytes();
+    value_list.Append(value);
+    overflow_bytes += value_list.GetOverflowBytes() - old_bytes;
+  }, ValueList{value});
+
+  write_lock.Unlock();
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return ret;
+}
+
+/*
+ * DeleteEntry() - Removes a key-value pair
+ *
+ * If the key-value pair does not exists yet in the map return false. The
+ * key is erased from the table together with its last value
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::DeleteEntry(const storage::Tuple *key,
+                                  ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  ValueEqualityChecker value_equals;
+  bool ret = false;
+  bool is_empty = false;
+  size_t freed_bytes = 0;
+
+  Spinlock &write_lock = GetWriteLock(index_key);
+  write_lock.Lock();
+
+  container.update_fn(index_key, [&](ValueList &value_list) {
+    for (size_t i = 0; i < value_list.GetSize(); i++) {
+      if (value_equals(value_list.GetValue(i), value) == true) {
+        value_list.Remove(i);
+        ret = true;
+        break;
+      }
+    }
+
+    is_empty = (value_list.GetSize() == 0);
+    if (is_empty == true) {
+      freed_bytes = value_list.GetOverflowBytes();
+    }
+  });
+
+  // Nobody else can modify this key while we hold the write lock
+  if (is_empty == true) {
+    container.erase(index_key);
+    overflow_bytes -= freed_bytes;
+  }
+
+  write_lock.Unlock();
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexDeletes(
+        ret == true ? 1 : 0, metadata);
+  }
+
+  return ret;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::CondInsertEntry(
+    const storage::Tuple *key, ItemPointer *value,
+    std::function<bool(const void *)> predicate) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  ValueEqualityChecker value_equals;
+  bool ret = true;
+
+  Spinlock &write_lock = GetWriteLock(index_key);
+  write_lock.Lock();
+
+  // The predicate is evaluated and the value appended under the same
+  // bucket lock, so no other writer can slip in between
+  container.upsert(index_key, [&](ValueList &value_list) {
+    for (size_t i = 0; i < value_list.GetSize(); i++) {
+      const ValueType &existing_value = value_list.GetValue(i);
+      if (predicate(existing_value) == true ||
+          value_equals(existing_value, value) == true) {
+        ret = false;
+        return;
+      }
+    }
+
+    size_t old_bytes = value_list.GetOverflowBytes();
+    value_list.Append(value);
+    overflow_bytes += value_list.GetOverflowBytes() - old_bytes;
+  }, ValueList{value});
+
+  write_lock.Unlock();
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return ret;
+}
+
+/*
+ * Scan() - Scans the index using index scan optimizer
+ *
+ * Point queries are a single hash lookup. There is no key order in a hash
+ * table, so full scans and interval scans walk the whole table (interval
+ * scans filter with the low and high key) and the result is unordered
+ * regardless of the scan direction
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::Scan(
+    UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
+    UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
+    UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, std::vector<ValueType> &result,
+    const ConjunctionScanPredicate *csp_p) {
+  if (scan_direction == ScanDirectionType::INVALID) {
+    throw Exception("Invalid scan direction \n");
+  }
+
+  LOG_TRACE("Scan() Point Query = %d; Full Scan = %d ", csp_p->IsPointQuery(),
+            csp_p->IsFullIndexScan());
+
+  size_t result_start = result.size();
+
+  if (csp_p->IsPointQuery() == true) {
+    const storage::Tuple *point_query_key_p = csp_p->GetPointQueryKey();
+
+    KeyType point_query_key;
+    point_query_key.SetFromKey(point_query_key_p);
+
+    GetValue(point_query_key, result);
+  } else if (csp_p->IsFullIndexScan() == true) {
+    ScanAllKeys(result);
+    return;
+  } else {
+    LOG_DEBUG("Range predicate on hash index %s; falling back to full scan",
+              GetName().c_str());
+
+    KeyType index_low_key;
+    KeyType index_high_key;
+    index_low_key.SetFromKey(csp_p->GetLowKey());
+    index_high_key.SetFromKey(csp_p->GetHighKey());
+
+    // This blocks all writers until the scan finishes
+    auto locked_table = container.lock_table();
+    for (const auto &item : locked_table) {
+      if (comparator(item.first, index_low_key) == true ||
+          comparator(index_high_key, item.first) == true) {
+        continue;
+      }
+
+      const ValueList &values = item.second;
+      for (size_t i = 0; i < values.GetSize(); i++) {
+        result.push_back(values.GetValue(i));
+      }
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size() - result_start, metadata);
+  }
+
+  return;
+}
+
+/*
+ * ScanLimit() - Scan the index with predicate and limit/offset
+ *
+ * A hash index has no key order to take "min" or "max" from, so this is
+ * always a normal scan
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanLimit(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, std::vector<ValueType> &result,
+    const ConjunctionScanPredicate *csp_p, UNUSED_ATTRIBUTE uint64_t limit,
+    UNUSED_ATTRIBUTE uint64_t offset) {
+  Scan(value_list, tuple_column_id_list, expr_list, scan_direction, result,
+       csp_p);
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanAllKeys(std::vector<ValueType> &result) {
+  size_t result_start = result.size();
+
+  {
+    auto locked_table = container.lock_table();
+    for (const auto &item : locked_table) {
+      const ValueList &values = item.second;
+      for (size_t i = 0; i < values.GetSize(); i++) {
+        result.push_back(values.GetValue(i));
+      }
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size() - result_start, metadata);
+  }
+  return;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanKey(const storage::Tuple *key,
+                              std::vector<ValueType> &result) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  size_t result_start = result.size();
+  GetValue(index_key, result);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size() - result_start, metadata);
+  }
+
+  return;
+}
+
+/*
+ * GetValue() - Append all values of a key to the result
+ *
+ * update_fn() is used as an in-place find: it takes the same bucket locks
+ * as find() but does not copy the value list out of the table
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::GetValue(const KeyType &key,
+                               std::vector<ValueType> &result) {
+  container.update_fn(key, [&result](ValueList &value_list) {
+    for (size_t i = 0; i < value_list.GetSize(); i++) {
+      result.push_back(value_list.GetValue(i));
+    }
+  });
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+size_t HASH_INDEX_TYPE::GetMemoryFootprint() {
+  return container.bucket_count() * MapType::slot_per_bucket *
+             sizeof(typename MapType::value_type) +
+         overflow_bytes.load();
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+std::string HASH_INDEX_TYPE::GetTypeName() const { return "Hash"; }
+
+// IMPORTANT: Make sure you don't exceed CompactIntegerKey_MAX_SLOTS
+
+template class HashIndex<CompactIntsKey<1>, ItemPointer *,
+                         CompactIntsComparator<1>,
+                         CompactIntsEqualityChecker<1>, CompactIntsHasher<1>,
+                         ItemPointerComparator>;
+template class HashIndex<CompactIntsKey<2>, ItemPointer *,
+                         CompactIntsComparator<2>,
+                         CompactIntsEqualityChecker<2>, CompactIntsHasher<2>,
+                         ItemPointerComparator>;
+template class HashIndex<CompactIntsKey<3>, ItemPointer *,
+                         CompactIntsComparator<3>,
+                         CompactIntsEqualityChecker<3>, CompactIntsHasher<3>,
+                         ItemPointerComparator>;
+template class HashIndex<CompactIntsKey<4>, ItemPointer *,
+                         CompactIntsComparator<4>,
+                         CompactIntsEqualityChecker<4>, CompactIntsHasher<4>,
+                         ItemPointerComparator>;
+
+// Generic key
+template class HashIndex<GenericKey<4>, ItemPointer *,
+                         FastGenericComparator<4>, GenericEqualityChecker<4>,
+                         GenericHasher<4>, ItemPointerComparator>;
+template class HashIndex<GenericKey<8>, ItemPointer *,
+                         FastGenericComparator<8>, GenericEqualityChecker<8>,
+                         GenericHasher<8>, ItemPointerComparator>;
+template class HashIndex<GenericKey<16>, ItemPointer *,
+                         FastGenericComparator<16>,
+                         GenericEqualityChecker<16>, GenericHasher<16>,
+                         ItemPointerComparator>;
+template class HashIndex<GenericKey<64>, ItemPointer *,
+                         FastGenericComparator<64>,
+                         GenericEqualityChecker<64>, GenericHasher<64>,
+                         ItemPointerComparator>;
+template class HashIndex<GenericKey<256>, ItemPointer *,
+                         FastGenericComparator<256>,
+                         GenericEqualityChecker<256>, GenericHasher<256>,
+                         ItemPointerComparator>;
+
+// Tuple key
+template class HashIndex<TupleKey, ItemPointer *, TupleKeyComparator,
+                         TupleKeyEqualityChecker, TupleKeyHasher,
+                         ItemPointerComparator>;
+
+}  // End index namespace
+}  // End peloton namespace
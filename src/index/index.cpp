@@ -15,7 +15,7 @@
 #include "common/exception.h"
 #include "common/logger.h"
 #include "storage/tuple.h"
-#include "type/ephemeral_pool.h"
+#include "type/arena_pool.h"
 
 #include "index/scan_optimizer.h"
 
@@ -140,7 +140,7 @@ Index::Index(IndexMetadata *metadata)
   lookup_counter = insert_counter = delete_counter = update_counter = 0;
 
   // initialize pool
-  pool = new type::EphemeralPool();
+  pool = new type::ArenaPool();
 
   return;
 }
@@ -185,6 +185,41 @@ oid_t Index::TupleColumnToKeyColumn(oid_t tuple_column_id) const {
   return key_column_id;
 }
 
+/*
+ * OpenScan() - Collects the entries of the scan and hands them out in batches
+ */
+std::unique_ptr<IndexScanCursor> Index::OpenScan(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, const ConjunctionScanPredicate *csp_p) {
+  std::vector<ItemPointer *> entries;
+
+  if (csp_p == nullptr) {
+    ScanAllKeys(entries);
+  } else {
+    Scan(value_list, tuple_column_id_list, expr_list, scan_direction, entries,
+         csp_p);
+  }
+
+  return std::unique_ptr<IndexScanCursor>(
+      new ResultScanCursor(std::move(entries)));
+}
+
+bool ResultScanCursor::Next(std::vector<ItemPointer *> &result,
+                            size_t batch_size) {
+  if (next_entry_ >= entries_.size()) {
+    return false;
+  }
+
+  size_t end_entry = std::min(entries_.size(), next_entry_ + batch_size);
+  result.insert(result.end(), entries_.begin() + next_entry_,
+                entries_.begin() + end_entry);
+  next_entry_ = end_entry;
+
+  return true;
+}
+
 /*
  * ScanTest() - This is used inside the unit test to check correctness of
  *              scan optimizer - do not change or remove this
@@ -15,7 +15,8 @@
 namespace peloton {
 namespace index {
 
-// Add your function definitions here
+// SkipList is a header-only template; it is instantiated by SkipListIndex
+// in skiplist_index.cpp
 
 }  // End index namespace
 }  // End peloton namespace
@@ -130,8 +130,7 @@ void Checkpoint::RecoverTuple(storage::Tuple *tuple, storage::DataTable *table,
   if (inserted_tuple_slot == INVALID_OID) {
     // TODO: We need to abort on failure!
   } else {
-    // TODO this is not thread safe
-    table->SetTupleCount(table->GetTupleCount() + 1);
+    table->IncreaseTupleCount(1);
   }
 }
 
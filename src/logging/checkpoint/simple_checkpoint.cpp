@@ -13,6 +13,8 @@
 #include <dirent.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <numeric>
 
@@ -62,15 +64,7 @@ SimpleCheckpoint::~SimpleCheckpoint() {
 }
 
 void SimpleCheckpoint::DoCheckpoint() {
-  // TODO split checkpoint file into multiple files in the future
-  // Create a new file for checkpoint
-  CreateFile();
-
   auto &log_manager = LogManager::GetInstance();
-  if (logger_ == nullptr) {
-    logger_.reset(BackendLogger::GetBackendLogger(LoggingType::NVM_WAL));
-  }
-
   start_commit_id_ = log_manager.GetGlobalMaxFlushedCommitId();
   if (start_commit_id_ == INVALID_CID) {
     auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
@@ -79,13 +73,8 @@ void SimpleCheckpoint::DoCheckpoint() {
 
   LOG_TRACE("DoCheckpoint cid = %lu", start_commit_id_);
 
-  // Add txn begin record
-  std::shared_ptr<LogRecord> begin_record(new TransactionRecord(
-      LOGRECORD_TYPE_TRANSACTION_BEGIN, start_commit_id_));
-  CopySerializeOutput begin_output_buffer;
-  begin_record->Serialize(begin_output_buffer);
-  records_.push_back(begin_record);
-
+  // Split the tables into parts
+  std::vector<CheckpointPart> parts;
   auto catalog = catalog::Catalog::GetInstance();
   auto database_count = catalog->GetDatabaseCount();
 
@@ -100,23 +89,54 @@ void SimpleCheckpoint::DoCheckpoint() {
       // Get the target table
       storage::DataTable *target_table = database->GetTable(table_idx);
       PL_ASSERT(target_table);
-      LOG_TRACE("SeqScan: database idx %u table idx %u: %s", database_idx,
-                table_idx, target_table->GetName().c_str());
-      Scan(target_table, database_oid);
+      auto tile_group_count = target_table->GetTileGroupCount();
+      for (oid_t tile_group_offset = START_OID;
+           tile_group_offset < tile_group_count;
+           tile_group_offset += CHECKPOINT_TILE_GROUPS_PER_FILE) {
+        CheckpointPart part;
+        part.table = target_table;
+        part.database_oid = database_oid;
+        part.begin_offset = tile_group_offset;
+        part.end_offset = std::min<oid_t>(
+            tile_group_offset + CHECKPOINT_TILE_GROUPS_PER_FILE,
+            tile_group_count);
+        parts.push_back(part);
+      }
     }
   }
 
-  // Add txn commit record
-  std::shared_ptr<LogRecord> commit_record(new TransactionRecord(
-      LOGRECORD_TYPE_TRANSACTION_COMMIT, start_commit_id_));
-  CopySerializeOutput commit_output_buffer;
-  commit_record->Serialize(commit_output_buffer);
-  records_.push_back(commit_record);
+  if (!disable_file_access) {
+    checkpoint_version++;
+  }
+
+  // Stream the parts to their files. Writers are not stalled, the tuples are
+  // read as of the checkpoint cid.
+  bool success = ForEachPart(parts.size(), [this, &parts](size_t part_idx) {
+    return WritePart(parts[part_idx], part_idx);
+  });
+  if (success == true && !disable_file_access) {
+    success = WriteManifest(parts.size());
+  }
 
-  // TODO Add delimiter record for checkpoint recovery as well
-  Persist();
+  if (success == false) {
+    LOG_ERROR("Failed to write checkpoint %d", checkpoint_version);
+    if (!disable_file_access) {
+      RemoveFiles(checkpoint_version, checkpoint_version);
+      checkpoint_version--;
+    }
+    return;
+  }
 
-  Cleanup();
+  LOG_TRACE("Wrote checkpoint %d in %lu files", checkpoint_version,
+            parts.size());
+
+  // Remove previous versions
+  if (!disable_file_access) {
+    RemoveFiles(0, checkpoint_version - 1);
+  }
+
+  // Truncate logs
+  LogManager::GetInstance().TruncateLogs(start_commit_id_);
   most_recent_checkpoint_cid = start_commit_id_;
 }
 
@@ -125,53 +145,42 @@ cid_t SimpleCheckpoint::DoRecovery() {
   if (checkpoint_version < 0) {
     return 0;
   }
-  // we open checkpoint file in read + binary mode
+
+  // Read the manifest
+  FileHandle file_handle;
   std::string file_name = ConcatFileName(checkpoint_dir, checkpoint_version);
   bool success =
-      LoggingUtil::InitFileHandle(file_name.c_str(), file_handle_, "rb");
+      LoggingUtil::InitFileHandle(file_name.c_str(), file_handle, "rb");
   if (!success) {
     return 0;
   }
 
-  auto size = LoggingUtil::GetLogFileSize(file_handle_);
-  PL_ASSERT(size > 0);
-  file_handle_.size = size;
-
-  bool should_stop = false;
-  cid_t commit_id = 0;
-  while (!should_stop) {
-    auto record_type = LoggingUtil::GetNextLogRecordType(file_handle_);
-    switch (record_type) {
-      case LOGRECORD_TYPE_WAL_TUPLE_INSERT: {
-        LOG_TRACE("Read checkpoint insert entry");
-        InsertTuple(commit_id);
-        break;
-      }
-      case LOGRECORD_TYPE_TRANSACTION_COMMIT: {
-        should_stop = true;
-        break;
-      }
-      case LOGRECORD_TYPE_TRANSACTION_BEGIN: {
-        LOG_TRACE("Read checkpoint begin entry");
-        TransactionRecord txn_rec(record_type);
-        if (LoggingUtil::ReadTransactionRecordHeader(txn_rec, file_handle_) ==
-            false) {
-          LOG_ERROR("Failed to read checkpoint begin entry");
-          return false;
-        }
-        commit_id = txn_rec.GetTransactionId();
-        break;
-      }
-      default: {
-        LOG_ERROR("Invalid checkpoint entry");
-        should_stop = true;
-        break;
-      }
-    }
+  char manifest[sizeof(int64_t) + sizeof(int32_t)];
+  auto ret = fread(manifest, 1, sizeof(manifest), file_handle.file);
+  fclose(file_handle.file);
+  if (ret != sizeof(manifest)) {
+    LOG_ERROR("Failed to read checkpoint manifest %s", file_name.c_str());
+    return 0;
+  }
+  ReferenceSerializeInput input(manifest, sizeof(manifest));
+  cid_t commit_id = input.ReadLong();
+  size_t part_count = input.ReadInt();
+
+  // Load the parts
+  std::vector<oid_t> max_tile_group_ids(part_count, 0);
+  success = ForEachPart(
+      part_count, [this, commit_id, &max_tile_group_ids](size_t part_idx) {
+        return ReadPart(part_idx, commit_id, max_tile_group_ids[part_idx]);
+      });
+  if (success == false) {
+    LOG_ERROR("Failed to recover checkpoint %d", checkpoint_version);
   }
 
   // After finishing recovery, set the next oid with maximum oid
   // observed during the recovery
+  for (auto max_tile_group_id : max_tile_group_ids) {
+    max_oid_ = std::max(max_oid_, max_tile_group_id);
+  }
   auto &manager = catalog::Manager::GetInstance();
   if (max_oid_ > manager.GetNextTileGroupId()) {
     manager.SetNextTileGroupId(max_oid_);
@@ -183,42 +192,12 @@ cid_t SimpleCheckpoint::DoRecovery() {
   return commit_id;
 }
 
-void SimpleCheckpoint::InsertTuple(cid_t commit_id) {
-  TupleRecord tuple_record(LOGRECORD_TYPE_WAL_TUPLE_INSERT);
-
-  // Check for torn log write
-  if (LoggingUtil::ReadTupleRecordHeader(tuple_record, file_handle_) == false) {
-    LOG_ERROR("Could not read tuple record header.");
-    return;
-  }
-
-  auto table = LoggingUtil::GetTable(tuple_record);
-  if (!table) {
-    // the table was deleted
-    LoggingUtil::SkipTupleRecordBody(file_handle_);
-    return;
-  }
-
-  // Read off the tuple record body from the log
-  std::unique_ptr<storage::Tuple> tuple(LoggingUtil::ReadTupleRecordBody(
-      table->GetSchema(), pool.get(), file_handle_));
-  // Check for torn log write
-  if (tuple == nullptr) {
-    LOG_ERROR("Torn checkpoint write.");
-    return;
-  }
-  auto target_location = tuple_record.GetInsertLocation();
-  auto tile_group_id = target_location.block;
-  RecoverTuple(tuple.get(), table, target_location, commit_id);
-  if (max_oid_ < target_location.block) {
-    max_oid_ = tile_group_id;
-  }
-  LOG_TRACE("Inserted a tuple from checkpoint: (%u, %u)", target_location.block,
-            target_location.offset);
-}
-
 void SimpleCheckpoint::Scan(storage::DataTable *target_table,
                             oid_t database_oid) {
+  if (logger_ == nullptr) {
+    logger_.reset(BackendLogger::GetBackendLogger(LoggingType::NVM_WAL));
+  }
+
   auto schema = target_table->GetSchema();
   PL_ASSERT(schema);
   std::vector<oid_t> column_ids;
@@ -229,7 +208,6 @@ void SimpleCheckpoint::Scan(storage::DataTable *target_table,
   auto table_tile_group_count = target_table->GetTileGroupCount();
   CheckpointTileScanner scanner;
 
-  // TODO scan assigned tile in multi-thread checkpoint
   while (current_tile_group_offset < table_tile_group_count) {
     // Retrieve a tile group
     auto tile_group = target_table->GetTileGroup(current_tile_group_offset);
@@ -262,7 +240,6 @@ void SimpleCheckpoint::Scan(storage::DataTable *target_table,
           tuple->SetValue(column_id, val, this->pool.get());
         }
         ItemPointer location(tile_group_id, tuple_id);
-        // TODO is it possible to avoid `new` for checkpoint?
         std::shared_ptr<LogRecord> record(logger_->GetTupleRecord(
             LOGRECORD_TYPE_TUPLE_INSERT, INITIAL_TXN_ID, target_table->GetOid(),
             database_oid, location, INVALID_ITEMPOINTER, tuple.get()));
@@ -274,8 +251,6 @@ void SimpleCheckpoint::Scan(storage::DataTable *target_table,
         records_.push_back(record);
       }
     }
-    // persist to file once per tile
-    Persist();
     current_tile_group_offset++;
   }
 }
@@ -289,59 +264,230 @@ std::vector<std::shared_ptr<LogRecord>> SimpleCheckpoint::GetRecords() {
 }
 
 // Private Functions
-void SimpleCheckpoint::CreateFile() {
-  if (disable_file_access) return;
-  // open checkpoint file and file descriptor
-  std::string file_name = ConcatFileName(checkpoint_dir, ++checkpoint_version);
-  bool success =
-      LoggingUtil::InitFileHandle(file_name.c_str(), file_handle_, "ab");
-  if (!success) {
-    PL_ASSERT(false);
-    return;
+bool SimpleCheckpoint::ForEachPart(size_t part_count,
+                                   const std::function<bool(size_t)> &task) {
+  std::atomic<size_t> next_part(0);
+  std::atomic<bool> success(true);
+  auto worker = [part_count, &task, &next_part, &success]() {
+    for (size_t part_idx = next_part++; part_idx < part_count;
+         part_idx = next_part++) {
+      try {
+        if (task(part_idx) == false) success = false;
+      } catch (Exception &e) {
+        LOG_ERROR("Checkpoint part %lu failed: %s", part_idx, e.what());
+        success = false;
+      }
+    }
+  };
+
+  size_t thread_count = std::min<size_t>(
+      std::max<size_t>(std::thread::hardware_concurrency(), 1), part_count);
+  std::vector<std::thread> threads;
+  for (size_t thread_itr = 1; thread_itr < thread_count; thread_itr++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
   }
-  LOG_TRACE("Created a new checkpoint file: %s", file_name.c_str());
+  return success;
 }
 
-// Only called when checkpoint has actual contents
-void SimpleCheckpoint::Persist() {
-  if (disable_file_access) return;
-  PL_ASSERT(file_handle_.file);
-  PL_ASSERT(file_handle_.fd != INVALID_FILE_DESCRIPTOR);
-
-  LOG_TRACE("Persisting %lu checkpoint entries", records_.size());
-  // write all the record in the queue and free them
-  for (auto record : records_) {
-    PL_ASSERT(record);
-    PL_ASSERT(record->GetMessageLength() > 0);
-    fwrite(record->GetMessage(), sizeof(char), record->GetMessageLength(),
-           file_handle_.file);
-    record.reset();
-  }
-  records_.clear();
+std::string SimpleCheckpoint::GetPartFileName(int version, size_t part_idx) {
+  return checkpoint_dir + "/" + FILE_PREFIX + std::to_string(version) + "_" +
+         std::to_string(part_idx) + FILE_SUFFIX;
 }
 
-void SimpleCheckpoint::Cleanup() {
-  // Clean up the record queue
-  for (auto record : records_) {
-    record.reset();
+/**
+ * @brief Write the tuples of a part visible at the checkpoint cid to its
+ * file, one tile group at a time. A block is laid out as
+ * [length][database oid][table oid][tile group id][tuple count]
+ * [tuple slots][values of column 0]...[values of column n - 1]
+ */
+bool SimpleCheckpoint::WritePart(const CheckpointPart &part, size_t part_idx) {
+  FileHandle file_handle;
+  if (!disable_file_access) {
+    auto file_name = GetPartFileName(checkpoint_version, part_idx);
+    if (LoggingUtil::InitFileHandle(file_name.c_str(), file_handle, "wb") ==
+        false) {
+      return false;
+    }
+  }
+
+  auto target_table = part.table;
+  auto column_count = target_table->GetSchema()->GetColumnCount();
+  CheckpointTileScanner scanner;
+  CopySerializeOutput output;
+  std::vector<oid_t> tuple_slots;
+  bool success = true;
+
+  for (oid_t tile_group_offset = part.begin_offset;
+       tile_group_offset < part.end_offset; tile_group_offset++) {
+    auto tile_group = target_table->GetTileGroup(tile_group_offset);
+    if (tile_group == nullptr) continue;
+
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+    tuple_slots.clear();
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (scanner.IsVisible(tile_group_header, tuple_id, start_commit_id_)) {
+        tuple_slots.push_back(tuple_id);
+      }
+    }
+    if (tuple_slots.empty()) continue;
+
+    output.Reset();
+    size_t length_position = output.ReserveBytes(sizeof(int32_t));
+    output.WriteInt(part.database_oid);
+    output.WriteInt(target_table->GetOid());
+    output.WriteInt(tile_group->GetTileGroupId());
+    output.WriteInt(tuple_slots.size());
+    for (auto tuple_id : tuple_slots) {
+      output.WriteInt(tuple_id);
+    }
+    for (oid_t column_id = 0; column_id < column_count; column_id++) {
+      oid_t tile_offset, tile_column_id;
+      tile_group->LocateTileAndColumn(column_id, tile_offset, tile_column_id);
+      auto tile = tile_group->GetTile(tile_offset);
+      for (auto tuple_id : tuple_slots) {
+        tile->GetValue(tuple_id, tile_column_id).SerializeTo(output);
+      }
+    }
+    output.WriteIntAt(length_position, output.Size() - sizeof(int32_t));
+
+    if (!disable_file_access &&
+        fwrite(output.Data(), sizeof(char), output.Size(), file_handle.file) !=
+            output.Size()) {
+      LOG_ERROR("Failed to write checkpoint file: %s", strerror(errno));
+      success = false;
+      break;
+    }
+    LOG_TRACE("Wrote %lu tuples of tile group %u", tuple_slots.size(),
+              tile_group->GetTileGroupId());
   }
-  records_.clear();
 
   if (!disable_file_access) {
-    // Close and sync the current one
-    fclose(file_handle_.file);
-
-    // Remove previous version
-    if (checkpoint_version > 0 && !disable_file_access) {
-      auto previous_version =
-          ConcatFileName(checkpoint_dir, checkpoint_version - 1).c_str();
-      if (remove(previous_version) != 0) {
-        LOG_TRACE("Failed to remove file %s", previous_version);
+    LoggingUtil::FFlushFsync(file_handle);
+    fclose(file_handle.file);
+  }
+  return success;
+}
+
+bool SimpleCheckpoint::WriteManifest(size_t part_count) {
+  FileHandle file_handle;
+  std::string file_name = ConcatFileName(checkpoint_dir, checkpoint_version);
+  if (LoggingUtil::InitFileHandle(file_name.c_str(), file_handle, "wb") ==
+      false) {
+    return false;
+  }
+
+  CopySerializeOutput output;
+  output.WriteLong(start_commit_id_);
+  output.WriteInt(part_count);
+  bool success = (fwrite(output.Data(), sizeof(char), output.Size(),
+                         file_handle.file) == output.Size());
+  LoggingUtil::FFlushFsync(file_handle);
+  fclose(file_handle.file);
+  return success;
+}
+
+bool SimpleCheckpoint::ReadPart(size_t part_idx, cid_t commit_id,
+                                oid_t &max_tile_group_id) {
+  FileHandle file_handle;
+  auto file_name = GetPartFileName(checkpoint_version, part_idx);
+  if (LoggingUtil::InitFileHandle(file_name.c_str(), file_handle, "rb") ==
+      false) {
+    return false;
+  }
+
+  auto catalog = catalog::Catalog::GetInstance();
+  type::EphemeralPool part_pool;
+  std::vector<char> block;
+  char length_buffer[sizeof(int32_t)];
+  bool success = true;
+
+  while (fread(length_buffer, 1, sizeof(length_buffer), file_handle.file) ==
+         sizeof(length_buffer)) {
+    ReferenceSerializeInput length_input(length_buffer, sizeof(length_buffer));
+    int32_t block_length = length_input.ReadInt();
+    block.resize(std::max<int32_t>(block_length, 0));
+    // Check for torn checkpoint write
+    if (block_length <= 0 ||
+        fread(block.data(), 1, block_length, file_handle.file) !=
+            static_cast<size_t>(block_length)) {
+      LOG_ERROR("Torn checkpoint write in %s", file_name.c_str());
+      success = false;
+      break;
+    }
+
+    ReferenceSerializeInput input(block.data(), block_length);
+    oid_t database_oid = input.ReadInt();
+    oid_t table_oid = input.ReadInt();
+    oid_t tile_group_id = input.ReadInt();
+    oid_t tuple_count = input.ReadInt();
+
+    storage::DataTable *table = nullptr;
+    try {
+      table = catalog->GetDatabaseWithOid(database_oid)
+                  ->GetTableWithOid(table_oid);
+    } catch (CatalogException &e) {
+      // the table was deleted
+      continue;
+    }
+
+    std::vector<oid_t> tuple_slots(tuple_count);
+    for (auto &tuple_id : tuple_slots) {
+      tuple_id = input.ReadInt();
+    }
+
+    // Fill in the tuples column by column
+    auto schema = table->GetSchema();
+    std::vector<std::unique_ptr<storage::Tuple>> tuples(tuple_count);
+    for (auto &tuple : tuples) {
+      tuple.reset(new storage::Tuple(schema, true));
+    }
+    for (oid_t column_id = 0; column_id < schema->GetColumnCount();
+         column_id++) {
+      auto column_type = schema->GetType(column_id);
+      for (auto &tuple : tuples) {
+        tuple->SetValue(
+            column_id,
+            type::Value::DeserializeFrom(input, column_type, &part_pool),
+            &part_pool);
       }
     }
+
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      ItemPointer target_location(tile_group_id, tuple_slots[tuple_itr]);
+      RecoverTuple(tuples[tuple_itr].get(), table, target_location, commit_id);
+    }
+    max_tile_group_id = std::max(max_tile_group_id, tile_group_id);
+    LOG_TRACE("Recovered %u tuples of tile group %u", tuple_count,
+              tile_group_id);
   }
-  // Truncate logs
-  LogManager::GetInstance().TruncateLogs(start_commit_id_);
+
+  fclose(file_handle.file);
+  return success;
+}
+
+void SimpleCheckpoint::RemoveFiles(int min_version, int max_version) {
+  if (disable_file_access || max_version < min_version) return;
+
+  struct dirent *file;
+  auto dirp = opendir(checkpoint_dir.c_str());
+  if (dirp == nullptr) return;
+
+  while ((file = readdir(dirp)) != NULL) {
+    if (strncmp(file->d_name, FILE_PREFIX.c_str(), FILE_PREFIX.length()) != 0)
+      continue;
+    int version = LoggingUtil::ExtractNumberFromFileName(file->d_name);
+    if (version < min_version || version > max_version) continue;
+    auto file_name = checkpoint_dir + "/" + file->d_name;
+    if (remove(file_name.c_str()) != 0) {
+      LOG_TRACE("Failed to remove file %s", file_name.c_str());
+    }
+  }
+  closedir(dirp);
 }
 
 void SimpleCheckpoint::InitVersionNumber() {
@@ -359,6 +505,10 @@ void SimpleCheckpoint::InitVersionNumber() {
       // found a checkpoint file!
       LOG_TRACE("Found a checkpoint file with name %s", file->d_name);
       int version = LoggingUtil::ExtractNumberFromFileName(file->d_name);
+      // Only checkpoints whose manifest was written are complete
+      if (file->d_name != FILE_PREFIX + std::to_string(version) + FILE_SUFFIX) {
+        continue;
+      }
       if (version > checkpoint_version) {
         checkpoint_version = version;
       }
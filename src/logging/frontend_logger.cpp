@@ -13,6 +13,7 @@
 #include <thread>
 
 #include "common/logger.h"
+#include "configuration/configuration.h"
 #include "logging/checkpoint.h"
 #include "logging/checkpoint_manager.h"
 #include "logging/frontend_logger.h"
@@ -20,6 +21,7 @@
 #include "logging/loggers/wal_frontend_logger.h"
 #include "logging/loggers/wbl_frontend_logger.h"
 #include "logging/logging_util.h"
+#include "statistics/backend_stats_context.h"
 
 // TODO peloton_wait_timeout is always 0
 // configuration for testing
@@ -169,15 +171,106 @@ void FrontendLogger::MainLoop(void) {
   log_manager.SetLoggingStatus(LoggingStatusType::SLEEP);
 }
 
+/**
+ * @brief Count a commit of an associated backend logger towards the current
+ * group commit batch, and wake up the frontend logger if it is waiting for
+ * the first commit or the batch is complete
+ */
+void FrontendLogger::NotifyCommitLogged() {
+  auto pending_commit_count = pending_commit_count_.fetch_add(1) + 1;
+
+  if (pending_commit_count == 1) {
+    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch());
+    first_pending_commit_time_ = now.count();
+  }
+
+  auto &log_manager = LogManager::GetInstance();
+  if (log_manager.GetGroupCommit() == true &&
+      (pending_commit_count == 1 ||
+       pending_commit_count == log_manager.GetGroupCommitMaxBatchSize())) {
+    std::lock_guard<std::mutex> lock(group_commit_mutex_);
+    group_commit_cv_.notify_one();
+  }
+}
+
+/**
+ * @brief Wait until a batch of commits should be flushed. This is the case
+ * when the batch reached the maximum batch size, or when its oldest commit
+ * waited for the adaptive group commit wait time. Without any commits, log
+ * records are still collected once per latency budget.
+ */
+void FrontendLogger::WaitForGroupCommit() {
+  auto &log_manager = LogManager::GetInstance();
+  auto max_batch_size = log_manager.GetGroupCommitMaxBatchSize();
+  auto latency_budget =
+      std::chrono::microseconds(log_manager.GetGroupCommitLatencyBudget());
+
+  std::unique_lock<std::mutex> lock(group_commit_mutex_);
+
+  group_commit_cv_.wait_for(lock, latency_budget,
+                            [this] { return pending_commit_count_ > 0; });
+
+  if (pending_commit_count_ == 0 ||
+      group_commit_wait_ == std::chrono::microseconds::zero()) {
+    return;
+  }
+
+  std::chrono::steady_clock::time_point first_pending_commit_time(
+      std::chrono::microseconds(first_pending_commit_time_.load()));
+  group_commit_cv_.wait_until(
+      lock, first_pending_commit_time + group_commit_wait_,
+      [this, max_batch_size] {
+        return pending_commit_count_ >= max_batch_size;
+      });
+}
+
+/**
+ * @brief Record the size of the batch made durable by a sync, and adapt the
+ * time the next batch waits for more commits. Waiting only pays off when
+ * commits arrive concurrently, i.e. when the last batch had more than one
+ * commit. A batch then waits about as long as a sync takes, within the
+ * latency budget, so that a commit waits at most two syncs.
+ */
+void FrontendLogger::GroupCommitSynced(
+    std::chrono::microseconds sync_duration) {
+  fsync_duration_ = (fsync_duration_ * 7 + sync_duration) / 8;
+
+  auto &log_manager = LogManager::GetInstance();
+  auto latency_budget =
+      std::chrono::microseconds(log_manager.GetGroupCommitLatencyBudget());
+  if (unsynced_commit_count_ > 1) {
+    group_commit_wait_ = std::min(latency_budget, fsync_duration_);
+  } else {
+    group_commit_wait_ = std::chrono::microseconds::zero();
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID && unsynced_commit_count_ > 0) {
+    stats::BackendStatsContext::GetInstance()
+        ->GetCommitsPerFsyncHistogram()
+        .Record(unsynced_commit_count_);
+  }
+  unsynced_commit_count_ = 0;
+}
+
 /**
  * @brief Collect the log records from BackendLoggers
  */
 void FrontendLogger::CollectLogRecordsFromBackendLoggers() {
-  auto sleep_period = std::chrono::microseconds(wait_timeout);
-  std::this_thread::sleep_for(sleep_period);
+  auto &log_manager = LogManager::GetInstance();
+
+  if (log_manager.GetGroupCommit() == true &&
+      log_manager.GetLoggingStatus() == LoggingStatusType::LOGGING) {
+    WaitForGroupCommit();
+  } else {
+    auto sleep_period = std::chrono::microseconds(wait_timeout);
+    std::this_thread::sleep_for(sleep_period);
+  }
   int debug_flag = 0;
 
-  auto &log_manager = LogManager::GetInstance();
+  // Every commit notified so far has its commit record in the buffers
+  // collected below
+  unsynced_commit_count_ += pending_commit_count_.exchange(0);
 
   {
     cid_t max_committed_cid = 0;
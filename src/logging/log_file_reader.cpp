@@ -0,0 +1,196 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// log_file_reader.cpp
+//
+// Identification: src/logging/log_file_reader.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+
+#include "logging/log_file_reader.h"
+
+#include "common/logger.h"
+#include "storage/tuple.h"
+#include "type/serializeio.h"
+
+namespace peloton {
+namespace logging {
+
+constexpr size_t LogFileReader::READ_BLOCK_SIZE;
+
+LogFileReader::LogFileReader()
+    : data_(nullptr), size_(0), position_(0), is_mapped_(false) {}
+
+LogFileReader::~LogFileReader() { Close(); }
+
+bool LogFileReader::Open(const std::string &file_name) {
+  Close();
+
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd == INVALID_FILE_DESCRIPTOR) {
+    LOG_ERROR("Could not open log file %s: %s", file_name.c_str(),
+              strerror(errno));
+    return false;
+  }
+
+  struct stat stat_buf;
+  if (fstat(fd, &stat_buf) != 0) {
+    LOG_ERROR("Could not stat log file %s: %s", file_name.c_str(),
+              strerror(errno));
+    close(fd);
+    return false;
+  }
+  size_ = stat_buf.st_size;
+
+  if (size_ == 0) {
+    close(fd);
+    return true;
+  }
+
+  void *mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (mapping != MAP_FAILED) {
+    // the whole file is parsed front to back exactly once
+    madvise(mapping, size_, MADV_SEQUENTIAL);
+    data_ = reinterpret_cast<const char *>(mapping);
+    is_mapped_ = true;
+    close(fd);
+    return true;
+  }
+
+  // Fall back to reading the file in large blocks
+  LOG_TRACE("mmap failed for %s, reading it instead", file_name.c_str());
+  buffer_.resize(size_);
+  size_t bytes_read = 0;
+  while (bytes_read < size_) {
+    auto block_size = std::min(READ_BLOCK_SIZE, size_ - bytes_read);
+    auto ret = read(fd, buffer_.data() + bytes_read, block_size);
+    if (ret <= 0) {
+      if (ret < 0 && errno == EINTR) continue;
+      break;
+    }
+    bytes_read += ret;
+  }
+  close(fd);
+
+  // Whatever could not be read is treated like a torn write
+  size_ = bytes_read;
+  data_ = buffer_.data();
+  return true;
+}
+
+void LogFileReader::Close() {
+  if (is_mapped_ == true) {
+    munmap(const_cast<char *>(data_), size_);
+  }
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+  data_ = nullptr;
+  size_ = 0;
+  position_ = 0;
+  is_mapped_ = false;
+}
+
+bool LogFileReader::Skip(size_t length) {
+  if (position_ + length > size_) {
+    position_ = size_;
+    return false;
+  }
+  position_ += length;
+  return true;
+}
+
+LogRecordType LogFileReader::ReadRecordType() {
+  if (position_ + sizeof(char) > size_) {
+    LOG_TRACE("Log file is truncated");
+    position_ = size_;
+    return LOGRECORD_TYPE_INVALID;
+  }
+
+  CopySerializeInput input(data_ + position_, sizeof(char));
+  position_ += sizeof(char);
+  return (LogRecordType)(input.ReadEnumInSingleByte());
+}
+
+size_t LogFileReader::GetNextFrameSize() const {
+  if (position_ + sizeof(int32_t) > size_) {
+    return 0;
+  }
+
+  // The frame length does not include the length field itself
+  CopySerializeInput frame_check(data_ + position_, sizeof(int32_t));
+  auto frame_length = frame_check.ReadInt();
+  if (frame_length < 0) {
+    return 0;
+  }
+
+  size_t frame_size = frame_length + sizeof(int32_t);
+  if (position_ + frame_size > size_) {
+    return 0;
+  }
+  return frame_size;
+}
+
+bool LogFileReader::ReadTransactionRecordHeader(TransactionRecord &txn_record) {
+  auto header_size = GetNextFrameSize();
+  if (header_size == 0) {
+    return false;
+  }
+
+  CopySerializeInput txn_header(data_ + position_, header_size);
+  txn_record.Deserialize(txn_header);
+  position_ += header_size;
+  return true;
+}
+
+bool LogFileReader::ReadTupleRecordHeader(TupleRecord &tuple_record) {
+  auto header_size = GetNextFrameSize();
+  if (header_size == 0) {
+    LOG_ERROR("Header size is zero ");
+    return false;
+  }
+
+  CopySerializeInput tuple_header(data_ + position_, header_size);
+  tuple_record.DeserializeHeader(tuple_header);
+  position_ += header_size;
+  return true;
+}
+
+storage::Tuple *LogFileReader::ReadTupleRecordBody(
+    const catalog::Schema *schema, type::AbstractPool *pool) {
+  auto body_size = GetNextFrameSize();
+  if (body_size == 0) {
+    LOG_ERROR("Body size is zero ");
+    return nullptr;
+  }
+
+  CopySerializeInput tuple_body(data_ + position_, body_size);
+  position_ += body_size;
+
+  // We create a tuple based on the message
+  storage::Tuple *tuple = new storage::Tuple(schema, true);
+  tuple->DeserializeFrom(tuple_body, pool);
+  return tuple;
+}
+
+bool LogFileReader::SkipTupleRecordBody() {
+  auto body_size = GetNextFrameSize();
+  if (body_size == 0) {
+    LOG_ERROR("Body size is zero ");
+    return false;
+  }
+  position_ += body_size;
+  return true;
+}
+
+}  // namespace logging
+}  // namespace peloton
@@ -17,11 +17,14 @@
 #include "catalog/manager.h"
 #include "common/logger.h"
 #include "common/macros.h"
+#include "common/timer.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "configuration/configuration.h"
 #include "executor/executor_context.h"
 #include "logging/log_manager.h"
 #include "logging/logging_util.h"
 #include "logging/records/transaction_record.h"
+#include "statistics/backend_stats_context.h"
 #include "storage/data_table.h"
 #include "storage/database.h"
 #include "storage/tile_group.h"
@@ -274,9 +277,28 @@ void LogManager::LogCommitTransaction(cid_t commit_id) {
   if (this->IsInLoggingMode()) {
     auto logger = this->GetBackendLogger();
     TransactionRecord record(LOGRECORD_TYPE_TRANSACTION_COMMIT, commit_id);
+
+    Timer<std::micro> commit_timer;
+    commit_timer.Start();
+
     logger->Log(&record);
+
+    // let the frontend logger know that its batch grew by one commit
+    auto frontend_logger_id = logger->GetFrontendLoggerID();
+    if (frontend_logger_id >= 0 &&
+        (unsigned int)frontend_logger_id < frontend_loggers.size()) {
+      frontend_loggers[frontend_logger_id]->NotifyCommitLogged();
+    }
+
     if (syncronization_commit) {
       WaitForFlush(commit_id);
+
+      if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+        commit_timer.Stop();
+        stats::BackendStatsContext::GetInstance()
+            ->GetCommitLatencyHistogram()
+            .Record((uint64_t)commit_timer.GetDuration());
+      }
     }
     // logger->GetVarlenPool()->Purge();
   }
@@ -476,25 +498,40 @@ cid_t LogManager::GetPersistentFlushedCommitId() {
 void LogManager::FrontendLoggerFlushed() {
   {
     std::unique_lock<std::mutex> wait_lock(flush_notify_mutex);
-    flush_notify_cv.notify_all();
+
+    // Complete the commits that became durable with this flush
+    auto persistent_flushed_cid = this->GetPersistentFlushedCommitId();
+    auto end = durability_promises_.upper_bound(persistent_flushed_cid);
+    for (auto itr = durability_promises_.begin(); itr != end; itr++) {
+      itr->second.set_value();
+    }
+    durability_promises_.erase(durability_promises_.begin(), end);
   }
 }
 
-void LogManager::WaitForFlush(cid_t cid) {
-  LOG_TRACE("Waiting for flush with %d", (int)cid);
+std::shared_future<void> LogManager::GetDurabilityFuture(cid_t cid) {
+  std::promise<void> promise;
+  std::shared_future<void> future = promise.get_future().share();
   {
     std::unique_lock<std::mutex> wait_lock(flush_notify_mutex);
 
-    while (this->GetPersistentFlushedCommitId() < cid) {
+    if (this->GetPersistentFlushedCommitId() >= cid) {
+      promise.set_value();
+    } else {
       LOG_TRACE(
           "Logs up to %lu cid is flushed. %lu cid is not flushed yet. Wait...",
           this->GetPersistentFlushedCommitId(), cid);
-      flush_notify_cv.wait(wait_lock);
+      durability_promises_.emplace(cid, std::move(promise));
     }
-    LOG_TRACE(
-        "Flushes done! Can return! Got persistent flushed commit id as %d",
-        (int)this->GetPersistentFlushedCommitId());
   }
+  return future;
+}
+
+void LogManager::WaitForFlush(cid_t cid) {
+  LOG_TRACE("Waiting for flush with %d", (int)cid);
+  GetDurabilityFuture(cid).wait();
+  LOG_TRACE("Flushes done! Can return! Got persistent flushed commit id as %d",
+            (int)this->GetPersistentFlushedCommitId());
 }
 
 void LogManager::NotifyRecoveryDone() {
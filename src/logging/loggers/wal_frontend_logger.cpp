@@ -13,9 +13,14 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/mman.h>
+#include <unistd.h>
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <dirent.h>
+#include <functional>
 #include <numeric>
+#include <thread>
 
 #include "catalog/catalog.h"
 #include "catalog/manager.h"
@@ -32,6 +37,7 @@
 #include "logging/loggers/wal_backend_logger.h"
 #include "logging/checkpoint_tile_scanner.h"
 #include "logging/logging_util.h"
+#include "logging/log_file_reader.h"
 #include "logging/checkpoint_manager.h"
 
 #include "storage/database.h"
@@ -99,6 +105,14 @@ void WriteAheadFrontendLogger::InitSelf() {
 WriteAheadFrontendLogger::~WriteAheadFrontendLogger() {
   // close the log file
   if (cur_file_handle.file != nullptr) {
+    // drop the preallocated space behind the last record
+    if (fflush(cur_file_handle.file) == 0) {
+      size_t log_file_size = ftell(cur_file_handle.file);
+      if (ftruncate(cur_file_handle.fd, log_file_size) != 0) {
+        LOG_TRACE("Could not truncate the log file (%s)", strerror(errno));
+      }
+    }
+
     int ret = fclose(cur_file_handle.file);
     if (ret != 0) {
       LOG_ERROR("Error occured while closing LogFile");
@@ -160,6 +174,7 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
   }
 
   bool flushed = false;
+  bool group_commit = LogManager::GetInstance().GetGroupCommit();
 
   if (max_collected_commit_id != max_flushed_commit_id) {
     if (!test_mode_) {
@@ -173,10 +188,13 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
                   this->max_collected_commit_id);
 
         // by moving the fflush and sync here, we ensure that this file will
-        // have at least 1 delimiter
-        if (Clock::now() > last_flush + flush_frequency) {
+        // have at least 1 delimiter. In group commit mode every batch is
+        // synced right away, since its backends are waiting for it
+        if (group_commit ||
+            Clock::now() > last_flush + flush_frequency) {
+          auto sync_start = Clock::now();
           if (!no_write_) {
-            LoggingUtil::FFlushFsync(cur_file_handle);
+            LoggingUtil::FFlushFdatasync(cur_file_handle);
           }
           last_flush = Clock::now();
           if (this->max_collected_commit_id > max_flushed_commit_id) {
@@ -185,6 +203,9 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
 
           fsync_count++;
           flushed = true;
+
+          GroupCommitSynced(
+              std::chrono::duration_cast<Micros>(last_flush - sync_start));
         }
 
         if (this->max_collected_commit_id > max_delimiter_file) {
@@ -195,7 +216,7 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
         if (FileSwitchCondIsTrue()) should_create_new_file = true;
       }
     } else {
-      if (Clock::now() > last_flush + flush_frequency) {
+      if (group_commit || Clock::now() > last_flush + flush_frequency) {
         last_flush = Clock::now();
         if (this->max_collected_commit_id > max_flushed_commit_id) {
           max_flushed_commit_id = this->max_collected_commit_id;
@@ -220,35 +241,185 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
 // Recovery
 //===--------------------------------------------------------------------===//
 
+/**
+ * @brief Run task(0) ... task(task_count - 1) on up to thread_count threads
+ */
+static void RunRecoveryTasks(size_t task_count, size_t thread_count,
+                             const std::function<void(size_t)> &task) {
+  thread_count = std::min(thread_count, task_count);
+  if (thread_count <= 1) {
+    for (size_t task_itr = 0; task_itr < task_count; task_itr++) {
+      task(task_itr);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next_task(0);
+  auto worker = [&]() {
+    size_t task_itr;
+    while ((task_itr = next_task.fetch_add(1)) < task_count) {
+      task(task_itr);
+    }
+  };
+
+  // the calling thread is one of the workers
+  std::vector<std::thread> threads;
+  for (size_t thread_itr = 1; thread_itr < thread_count; thread_itr++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
 /**
  * @brief Recovery system based on log file
+ *
+ * The log files are mapped and parsed in parallel, one file per thread.
+ * The parsed records are then matched with their transactions in log
+ * order, and the records of committed transactions are partitioned by
+ * table. Finally the partitions are replayed in parallel. Records of the
+ * same table are replayed in commit order.
  */
 void WriteAheadFrontendLogger::DoRecovery() {
   // FIXME GetNextCommitId() increments next_cid!!!
   cid_t start_commit_id = CheckpointManager::GetInstance().GetRecoveredCid();
   auto &log_manager = logging::LogManager::GetInstance();
-  int num_inserts = 0;
+  size_t thread_count = log_manager.GetRecoveryThreadCount();
   cid_t global_max_flushed_id_for_recovery;
   log_file_cursor_ = 0;
+  recovered_record_count_ = 0;
+  recovered_byte_count_ = 0;
 
   global_max_flushed_id_for_recovery =
       log_manager.GetGlobalMaxFlushedIdForRecovery();
   LOG_TRACE("Got start_commit_id as %d, global max flushed as %d",
             (int)start_commit_id, (int)global_max_flushed_id_for_recovery);
 
-  // open first file
-  OpenNextLogFile();
+  // Parse all log files
+  std::vector<RecoveryLogFile> parsed_log_files(log_files_.size());
+  RunRecoveryTasks(log_files_.size(), thread_count, [&](size_t file_itr) {
+    ParseLogFile(file_itr, start_commit_id, global_max_flushed_id_for_recovery,
+                 parsed_log_files[file_itr]);
+  });
 
-  // Go over the log file if needed
+  recovery_partitions_.clear();
+  recovery_partitions_.resize(thread_count);
+
+  // Go over the records of each log file in log order. Everything after a
+  // torn record is ignored
   bool reached_end_of_log = false;
+  for (auto &parsed_log_file : parsed_log_files) {
+    if (reached_end_of_log == false) {
+      log_file_cursor_++;
+      recovered_record_count_ += parsed_log_file.record_count;
+      recovered_byte_count_ += parsed_log_file.byte_count;
+    }
+
+    for (auto &record : parsed_log_file.records) {
+      if (reached_end_of_log == true) {
+        if (record.tuple_record != nullptr) {
+          delete record.tuple_record->GetTuple();
+          delete record.tuple_record;
+        }
+        continue;
+      }
+
+      switch (record.type) {
+        case LOGRECORD_TYPE_TRANSACTION_BEGIN:
+          PL_ASSERT(record.log_id != INVALID_CID);
+          StartTransactionRecovery(record.log_id);
+          break;
+
+        case LOGRECORD_TYPE_TRANSACTION_COMMIT:
+          PL_ASSERT(record.log_id != INVALID_CID);
+
+          // Now directly commit this transaction. This is safe because we
+          // reject commit ids that appear after the persistent commit id
+          // while parsing the log file.
+          CommitTransactionRecovery(record.log_id);
+          break;
+
+        case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
+        case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
+        case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
+          if (recovery_txn_table.find(record.log_id) ==
+              recovery_txn_table.end()) {
+            LOG_ERROR("Txn id %d not found in recovery txn table",
+                      (int)record.log_id);
+            delete record.tuple_record->GetTuple();
+            delete record.tuple_record;
+            reached_end_of_log = true;
+            break;
+          }
+          recovery_txn_table[record.log_id].push_back(record.tuple_record);
+          break;
+
+        default:
+          // Do nothing if we hit the delimiter, because the delimiters help
+          // us only to find the max persistent commit id, and should be
+          // ignored during actual recovery
+          break;
+      }
+    }
+
+    if (parsed_log_file.is_torn == true) {
+      reached_end_of_log = true;
+    }
+  }
+
+  // Replay the committed transactions
+  ReplayCommittedTransactions();
+
+  // Finally, abort ACTIVE transactions in recovery_txn_table
+  AbortActiveTransactions();
+
+  // After finishing recovery, set the next oid with maximum oid
+  // observed during the recovery
+  log_manager.UpdateCatalogAndTxnManagers(max_oid, max_cid);
 
-  // Go over each log record in the log file
-  while (reached_end_of_log == false) {
+  LOG_TRACE("Recovered %lu log records from %lu bytes",
+            recovered_record_count_, recovered_byte_count_);
+  cur_file_handle = INVALID_FILE_HANDLE;
+}
+
+/**
+ * @brief Parse the records of a log file that need to be replayed
+ * @param log_file_itr offset of the file in the list of log files
+ * @param log_file the parsed records
+ */
+void WriteAheadFrontendLogger::ParseLogFile(int log_file_itr,
+                                            cid_t start_commit_id,
+                                            cid_t max_commit_id,
+                                            RecoveryLogFile &log_file) {
+  auto file_name =
+      GetFileNameFromVersion(log_files_[log_file_itr]->GetLogNumber());
+
+  LogFileReader reader;
+  if (reader.Open(file_name) == false) {
+    LOG_ERROR("Couldn't open log file %s", file_name.c_str());
+    log_file.is_torn = true;
+    return;
+  }
+
+  // Skip the max commit id and the max delimiter in the file header
+  if (reader.Skip(sizeof(cid_t) + sizeof(cid_t)) == false) {
+    LOG_ERROR("Read failed after opening file %s", file_name.c_str());
+    return;
+  }
+
+  auto is_skipped = [&](cid_t log_id) {
+    return log_id <= start_commit_id || log_id > max_commit_id;
+  };
+
+  while (true) {
     // Read the first byte to identify log record type
-    // If that is not possible, then wrap up recovery
-    auto record_type = GetNextLogRecordTypeForRecovery();
+    // If that is not possible, then we are done with this file
+    auto record_type = reader.ReadRecordType();
     cid_t log_id = INVALID_CID;
-    TupleRecord *tuple_record;
+    TupleRecord *tuple_record = nullptr;
+    bool is_replayed = true;
 
     switch (record_type) {
       case LOGRECORD_TYPE_TRANSACTION_BEGIN:
@@ -256,128 +427,96 @@ void WriteAheadFrontendLogger::DoRecovery() {
       case LOGRECORD_TYPE_ITERATION_DELIMITER: {
         // Check for torn log write
         TransactionRecord txn_rec(record_type);
-        if (LoggingUtil::ReadTransactionRecordHeader(
-                txn_rec, cur_file_handle) == false) {
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+        if (reader.ReadTransactionRecordHeader(txn_rec) == false) {
+          log_file.is_torn = true;
+          break;
         }
         log_id = txn_rec.GetTransactionId();
-        if (log_id <= start_commit_id ||
-            log_id > global_max_flushed_id_for_recovery) {
-          LOG_TRACE("SKIP");
-          continue;
-        }
         break;
       }
       case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
       case LOGRECORD_TYPE_WAL_TUPLE_UPDATE: {
         tuple_record = new TupleRecord(record_type);
         // Check for torn log write
-        if (LoggingUtil::ReadTupleRecordHeader(*tuple_record,
-                                               cur_file_handle) == false) {
+        if (reader.ReadTupleRecordHeader(*tuple_record) == false) {
           LOG_ERROR("Could not read tuple record header.");
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          log_file.is_torn = true;
+          break;
         }
 
         log_id = tuple_record->GetTransactionId();
         auto table = LoggingUtil::GetTable(*tuple_record);
 
-        if (!table || log_id <= start_commit_id ||
-            log_id > global_max_flushed_id_for_recovery) {
-          LoggingUtil::SkipTupleRecordBody(cur_file_handle);
+        if (!table || is_skipped(log_id)) {
           LOG_TRACE("Skip a tuple, log id is %d", (int)log_id);
-          delete tuple_record;
-          continue;
-        }
-
-        if (recovery_txn_table.find(log_id) == recovery_txn_table.end()) {
-          LOG_ERROR("Insert txd id %d not found in recovery txn table",
-                    (int)log_id);
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          if (reader.SkipTupleRecordBody() == false) {
+            log_file.is_torn = true;
+          }
+          is_replayed = false;
+          break;
         }
 
         // Read off the tuple record body from the log
-        tuple_record->SetTuple(LoggingUtil::ReadTupleRecordBody(
-            table->GetSchema(), recovery_pool, cur_file_handle));
-        num_inserts++;
+        auto tuple =
+            reader.ReadTupleRecordBody(table->GetSchema(), recovery_pool);
+        if (tuple == nullptr) {
+          log_file.is_torn = true;
+          break;
+        }
+        tuple_record->SetTuple(tuple);
         break;
       }
       case LOGRECORD_TYPE_WAL_TUPLE_DELETE: {
         tuple_record = new TupleRecord(record_type);
         // Check for torn log write
-        if (LoggingUtil::ReadTupleRecordHeader(*tuple_record,
-                                               cur_file_handle) == false) {
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+        if (reader.ReadTupleRecordHeader(*tuple_record) == false) {
+          log_file.is_torn = true;
+          break;
         }
-
         log_id = tuple_record->GetTransactionId();
-        if (log_id <= start_commit_id ||
-            log_id > global_max_flushed_id_for_recovery) {
-          delete tuple_record;
-          continue;
-        }
-        if (recovery_txn_table.find(log_id) == recovery_txn_table.end()) {
-          LOG_TRACE("Delete txd id %d not found in recovery txn table",
-                    (int)log_id);
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
-        }
         break;
       }
       default:
-        reached_end_of_log = true;
-        break;
+        log_file.byte_count = reader.GetPosition();
+        return;
     }
-    if (!reached_end_of_log) {
-      switch (record_type) {
-        case LOGRECORD_TYPE_TRANSACTION_BEGIN:
-          PL_ASSERT(log_id != INVALID_CID);
-          StartTransactionRecovery(log_id);
-          break;
 
-        case LOGRECORD_TYPE_TRANSACTION_COMMIT:
-          PL_ASSERT(log_id != INVALID_CID);
-
-          // Now directly commit this transaction. This is safe because we
-          // reject commit ids that appear
-          // after the persistent commit id before coming here (in the switch
-          // case above).
-          CommitTransactionRecovery(log_id);
-          break;
+    if (log_file.is_torn == true) {
+      delete tuple_record;
+      log_file.byte_count = reader.GetPosition();
+      return;
+    }
 
-        case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
-        case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
-        case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
-          recovery_txn_table[tuple_record->GetTransactionId()]
-              .push_back(tuple_record);
-          break;
-        case LOGRECORD_TYPE_ITERATION_DELIMITER: {
-          // Do nothing if we hit the delimiter, because the delimiters help
-          // us only to find
-          // the max persistent commit id, and should be ignored during actual
-          // recovery
-          break;
-        }
+    log_file.record_count++;
 
-        default:
-          reached_end_of_log = true;
-          break;
-      }
+    if (is_replayed == false || is_skipped(log_id)) {
+      delete tuple_record;
+      continue;
     }
-  }
 
-  // Finally, abort ACTIVE transactions in recovery_txn_table
-  AbortActiveTransactions();
+    log_file.records.push_back({record_type, log_id, tuple_record});
+  }
+}
 
-  // After finishing recovery, set the next oid with maximum oid
-  // observed during the recovery
-  log_manager.UpdateCatalogAndTxnManagers(max_oid, max_cid);
+/**
+ * @brief Replay the partitions of committed records in parallel
+ */
+void WriteAheadFrontendLogger::ReplayCommittedTransactions() {
+  std::vector<oid_t> max_tile_group_ids(recovery_partitions_.size(), max_oid);
+
+  RunRecoveryTasks(
+      recovery_partitions_.size(), recovery_partitions_.size(),
+      [&](size_t partition_itr) {
+        for (auto tuple_record : recovery_partitions_[partition_itr]) {
+          ReplayTupleRecord(tuple_record, max_tile_group_ids[partition_itr]);
+          delete tuple_record;
+        }
+      });
 
-  LOG_TRACE("This thread did %d inserts", (int)num_inserts);
-  cur_file_handle = INVALID_FILE_HANDLE;
+  for (auto max_tile_group_id : max_tile_group_ids) {
+    max_oid = std::max(max_oid, max_tile_group_id);
+  }
+  recovery_partitions_.clear();
 }
 
 void WriteAheadFrontendLogger::RecoverIndex() {
@@ -388,6 +527,7 @@ void WriteAheadFrontendLogger::RecoverIndex() {
 
   auto catalog = catalog::Catalog::GetInstance();
   auto database_count = catalog->GetDatabaseCount();
+  std::vector<storage::DataTable *> target_tables;
 
   // loop all databases
   for (oid_t database_idx = 1; database_idx < database_count; database_idx++) {
@@ -401,12 +541,16 @@ void WriteAheadFrontendLogger::RecoverIndex() {
       PL_ASSERT(target_table);
       LOG_TRACE("SeqScan: database oid %u table oid %u: %s", database_idx,
                 table_idx, target_table->GetName().c_str());
-
-      if (!RecoverTableIndexHelper(target_table, cid)) {
-        break;
-      }
+      target_tables.push_back(target_table);
     }
   }
+
+  // Tables are independent of each other, so recover them in parallel
+  auto &log_manager = logging::LogManager::GetInstance();
+  RunRecoveryTasks(target_tables.size(), log_manager.GetRecoveryThreadCount(),
+                   [&](size_t table_itr) {
+                     RecoverTableIndexHelper(target_tables[table_itr], cid);
+                   });
 }
 
 bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
@@ -421,6 +565,7 @@ bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
   auto table_tile_group_count = target_table->GetTileGroupCount();
   LOG_TRACE("Recovering tile group count: %ld", table_tile_group_count);
   CheckpointTileScanner scanner;
+  size_t recovered_tuple_count = 0;
 
   while (current_tile_group_offset < table_tile_group_count) {
     // Retrieve a tile group
@@ -436,57 +581,23 @@ bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
       continue;
     }
 
-    auto tile_group_id = logical_tile->GetColumnInfo(0)
-                             .base_tile->GetTileGroup()
-                             ->GetTileGroupId();
-    LOG_TRACE("Retrieved tile group %u", tile_group_id);
-
-    // Go over the logical tile
-    for (oid_t tuple_id : *logical_tile) {
-      expression::ContainerTuple<executor::LogicalTile> cur_tuple(
-          logical_tile.get(), tuple_id);
-
-      // Index update
-      {
-        // construct a physical tuple from the logical tuple
-        std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
-        for (auto column_id : column_ids) {
-          type::Value val = cur_tuple.GetValue(column_id);
-          tuple->SetValue(column_id, val,
-                          recovery_pool);
-        }
-
-        ItemPointer location(tile_group_id, tuple_id);
-        InsertIndexEntry(tuple.get(), target_table, location);
-      }
-    }
+    LOG_TRACE("Retrieved tile group %u", tile_group->GetTileGroupId());
+    recovered_tuple_count += logical_tile->GetTupleCount();
     current_tile_group_offset++;
   }
-  return true;
-}
 
-void WriteAheadFrontendLogger::InsertIndexEntry(storage::Tuple *tuple,
-                                                storage::DataTable *table,
-                                                ItemPointer target_location UNUSED_ATTRIBUTE) {
-  PL_ASSERT(tuple);
-  PL_ASSERT(table);
-  auto index_count = table->GetIndexCount();
-  LOG_TRACE("Insert tuple (%u, %u) into %u indexes", target_location.block,
-            target_location.offset, index_count);
-
-  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
-    auto index = table->GetIndex(index_itr);
-    auto index_schema = index->GetKeySchema();
-    auto indexed_columns = index_schema->GetIndexedColumns();
-    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
-    key->SetFromTuple(tuple, indexed_columns, index->GetPool());
-
-    // TODO: workaround. this can cause memory leak.
-    // since currently logging does not work, we will handle this later.
-    // index->InsertEntry(key.get(), new ItemPointer(target_location));
-    // Increase the indexes' number of tuples by 1 as well
-    index->IncreaseNumberOfTuplesBy(1);
+  // TODO: insert the entries themselves once recovered tuples get an
+  // indirection slot. Inserting new ItemPointers here would leak them, and
+  // since currently logging does not work, we only bulk update the indexes'
+  // number of tuples.
+  auto index_count = target_table->GetIndexCount();
+  LOG_TRACE("Add %lu tuples to %u indexes", recovered_tuple_count,
+            index_count);
+  for (oid_t index_itr = 0; index_itr < index_count; index_itr++) {
+    auto index = target_table->GetIndex(index_itr);
+    index->IncreaseNumberOfTuplesBy(recovered_tuple_count);
   }
+  return true;
 }
 
 /**
@@ -497,6 +608,7 @@ void WriteAheadFrontendLogger::AbortActiveTransactions() {
        it++) {
     LOG_TRACE("Aborting some active transactions!");
     for (auto it2 = it->second.begin(); it2 != it->second.end(); it2++) {
+      delete (*it2)->GetTuple();
       delete *it2;
     }
   }
@@ -518,27 +630,28 @@ void WriteAheadFrontendLogger::StartTransactionRecovery(cid_t commit_id) {
  */
 void WriteAheadFrontendLogger::CommitTransactionRecovery(cid_t commit_id) {
   std::vector<TupleRecord *> &tuple_records = recovery_txn_table[commit_id];
+  if (recovery_partitions_.empty()) {
+    recovery_partitions_.resize(1);
+  }
   for (auto it = tuple_records.begin(); it != tuple_records.end(); it++) {
     TupleRecord *curr = *it;
-    switch (curr->GetType()) {
-      case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
-        InsertTuple(curr);
-        break;
-      case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
-        UpdateTuple(curr);
-        break;
-      case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
-        DeleteTuple(curr);
-        break;
-      default:
-        continue;
-    }
-    delete curr;
+    recovery_partitions_[GetRecoveryPartition(curr)].push_back(curr);
   }
-  max_cid = commit_id + 1;
+  max_cid = std::max(max_cid, commit_id + 1);
   recovery_txn_table.erase(commit_id);
 }
 
+/**
+ * @brief all records of a table go to the same partition, so that they are
+ * replayed by one thread in commit order
+ */
+size_t WriteAheadFrontendLogger::GetRecoveryPartition(
+    TupleRecord *record) const {
+  auto table_key = (static_cast<size_t>(record->GetDatabaseOid()) << 32) |
+                   record->GetTableId();
+  return std::hash<size_t>()(table_key) % recovery_partitions_.size();
+}
+
 void InsertTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
                        oid_t table_id, const ItemPointer &insert_loc,
                        storage::Tuple *tuple,
@@ -672,64 +785,38 @@ void WriteAheadFrontendLogger::UpdateTuple(TupleRecord *record) {
                     record->GetTuple());
 }
 
+/**
+ * @brief replay a committed tuple record, tracking the max tile group id in
+ * max_tg instead of max_oid so that partitions can be replayed concurrently
+ */
+void WriteAheadFrontendLogger::ReplayTupleRecord(TupleRecord *record,
+                                                 oid_t &max_tg) {
+  switch (record->GetType()) {
+    case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
+      InsertTupleHelper(max_tg, record->GetTransactionId(),
+                        record->GetDatabaseOid(), record->GetTableId(),
+                        record->GetInsertLocation(), record->GetTuple());
+      break;
+    case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
+      UpdateTupleHelper(max_tg, record->GetTransactionId(),
+                        record->GetDatabaseOid(), record->GetTableId(),
+                        record->GetDeleteLocation(),
+                        record->GetInsertLocation(), record->GetTuple());
+      break;
+    case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
+      DeleteTupleHelper(max_tg, record->GetTransactionId(),
+                        record->GetDatabaseOid(), record->GetTableId(),
+                        record->GetDeleteLocation());
+      break;
+    default:
+      break;
+  }
+}
+
 //===--------------------------------------------------------------------===//
 // Utility functions
 //===--------------------------------------------------------------------===//
 
-LogRecordType WriteAheadFrontendLogger::GetNextLogRecordTypeForRecovery() {
-  char buffer;
-  bool is_truncated = false;
-  int ret;
-
-  if (cur_file_handle.file == nullptr || cur_file_handle.fd == -1)
-    return LOGRECORD_TYPE_INVALID;
-
-  LOG_TRACE("Inside GetNextLogRecordForRecovery");
-
-  LOG_TRACE("File is at position %d", (int)ftell(cur_file_handle.file));
-
-  // Check if the log record type is broken
-  if (LoggingUtil::IsFileTruncated(cur_file_handle, 1)) {
-    LOG_TRACE("Log file is truncated, should open next log file");
-    is_truncated = true;
-  }
-
-  // Otherwise, read the log record type
-  if (!is_truncated) {
-    ret = fread((void *)&buffer, 1, sizeof(char), cur_file_handle.file);
-    if (ret <= 0) {
-      LOG_TRACE("Failed an fread");
-    }
-  }
-  if (is_truncated || ret <= 0) {
-    LOG_TRACE("Call OpenNextLogFile");
-    OpenNextLogFile();
-    if (cur_file_handle.fd == -1) return LOGRECORD_TYPE_INVALID;
-
-    LOG_TRACE("Open succeeded. log_file_fd is %d", (int)cur_file_handle.fd);
-
-    if (LoggingUtil::IsFileTruncated(cur_file_handle, 1)) {
-      LOG_ERROR("Log file is truncated");
-      return LOGRECORD_TYPE_INVALID;
-    }
-
-    LOG_TRACE("File is not truncated.");
-    ret = fread((void *)&buffer, 1, sizeof(char), cur_file_handle.file);
-    if (ret <= 0) {
-      LOG_ERROR("Could not read from log file");
-      return LOGRECORD_TYPE_INVALID;
-    }
-    LOG_TRACE("fread succeeded.");
-  } else {
-    LOG_TRACE("fread succeeded.");
-  }
-
-  CopySerializeInput input(&buffer, sizeof(char));
-  LogRecordType log_record_type = (LogRecordType)(input.ReadByte());
-
-  return log_record_type;
-}
-
 std::string WriteAheadFrontendLogger::GetLogFileName(void) {
   auto &log_manager = logging::LogManager::GetInstance();
   return log_manager.GetLogFileName();
@@ -874,7 +961,6 @@ void WriteAheadFrontendLogger::CreateNewLogFile(bool close_old_file) {
   int new_file_num;
   std::string new_file_name;
   cid_t default_commit_id = INVALID_CID, default_delimiter = INVALID_CID;
-  struct stat log_stats;
 
   new_file_num = log_file_counter_;
 
@@ -883,6 +969,9 @@ void WriteAheadFrontendLogger::CreateNewLogFile(bool close_old_file) {
     LogFile *cur_log_file_object = log_files_[file_list_size - 1];
 
     if (file_list_size != 0) {
+      // the file may have been preallocated beyond the written records
+      size_t log_file_size = ftell(cur_file_handle.file);
+
       // TODO check return values of all these operations!
       fseek(cur_file_handle.file, 0, SEEK_SET);
 
@@ -904,9 +993,13 @@ void WriteAheadFrontendLogger::CreateNewLogFile(bool close_old_file) {
       max_log_id_file = 0;     // reset
       max_delimiter_file = 0;  // reset
 
-      fstat(cur_file_handle.fd, &log_stats);
+      fflush(cur_file_handle.file);
+      if (ftruncate(cur_file_handle.fd, log_file_size) != 0) {
+        LOG_ERROR("Could not truncate the log file to %lu bytes",
+                  log_file_size);
+      }
 
-      cur_file_handle.size = log_stats.st_size;
+      cur_file_handle.size = log_file_size;
 
       LOG_TRACE("The log file to be closed has size %d",
                 (int)cur_file_handle.size);
@@ -945,6 +1038,11 @@ void WriteAheadFrontendLogger::CreateNewLogFile(bool close_old_file) {
 
   if (cur_file_handle.fd == -1) {
     LOG_ERROR("cur_file_handle.fd is -1");
+  } else if (!no_write_) {
+    // reserve the whole segment so that appends and data syncs do not have
+    // to update the file size
+    LoggingUtil::PreallocateFile(
+        cur_file_handle, LogManager::GetInstance().GetLogFileSizeLimit() * 1024);
   }
 
   LOG_TRACE("FD of newly created file is %d", cur_file_handle.fd);
@@ -960,91 +1058,15 @@ void WriteAheadFrontendLogger::CreateNewLogFile(bool close_old_file) {
 }
 
 bool WriteAheadFrontendLogger::FileSwitchCondIsTrue() {
-  struct stat stat_buf;
   if (cur_file_handle.fd == -1) return false;
 
-  fstat(cur_file_handle.fd, &stat_buf);
-  cur_file_handle.size = stat_buf.st_size;
+  // use the write position, the file itself is preallocated
+  cur_file_handle.size = ftell(cur_file_handle.file);
 
   return cur_file_handle.size >
          LogManager::GetInstance().GetLogFileSizeLimit() * 1024;
 }
 
-void WriteAheadFrontendLogger::OpenNextLogFile() {
-  cid_t temp_max_log_id_file, temp_max_delimiter_file;
-
-  if (log_files_.size() == 0) {  // no log files, fresh start
-    LOG_TRACE("Size of log files list is 0.");
-    cur_file_handle = INVALID_FILE_HANDLE;
-    return;
-  }
-
-  if (this->log_file_cursor_ >= (int)this->log_files_.size()) {
-    LOG_TRACE("Cursor has reached the end. No more log files to read from.");
-    fclose(cur_file_handle.file);
-    cur_file_handle = INVALID_FILE_HANDLE;
-    return;
-  }
-
-  if (log_file_cursor_ != 0)  // close old file
-  {
-    LOG_TRACE("Closing last opened file");
-    fclose(cur_file_handle.file);
-  }
-
-  // open the next file
-  cur_file_handle.file =
-      fopen(GetFileNameFromVersion(log_files_[log_file_cursor_]->GetLogNumber())
-                .c_str(),
-            "rb");
-
-  if (cur_file_handle.file == NULL) {
-    LOG_ERROR("Couldn't open next log file");
-    cur_file_handle = INVALID_FILE_HANDLE;
-    return;
-  } else {
-    LOG_TRACE("Opened new log file for recovery");
-  }
-
-  cur_file_handle.fd = fileno(cur_file_handle.file);
-
-  LOG_TRACE("FD of opened file is %d", (int)cur_file_handle.fd);
-
-  // Skip first 8 bytes of max commit id
-  size_t read_size =
-      fread((void *)&temp_max_log_id_file, sizeof(temp_max_log_id_file), 1,
-            cur_file_handle.file);
-  if (read_size != 1) {
-    LOG_ERROR("Read failed after opening file %s",
-              GetFileNameFromVersion(
-                  log_files_[log_file_cursor_]->GetLogNumber()).c_str());
-  }
-
-  LOG_TRACE("On startup: MaxLogId of this file is %d",
-            (int)temp_max_log_id_file);
-
-  // Skip next 8 bytes of max delimiter
-  read_size = fread((void *)&temp_max_delimiter_file,
-                    sizeof(temp_max_delimiter_file), 1, cur_file_handle.file);
-
-  if (read_size != 1) {
-    LOG_ERROR("Read failed after opening file %s",
-              GetFileNameFromVersion(
-                  log_files_[log_file_cursor_]->GetLogNumber()).c_str());
-  }
-
-  LOG_TRACE("On startup: MaxDelimiter of this file is %d",
-            (int)temp_max_delimiter_file);
-
-  struct stat stat_buf;
-
-  fstat(cur_file_handle.fd, &stat_buf);
-  cur_file_handle.size = stat_buf.st_size;
-
-  log_file_cursor_++;
-  LOG_TRACE("Cursor is now %d", (int)log_file_cursor_);
-}
-
 void WriteAheadFrontendLogger::TruncateLog(cid_t truncate_log_id) {
   int return_val;
 
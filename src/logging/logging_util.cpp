@@ -12,6 +12,7 @@
 #include "logging/logging_util.h"
 
 #include <dirent.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <cstring>
 
@@ -108,6 +109,42 @@ void LoggingUtil::FFlushFsync(FileHandle &file_handle) {
   }
 }
 
+/**
+ * @brief Like FFlushFsync, but does not sync the file metadata that is not
+ * needed to read the data back, such as the modification time
+ */
+void LoggingUtil::FFlushFdatasync(FileHandle &file_handle) {
+  PL_ASSERT(file_handle.fd != -1);
+  if (file_handle.fd == -1) return;
+  int ret = fflush(file_handle.file);
+  if (ret != 0) {
+    LOG_ERROR("Error occured in fflush(%s)", strerror(errno));
+  }
+  ret = fdatasync(file_handle.fd);
+  if (ret != 0) {
+    LOG_ERROR("Error occured in fdatasync(%s)", strerror(errno));
+  }
+}
+
+/**
+ * @brief Allocate the blocks of a file up front, so that appending to it
+ * does not change its size and a data sync does not have to sync metadata.
+ * The file is extended with zeros, which read back as an invalid record
+ * type and thus as the end of the log.
+ * @return false if the file system does not support preallocation
+ */
+bool LoggingUtil::PreallocateFile(FileHandle &file_handle, size_t size) {
+  PL_ASSERT(file_handle.fd != -1);
+  if (file_handle.fd == -1) return false;
+  // unlike posix_fallocate, fallocate does not fall back to writing zeros
+  int ret = fallocate(file_handle.fd, 0, 0, size);
+  if (ret != 0) {
+    LOG_TRACE("Could not preallocate log file (%s)", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
 bool LoggingUtil::InitFileHandle(const char *name, FileHandle &file_handle,
                                  const char *mode) {
   auto file = fopen(name, mode);
@@ -13,6 +13,7 @@
 
 #include <iomanip>
 #include <algorithm>
+#include <thread>
 #include <sys/stat.h>
 
 #include "common/exception.h"
@@ -42,6 +43,7 @@ void Usage(FILE* out) {
           "   -v --flush-mode        :  Flush mode \n"
           "   -r --commit-interval   :  Group commit interval \n"
           "   -j --log-dir           :  Log directory\n"
+          "   -T --recovery-threads  :  Number of recovery threads \n"
           "   -y --benchmark-type    :  Benchmark type \n");
 }
 
@@ -56,6 +58,7 @@ static struct option opts[] = {
     {"commit-interval", optional_argument, NULL, 'r'},
     {"benchmark-type", optional_argument, NULL, 'y'},
     {"log-dir", optional_argument, NULL, 'j'},
+    {"recovery-threads", optional_argument, NULL, 'T'},
     {NULL, 0, NULL, 0}};
 
 static void ValidateLoggingType(const configuration& state) {
@@ -205,6 +208,16 @@ static void ValidatePCOMMITLatency(const configuration& state) {
   LOG_INFO("pcommit_latency :: %d", state.pcommit_latency);
 }
 
+static void ValidateRecoveryThreadCount(const configuration& state) {
+  if (state.recovery_thread_count <= 0) {
+    LOG_ERROR("Invalid recovery_thread_count :: %d",
+              state.recovery_thread_count);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("recovery_thread_count :: %d", state.recovery_thread_count);
+}
+
 static void ValidateLogFileDir(configuration& state) {
   struct stat data_stat;
   // Check the existence of the log directory
@@ -233,6 +246,8 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
   state.pcommit_latency = 0;
   state.asynchronous_mode = ASYNCHRONOUS_TYPE_SYNC;
   state.checkpoint_type = CheckpointType::INVALID;
+  state.recovery_thread_count =
+      std::max(std::thread::hardware_concurrency(), 1u);
 
   // YCSB Default Values
   ycsb::state.index = IndexType::BWTREE;
@@ -265,10 +280,10 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
   // Parse args
   while (1) {
     int idx = 0;
-    // logger - hs:x:f:l:t:q:v:r:y:
+    // logger - hs:x:f:l:t:q:v:r:y:j:T:
     // ycsb   - hemgi:k:d:p:b:c:o:u:z:n:
     // tpcc   - heagi:k:d:p:b:w:n:
-    int c = getopt_long(argc, argv, "hs:x:f:l:t:q:v:r:y:emgi:k:d:p:b:c:o:u:z:n:aw:j:",
+    int c = getopt_long(argc, argv, "hs:x:f:l:t:q:v:r:y:emgi:k:d:p:b:c:o:u:z:n:aw:j:T:",
                         opts, &idx);
 
     if (c == -1) break;
@@ -286,6 +301,9 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
       case 'j':
         state.log_file_dir = optarg;
         break;
+      case 'T':
+        state.recovery_thread_count = atoi(optarg);
+        break;
       case 'l':
         state.logging_type = (LoggingType)atoi(optarg);
         break;
@@ -404,6 +422,7 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
   ValidateFlushMode(state);
   ValidateNVMLatency(state);
   ValidatePCOMMITLatency(state);
+  ValidateRecoveryThreadCount(state);
 
   // Print YCSB configuration
   if (state.benchmark_type == BENCHMARK_TYPE_YCSB) {
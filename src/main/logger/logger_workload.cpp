@@ -358,6 +358,7 @@ void DoRecovery() {
   auto& log_manager = peloton::logging::LogManager::GetInstance();
   log_manager.ResetLogStatus();
   log_manager.ResetFrontendLoggers();
+  log_manager.SetRecoveryThreadCount(state.recovery_thread_count);
 
   Timer<std::milli> timer;
   std::thread thread;
@@ -394,6 +395,28 @@ void DoRecovery() {
 
   // Recovery time (in ms)
   LOG_INFO("recovery time: %lf", timer.GetDuration());
+
+  // Recovery throughput
+  if (logging::LoggingUtil::IsBasedOnWriteAheadLogging(peloton_logging_mode)) {
+    size_t record_count = 0;
+    size_t byte_count = 0;
+    for (auto& frontend_logger : log_manager.GetFrontendLoggersList()) {
+      auto wal_frontend_logger =
+          static_cast<logging::WriteAheadFrontendLogger*>(
+              frontend_logger.get());
+      record_count += wal_frontend_logger->GetRecoveredRecordCount();
+      byte_count += wal_frontend_logger->GetRecoveredByteCount();
+    }
+
+    auto duration = timer.GetDuration() / 1000;
+    if (duration > 0) {
+      LOG_INFO("recovery threads: %d", state.recovery_thread_count);
+      LOG_INFO("recovered records: %lu (%lf records/s)", record_count,
+               record_count / duration);
+      LOG_INFO("recovered bytes: %lu (%lf MB/s)", byte_count,
+               byte_count / duration / (1024 * 1024));
+    }
+  }
 }
 
 //===--------------------------------------------------------------------===//
@@ -27,7 +27,7 @@ void Usage(FILE *out) {
   fprintf(out,
           "Command line options : ycsb <options> \n"
           "   -h --help              :  print help message \n"
-          "   -i --index             :  index type: bwtree (default) \n"
+          "   -i --index             :  index type: bwtree (default), hash \n"
           "   -k --scale_factor      :  # of K tuples \n"
           "   -d --duration          :  execution duration \n"
           "   -p --profile_duration  :  profile duration \n"
@@ -63,7 +63,7 @@ static struct option opts[] = {
 };
 
 void ValidateIndex(const configuration &state) {
-  if (state.index != IndexType::BWTREE && state.index != IndexType::BWTREE) {
+  if (state.index != IndexType::BWTREE && state.index != IndexType::HASH) {
     LOG_ERROR("Invalid index");
     exit(EXIT_FAILURE);
   }
@@ -179,6 +179,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
         char *index = optarg;
         if (strcmp(index, "bwtree") == 0) {
           state.index = IndexType::BWTREE;
+        } else if (strcmp(index, "hash") == 0) {
+          state.index = IndexType::HASH;
         } else {
           LOG_ERROR("Unknown index: %s", index);
           exit(EXIT_FAILURE);
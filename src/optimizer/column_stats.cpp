@@ -0,0 +1,266 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_stats.cpp
+//
+// Identification: src/optimizer/column_stats.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/column_stats.h"
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "common/macros.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace optimizer {
+
+static inline bool IsLessThan(const type::Value &lhs, const type::Value &rhs) {
+  return lhs.CompareLessThan(rhs) == type::CMP_TRUE;
+}
+
+// Read the value as a number, for interpolating between histogram bounds
+static bool GetNumber(const type::Value &value, double &number) {
+  switch (value.GetTypeId()) {
+    case type::Type::TINYINT:
+      number = value.GetAs<int8_t>();
+      return true;
+    case type::Type::SMALLINT:
+      number = value.GetAs<int16_t>();
+      return true;
+    case type::Type::INTEGER:
+      number = value.GetAs<int32_t>();
+      return true;
+    case type::Type::BIGINT:
+      number = value.GetAs<int64_t>();
+      return true;
+    case type::Type::DECIMAL:
+      number = value.GetAs<double>();
+      return true;
+    case type::Type::TIMESTAMP:
+      number = value.GetAs<uint64_t>();
+      return true;
+    default:
+      return false;
+  }
+}
+
+ColumnStats::ColumnStats(type::Type::TypeId type, double null_fraction,
+                         double distinct_count,
+                         std::vector<type::Value> most_common_values,
+                         std::vector<double> most_common_frequencies,
+                         std::vector<type::Value> histogram_bounds)
+    : type_(type),
+      null_fraction_(null_fraction),
+      distinct_count_(distinct_count),
+      most_common_values_(std::move(most_common_values)),
+      most_common_frequencies_(std::move(most_common_frequencies)),
+      histogram_bounds_(std::move(histogram_bounds)) {
+  PL_ASSERT(most_common_values_.size() == most_common_frequencies_.size());
+  histogram_fraction_ = 1 - null_fraction_;
+  for (auto frequency : most_common_frequencies_) {
+    histogram_fraction_ -= frequency;
+  }
+  histogram_fraction_ = std::max(0.0, histogram_fraction_);
+}
+
+std::shared_ptr<ColumnStats> ColumnStats::Build(
+    type::Type::TypeId type, std::vector<type::Value> &sample_values,
+    size_t sample_row_count, double null_fraction, double distinct_count) {
+  std::unordered_map<type::Value, size_t, type::Value::hash,
+                     type::Value::equal_to> value_counts;
+  for (auto &value : sample_values) {
+    value_counts[value]++;
+  }
+
+  // The sample cannot hold more distinct values than the table
+  distinct_count = std::max(distinct_count, (double)value_counts.size());
+
+  // A value is common if it is well above the average frequency. When the
+  // sample holds every distinct value and there are few of them, they are
+  // all kept and no histogram is needed.
+  bool keep_all = (value_counts.size() <= STATS_MCV_COUNT &&
+                   distinct_count < value_counts.size() + 1);
+  double average_count = 0;
+  if (value_counts.empty() == false) {
+    average_count = sample_values.size() / (double)value_counts.size();
+  }
+
+  std::vector<std::pair<size_t, type::Value>> candidates;
+  for (auto &value_count : value_counts) {
+    if (keep_all == true ||
+        (value_count.second > 1 && value_count.second > 1.25 * average_count)) {
+      candidates.emplace_back(value_count.second, value_count.first);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const std::pair<size_t, type::Value> &lhs,
+               const std::pair<size_t, type::Value> &rhs) {
+              if (lhs.first != rhs.first) return lhs.first > rhs.first;
+              return IsLessThan(lhs.second, rhs.second);
+            });
+  if (candidates.size() > STATS_MCV_COUNT) {
+    candidates.resize(STATS_MCV_COUNT);
+  }
+
+  std::vector<type::Value> most_common_values;
+  std::vector<double> most_common_frequencies;
+  std::unordered_set<type::Value, type::Value::hash, type::Value::equal_to>
+      most_common_set;
+  for (auto &candidate : candidates) {
+    most_common_values.push_back(candidate.second);
+    most_common_frequencies.push_back(candidate.first /
+                                      (double)sample_row_count);
+    most_common_set.insert(candidate.second);
+  }
+
+  // The histogram covers the other values
+  auto histogram_end = std::partition(
+      sample_values.begin(), sample_values.end(),
+      [&](const type::Value &value) {
+        return most_common_set.count(value) == 0;
+      });
+  std::sort(sample_values.begin(), histogram_end, IsLessThan);
+
+  std::vector<type::Value> histogram_bounds;
+  size_t histogram_value_count = histogram_end - sample_values.begin();
+  if (histogram_value_count >= 2) {
+    size_t bucket_count =
+        std::min<size_t>(STATS_HISTOGRAM_BUCKETS, histogram_value_count - 1);
+    for (size_t bound_idx = 0; bound_idx <= bucket_count; bound_idx++) {
+      histogram_bounds.push_back(sample_values[
+          bound_idx * (histogram_value_count - 1) / bucket_count]);
+    }
+  }
+
+  return std::make_shared<ColumnStats>(
+      type, null_fraction, distinct_count, std::move(most_common_values),
+      std::move(most_common_frequencies), std::move(histogram_bounds));
+}
+
+double ColumnStats::GetEqualSelectivity(const type::Value &value) const {
+  if (value.IsNull() == true) {
+    return 0;
+  }
+
+  for (size_t value_idx = 0; value_idx < most_common_values_.size();
+       value_idx++) {
+    if (value.CompareEquals(most_common_values_[value_idx]) == type::CMP_TRUE) {
+      return most_common_frequencies_[value_idx];
+    }
+  }
+
+  // The other values share the rest of the rows evenly
+  double other_distinct_count =
+      distinct_count_ - most_common_values_.size();
+  return histogram_fraction_ / std::max(1.0, other_distinct_count);
+}
+
+double ColumnStats::GetLessThanSelectivity(const type::Value &value) const {
+  if (value.IsNull() == true) {
+    return 0;
+  }
+
+  double selectivity = 0;
+  for (size_t value_idx = 0; value_idx < most_common_values_.size();
+       value_idx++) {
+    if (IsLessThan(most_common_values_[value_idx], value) == true) {
+      selectivity += most_common_frequencies_[value_idx];
+    }
+  }
+  return selectivity + histogram_fraction_ * GetHistogramPosition(value);
+}
+
+double ColumnStats::GetHistogramPosition(const type::Value &value) const {
+  if (histogram_bounds_.size() < 2) {
+    return 0.5;
+  }
+  if (value.CompareLessThanEquals(histogram_bounds_.front()) ==
+      type::CMP_TRUE) {
+    return 0;
+  }
+  if (IsLessThan(histogram_bounds_.back(), value) == true) {
+    return 1;
+  }
+
+  // The bucket whose upper bound is the first one not less than the value
+  size_t upper_idx =
+      std::lower_bound(histogram_bounds_.begin(), histogram_bounds_.end(),
+                       value, IsLessThan) -
+      histogram_bounds_.begin();
+  PL_ASSERT(upper_idx > 0 && upper_idx < histogram_bounds_.size());
+
+  // Assume the values are spread evenly in the bucket
+  double in_bucket = 0.5;
+  double lower, upper, number;
+  if (GetNumber(histogram_bounds_[upper_idx - 1], lower) == true &&
+      GetNumber(histogram_bounds_[upper_idx], upper) == true &&
+      GetNumber(value, number) == true && upper > lower) {
+    in_bucket = (number - lower) / (upper - lower);
+  }
+
+  return (upper_idx - 1 + in_bucket) / (histogram_bounds_.size() - 1);
+}
+
+double ColumnStats::GetSelectivity(ExpressionType compare_type,
+                                   const type::Value &value) const {
+  // Parameters and values of other types tell nothing about the column
+  if (value.CheckComparable(type::ValueFactory::GetNullValueByType(type_)) ==
+      false) {
+    return DEFAULT_SELECTIVITY;
+  }
+
+  double non_null_fraction = 1 - null_fraction_;
+  double selectivity;
+  switch (compare_type) {
+    case ExpressionType::COMPARE_EQUAL:
+      selectivity = GetEqualSelectivity(value);
+      break;
+    case ExpressionType::COMPARE_NOTEQUAL:
+      selectivity = non_null_fraction - GetEqualSelectivity(value);
+      break;
+    case ExpressionType::COMPARE_LESSTHAN:
+      selectivity = GetLessThanSelectivity(value);
+      break;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      selectivity = GetLessThanSelectivity(value) + GetEqualSelectivity(value);
+      break;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      selectivity = non_null_fraction - GetLessThanSelectivity(value) -
+                    GetEqualSelectivity(value);
+      break;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      selectivity = non_null_fraction - GetLessThanSelectivity(value);
+      break;
+    default:
+      selectivity = DEFAULT_SELECTIVITY;
+      break;
+  }
+  return std::min(1.0, std::max(0.0, selectivity));
+}
+
+const std::string ColumnStats::GetInfo() const {
+  std::ostringstream os;
+  os << "ColumnStats[" << TypeIdToString(type_) << "]"
+     << " null fraction: " << null_fraction_
+     << " distinct: " << distinct_count_ << " most common: {";
+  for (size_t value_idx = 0; value_idx < most_common_values_.size();
+       value_idx++) {
+    if (value_idx > 0) os << ", ";
+    os << most_common_values_[value_idx].ToString() << ": "
+       << most_common_frequencies_[value_idx];
+  }
+  os << "} histogram bounds: " << histogram_bounds_.size();
+  return os.str();
+}
+
+}  // namespace optimizer
+}  // namespace peloton
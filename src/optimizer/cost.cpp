@@ -0,0 +1,168 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// cost.cpp
+//
+// Identification: src/optimizer/cost.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/cost.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "optimizer/stats.h"
+
+namespace peloton {
+namespace optimizer {
+
+// The comparison seen from the other side, as in "5 < a" to "a > 5"
+static ExpressionType MirrorComparison(ExpressionType compare_type) {
+  switch (compare_type) {
+    case ExpressionType::COMPARE_LESSTHAN:
+      return ExpressionType::COMPARE_GREATERTHAN;
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return ExpressionType::COMPARE_LESSTHAN;
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return ExpressionType::COMPARE_LESSTHANOREQUALTO;
+    default:
+      return compare_type;
+  }
+}
+
+static double GetComparisonSelectivity(
+    const Stats &stats, const expression::AbstractExpression *comparison,
+    oid_t table_id) {
+  auto compare_type = comparison->GetExpressionType();
+  auto left = comparison->GetChild(0);
+  auto right = comparison->GetChild(1);
+  if (left == nullptr || right == nullptr) {
+    return DEFAULT_SELECTIVITY;
+  }
+
+  if (left->GetExpressionType() == ExpressionType::VALUE_CONSTANT &&
+      right->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    std::swap(left, right);
+    compare_type = MirrorComparison(compare_type);
+  }
+  if (left->GetExpressionType() != ExpressionType::VALUE_TUPLE ||
+      right->GetExpressionType() != ExpressionType::VALUE_CONSTANT) {
+    return DEFAULT_SELECTIVITY;
+  }
+
+  auto column = static_cast<const expression::TupleValueExpression *>(left);
+  std::shared_ptr<ColumnStats> column_stats;
+  if (column->is_bound == true) {
+    column_stats = stats.GetColumnStats(std::get<1>(column->bound_obj_id),
+                                        std::get<2>(column->bound_obj_id));
+  } else if (table_id != INVALID_OID) {
+    column_stats = stats.GetColumnStats(table_id, column->GetColumnId());
+  }
+  if (column_stats == nullptr) {
+    return DEFAULT_SELECTIVITY;
+  }
+
+  auto value =
+      static_cast<const expression::ConstantValueExpression *>(right)
+          ->GetValue();
+  return column_stats->GetSelectivity(compare_type, value);
+}
+
+double Cost::GetSelectivity(const Stats &stats,
+                            const expression::AbstractExpression *predicate,
+                            oid_t table_id) {
+  if (predicate == nullptr) {
+    return 1;
+  }
+
+  switch (predicate->GetExpressionType()) {
+    case ExpressionType::CONJUNCTION_AND:
+      // The terms are taken to be independent
+      return GetSelectivity(stats, predicate->GetChild(0), table_id) *
+             GetSelectivity(stats, predicate->GetChild(1), table_id);
+    case ExpressionType::CONJUNCTION_OR: {
+      double left = GetSelectivity(stats, predicate->GetChild(0), table_id);
+      double right = GetSelectivity(stats, predicate->GetChild(1), table_id);
+      return left + right - left * right;
+    }
+    case ExpressionType::OPERATOR_NOT:
+      return 1 - GetSelectivity(stats, predicate->GetChild(0), table_id);
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return GetComparisonSelectivity(stats, predicate, table_id);
+    default:
+      return DEFAULT_SELECTIVITY;
+  }
+}
+
+size_t Cost::GetPredicateCount(
+    const expression::AbstractExpression *predicate) {
+  if (predicate == nullptr) {
+    return 0;
+  }
+  if (predicate->GetExpressionType() == ExpressionType::CONJUNCTION_AND) {
+    return GetPredicateCount(predicate->GetChild(0)) +
+           GetPredicateCount(predicate->GetChild(1));
+  }
+  return 1;
+}
+
+double Cost::GetJoinRows(double left_rows, double right_rows) {
+  return std::max(left_rows, right_rows);
+}
+
+double Cost::SeqScanCost(double table_rows, size_t predicate_count) {
+  return table_rows *
+         (DEFAULT_TUPLE_COST + predicate_count * DEFAULT_OPERATOR_COST);
+}
+
+double Cost::IndexScanCost(double table_rows, double matched_rows,
+                           size_t predicate_count) {
+  double descent_cost = std::log2(table_rows + 1) * DEFAULT_INDEX_TUPLE_COST;
+  return descent_cost +
+         matched_rows * (DEFAULT_INDEX_TUPLE_COST + DEFAULT_TUPLE_COST +
+                         predicate_count * DEFAULT_OPERATOR_COST);
+}
+
+double Cost::NLJoinCost(double left_rows, double right_rows,
+                        double output_rows) {
+  return left_rows * right_rows * DEFAULT_OPERATOR_COST +
+         output_rows * DEFAULT_TUPLE_COST;
+}
+
+double Cost::HashJoinCost(double left_rows, double right_rows,
+                          double output_rows) {
+  double build_cost =
+      right_rows * (DEFAULT_OPERATOR_COST + DEFAULT_MEMORY_TUPLE_COST);
+  double probe_cost = left_rows * DEFAULT_OPERATOR_COST;
+  return build_cost + probe_cost + output_rows * DEFAULT_TUPLE_COST;
+}
+
+double Cost::SortCost(double rows) {
+  if (rows < 2) {
+    return rows * DEFAULT_MEMORY_TUPLE_COST;
+  }
+  return rows * DEFAULT_MEMORY_TUPLE_COST +
+         rows * std::log2(rows) * DEFAULT_OPERATOR_COST;
+}
+
+double Cost::AggregateCost(double rows, double group_count,
+                           size_t aggregate_count) {
+  return rows * (1 + aggregate_count) * DEFAULT_OPERATOR_COST +
+         group_count * DEFAULT_MEMORY_TUPLE_COST;
+}
+
+}  // namespace optimizer
+}  // namespace peloton
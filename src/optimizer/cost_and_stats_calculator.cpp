@@ -12,7 +12,11 @@
 
 #include "optimizer/cost_and_stats_calculator.h"
 #include "optimizer/column_manager.h"
+#include "optimizer/cost.h"
+#include "optimizer/properties.h"
 #include "optimizer/stats.h"
+#include "optimizer/stats_storage.h"
+#include "storage/data_table.h"
 
 namespace peloton {
 namespace optimizer {
@@ -32,25 +36,105 @@ void CostAndStatsCalculator::CalculateCostAndStats(
   gexpr->Op().Accept(this);
 }
 
-void CostAndStatsCalculator::Visit(const PhysicalScan *) {
-  // TODO: Replace with more accurate cost
-  output_stats_.reset(new Stats(nullptr));
-  output_cost_ = 1;
+void CostAndStatsCalculator::Visit(const PhysicalScan *op) {
+  // Tables that were never analyzed are taken to be as large as the rows
+  // they hold
+  auto table_stats = StatsStorage::GetInstance().GetTableStats(
+      op->table_->GetOid());
+  double table_rows = (table_stats != nullptr)
+                          ? table_stats->GetNumRows()
+                          : (double)op->table_->GetTupleCount();
+  output_stats_.reset(new Stats(table_rows));
+  output_stats_->AddTableStats(table_stats);
+
+  expression::AbstractExpression *predicate = nullptr;
+  auto predicate_property =
+      output_properties_->GetPropertyOfType(PropertyType::PREDICATE);
+  if (predicate_property != nullptr) {
+    predicate = predicate_property->As<PropertyPredicate>()->GetPredicate();
+  }
+
+  output_stats_->SetNumRows(
+      table_rows *
+      Cost::GetSelectivity(*output_stats_, predicate, op->table_->GetOid()));
+  output_cost_ =
+      Cost::SeqScanCost(table_rows, Cost::GetPredicateCount(predicate));
 };
+
 void CostAndStatsCalculator::Visit(const PhysicalProject *) {
-  // TODO: Replace with more accurate cost
-  output_stats_.reset(new Stats(nullptr));
-  output_cost_ = 0;
+  PL_ASSERT(child_stats_.size() == 1);
+  output_stats_.reset(new Stats(child_stats_[0]->GetNumRows()));
+  output_stats_->AddTableStats(*child_stats_[0]);
+
+  size_t expression_count = 0;
+  auto projection_property =
+      output_properties_->GetPropertyOfType(PropertyType::PROJECT);
+  if (projection_property != nullptr) {
+    expression_count = projection_property->As<PropertyProjection>()
+                           ->GetProjectionListSize();
+  }
+  output_cost_ = child_costs_[0] + child_stats_[0]->GetNumRows() *
+                                       expression_count *
+                                       DEFAULT_OPERATOR_COST;
+}
+
+void CostAndStatsCalculator::Visit(const PhysicalFilter *) {
+  // The predicate is the second child and has no statistics
+  auto input_stats = child_stats_[0];
+  output_stats_.reset(
+      new Stats(input_stats->GetNumRows() * DEFAULT_SELECTIVITY));
+  output_stats_->AddTableStats(*input_stats);
+  output_cost_ = child_costs_[0] +
+                 input_stats->GetNumRows() * DEFAULT_OPERATOR_COST;
+};
+
+void CostAndStatsCalculator::Visit(const PhysicalInnerNLJoin *) {
+  CalculateJoin(false);
+};
+void CostAndStatsCalculator::Visit(const PhysicalLeftNLJoin *) {
+  CalculateJoin(false);
+};
+void CostAndStatsCalculator::Visit(const PhysicalRightNLJoin *) {
+  CalculateJoin(false);
+};
+void CostAndStatsCalculator::Visit(const PhysicalOuterNLJoin *) {
+  CalculateJoin(false);
+};
+void CostAndStatsCalculator::Visit(const PhysicalInnerHashJoin *) {
+  CalculateJoin(true);
+};
+void CostAndStatsCalculator::Visit(const PhysicalLeftHashJoin *) {
+  CalculateJoin(true);
+};
+void CostAndStatsCalculator::Visit(const PhysicalRightHashJoin *) {
+  CalculateJoin(true);
+};
+void CostAndStatsCalculator::Visit(const PhysicalOuterHashJoin *) {
+  CalculateJoin(true);
+};
+
+void CostAndStatsCalculator::CalculateJoin(bool hash_join) {
+  // The children are the two inputs and the join predicate
+  PL_ASSERT(child_stats_.size() >= 2);
+  auto &left_stats = child_stats_[0];
+  auto &right_stats = child_stats_[1];
+  double left_rows = left_stats->GetNumRows();
+  double right_rows = right_stats->GetNumRows();
+
+  // Outer joins keep the rows of their outer inputs, which the estimate
+  // already covers
+  double output_rows = Cost::GetJoinRows(left_rows, right_rows);
+  output_stats_.reset(new Stats(output_rows));
+  output_stats_->AddTableStats(*left_stats);
+  output_stats_->AddTableStats(*right_stats);
+
+  output_cost_ = child_costs_[0] + child_costs_[1];
+  if (hash_join == true) {
+    output_cost_ += Cost::HashJoinCost(left_rows, right_rows, output_rows);
+  } else {
+    output_cost_ += Cost::NLJoinCost(left_rows, right_rows, output_rows);
+  }
 }
-void CostAndStatsCalculator::Visit(const PhysicalFilter *){};
-void CostAndStatsCalculator::Visit(const PhysicalInnerNLJoin *){};
-void CostAndStatsCalculator::Visit(const PhysicalLeftNLJoin *){};
-void CostAndStatsCalculator::Visit(const PhysicalRightNLJoin *){};
-void CostAndStatsCalculator::Visit(const PhysicalOuterNLJoin *){};
-void CostAndStatsCalculator::Visit(const PhysicalInnerHashJoin *){};
-void CostAndStatsCalculator::Visit(const PhysicalLeftHashJoin *){};
-void CostAndStatsCalculator::Visit(const PhysicalRightHashJoin *){};
-void CostAndStatsCalculator::Visit(const PhysicalOuterHashJoin *){};
 
 } /* namespace optimizer */
 } /* namespace peloton */
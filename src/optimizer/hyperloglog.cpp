@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hyperloglog.cpp
+//
+// Identification: src/optimizer/hyperloglog.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/hyperloglog.h"
+
+#include <cmath>
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace optimizer {
+
+static const size_t HLL_REGISTER_COUNT = 1 << HLL_PRECISION;
+
+HyperLogLog::HyperLogLog() : registers_(HLL_REGISTER_COUNT, 0) {}
+
+void HyperLogLog::AddHash(uint64_t hash) {
+  // The hashes of integers are the integers themselves, so mix the bits
+  // before using them
+  hash ^= hash >> 33;
+  hash *= UINT64_C(0xff51afd7ed558ccd);
+  hash ^= hash >> 33;
+  hash *= UINT64_C(0xc4ceb9fe1a85ec53);
+  hash ^= hash >> 33;
+
+  size_t register_idx = hash >> (64 - HLL_PRECISION);
+  // Leading zeros of the remaining bits, plus one. The sentinel bit bounds
+  // the count when they are all zero.
+  uint64_t rest = (hash << HLL_PRECISION) | (UINT64_C(1) << (HLL_PRECISION - 1));
+  uint8_t rank = __builtin_clzll(rest) + 1;
+
+  if (rank > registers_[register_idx]) {
+    registers_[register_idx] = rank;
+  }
+}
+
+void HyperLogLog::Merge(const HyperLogLog &other) {
+  PL_ASSERT(registers_.size() == other.registers_.size());
+  for (size_t register_idx = 0; register_idx < registers_.size();
+       register_idx++) {
+    if (other.registers_[register_idx] > registers_[register_idx]) {
+      registers_[register_idx] = other.registers_[register_idx];
+    }
+  }
+}
+
+double HyperLogLog::Estimate() const {
+  double register_count = registers_.size();
+  double sum = 0;
+  size_t zero_count = 0;
+  for (auto rank : registers_) {
+    sum += std::ldexp(1.0, -rank);
+    if (rank == 0) {
+      zero_count++;
+    }
+  }
+
+  double alpha = 0.7213 / (1 + 1.079 / register_count);
+  double estimate = alpha * register_count * register_count / sum;
+
+  // Small cardinalities are better counted by the empty registers
+  if (estimate <= 2.5 * register_count && zero_count > 0) {
+    estimate = register_count * std::log(register_count / zero_count);
+  }
+  return estimate;
+}
+
+}  // namespace optimizer
+}  // namespace peloton
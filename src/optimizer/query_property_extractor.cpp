@@ -106,6 +106,8 @@ void QueryPropertyExtractor::Visit(
     UNUSED_ATTRIBUTE const parser::UpdateStatement *op) {}
 void QueryPropertyExtractor::Visit(
     UNUSED_ATTRIBUTE const parser::CopyStatement *op) {}
+void QueryPropertyExtractor::Visit(
+    UNUSED_ATTRIBUTE const parser::AnalyzeStatement *op) {}
 
 } /* namespace optimizer */
 } /* namespace peloton */
@@ -11,6 +11,8 @@
 //===----------------------------------------------------------------------===//
 
 #include "optimizer/simple_optimizer.h"
+#include "optimizer/cost.h"
+#include "optimizer/stats_storage.h"
 
 #include "parser/abstract_parse.h"
 
@@ -24,6 +26,7 @@
 #include "planner/abstract_plan.h"
 #include "planner/abstract_scan_plan.h"
 #include "planner/aggregate_plan.h"
+#include "planner/analyze_plan.h"
 #include "planner/copy_plan.h"
 #include "planner/create_plan.h"
 #include "planner/delete_plan.h"
@@ -497,6 +500,19 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
       child_plan = std::move(CreateCopyPlan(copy_parse_tree));
     } break;
 
+    case StatementType::ANALYZE: {
+      LOG_TRACE("Adding Analyze plan...");
+      parser::AnalyzeStatement* analyze_parse_tree =
+          static_cast<parser::AnalyzeStatement*>(parse_tree2);
+      storage::DataTable* target_table = nullptr;
+      if (analyze_parse_tree->table_info_ != nullptr) {
+        target_table = catalog::Catalog::GetInstance()->GetTableWithName(
+            analyze_parse_tree->GetDatabaseName(),
+            analyze_parse_tree->GetTableName());
+      }
+      child_plan.reset(new planner::AnalyzePlan(target_table));
+    } break;
+
     case StatementType::DELETE: {
       LOG_TRACE("Adding Delete plan...");
 
@@ -676,6 +692,15 @@ std::unique_ptr<planner::AbstractPlan> SimpleOptimizer::CreateCopyPlan(
   std::string table_name(copy_stmt->cpy_table->GetTableName());
   bool deserialize_parameters = false;
 
+  // Imports load the file straight into the table
+  if (copy_stmt->type == CopyType::IMPORT_CSV ||
+      copy_stmt->type == CopyType::IMPORT_TSV) {
+    auto target_table = catalog::Catalog::GetInstance()->GetTableWithName(
+        copy_stmt->cpy_table->GetDatabaseName(), table_name);
+    return std::unique_ptr<planner::AbstractPlan>(new planner::CopyPlan(
+        copy_stmt->file_path, target_table, copy_stmt->delimiter));
+  }
+
   // If we're copying the query metric table, then we need to handle the
   // deserialization of prepared stmt parameters
   if (table_name == QUERY_METRIC_NAME) {
@@ -799,6 +824,37 @@ bool SimpleOptimizer::CheckIndexSearchable(
     column_idx++;
   }
 
+  // Once the table is analyzed, scan it sequentially when the index would
+  // reach too many of its tuples
+  auto table_stats =
+      StatsStorage::GetInstance().GetTableStats(target_table->GetOid());
+  if (table_stats != nullptr) {
+    double selectivity = 1;
+    for (size_t key_idx = 0; key_idx < key_column_ids.size(); key_idx++) {
+      auto column_stats = table_stats->GetColumnStats(key_column_ids[key_idx]);
+      selectivity *= (column_stats != nullptr)
+                         ? column_stats->GetSelectivity(expr_types[key_idx],
+                                                        values[key_idx])
+                         : DEFAULT_SELECTIVITY;
+    }
+
+    double table_rows = table_stats->GetNumRows();
+    size_t predicate_count = Cost::GetPredicateCount(expression);
+    size_t residual_count =
+        predicate_count - std::min(predicate_count, key_column_ids.size());
+    if (Cost::SeqScanCost(table_rows, predicate_count) <
+        Cost::IndexScanCost(table_rows, table_rows * selectivity,
+                            residual_count)) {
+      LOG_DEBUG("Index '%s.%s' would reach %.0f tuples. Skipping...",
+                target_table->GetName().c_str(), index->GetName().c_str(),
+                table_rows * selectivity);
+      key_column_ids.clear();
+      expr_types.clear();
+      values.clear();
+      return (false);
+    }
+  }
+
   return true;
 }
 
@@ -1290,6 +1346,12 @@ std::unique_ptr<planner::AbstractPlan> SimpleOptimizer::CreateJoinPlan(
   return std::move(hash_join_plan_node);
 }
 
+// Whether a scan of the index returns the tuples in key order
+static bool IsOrderedIndex(index::Index* index) {
+  return index->GetIndexMethodType() == IndexType::BWTREE ||
+         index->GetIndexMethodType() == IndexType::SKIPLIST;
+}
+
 void SimpleOptimizer::SetIndexScanFlag(planner::AbstractPlan* select_plan,
                                        uint64_t limit, uint64_t offset,
                                        bool descent) {
@@ -1314,6 +1376,14 @@ void SimpleOptimizer::SetIndexScanFlag(planner::AbstractPlan* select_plan,
     }
   }
 
+  // A hash index returns its tuples in no particular order, so neither the
+  // limit nor the direction can be pushed into the scan
+  if (index_scan_plan != nullptr &&
+      IsOrderedIndex(index_scan_plan->GetIndex().get()) == false) {
+    LOG_TRACE("Index of the index scan plan is not ordered");
+    return;
+  }
+
   if (index_scan_plan != nullptr) {
     LOG_TRACE("Set index scan plan");
     index_scan_plan->SetLimit(true);
@@ -1354,6 +1424,12 @@ bool SimpleOptimizer::UnderlyingSameOrder(planner::AbstractPlan* select_plan,
     return false;
   }
 
+  // Only the tree indexes return their tuples in key order
+  if (IsOrderedIndex(index_scan_plan->GetIndex().get()) == false) {
+    LOG_TRACE("underlying index is not ordered");
+    return false;
+  }
+
   // Check whether index scan output has the same ordering with order_by
   if (index_scan_plan->GetDescend() != order_by_descending) {
     LOG_TRACE("index scan output does not have the same ordering");
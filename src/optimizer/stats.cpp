@@ -20,5 +20,26 @@ namespace optimizer {
 // Stats
 //===--------------------------------------------------------------------===//
 
+void Stats::AddTableStats(std::shared_ptr<TableStats> table_stats) {
+  if (table_stats != nullptr) {
+    table_stats_[table_stats->GetTableId()] = table_stats;
+  }
+}
+
+void Stats::AddTableStats(const Stats &input_stats) {
+  for (auto &table_stats : input_stats.table_stats_) {
+    table_stats_[table_stats.first] = table_stats.second;
+  }
+}
+
+std::shared_ptr<ColumnStats> Stats::GetColumnStats(oid_t table_id,
+                                                   oid_t column_id) const {
+  auto table_stats = table_stats_.find(table_id);
+  if (table_stats == table_stats_.end()) {
+    return nullptr;
+  }
+  return table_stats->second->GetColumnStats(column_id);
+}
+
 } /* namespace optimizer */
 } /* namespace peloton */
@@ -0,0 +1,166 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// stats_storage.cpp
+//
+// Identification: src/optimizer/stats_storage.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/stats_storage.h"
+
+#include <chrono>
+#include <sstream>
+
+#include "catalog/catalog.h"
+#include "catalog/catalog_util.h"
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "storage/data_table.h"
+#include "type/ephemeral_pool.h"
+
+namespace peloton {
+namespace optimizer {
+
+template <typename T>
+static std::string ListToString(const std::vector<T> &list) {
+  std::ostringstream os;
+  os << "{";
+  for (size_t idx = 0; idx < list.size(); idx++) {
+    if (idx > 0) os << ",";
+    os << list[idx];
+  }
+  os << "}";
+  return os.str();
+}
+
+static std::string ListToString(const std::vector<type::Value> &values) {
+  std::vector<std::string> strings;
+  for (auto &value : values) {
+    strings.push_back(value.ToString());
+  }
+  return ListToString(strings);
+}
+
+StatsStorage &StatsStorage::GetInstance() {
+  static StatsStorage stats_storage;
+  return stats_storage;
+}
+
+std::shared_ptr<TableStats> StatsStorage::AnalyzeTable(
+    storage::DataTable *table, concurrency::Transaction *txn) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  bool single_statement_txn = false;
+
+  if (txn == nullptr) {
+    single_statement_txn = true;
+    txn = txn_manager.BeginTransaction();
+  }
+
+  auto table_stats = TableStats::Collect(table, txn);
+  InsertColumnStats(*table_stats, txn);
+
+  if (single_statement_txn) {
+    txn_manager.CommitTransaction(txn);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    table_stats_[table->GetOid()] = table_stats;
+    analyzed_modified_counts_.erase(table->GetOid());
+  }
+  LOG_TRACE("%s", table_stats->GetInfo().c_str());
+  return table_stats;
+}
+
+std::shared_ptr<TableStats> StatsStorage::GetTableStats(oid_t table_id) {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  auto table_stats = table_stats_.find(table_id);
+  if (table_stats == table_stats_.end()) {
+    return nullptr;
+  }
+  return table_stats->second;
+}
+
+void StatsStorage::RefreshTableStats(storage::DataTable *table,
+                                     int64_t modified_count) {
+  oid_t table_id = table->GetOid();
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    auto table_stats = table_stats_.find(table_id);
+    if (table_stats == table_stats_.end()) {
+      return;
+    }
+
+    // The first report after ANALYZE is the starting point
+    auto analyzed_modified_count = analyzed_modified_counts_.find(table_id);
+    if (analyzed_modified_count == analyzed_modified_counts_.end()) {
+      analyzed_modified_counts_[table_id] = modified_count;
+      return;
+    }
+
+    double threshold = STATS_REFRESH_THRESHOLD +
+                       STATS_REFRESH_SCALE_FACTOR *
+                           table_stats->second->GetNumRows();
+    if (modified_count - analyzed_modified_count->second < threshold) {
+      return;
+    }
+  }
+
+  LOG_TRACE("Refreshing the statistics of table %u", table_id);
+  AnalyzeTable(table, nullptr);
+
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  analyzed_modified_counts_[table_id] = modified_count;
+}
+
+void StatsStorage::DropTableStats(oid_t table_id,
+                                  concurrency::Transaction *txn) {
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    analyzed_modified_counts_.erase(table_id);
+    if (table_stats_.erase(table_id) == 0) {
+      return;
+    }
+  }
+
+  auto column_stats_table = catalog::Catalog::GetInstance()->GetTableWithName(
+      CATALOG_DATABASE_NAME, COLUMN_STATS_NAME);
+  catalog::DeleteTuple(column_stats_table, table_id, txn);
+}
+
+void StatsStorage::InsertColumnStats(const TableStats &table_stats,
+                                     concurrency::Transaction *txn) {
+  auto column_stats_table = catalog::Catalog::GetInstance()->GetTableWithName(
+      CATALOG_DATABASE_NAME, COLUMN_STATS_NAME);
+  auto schema = column_stats_table->GetSchema();
+
+  auto time_since_epoch = std::chrono::system_clock::now().time_since_epoch();
+  auto time_stamp =
+      std::chrono::duration_cast<std::chrono::seconds>(time_since_epoch)
+          .count();
+
+  // Replace the rows of the last ANALYZE
+  catalog::DeleteTuple(column_stats_table, table_stats.GetTableId(), txn);
+
+  type::EphemeralPool pool;
+  for (oid_t column_id = 0; column_id < table_stats.GetColumnCount();
+       column_id++) {
+    auto column_stats = table_stats.GetColumnStats(column_id);
+    auto column_stats_tuple = catalog::GetColumnStatsCatalogTuple(
+        schema, table_stats.GetTableId(), column_id,
+        table_stats.GetDatabaseId(), (int64_t)table_stats.GetNumRows(),
+        column_stats->GetNullFraction(), column_stats->GetDistinctCount(),
+        ListToString(column_stats->GetMostCommonValues()),
+        ListToString(column_stats->GetMostCommonFrequencies()),
+        ListToString(column_stats->GetHistogramBounds()), time_stamp, &pool);
+    catalog::InsertTuple(column_stats_table, std::move(column_stats_tuple),
+                         txn);
+  }
+}
+
+}  // namespace optimizer
+}  // namespace peloton
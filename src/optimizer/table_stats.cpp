@@ -0,0 +1,227 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// table_stats.cpp
+//
+// Identification: src/optimizer/table_stats.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "optimizer/table_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <sstream>
+
+#include "catalog/schema.h"
+#include "common/init.h"
+#include "common/logger.h"
+#include "common/thread_pool.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "optimizer/hyperloglog.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace optimizer {
+
+// What a thread gathers from the tile groups it visits
+struct SampleWorker {
+  // Reservoir sample of the rows, each with the values of all the columns
+  std::vector<std::vector<type::Value>> sample;
+
+  size_t row_count = 0;
+
+  std::vector<size_t> null_counts;
+
+  std::vector<HyperLogLog> sketches;
+
+  std::vector<oid_t> visible_tuples;
+
+  std::mt19937_64 random;
+};
+
+// The values read from a tile point into its varlen pool, which is freed
+// with the tile group. The sampled ones are kept in the statistics.
+static type::Value GetOwnedValue(const type::Value &value) {
+  if (value.IsNull() == true) {
+    return value;
+  }
+  switch (value.GetTypeId()) {
+    case type::Type::VARCHAR:
+      return type::ValueFactory::GetVarcharValue(value.GetData(), true);
+    case type::Type::VARBINARY:
+      return type::ValueFactory::GetVarbinaryValue(
+          reinterpret_cast<const unsigned char *>(value.GetData()),
+          value.GetLength(), true);
+    default:
+      return value;
+  }
+}
+
+TableStats::TableStats(oid_t database_id, oid_t table_id, double num_rows,
+                       std::vector<std::shared_ptr<ColumnStats>> column_stats)
+    : database_id_(database_id),
+      table_id_(table_id),
+      num_rows_(num_rows),
+      column_stats_(std::move(column_stats)) {}
+
+std::shared_ptr<TableStats> TableStats::Collect(storage::DataTable *table,
+                                                concurrency::Transaction *txn,
+                                                size_t sample_size) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto schema = table->GetSchema();
+  oid_t column_count = schema->GetColumnCount();
+  oid_t tile_group_count = table->GetTileGroupCount();
+
+  size_t worker_count = std::max<size_t>(
+      1, std::min<size_t>(thread_pool.GetPoolSize() + 1, tile_group_count));
+  std::vector<SampleWorker> workers(worker_count);
+  for (size_t worker_idx = 0; worker_idx < worker_count; worker_idx++) {
+    workers[worker_idx].null_counts.assign(column_count, 0);
+    workers[worker_idx].sketches.resize(column_count);
+    workers[worker_idx].random.seed(worker_idx);
+  }
+
+  std::atomic<oid_t> next_offset(0);
+  thread_pool.RunTasks(worker_count, [&](size_t worker_idx) {
+    auto &worker = workers[worker_idx];
+    for (;;) {
+      oid_t offset = next_offset.fetch_add(1);
+      if (offset >= tile_group_count) break;
+
+      auto tile_group = table->GetTileGroup(offset);
+      txn_manager.GetVisibleTuples(txn, tile_group->GetHeader(),
+                                   tile_group->GetNextTupleSlot(),
+                                   worker.visible_tuples);
+
+      for (auto tuple_id : worker.visible_tuples) {
+        worker.row_count++;
+
+        // The first rows fill the reservoir. Then each row replaces a
+        // random one with probability sample_size / row_count.
+        size_t sample_idx = worker.sample.size();
+        if (sample_idx >= sample_size) {
+          sample_idx = worker.random() % worker.row_count;
+        }
+        bool sampled = (sample_idx < sample_size);
+
+        std::vector<type::Value> row;
+        if (sampled == true) {
+          row.reserve(column_count);
+        }
+        for (oid_t column_id = 0; column_id < column_count; column_id++) {
+          type::Value value = tile_group->GetValue(tuple_id, column_id);
+          if (value.IsNull() == true) {
+            worker.null_counts[column_id]++;
+          } else {
+            worker.sketches[column_id].Add(value);
+          }
+          if (sampled == true) {
+            row.push_back(GetOwnedValue(value));
+          }
+        }
+
+        if (sampled == false) {
+          continue;
+        }
+        if (sample_idx == worker.sample.size()) {
+          worker.sample.push_back(std::move(row));
+        } else {
+          worker.sample[sample_idx] = std::move(row);
+        }
+      }
+    }
+  });
+
+  // Draw the rows from the samples of the workers, each time picking a
+  // worker with probability proportional to the rows it has left
+  size_t row_count = 0;
+  std::vector<size_t> remaining_counts;
+  for (auto &worker : workers) {
+    row_count += worker.row_count;
+    remaining_counts.push_back(worker.row_count);
+  }
+  size_t remaining_count = row_count;
+
+  std::mt19937_64 random;
+  std::vector<std::vector<type::Value>> sample;
+  while (sample.size() < std::min(sample_size, row_count)) {
+    size_t pick = random() % remaining_count;
+    size_t worker_idx = 0;
+    while (pick >= remaining_counts[worker_idx]) {
+      pick -= remaining_counts[worker_idx];
+      worker_idx++;
+    }
+
+    auto &worker_sample = workers[worker_idx].sample;
+    PL_ASSERT(worker_sample.empty() == false);
+    size_t sample_idx = random() % worker_sample.size();
+    sample.push_back(std::move(worker_sample[sample_idx]));
+    worker_sample[sample_idx] = std::move(worker_sample.back());
+    worker_sample.pop_back();
+
+    remaining_counts[worker_idx]--;
+    remaining_count--;
+  }
+
+  std::vector<std::shared_ptr<ColumnStats>> column_stats;
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    size_t null_count = 0;
+    HyperLogLog sketch;
+    for (auto &worker : workers) {
+      null_count += worker.null_counts[column_id];
+      sketch.Merge(worker.sketches[column_id]);
+    }
+
+    std::vector<type::Value> values;
+    for (auto &row : sample) {
+      if (row[column_id].IsNull() == false) {
+        values.push_back(std::move(row[column_id]));
+      }
+    }
+
+    double null_fraction = 0;
+    if (row_count > 0) {
+      null_fraction = null_count / (double)row_count;
+    }
+    double distinct_count =
+        std::min(sketch.Estimate(), (double)(row_count - null_count));
+
+    column_stats.push_back(ColumnStats::Build(schema->GetType(column_id),
+                                              values, sample.size(),
+                                              null_fraction, distinct_count));
+  }
+
+  LOG_TRACE("Analyzed table %u: %lu rows, %lu sampled", table->GetOid(),
+            row_count, sample.size());
+
+  return std::make_shared<TableStats>(table->GetDatabaseOid(), table->GetOid(),
+                                      row_count, std::move(column_stats));
+}
+
+std::shared_ptr<ColumnStats> TableStats::GetColumnStats(
+    oid_t column_id) const {
+  if (column_id >= column_stats_.size()) {
+    return nullptr;
+  }
+  return column_stats_[column_id];
+}
+
+const std::string TableStats::GetInfo() const {
+  std::ostringstream os;
+  os << "TableStats[" << table_id_ << "] rows: " << num_rows_ << "\n";
+  for (oid_t column_id = 0; column_id < column_stats_.size(); column_id++) {
+    os << "  " << column_id << ": " << column_stats_[column_id]->GetInfo()
+       << "\n";
+  }
+  return os.str();
+}
+
+}  // namespace optimizer
+}  // namespace peloton
@@ -158,6 +158,7 @@ struct PARSER_CUST_LTYPE {
 	peloton::parser::ExecuteStatement*     exec_stmt;
 	peloton::parser::TransactionStatement* txn_stmt;
 	peloton::parser::CopyStatement* 	   copy_stmt;
+	peloton::parser::AnalyzeStatement*     analyze_stmt;
 
 	peloton::parser::TableRef* table;
 	peloton::parser::TableInfo* table_info;
@@ -222,13 +223,14 @@ struct PARSER_CUST_LTYPE {
 %type <drop_stmt>	drop_statement
 %type <txn_stmt>    transaction_statement
 %type <copy_stmt>   copy_statement
+%type <analyze_stmt> analyze_statement
 %type <sval> 		opt_alias alias
 %type <bval> 		opt_not_exists opt_exists opt_distinct opt_notnull opt_primary opt_unique opt_update
 %type <uval>		opt_join_type column_type opt_column_width opt_index_type
 %type <table> 		from_clause table_ref table_ref_atomic table_ref_name
 %type <table>		join_clause join_table table_ref_name_no_alias
 %type <expr> 		expr scalar_expr unary_expr binary_expr function_expr star_expr expr_alias parameter_expr opt_default
-%type <expr> 		column_name literal int_literal num_literal string_literal aggregate_expr
+%type <expr> 		column_name literal int_literal num_literal string_literal null_literal aggregate_expr
 %type <expr> 		comp_expr opt_where join_condition opt_having placeholder_expr
 %type <table_info>	table_name
 %type <order>		opt_order
@@ -308,6 +310,7 @@ preparable_statement:
 	|	execute_statement { $$ = $1; }
 	|	transaction_statement { $$ = $1; }	
 	|	copy_statement { $$ = $1; }
+	|	analyze_statement { $$ = $1; }
 	;
 
 
@@ -796,6 +799,7 @@ column_name:
 literal:
 		string_literal
 	|	num_literal
+	|	null_literal
 	|	placeholder_expr
 	|	parameter_expr
 	;
@@ -814,6 +818,10 @@ int_literal:
 		INTVAL { $$ = new peloton::expression::ConstantValueExpression(peloton::type::ValueFactory::GetIntegerValue($1)); $$->ival_ = $1; }
 	;
 
+null_literal:
+		NULL { $$ = new peloton::expression::ConstantValueExpression(peloton::type::ValueFactory::GetNullValueByType(peloton::type::Type::INTEGER)); }
+	;
+
 star_expr:
 		'*' { 
 			$$ = new peloton::expression::StarExpression(); 
@@ -948,6 +956,7 @@ join_condition:
 /******************************
  * Copy Statement
  * COPY catalog_db.query_metric TO '/home/user/query_metric.csv' DELIMITER ','
+ * COPY emp_db.department_table FROM '/home/user/department.csv' DELIMITER ','
  * TODO: Nested query like below is not supported yet
  * COPY (SELECT id FROM A WHERE val = 1) TO '/path/file.csv' DELIMITER ';'
  ******************************/
@@ -962,6 +971,35 @@ copy_statement:
 			$$->delimiter = *($6);
 			delete $6;
 		}
+	|	COPY table_ref_name FROM STRING DELIMITER STRING {
+			$$ = new CopyStatement(peloton::CopyType::IMPORT_CSV);
+			$$->cpy_table = $2;
+			$$->file_path = $4;
+			$$->delimiter = *($6);
+			delete $6;
+		}
+	|	COPY table_ref_name FROM STRING {
+			$$ = new CopyStatement(peloton::CopyType::IMPORT_CSV);
+			$$->cpy_table = $2;
+			$$->file_path = $4;
+		}
+	;
+
+
+/******************************
+ * Analyze Statement
+ * ANALYZE emp_db.department_table
+ * ANALYZE
+ ******************************/
+
+analyze_statement:
+		ANALYZE table_name {
+			$$ = new AnalyzeStatement();
+			$$->table_info_ = $2;
+		}
+	|	ANALYZE {
+			$$ = new AnalyzeStatement();
+		}
 	;
 
 
@@ -12,8 +12,13 @@
 //===----------------------------------------------------------------------===//
 
 #include "planner/insert_plan.h"
+
+
 #include "catalog/catalog.h"
 #include "catalog/column.h"
+#include "common/exception.h"
+#include "expression/parameter_value_expression.h"
+#include "type/arena_pool.h"
 #include "type/value.h"
 #include "parser/insert_statement.h"
 #include "parser/select_statement.h"
@@ -66,11 +71,14 @@ InsertPlan::InsertPlan(
         std::unique_ptr<storage::Tuple> tuple(
             new storage::Tuple(table_schema, true));
         int col_cntr = 0;
-        int param_index = 0;
         for (expression::AbstractExpression *elem : *values) {
           if (elem->GetExpressionType() == ExpressionType::VALUE_PARAMETER) {
+            // $n is bound to the n-th parameter wherever it is in the row
+            oid_t param_index =
+                static_cast<expression::ParameterValueExpression *>(elem)
+                    ->GetValueIdx();
             std::tuple<oid_t, oid_t, oid_t> pair =
-                std::make_tuple(tuple_idx, col_cntr, param_index++);
+                std::make_tuple(tuple_idx, col_cntr, param_index);
             parameter_vector_->push_back(pair);
             params_value_type_->push_back(
                 table_schema->GetColumn(col_cntr).GetType());
@@ -131,8 +139,12 @@ InsertPlan::InsertPlan(
 
             if (values->at(pos)->GetExpressionType() ==
                 ExpressionType::VALUE_PARAMETER) {
+              // $n is bound to the n-th parameter wherever it is in the row
+              oid_t param_index =
+                  static_cast<expression::ParameterValueExpression *>(
+                      values->at(pos))->GetValueIdx();
               std::tuple<oid_t, oid_t, oid_t> pair =
-                  std::make_tuple(tuple_idx, col_cntr, pos);
+                  std::make_tuple(tuple_idx, col_cntr, param_index);
               parameter_vector_->push_back(pair);
               params_value_type_->push_back(
                   table_schema->GetColumn(col_cntr).GetType());
@@ -159,17 +171,26 @@ InsertPlan::InsertPlan(
 type::AbstractPool *InsertPlan::GetPlanPool() {
   // construct pool if needed
   if (pool_.get() == nullptr)
-    pool_.reset(new type::EphemeralPool());
+    pool_.reset(new type::ArenaPool());
   // return pool
   return pool_.get();
 }
 
 void InsertPlan::SetParameterValues(std::vector<type::Value> *values) {
-  PL_ASSERT(values->size() == parameter_vector_->size());
+  if (values->size() != parameter_vector_->size()) {
+    throw PlannerException("Insert expects " +
+                           std::to_string(parameter_vector_->size()) +
+                           " parameters, got " +
+                           std::to_string(values->size()));
+  }
   LOG_TRACE("Set Parameter Values in Insert");
   for (unsigned int i = 0; i < values->size(); ++i) {
     auto param_type = params_value_type_->at(i);
     auto &put_loc = parameter_vector_->at(i);
+    if (std::get<2>(put_loc) >= values->size()) {
+      throw PlannerException("No value for insert parameter $" +
+                             std::to_string(std::get<2>(put_loc) + 1));
+    }
     auto value = values->at(std::get<2>(put_loc));
     // LOG_TRACE("Setting value of type %s",
     // ValueTypeToString(param_type).c_str());
@@ -47,7 +47,9 @@ BackendStatsContext* BackendStatsContext::GetInstance() {
 
 BackendStatsContext::BackendStatsContext(size_t max_latency_history,
                                          bool regiser_to_aggregator)
-    : txn_latencies_(LATENCY_METRIC, max_latency_history) {
+    : txn_latencies_(LATENCY_METRIC, max_latency_history),
+      commit_latencies_(HISTOGRAM_METRIC, "COMMIT LATENCY", "us"),
+      commits_per_fsync_(HISTOGRAM_METRIC, "COMMITS PER FSYNC", "txns") {
   std::thread::id this_id = std::this_thread::get_id();
   thread_id_ = this_id;
 
@@ -107,6 +109,14 @@ LatencyMetric& BackendStatsContext::GetTxnLatencyMetric() {
   return txn_latencies_;
 }
 
+HistogramMetric& BackendStatsContext::GetCommitLatencyHistogram() {
+  return commit_latencies_;
+}
+
+HistogramMetric& BackendStatsContext::GetCommitsPerFsyncHistogram() {
+  return commits_per_fsync_;
+}
+
 void BackendStatsContext::IncrementTableReads(oid_t tile_group_id) {
   oid_t table_id =
       catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetTableId();
@@ -217,6 +227,14 @@ void BackendStatsContext::IncrementTxnAborted(oid_t database_id) {
   CompleteQueryMetric();
 }
 
+void BackendStatsContext::IncrementPlanCacheLookups(bool hit) {
+  if (hit == true) {
+    plan_cache_hits_.Increment();
+  } else {
+    plan_cache_misses_.Increment();
+  }
+}
+
 void BackendStatsContext::InitQueryMetric(
     const std::shared_ptr<Statement> statement,
     const std::shared_ptr<QueryMetric::QueryParams> params) {
@@ -233,6 +251,10 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
   // Aggregate all global metrics
   txn_latencies_.Aggregate(source.txn_latencies_);
   txn_latencies_.ComputeLatencies();
+  commit_latencies_.Aggregate(source.commit_latencies_);
+  commits_per_fsync_.Aggregate(source.commits_per_fsync_);
+  plan_cache_hits_.Aggregate(source.plan_cache_hits_);
+  plan_cache_misses_.Aggregate(source.plan_cache_misses_);
 
   // Aggregate all per-database metrics
   for (auto& database_item : source.database_metrics_) {
@@ -267,6 +289,10 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
 
 void BackendStatsContext::Reset() {
   txn_latencies_.Reset();
+  commit_latencies_.Reset();
+  commits_per_fsync_.Reset();
+  plan_cache_hits_.Reset();
+  plan_cache_misses_.Reset();
 
   for (auto& database_item : database_metrics_) {
     database_item.second->Reset();
@@ -322,6 +348,16 @@ std::string BackendStatsContext::ToString() const {
   std::stringstream ss;
 
   ss << txn_latencies_.GetInfo() << std::endl;
+  if (commit_latencies_.GetCount() > 0) {
+    ss << commit_latencies_.GetInfo() << std::endl;
+  }
+  if (commits_per_fsync_.GetCount() > 0) {
+    ss << commits_per_fsync_.GetInfo() << std::endl;
+  }
+  if (plan_cache_hits_.GetCounter() + plan_cache_misses_.GetCounter() > 0) {
+    ss << "PLAN CACHE [hits=" << plan_cache_hits_.GetInfo()
+       << ", misses=" << plan_cache_misses_.GetInfo() << "]" << std::endl;
+  }
 
   for (auto& database_item : database_metrics_) {
     oid_t database_id = database_item.second->GetDatabaseId();
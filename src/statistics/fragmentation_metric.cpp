@@ -0,0 +1,35 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// fragmentation_metric.cpp
+//
+// Identification: src/statistics/fragmentation_metric.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "statistics/fragmentation_metric.h"
+#include "common/macros.h"
+
+namespace peloton {
+namespace stats {
+
+FragmentationMetric::FragmentationMetric(MetricType type)
+    : AbstractMetric(type) {}
+
+void FragmentationMetric::Aggregate(AbstractMetric &source) {
+  PL_ASSERT(source.GetType() == FRAGMENTATION_METRIC);
+
+  auto &fragmentation_metric = static_cast<FragmentationMetric &>(source);
+  tile_group_count_ += fragmentation_metric.tile_group_count_;
+  slot_count_ += fragmentation_metric.slot_count_;
+  live_tuple_count_ += fragmentation_metric.live_tuple_count_;
+  sparse_tile_group_count_ += fragmentation_metric.sparse_tile_group_count_;
+  relocated_tuple_count_ += fragmentation_metric.relocated_tuple_count_;
+  released_tile_group_count_ += fragmentation_metric.released_tile_group_count_;
+}
+
+}  // namespace stats
+}  // namespace peloton
@@ -0,0 +1,101 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// histogram_metric.cpp
+//
+// Identification: src/statistics/histogram_metric.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <sstream>
+
+#include "statistics/histogram_metric.h"
+#include "common/macros.h"
+
+namespace peloton {
+namespace stats {
+
+HistogramMetric::HistogramMetric(MetricType type, const std::string &name,
+                                 const std::string &unit)
+    : AbstractMetric(type), name_(name), unit_(unit) {
+  Reset();
+}
+
+uint64_t HistogramMetric::GetCount() const {
+  uint64_t count = 0;
+  for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+    count += GetBucketCount(bucket);
+  }
+  return count;
+}
+
+double HistogramMetric::GetAverage() const {
+  auto count = GetCount();
+  if (count == 0) {
+    return 0.0;
+  }
+  return (double)sum_.load(std::memory_order_relaxed) / count;
+}
+
+uint64_t HistogramMetric::GetPercentile(double quantile) const {
+  auto count = GetCount();
+  if (count == 0) {
+    return 0;
+  }
+
+  // Number of values that are at most the percentile
+  uint64_t rank = (uint64_t)(quantile * count);
+  if (rank == 0) rank = 1;
+
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+    seen += GetBucketCount(bucket);
+    if (seen >= rank) {
+      return GetBucketUpperBound(bucket);
+    }
+  }
+  return GetBucketUpperBound(BUCKET_COUNT - 1);
+}
+
+void HistogramMetric::Reset() {
+  for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+    buckets_[bucket].store(0, std::memory_order_relaxed);
+  }
+  sum_.store(0, std::memory_order_relaxed);
+}
+
+void HistogramMetric::Aggregate(AbstractMetric &source) {
+  PL_ASSERT(source.GetType() == HISTOGRAM_METRIC);
+
+  auto &histogram = static_cast<HistogramMetric &>(source);
+  for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+    buckets_[bucket].fetch_add(histogram.GetBucketCount(bucket),
+                               std::memory_order_relaxed);
+  }
+  sum_.fetch_add(histogram.sum_.load(std::memory_order_relaxed),
+                 std::memory_order_relaxed);
+}
+
+const std::string HistogramMetric::GetInfo() const {
+  std::stringstream ss;
+  ss << name_ << " (" << unit_ << "): [ ";
+  ss << "count=" << GetCount();
+  ss << ", average=" << GetAverage();
+  ss << ", median<=" << GetPercentile(0.5);
+  ss << ", 99th-%-tile<=" << GetPercentile(0.99);
+  ss << " ]" << std::endl;
+
+  for (size_t bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+    auto bucket_count = GetBucketCount(bucket);
+    if (bucket_count == 0) continue;
+    ss << "  [" << GetBucketLowerBound(bucket) << ", "
+       << GetBucketUpperBound(bucket) << "]: " << bucket_count << std::endl;
+  }
+  return ss.str();
+}
+
+}  // namespace stats
+}  // namespace peloton
@@ -17,6 +17,7 @@
 
 #include "catalog/catalog.h"
 #include "catalog/catalog_util.h"
+#include "optimizer/stats_storage.h"
 #include "statistics/backend_stats_context.h"
 #include "statistics/stats_aggregator.h"
 
@@ -109,6 +110,9 @@ void StatsAggregator::Aggregate(int64_t &interval_cnt, double &alpha,
   // Write the stats to metric tables
   UpdateMetrics();
 
+  // Analyze the tables that changed a lot since their last ANALYZE
+  RefreshTableStats();
+
   if (interval_cnt % STATS_LOG_INTERVALS == 0) {
     try {
       ofs_ << "At interval: " << interval_cnt << std::endl;
@@ -204,6 +208,24 @@ void StatsAggregator::UpdateMetrics() {
   txn_manager.CommitTransaction(txn);
 }
 
+void StatsAggregator::RefreshTableStats() {
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database_count = catalog->GetDatabaseCount();
+  for (oid_t database_offset = 0; database_offset < database_count; database_offset++) {
+    auto database = catalog->GetDatabaseWithOffset(database_offset);
+    auto database_oid = database->GetOid();
+    auto table_count = database->GetTableCount();
+    for (oid_t table_offset = 0; table_offset < table_count; table_offset++) {
+      auto table = database->GetTable(table_offset);
+      auto table_access =
+          aggregated_stats_.GetTableMetric(database_oid, table->GetOid())->GetTableAccess();
+      int64_t modified_count =
+          table_access.GetInserts() + table_access.GetUpdates() + table_access.GetDeletes();
+      optimizer::StatsStorage::GetInstance().RefreshTableStats(table, modified_count);
+    }
+  }
+}
+
 void StatsAggregator::UpdateTableMetrics(storage::Database *database, int64_t time_stamp,
                                          concurrency::Transaction *txn) {
   // Get the target table metrics table
@@ -35,6 +35,7 @@ void TableMetric::Aggregate(AbstractMetric& source) {
 
   TableMetric& table_metric = static_cast<TableMetric&>(source);
   table_access_.Aggregate(table_metric.GetTableAccess());
+  table_fragmentation_.Aggregate(table_metric.GetTableFragmentation());
 }
 
 }  // namespace stats
@@ -17,6 +17,7 @@
 #include "brain/sample.h"
 #include "catalog/catalog.h"
 #include "catalog/foreign_key.h"
+#include "common/container_tuple.h"
 #include "common/exception.h"
 #include "common/exception.h"
 #include "common/logger.h"
@@ -414,6 +415,105 @@ bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
   return true;
 }
 
+bool DataTable::InsertInIndexes(const std::vector<ItemPointer> &locations,
+                                concurrency::Transaction *transaction,
+                                std::vector<ItemPointer *> &index_entry_ptrs) {
+  auto &manager = catalog::Manager::GetInstance();
+  index_entry_ptrs.assign(locations.size(), nullptr);
+
+  int index_count = GetIndexCount();
+  if (index_count == 0 && foreign_keys_.empty() == true) {
+    return true;
+  }
+
+  // Point an index entry at every tuple first
+  if (index_count > 0) {
+    size_t active_indirection_array_id =
+        number_of_tuples_ % active_indirection_array_count_;
+    for (size_t tuple_itr = 0; tuple_itr < locations.size(); tuple_itr++) {
+      size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
+      while (true) {
+        auto active_indirection_array =
+            active_indirection_arrays_[active_indirection_array_id];
+        indirection_offset = active_indirection_array->AllocateIndirection();
+
+        if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
+          index_entry_ptrs[tuple_itr] =
+              active_indirection_array->GetIndirectionByOffset(
+                  indirection_offset);
+          break;
+        }
+      }
+
+      *index_entry_ptrs[tuple_itr] = locations[tuple_itr];
+
+      if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
+        AddDefaultIndirectionArray(active_indirection_array_id);
+      }
+    }
+  }
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  std::function<bool(const void *)> fn =
+      std::bind(&concurrency::TransactionManager::IsOccupied,
+                &transaction_manager, transaction, std::placeholders::_1);
+
+  // Tuples up to this one are in all the indexes done so far
+  size_t valid_count = locations.size();
+
+  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
+    auto index = GetIndex(index_itr);
+    auto index_schema = index->GetKeySchema();
+    auto indexed_columns = index_schema->GetIndexedColumns();
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+    bool is_unique = (index->GetIndexType() == IndexConstraintType::PRIMARY_KEY ||
+                      index->GetIndexType() == IndexConstraintType::UNIQUE);
+
+    for (size_t tuple_itr = 0; tuple_itr < valid_count; tuple_itr++) {
+      auto &location = locations[tuple_itr];
+      expression::ContainerTuple<storage::TileGroup> tuple(
+          manager.GetTileGroupPtr(location.block), location.offset);
+      key->SetFromTuple(&tuple, indexed_columns, index->GetPool());
+
+      if (is_unique == true) {
+        if (index->CondInsertEntry(key.get(), index_entry_ptrs[tuple_itr],
+                                   fn) == false) {
+          LOG_TRACE("Index constraint violated in %s",
+                    index->GetName().c_str());
+          valid_count = tuple_itr;
+        }
+      } else {
+        index->InsertEntry(key.get(), index_entry_ptrs[tuple_itr]);
+      }
+    }
+  }
+
+  // ForeignKey checks
+  if (foreign_keys_.empty() == false) {
+    for (size_t tuple_itr = 0; tuple_itr < valid_count; tuple_itr++) {
+      auto &location = locations[tuple_itr];
+      expression::ContainerTuple<storage::TileGroup> tuple(
+          manager.GetTileGroupPtr(location.block), location.offset);
+      if (CheckForeignKeyConstraints(&tuple) == false) {
+        LOG_TRACE("ForeignKey constraint violated");
+        valid_count = tuple_itr;
+        break;
+      }
+    }
+  }
+
+  // The tuples after a violation are in some of the indexes only, and
+  // readers may find them there, so the entries stay valid but are not
+  // returned
+  for (size_t tuple_itr = valid_count; tuple_itr < locations.size();
+       tuple_itr++) {
+    index_entry_ptrs[tuple_itr] = nullptr;
+  }
+  return valid_count == locations.size();
+}
+
 bool DataTable::InsertInSecondaryIndexes(const AbstractTuple *tuple,
                                          const TargetList *targets_ptr,
                                          concurrency::Transaction *transaction,
@@ -496,7 +596,7 @@ bool DataTable::InsertInSecondaryIndexes(const AbstractTuple *tuple,
  * @returns True on success, false if any foreign key constraints fail
  */
 bool DataTable::CheckForeignKeyConstraints(
-    const storage::Tuple *tuple UNUSED_ATTRIBUTE) {
+    const AbstractTuple *tuple UNUSED_ATTRIBUTE) {
   for (auto foreign_key : foreign_keys_) {
     oid_t sink_table_id = foreign_key->GetSinkTableOid();
     storage::DataTable *ref_table =
@@ -614,6 +714,29 @@ oid_t DataTable::AddDefaultIndirectionArray(
   return indirection_array_id;
 }
 
+std::shared_ptr<TileGroup> DataTable::AddBulkLoadTileGroup() {
+  column_map_type column_map =
+      GetTileGroupLayout((LayoutType)peloton_layout_mode);
+  std::shared_ptr<TileGroup> tile_group(GetTileGroupWithLayout(column_map));
+  PL_ASSERT(tile_group.get());
+
+  auto tile_group_id = tile_group->GetTileGroupId();
+  tile_groups_.Append(tile_group_id);
+
+  // add tile group metadata in locator
+  catalog::Manager::GetInstance().AddTileGroup(tile_group_id, tile_group);
+
+  // we must guarantee that the compiler always add tile group before adding
+  // tile_group_count_.
+  COMPILER_MEMORY_FENCE;
+
+  tile_group_count_++;
+
+  LOG_TRACE("Recording bulk load tile group : %u ", tile_group_id);
+
+  return tile_group;
+}
+
 oid_t DataTable::AddDefaultTileGroup() {
   size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
   return AddDefaultTileGroup(active_tile_group_id);
@@ -730,6 +853,16 @@ std::shared_ptr<storage::TileGroup> DataTable::GetTileGroupById(
   return manager.GetTileGroup(tile_group_id);
 }
 
+storage::TileGroup *DataTable::GetTileGroupPtr(
+    const std::size_t &tile_group_offset) const {
+  PL_ASSERT(tile_group_offset < GetTileGroupCount());
+
+  auto tile_group_id =
+      tile_groups_.FindValid(tile_group_offset, invalid_tile_group_id);
+
+  return catalog::Manager::GetInstance().GetTileGroupPtr(tile_group_id);
+}
+
 void DataTable::DropTileGroups() {
   auto &catalog_manager = catalog::Manager::GetInstance();
   auto tile_groups_size = tile_groups_.GetSize();
@@ -12,6 +12,7 @@
 
 #include <sstream>
 
+#include "catalog/catalog.h"
 #include "catalog/foreign_key.h"
 #include "common/exception.h"
 #include "common/logger.h"
@@ -23,12 +24,13 @@
 namespace peloton {
 namespace storage {
 
-Database::Database(const oid_t &database_oid) : database_oid(database_oid) {}
+Database::Database(const oid_t &database_oid)
+    : database_oid(database_oid), table_set(new TableSet()) {}
 
 Database::~Database() {
   // Clean up all the tables
   LOG_TRACE("Deleting tables from database");
-  for (auto table : tables) delete table;
+  for (auto table : GetTableSet()->tables) delete table;
 
   LOG_TRACE("Finish deleting tables from database");
 }
@@ -37,10 +39,25 @@ Database::~Database() {
 // TABLE
 //===--------------------------------------------------------------------===//
 
+void Database::SetTables(std::vector<storage::DataTable *> &&tables) {
+  std::shared_ptr<TableSet> new_table_set(new TableSet());
+  new_table_set->tables = std::move(tables);
+  // The first table of a name wins, as with a scan of the vector
+  for (auto table : new_table_set->tables) {
+    new_table_set->tables_by_name.emplace(table->GetName(), table);
+    new_table_set->tables_by_oid.emplace(table->GetOid(), table);
+  }
+  std::atomic_store(&table_set,
+                    std::shared_ptr<const TableSet>(std::move(new_table_set)));
+  catalog::Catalog::IncrementVersion();
+}
+
 void Database::AddTable(storage::DataTable *table, bool is_catalog) {
   {
     std::lock_guard<std::mutex> lock(database_mutex);
+    auto tables = GetTableSet()->tables;
     tables.push_back(table);
+    SetTables(std::move(tables));
 
     if (is_catalog == false) {
       // Register table to GC manager.
@@ -52,15 +69,17 @@ void Database::AddTable(storage::DataTable *table, bool is_catalog) {
 }
 
 storage::DataTable *Database::GetTableWithOid(const oid_t table_oid) const {
-  for (auto table : tables)
-    if (table->GetOid() == table_oid) return table;
+  auto current_table_set = GetTableSet();
+  auto itr = current_table_set->tables_by_oid.find(table_oid);
+  if (itr != current_table_set->tables_by_oid.end()) return itr->second;
   throw CatalogException("Table with oid = " + std::to_string(table_oid) + " is not found");
   return nullptr;
 }
 
 storage::DataTable *Database::GetTableWithName(const std::string table_name) const {
-  for (auto table : tables)
-    if (table->GetName() == table_name) return table;
+  auto current_table_set = GetTableSet();
+  auto itr = current_table_set->tables_by_name.find(table_name);
+  if (itr != current_table_set->tables_by_name.end()) return itr->second;
   throw CatalogException("Table '" + table_name + "' does not exist");
   return nullptr;
 }
@@ -75,28 +94,32 @@ void Database::DropTableWithOid(const oid_t table_oid) {
     assert(gc_manager != nullptr);
     gc_manager->DeregisterTable(table_oid);
 
+    auto tables = GetTableSet()->tables;
     oid_t table_offset = 0;
     for (auto table : tables) {
       if (table->GetOid() == table_oid) {
-        delete table;
         break;
       }
       table_offset++;
     }
     PL_ASSERT(table_offset < tables.size());
 
-    // Drop the table
+    // Drop the table, after it is no longer found
+    storage::DataTable *table = tables[table_offset];
     tables.erase(tables.begin() + table_offset);
+    SetTables(std::move(tables));
+    delete table;
   }
 }
 
 storage::DataTable *Database::GetTable(const oid_t table_offset) const {
-  PL_ASSERT(table_offset < tables.size());
-  auto table = tables.at(table_offset);
+  auto current_table_set = GetTableSet();
+  PL_ASSERT(table_offset < current_table_set->tables.size());
+  auto table = current_table_set->tables.at(table_offset);
   return table;
 }
 
-oid_t Database::GetTableCount() const { return tables.size(); }
+oid_t Database::GetTableCount() const { return GetTableSet()->tables.size(); }
 
 //===--------------------------------------------------------------------===//
 // UTILITIES
@@ -113,7 +136,7 @@ const std::string Database::GetInfo() const {
   os << "Table Count : " << table_count << "\n";
 
   oid_t table_itr = 0;
-  for (auto table : tables) {
+  for (auto table : GetTableSet()->tables) {
     if (table != nullptr) {
       os << "(" << ++table_itr << "/" << table_count << ") "
          << "Table Name(" << table->GetOid() << ") : " << table->GetName() << std::endl;
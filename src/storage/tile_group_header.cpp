@@ -35,7 +35,13 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
       data(nullptr),
       num_tuple_slots(tuple_count),
       next_tuple_slot(0),
-      tile_header_lock() {
+      tile_header_lock(),
+      write_generation(0),
+      frozen_generation(INVALID_GENERATION),
+      frozen_cid(MAX_CID),
+      compacting_cid(MAX_CID),
+      pending_garbage_count(0),
+      free_slot_count(0) {
   header_size = num_tuple_slots * header_entry_size;
 
   // allocate storage space for header
@@ -223,6 +229,80 @@ void TileGroupHeader::PrintVisibility(txn_id_t txn_id, cid_t at_cid) {
   LOG_TRACE("%s", os.str().c_str());
 }
 
+bool TileGroupHeader::GetVisibleTuples(const cid_t snapshot_cid,
+                                       const oid_t start_tuple_id,
+                                       const oid_t end_tuple_id,
+                                       std::vector<oid_t> &visible_tuples,
+                                       std::vector<oid_t> &undecided_tuples,
+                                       cid_t &max_begin_cid) const {
+  PL_ASSERT(end_tuple_id <= num_tuple_slots);
+  bool all_committed = true;
+  max_begin_cid = 0;
+
+  for (oid_t tuple_slot_id = start_tuple_id; tuple_slot_id < end_tuple_id;
+       tuple_slot_id++) {
+    const char *entry = TUPLE_HEADER_LOCATION;
+    txn_id_t tuple_txn_id = *((const txn_id_t *)(entry + txn_id_offset));
+    cid_t tuple_begin_cid = *((const cid_t *)(entry + begin_cid_offset));
+    cid_t tuple_end_cid = *((const cid_t *)(entry + end_cid_offset));
+
+    if (tuple_txn_id == INITIAL_TXN_ID) {
+      // committed version, visible if the snapshot lies in its lifetime
+      if ((snapshot_cid >= tuple_begin_cid) & (snapshot_cid < tuple_end_cid)) {
+        visible_tuples.push_back(tuple_slot_id);
+      }
+      all_committed &= (tuple_end_cid == MAX_CID);
+      if (tuple_begin_cid > max_begin_cid) max_begin_cid = tuple_begin_cid;
+    } else {
+      // owned by a transaction, or an empty / aborted slot
+      if (tuple_txn_id != INVALID_TXN_ID) {
+        undecided_tuples.push_back(tuple_slot_id);
+      }
+      all_committed = false;
+    }
+  }
+
+  return all_committed;
+}
+
+bool TileGroupHeader::IsFrozen(const cid_t snapshot_cid) const {
+  uint64_t generation = frozen_generation.load();
+  if (generation != write_generation.load()) {
+    return false;
+  }
+  cid_t max_begin_cid = frozen_cid.load();
+
+  // make sure frozen_cid belongs to the generation we checked
+  if (frozen_generation.load() != generation) {
+    return false;
+  }
+  return snapshot_cid >= max_begin_cid;
+}
+
+void TileGroupHeader::Freeze(const uint64_t generation,
+                             const cid_t max_begin_cid) const {
+  if (GetCurrentNextTupleSlot() != num_tuple_slots) {
+    // the tile group still receives inserts
+    return;
+  }
+
+  uint64_t current_generation = frozen_generation.load();
+  if (current_generation == generation ||
+      current_generation == FREEZING_GENERATION ||
+      write_generation.load() != generation) {
+    return;
+  }
+
+  // only one thread publishes a freeze at a time
+  if (frozen_generation.compare_exchange_strong(current_generation,
+                                                FREEZING_GENERATION) == false) {
+    return;
+  }
+  frozen_cid = max_begin_cid;
+  frozen_generation = generation;
+  LOG_TRACE("Froze tile group at generation %lu", generation);
+}
+
 // this function is called only when building tile groups for aggregation
 // operations.
 oid_t TileGroupHeader::GetActiveTupleCount() const {
@@ -0,0 +1,275 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_cache.cpp
+//
+// Identification: src/tcop/plan_cache.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "tcop/plan_cache.h"
+
+#include <strings.h>
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+
+#include "common/statement.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace tcop {
+
+static inline bool IsKeyword(const std::string &word, const char *keyword) {
+  return strcasecmp(word.c_str(), keyword) == 0;
+}
+
+static inline bool IsDigit(const std::string &query, size_t pos) {
+  return pos < query.size() && isdigit(query[pos]);
+}
+
+PlanCache::PlanCache(size_t max_queries, size_t max_idle_statements)
+    : max_queries_(max_queries), max_idle_statements_(max_idle_statements) {}
+
+PlanCache &PlanCache::GetInstance() {
+  static PlanCache plan_cache;
+  return plan_cache;
+}
+
+// The tokens follow the rules of the SQL scanner, so the parameterized query
+// parses like the original one
+bool PlanCache::ParameterizeQuery(const std::string &query, std::string &key,
+                                  std::string &query_string,
+                                  std::vector<type::Value> &params) {
+  query_string.clear();
+  params.clear();
+  // One letter per parameter, for the type of its literal
+  std::string param_types;
+
+  std::string query_type;
+  bool in_where = false;
+  bool in_values = false;
+  bool keep_next_literal = false;
+  int depth = 0;
+  int value_lists = 0;
+  bool space = false;
+
+  size_t pos = 0;
+  while (pos < query.size()) {
+    char c = query[pos];
+
+    if (isspace(c)) {
+      space = (query_string.empty() == false);
+      pos++;
+      continue;
+    }
+    if (space == true) {
+      query_string.push_back(' ');
+      space = false;
+    }
+
+    // Comments, and queries that already have parameters, are planned as
+    // they are
+    if ((c == '-' && pos + 1 < query.size() && query[pos + 1] == '-') ||
+        c == '$' || c == '?') {
+      return false;
+    }
+
+    // Quoted identifier
+    if (c == '"') {
+      size_t end = query.find('"', pos + 1);
+      if (end == std::string::npos) return false;
+      query_string.append(query, pos, end + 1 - pos);
+      pos = end + 1;
+      keep_next_literal = false;
+      continue;
+    }
+
+    // Keyword or identifier
+    if (isalpha(c)) {
+      size_t end = pos + 1;
+      while (end < query.size() && (isalnum(query[end]) || query[end] == '_')) {
+        end++;
+      }
+      std::string word = query.substr(pos, end - pos);
+      if (query_type.empty() == true) {
+        if (IsKeyword(word, "select") == false &&
+            IsKeyword(word, "insert") == false &&
+            IsKeyword(word, "update") == false &&
+            IsKeyword(word, "delete") == false) {
+          return false;
+        }
+        query_type = word;
+      }
+      if (IsKeyword(word, "where") == true) {
+        in_where = true;
+      } else if (IsKeyword(word, "values") == true) {
+        in_values = true;
+      }
+      // The parser wants plain numbers there
+      keep_next_literal = IsKeyword(word, "limit") ||
+                          IsKeyword(word, "offset") || IsKeyword(word, "by");
+      query_string.append(word);
+      pos = end;
+      continue;
+    }
+
+    bool is_string = (c == '\'');
+    bool is_number = isdigit(c) || (c == '.' && IsDigit(query, pos + 1)) ||
+                     (c == '-' && IsDigit(query, pos + 1));
+    if (is_string == false && is_number == false) {
+      if (c == '(') {
+        if (depth == 0 && in_values == true) {
+          value_lists++;
+        }
+        depth++;
+      } else if (c == ')') {
+        depth--;
+      }
+      query_string.push_back(c);
+      pos++;
+      keep_next_literal = false;
+      continue;
+    }
+
+    // Literal
+    if (query_type.empty() == true) return false;
+    size_t end = pos + 1;
+    bool is_decimal = (c == '.');
+    if (is_string == true) {
+      end = query.find('\'', pos + 1);
+      if (end == std::string::npos ||
+          query.find('\n', pos + 1) < end) {
+        return false;
+      }
+      end++;
+    } else {
+      while (IsDigit(query, end)) end++;
+      if (is_decimal == false && end < query.size() && query[end] == '.') {
+        is_decimal = true;
+        end++;
+        while (IsDigit(query, end)) end++;
+      }
+    }
+    std::string literal = query.substr(pos, end - pos);
+    pos = end;
+
+    // The SET clause of an UPDATE is cast to the column types when it is
+    // planned, so it keeps its literals
+    bool keep_literal = keep_next_literal;
+    if (IsKeyword(query_type, "update") == true && in_where == false) {
+      keep_literal = true;
+    }
+    keep_next_literal = false;
+    if (keep_literal == true) {
+      query_string.append(literal);
+      continue;
+    }
+
+    if (is_string == true) {
+      params.push_back(type::ValueFactory::GetVarcharValue(
+          literal.substr(1, literal.size() - 2)));
+      param_types.push_back('s');
+    } else if (is_decimal == true) {
+      params.push_back(
+          type::ValueFactory::GetDecimalValue(atof(literal.c_str())));
+      param_types.push_back('d');
+    } else {
+      long long value = strtoll(literal.c_str(), nullptr, 10);
+      if (value < INT_MIN || value > INT_MAX) return false;
+      params.push_back(type::ValueFactory::GetIntegerValue(value));
+      param_types.push_back('i');
+    }
+    query_string.append("$" + std::to_string(params.size()));
+  }
+
+  if (query_type.empty() == true) return false;
+
+  // Inserts bind their parameters by position within a single row
+  if (IsKeyword(query_type, "insert") == true &&
+      (in_values == false || value_lists != 1)) {
+    return false;
+  }
+
+  key = query_string + "\n" + param_types;
+  return true;
+}
+
+std::shared_ptr<Statement> PlanCache::Acquire(const std::string &key,
+                                              uint64_t &version) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  version = version_;
+
+  auto itr = entries_.find(key);
+  if (itr == entries_.end() || itr->second.idle_statements.empty() == true) {
+    return nullptr;
+  }
+
+  auto &entry = itr->second;
+  auto statement = std::move(entry.idle_statements.back());
+  entry.idle_statements.pop_back();
+  lru_keys_.splice(lru_keys_.begin(), lru_keys_, entry.lru_itr);
+  return statement;
+}
+
+void PlanCache::Release(const std::string &key,
+                        const std::shared_ptr<Statement> &statement,
+                        uint64_t version) {
+  if (statement.get() == nullptr) return;
+
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  if (version != version_) return;
+
+  auto itr = entries_.find(key);
+  if (itr == entries_.end()) {
+    // Make room by dropping the least recently used query
+    if (entries_.size() >= max_queries_ && lru_keys_.empty() == false) {
+      entries_.erase(lru_keys_.back());
+      lru_keys_.pop_back();
+    }
+    lru_keys_.push_front(key);
+    Entry entry;
+    entry.table_ids = statement->GetReferencedTables();
+    entry.lru_itr = lru_keys_.begin();
+    itr = entries_.emplace(key, std::move(entry)).first;
+  }
+
+  auto &idle_statements = itr->second.idle_statements;
+  if (idle_statements.size() < max_idle_statements_) {
+    idle_statements.push_back(statement);
+  }
+}
+
+// The statements in use are not tracked, so any invalidation drops them
+// when they are released
+void PlanCache::InvalidateTable(oid_t table_id) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  version_++;
+
+  for (auto itr = entries_.begin(); itr != entries_.end();) {
+    if (itr->second.table_ids.count(table_id) > 0) {
+      lru_keys_.erase(itr->second.lru_itr);
+      itr = entries_.erase(itr);
+    } else {
+      ++itr;
+    }
+  }
+}
+
+void PlanCache::Clear() {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  version_++;
+  entries_.clear();
+  lru_keys_.clear();
+}
+
+size_t PlanCache::GetQueryCount() {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return entries_.size();
+}
+
+}  // End tcop namespace
+}  // End peloton namespace
@@ -33,6 +33,8 @@
 #include "optimizer/simple_optimizer.h"
 
 #include "planner/plan_util.h"
+#include "statistics/backend_stats_context.h"
+#include "tcop/plan_cache.h"
 
 #include <boost/algorithm/string.hpp>
 
@@ -163,10 +165,25 @@ ResultType TrafficCop::ExecuteStatement(
 
 ResultType TrafficCop::ExecuteStatement(
     const std::shared_ptr<Statement> &statement,
-    const std::vector<type::Value> &params, UNUSED_ATTRIBUTE const bool unnamed,
+    const std::vector<type::Value> &params, const bool unnamed,
     std::shared_ptr<stats::QueryMetric::QueryParams> param_stats,
     const std::vector<int> &result_format, std::vector<StatementResult> &result,
-    int &rows_changed, UNUSED_ATTRIBUTE std::string &error_message) {
+    int &rows_changed, std::string &error_message) {
+  result.clear();
+  return ExecuteStatement(
+      statement, params, unnamed, param_stats,
+      [&result, &result_format](executor::LogicalTile *tile) {
+        bridge::PlanExecutor::AddResultTile(tile, result_format, result);
+      },
+      rows_changed, error_message);
+}
+
+ResultType TrafficCop::ExecuteStatement(
+    const std::shared_ptr<Statement> &statement,
+    const std::vector<type::Value> &params, UNUSED_ATTRIBUTE const bool unnamed,
+    std::shared_ptr<stats::QueryMetric::QueryParams> param_stats,
+    const bridge::ResultTileCallback &result_callback, int &rows_changed,
+    UNUSED_ATTRIBUTE std::string &error_message) {
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()->InitQueryMetric(statement,
                                                                param_stats);
@@ -186,11 +203,23 @@ ResultType TrafficCop::ExecuteStatement(
     else if (statement->GetQueryType() == "ROLLBACK")
       return AbortQueryHelper();
     else {
-      auto status = ExecuteStatementPlan(statement->GetPlanTree().get(), params,
-                                         result, result_format);
+      // Cached plans must not outlive the tables and indexes they use
+      auto plan = statement->GetPlanTree().get();
+      bool is_ddl = (plan != nullptr &&
+                     (plan->GetPlanNodeType() == PlanNodeType::CREATE ||
+                      plan->GetPlanNodeType() == PlanNodeType::DROP));
+      if (is_ddl == true) {
+        PlanCache::GetInstance().Clear();
+      }
+
+      auto status = ExecuteStatementPlan(plan, params, result_callback);
       LOG_TRACE("Statement executed. Result: %s",
                 ResultTypeToString(status.m_result).c_str());
       rows_changed = status.m_processed;
+
+      if (is_ddl == true) {
+        PlanCache::GetInstance().Clear();
+      }
       return status.m_result;
     }
   } catch (Exception &e) {
@@ -202,6 +231,16 @@ ResultType TrafficCop::ExecuteStatement(
 bridge::peloton_status TrafficCop::ExecuteStatementPlan(
     const planner::AbstractPlan *plan, const std::vector<type::Value> &params,
     std::vector<StatementResult> &result, const std::vector<int> &result_format) {
+  result.clear();
+  return ExecuteStatementPlan(
+      plan, params, [&result, &result_format](executor::LogicalTile *tile) {
+        bridge::PlanExecutor::AddResultTile(tile, result_format, result);
+      });
+}
+
+bridge::peloton_status TrafficCop::ExecuteStatementPlan(
+    const planner::AbstractPlan *plan, const std::vector<type::Value> &params,
+    const bridge::ResultTileCallback &result_callback) {
   concurrency::Transaction *txn;
   bool single_statement_txn = false, init_failure = false;
   bridge::peloton_status p_status;
@@ -222,8 +261,8 @@ bridge::peloton_status TrafficCop::ExecuteStatementPlan(
   // skip if already aborted
   if (curr_state.second != ResultType::ABORTED) {
     PL_ASSERT(txn);
-    p_status = bridge::PlanExecutor::ExecutePlan(plan, txn, params, result,
-                                                 result_format);
+    p_status =
+        bridge::PlanExecutor::ExecutePlan(plan, txn, params, result_callback);
 
     if (p_status.m_result == ResultType::FAILURE) {
       // only possible if init failed
@@ -306,6 +345,63 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
   }
 }
 
+std::shared_ptr<Statement> TrafficCop::PrepareCachedStatement(
+    const std::string &query_string, std::vector<type::Value> &params,
+    std::string &error_message) {
+  std::string parameterized_query;
+  cached_statement_key_.clear();
+  if (PlanCache::ParameterizeQuery(query_string, cached_statement_key_,
+                                   parameterized_query, params) == false) {
+    cached_statement_key_.clear();
+    params.clear();
+    return PrepareStatement("unnamed", query_string, error_message);
+  }
+
+  auto &plan_cache = PlanCache::GetInstance();
+  auto statement =
+      plan_cache.Acquire(cached_statement_key_, cached_statement_version_);
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementPlanCacheLookups(
+        statement.get() != nullptr);
+  }
+
+  if (statement.get() == nullptr) {
+    statement =
+        PrepareStatement("unnamed", parameterized_query, error_message);
+    if (statement.get() == nullptr) {
+      // Some literals cannot be parameters, plan the query as it is
+      LOG_TRACE("Failed to prepare parameterized query: %s",
+                parameterized_query.c_str());
+      cached_statement_key_.clear();
+      params.clear();
+      error_message.clear();
+      return PrepareStatement("unnamed", query_string, error_message);
+    }
+  }
+
+  if (params.empty() == false && statement->GetPlanTree().get() != nullptr) {
+    try {
+      statement->GetPlanTree()->SetParameterValues(&params);
+    } catch (std::exception &e) {
+      // The literals do not fit the cached plan, plan the query as it is
+      LOG_TRACE("Failed to bind parameters of %s: %s",
+                parameterized_query.c_str(), e.what());
+      ReleaseCachedStatement(statement);
+      params.clear();
+      return PrepareStatement("unnamed", query_string, error_message);
+    }
+  }
+  return statement;
+}
+
+void TrafficCop::ReleaseCachedStatement(
+    const std::shared_ptr<Statement> &statement) {
+  if (cached_statement_key_.empty() == true) return;
+  PlanCache::GetInstance().Release(cached_statement_key_, statement,
+                                   cached_statement_version_);
+  cached_statement_key_.clear();
+}
+
 std::vector<FieldInfo> TrafficCop::GenerateTupleDescriptor(
     parser::SQLStatement *sql_stmt) {
   std::vector<FieldInfo> tuple_descriptor;
@@ -399,11 +495,27 @@ FieldInfo TrafficCop::GetColumnFieldForValueType(
   PostgresValueType field_type;
   size_t field_size;
   switch (column_type) {
+    case type::Type::BOOLEAN: {
+      field_type = PostgresValueType::BOOLEAN;
+      field_size = 1;
+      break;
+    }
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT: {
+      field_type = PostgresValueType::SMALLINT;
+      field_size = 2;
+      break;
+    }
     case type::Type::INTEGER: {
       field_type = PostgresValueType::INTEGER;
       field_size = 4;
       break;
     }
+    case type::Type::BIGINT: {
+      field_type = PostgresValueType::BIGINT;
+      field_size = 8;
+      break;
+    }
     case type::Type::DECIMAL: {
       field_type = PostgresValueType::DOUBLE;
       field_size = 8;
@@ -417,7 +529,7 @@ FieldInfo TrafficCop::GetColumnFieldForValueType(
     }
     case type::Type::TIMESTAMP: {
       field_type = PostgresValueType::TIMESTAMPS;
-      field_size = 64;
+      field_size = 8;
       break;
     }
     default: {
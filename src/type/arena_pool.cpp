@@ -0,0 +1,147 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// arena_pool.cpp
+//
+// Identification: src/type/arena_pool.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "type/arena_pool.h"
+
+#include <cstdlib>
+
+namespace peloton {
+namespace type {
+
+constexpr size_t ArenaPool::CHUNK_SIZE;
+constexpr size_t ArenaPool::MAX_THREAD_COUNT;
+
+namespace {
+
+// A thread takes a slot the first time it allocates and gives it back when
+// it exits, so that the slots of the live threads stay few. Its chunks in
+// a pool are then found by the slot, and a thread that later gets the slot
+// goes on with them.
+std::atomic<uint64_t> used_thread_slots(0);
+
+static_assert(ArenaPool::MAX_THREAD_COUNT <= 64,
+              "thread slots must fit in the bitmap");
+
+struct ThreadSlot {
+  ThreadSlot() : slot(ArenaPool::MAX_THREAD_COUNT) {
+    uint64_t used = used_thread_slots.load();
+    while (~used != 0) {
+      size_t free_slot = __builtin_ctzll(~used);
+      if (free_slot >= ArenaPool::MAX_THREAD_COUNT) {
+        break;
+      }
+      if (used_thread_slots.compare_exchange_weak(
+              used, used | (1ULL << free_slot)) == true) {
+        slot = free_slot;
+        break;
+      }
+    }
+  }
+
+  ~ThreadSlot() {
+    if (slot < ArenaPool::MAX_THREAD_COUNT) {
+      used_thread_slots.fetch_and(~(1ULL << slot));
+    }
+  }
+
+  // MAX_THREAD_COUNT when all slots are taken
+  size_t slot;
+};
+
+thread_local ThreadSlot thread_slot;
+
+// Allocations larger than this get a chunk of their own
+constexpr size_t MAX_CARVED_SIZE = ArenaPool::CHUNK_SIZE / 4;
+
+constexpr size_t ALIGNMENT = 8;
+
+}  // namespace
+
+ArenaPool::ArenaPool() : reserved_size_(0) {}
+
+ArenaPool::~ArenaPool() {
+  chunk_lock_.Lock();
+  for (auto chunk : chunks_) {
+    free(chunk);
+  }
+  chunk_lock_.Unlock();
+}
+
+void *ArenaPool::Allocate(size_t size) {
+  size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+  size_t slot = thread_slot.slot;
+  if (slot >= MAX_THREAD_COUNT) {
+    return AllocateShared(size);
+  }
+
+  auto &thread_chunk = thread_chunks_[slot];
+  if (size <= static_cast<size_t>(thread_chunk.end - thread_chunk.next)) {
+    char *location = thread_chunk.next;
+    thread_chunk.next += size;
+    return location;
+  }
+
+  // Large allocations leave the chunk of the thread alone
+  if (size > MAX_CARVED_SIZE) {
+    return AllocateChunk(size);
+  }
+
+  char *chunk = AllocateChunk(CHUNK_SIZE);
+  if (chunk == nullptr) {
+    return nullptr;
+  }
+  thread_chunk.next = chunk + size;
+  thread_chunk.end = chunk + CHUNK_SIZE;
+  return chunk;
+}
+
+void *ArenaPool::AllocateShared(size_t size) {
+  if (size > MAX_CARVED_SIZE) {
+    return AllocateChunk(size);
+  }
+
+  chunk_lock_.Lock();
+  if (size > static_cast<size_t>(shared_chunk_.end - shared_chunk_.next)) {
+    char *chunk = AddChunk(CHUNK_SIZE);
+    if (chunk == nullptr) {
+      chunk_lock_.Unlock();
+      return nullptr;
+    }
+    shared_chunk_.next = chunk;
+    shared_chunk_.end = chunk + CHUNK_SIZE;
+  }
+  char *location = shared_chunk_.next;
+  shared_chunk_.next += size;
+  chunk_lock_.Unlock();
+  return location;
+}
+
+char *ArenaPool::AllocateChunk(size_t size) {
+  chunk_lock_.Lock();
+  char *chunk = AddChunk(size);
+  chunk_lock_.Unlock();
+  return chunk;
+}
+
+char *ArenaPool::AddChunk(size_t size) {
+  char *chunk = static_cast<char *>(malloc(size));
+  if (chunk == nullptr) {
+    return nullptr;
+  }
+  chunks_.push_back(chunk);
+  reserved_size_.fetch_add(size);
+  return chunk;
+}
+
+}  // namespace type
+}  // namespace peloton
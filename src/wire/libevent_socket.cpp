@@ -10,7 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <poll.h>
 #include <unistd.h>
+#include <chrono>
 #include "wire/libevent_server.h"
 
 namespace peloton {
@@ -27,6 +29,9 @@ void LibeventSocket::Init(short event_flags, LibeventThread *thread,
 
   // clear out packet
   rpkt.Reset();
+
+  // let queries stream their results through this socket
+  pkt_manager.stream_responses = [this]() { return StreamResponses(); };
   if (event == nullptr) {
     event = event_new(thread->GetEventBase(), sock_fd, event_flags,
                       EventHandler, this);
@@ -193,6 +198,46 @@ WriteState LibeventSocket::WritePackets() {
   return WRITE_COMPLETE;
 }
 
+bool LibeventSocket::StreamResponses() {
+  // rows should reach the client as soon as they are produced
+  pkt_manager.force_flush = true;
+
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(STREAM_WRITE_TIMEOUT_MS);
+  for (;;) {
+    switch (WritePackets()) {
+      case WRITE_COMPLETE:
+        return true;
+
+      case WRITE_NOT_READY: {
+        // the query runs on this thread, so it waits for the client to
+        // catch up instead of buffering more rows. The other connections of
+        // the thread wait too, so a client that stops reading is given up.
+        auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           deadline - std::chrono::steady_clock::now()).count();
+        if (timeout <= 0) {
+          LOG_ERROR("Client did not take the result rows in %d ms",
+                    STREAM_WRITE_TIMEOUT_MS);
+          return false;
+        }
+        struct pollfd poll_fd;
+        poll_fd.fd = sock_fd;
+        poll_fd.events = POLLOUT;
+        poll_fd.revents = 0;
+        if (poll(&poll_fd, 1, static_cast<int>(timeout)) < 0 &&
+            errno != EINTR) {
+          LOG_ERROR("Failed to wait for the socket to become writable");
+          return false;
+        }
+        break;
+      }
+
+      case WRITE_ERROR:
+        return false;
+    }
+  }
+}
+
 ReadState LibeventSocket::FillReadBuffer() {
   ReadState result = READ_NO_DATA_RECEIVED;
   ssize_t bytes_read = 0;
@@ -432,8 +477,9 @@ WriteState LibeventSocket::BufferWriteBytesHeader(OutputPacket *pkt) {
 WriteState LibeventSocket::BufferWriteBytesContent(OutputPacket *pkt) {
   // the packet content to write
   ByteBuf &pkt_buf = pkt->buf;
-  // the length of remaining content to write
-  size_t len = pkt->len;
+  // the length of remaining content to write, which is less than the packet
+  // when an earlier write was interrupted
+  size_t len = pkt->len - pkt->write_ptr;
   // window is the size of remaining space in socket's wbuf
   size_t window = 0;
 
@@ -15,12 +15,48 @@
 #include <iterator>
 #include "wire/marshal.h"
 #include "common/macros.h"
+#include "storage/tile.h"
+#include "type/value.h"
 
 #include <netinet/in.h>
 
 namespace peloton {
 namespace wire {
 
+// Days from 1970-01-01 to 2000-01-01, the epoch of PostgreSQL timestamps
+#define POSTGRES_EPOCH_DAYS 10957
+
+// Days from 1970-01-01 to the given date of the proleptic Gregorian calendar
+static int64_t DaysFromCivil(int64_t year, int64_t month, int64_t day) {
+  year -= (month <= 2) ? 1 : 0;
+  int64_t era = (year >= 0 ? year : year - 399) / 400;
+  int64_t year_of_era = year - era * 400;
+  int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int64_t day_of_era =
+      year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return era * 146097 + day_of_era - 719468;
+}
+
+// Convert a timestamp in the packed layout of type::TimestampType into
+// microseconds since the PostgreSQL epoch. The timestamp is sent as
+// "timestamp without time zone", so its time zone field is dropped.
+static int64_t TimestampToPostgres(uint64_t timestamp) {
+  int64_t micro = timestamp % 1000000;
+  timestamp /= 1000000;
+  int64_t second_of_day = timestamp % 100000;
+  timestamp /= 100000;
+  int64_t year = timestamp % 10000;
+  timestamp /= 10000;
+  // skip the time zone
+  timestamp /= 27;
+  int64_t day = timestamp % 32;
+  timestamp /= 32;
+  int64_t month = timestamp;
+
+  int64_t days = DaysFromCivil(year, month, day) - POSTGRES_EPOCH_DAYS;
+  return (days * 86400 + second_of_day) * 1000000 + micro;
+}
+
 // checks for parsing overflows
 inline void CheckOverflow(UNUSED_ATTRIBUTE InputPacket *rpkt,
                           UNUSED_ATTRIBUTE size_t size) {
@@ -162,5 +198,156 @@ void PacketPutCbytes(OutputPacket *pkt, const uchar *b, int len) {
   pkt->len += len;
 }
 
+void PacketPutInt64(OutputPacket *pkt, int64_t n) {
+  uint64_t value = static_cast<uint64_t>(n);
+  uchar bytes[sizeof(uint64_t)];
+  for (int i = sizeof(uint64_t) - 1; i >= 0; i--) {
+    bytes[i] = static_cast<uchar>(value & 0xff);
+    value >>= 8;
+  }
+  PacketPutCbytes(pkt, bytes, sizeof(uint64_t));
+}
+
+void PacketSetInt(OutputPacket *pkt, size_t offset, int n) {
+  PL_ASSERT(offset + sizeof(int32_t) <= pkt->buf.size());
+  n = htonl(n);
+  PL_MEMCPY(pkt->buf.data() + offset, &n, sizeof(int32_t));
+}
+
+void PacketPutTileField(OutputPacket *pkt, storage::Tile *tile,
+                        oid_t tuple_offset, oid_t column_id, int format) {
+  const catalog::Schema *schema = tile->GetSchema();
+  const type::Type::TypeId column_type = schema->GetType(column_id);
+  const char *field_location =
+      tile->GetTupleLocation(tuple_offset) + schema->GetOffset(column_id);
+
+  // Strings are the same in both formats
+  if (column_type == type::Type::VARCHAR ||
+      column_type == type::Type::VARBINARY) {
+    const char *data = *reinterpret_cast<const char *const *>(field_location);
+    if (data == nullptr) {
+      PacketPutInt(pkt, NULL_CONTENT_SIZE, 4);
+      return;
+    }
+    uint32_t len;
+    PL_MEMCPY(&len, data, sizeof(uint32_t));
+    // varchars are stored with their terminating null character
+    if (column_type == type::Type::VARCHAR && len > 0) {
+      len--;
+    }
+    PacketPutInt(pkt, len, 4);
+    PacketPutCbytes(pkt, reinterpret_cast<const uchar *>(data) +
+                             sizeof(uint32_t),
+                    len);
+    return;
+  }
+
+  if (format == 1) {
+    switch (column_type) {
+      case type::Type::BOOLEAN: {
+        int8_t value;
+        PL_MEMCPY(&value, field_location, sizeof(int8_t));
+        if (value == type::PELOTON_BOOLEAN_NULL) break;
+        PacketPutInt(pkt, 1, 4);
+        PacketPutByte(pkt, value != 0);
+        return;
+      }
+      // there is no 8-bit int in PostgreSQL, so tinyints are sent as int2
+      case type::Type::TINYINT: {
+        int8_t value;
+        PL_MEMCPY(&value, field_location, sizeof(int8_t));
+        if (value == type::PELOTON_INT8_NULL) break;
+        PacketPutInt(pkt, 2, 4);
+        PacketPutInt(pkt, value, 2);
+        return;
+      }
+      case type::Type::SMALLINT: {
+        int16_t value;
+        PL_MEMCPY(&value, field_location, sizeof(int16_t));
+        if (value == type::PELOTON_INT16_NULL) break;
+        PacketPutInt(pkt, 2, 4);
+        PacketPutInt(pkt, value, 2);
+        return;
+      }
+      case type::Type::INTEGER: {
+        int32_t value;
+        PL_MEMCPY(&value, field_location, sizeof(int32_t));
+        if (value == type::PELOTON_INT32_NULL) break;
+        PacketPutInt(pkt, 4, 4);
+        PacketPutInt(pkt, value, 4);
+        return;
+      }
+      case type::Type::BIGINT: {
+        int64_t value;
+        PL_MEMCPY(&value, field_location, sizeof(int64_t));
+        if (value == type::PELOTON_INT64_NULL) break;
+        PacketPutInt(pkt, 8, 4);
+        PacketPutInt64(pkt, value);
+        return;
+      }
+      // decimals are doubles, which are described as float8
+      case type::Type::DECIMAL: {
+        double value;
+        PL_MEMCPY(&value, field_location, sizeof(double));
+        if (value == type::PELOTON_DECIMAL_NULL) break;
+        int64_t bits;
+        PL_MEMCPY(&bits, &value, sizeof(int64_t));
+        PacketPutInt(pkt, 8, 4);
+        PacketPutInt64(pkt, bits);
+        return;
+      }
+      case type::Type::TIMESTAMP: {
+        uint64_t value;
+        PL_MEMCPY(&value, field_location, sizeof(uint64_t));
+        if (value == type::PELOTON_TIMESTAMP_NULL) break;
+        PacketPutInt(pkt, 8, 4);
+        PacketPutInt64(pkt, TimestampToPostgres(value));
+        return;
+      }
+      default: {
+        // no binary encoding, fall back to the text format
+        type::Value value =
+            type::Value::DeserializeFrom(field_location, column_type, false);
+        if (value.IsNull() == true) break;
+        auto str = value.ToString();
+        PacketPutInt(pkt, str.size(), 4);
+        PacketPutCbytes(pkt, reinterpret_cast<const uchar *>(str.data()),
+                        str.size());
+        return;
+      }
+    }
+    // the value is NULL
+    PacketPutInt(pkt, NULL_CONTENT_SIZE, 4);
+    return;
+  }
+
+  type::Value value =
+      type::Value::DeserializeFrom(field_location, column_type, false);
+  if (value.IsNull() == true) {
+    PacketPutInt(pkt, NULL_CONTENT_SIZE, 4);
+    return;
+  }
+  auto str = value.ToString();
+  PacketPutInt(pkt, str.size(), 4);
+  PacketPutCbytes(pkt, reinterpret_cast<const uchar *>(str.data()),
+                  str.size());
+}
+
+bool HasBinaryFormat(PostgresValueType field_type) {
+  switch (field_type) {
+    case PostgresValueType::BOOLEAN:
+    case PostgresValueType::SMALLINT:
+    case PostgresValueType::INTEGER:
+    case PostgresValueType::BIGINT:
+    case PostgresValueType::DOUBLE:
+    case PostgresValueType::TIMESTAMPS:
+    // the binary format of text is the string itself
+    case PostgresValueType::TEXT:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // end wire
 }  // end peloton
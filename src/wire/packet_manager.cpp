@@ -18,11 +18,13 @@
 #include "common/cache.h"
 #include "common/macros.h"
 #include "common/portal.h"
+#include "executor/logical_tile.h"
 #include "optimizer/simple_optimizer.h"
 #include "planner/abstract_plan.h"
 #include "planner/delete_plan.h"
 #include "planner/insert_plan.h"
 #include "planner/update_plan.h"
+#include "tcop/plan_cache.h"
 #include "tcop/tcop.h"
 #include "type/types.h"
 #include "type/value.h"
@@ -79,6 +81,8 @@ PacketManager::~PacketManager() {
 }
 
 void PacketManager::InvalidatePreparedStatements(oid_t table_id) {
+  tcop::PlanCache::GetInstance().InvalidateTable(table_id);
+
   if (table_statement_cache_.find(table_id) == table_statement_cache_.end()) {
     return;
   }
@@ -183,14 +187,16 @@ bool PacketManager::ProcessStartupPacket(InputPacket *pkt) {
 }
 
 void PacketManager::PutTupleDescriptor(
-    const std::vector<FieldInfo> &tuple_descriptor) {
+    const std::vector<FieldInfo> &tuple_descriptor,
+    const std::vector<int> &result_format) {
   if (tuple_descriptor.empty()) return;
 
   std::unique_ptr<OutputPacket> pkt(new OutputPacket());
   pkt->msg_type = NetworkMessageType::ROW_DESCRIPTION;
   PacketPutInt(pkt.get(), tuple_descriptor.size(), 2);
 
-  for (auto col : tuple_descriptor) {
+  for (size_t i = 0; i < tuple_descriptor.size(); i++) {
+    auto &col = tuple_descriptor[i];
     PacketPutString(pkt.get(), std::get<0>(col));
     // TODO: Table Oid (int32)
     PacketPutInt(pkt.get(), 0, 4);
@@ -202,39 +208,68 @@ void PacketManager::PutTupleDescriptor(
     PacketPutInt(pkt.get(), std::get<2>(col), 2);
     // Type modifier (int32)
     PacketPutInt(pkt.get(), -1, 4);
-    // Format code for text
-    PacketPutInt(pkt.get(), 0, 2);
+    // Format code, text unless the portal asked for binary
+    PacketPutInt(pkt.get(), i < result_format.size() ? result_format[i] : 0,
+                 2);
   }
   responses.push_back(std::move(pkt));
 }
 
-void PacketManager::SendDataRows(std::vector<StatementResult> &results,
+void PacketManager::SendDataRows(executor::LogicalTile *tile,
+                                 const std::vector<int> &result_format,
                                  int colcount, int &rows_affected) {
-  if (results.empty() || colcount == 0) return;
+  if (colcount == 0 || stream_failed_ == true) return;
 
-  size_t numrows = results.size() / colcount;
+  // Fields are written from the base tiles that the columns point to
+  auto &columns = tile->GetSchema();
+  auto &position_lists = tile->GetPositionLists();
+  PL_ASSERT(columns.size() >= static_cast<size_t>(colcount));
 
-  // 1 packet per row
-  for (size_t i = 0; i < numrows; i++) {
-    std::unique_ptr<OutputPacket> pkt(new OutputPacket());
-    pkt->msg_type = NetworkMessageType::DATA_ROW;
+  // One packet carries the complete DataRow messages of the whole tile, so
+  // it is written without a header of its own
+  std::unique_ptr<OutputPacket> pkt(new OutputPacket());
+  pkt->skip_header_write = true;
+  int row_count = 0;
+  for (oid_t tuple_id : *tile) {
+    PacketPutByte(pkt.get(), static_cast<uchar>(NetworkMessageType::DATA_ROW));
+    // length of the message, including the length field itself, is filled
+    // in once the fields are written
+    size_t row_len_offset = pkt->len;
+    PacketPutInt(pkt.get(), 0, 4);
     PacketPutInt(pkt.get(), colcount, 2);
     for (int j = 0; j < colcount; j++) {
-      auto content = results[i * colcount + j].second;
-      if (content.size() == 0) {
-        // content is NULL
+      auto &column = columns[j];
+      oid_t base_tuple_id = position_lists[column.position_list_idx][tuple_id];
+      if (base_tuple_id == NULL_OID) {
         PacketPutInt(pkt.get(), NULL_CONTENT_SIZE, 4);
-        // no value bytes follow
-      } else {
-        // length of the row attribute
-        PacketPutInt(pkt.get(), content.size(), 4);
-        // contents of the row attribute
-        PacketPutBytes(pkt.get(), content);
+        continue;
       }
+      int format = (static_cast<size_t>(j) < result_format.size())
+                       ? result_format[j]
+                       : 0;
+      PacketPutTileField(pkt.get(), column.base_tile.get(), base_tuple_id,
+                         column.origin_column_id, format);
+    }
+    PacketSetInt(pkt.get(), row_len_offset, pkt->len - row_len_offset);
+    row_count++;
+  }
+  if (row_count == 0) return;
+
+  // Stream the first rows of the result right away, and later ones once
+  // they fill the socket buffer
+  bool first_rows = (rows_affected == 0);
+  rows_affected += row_count;
+  queued_row_bytes_ += pkt->len;
+  responses.push_back(std::move(pkt));
+
+  if (stream_responses &&
+      (first_rows == true || queued_row_bytes_ >= SOCKET_BUFFER_SIZE)) {
+    queued_row_bytes_ = 0;
+    if (stream_responses() == false) {
+      LOG_ERROR("Failed to stream result rows");
+      stream_failed_ = true;
     }
-    responses.push_back(std::move(pkt));
   }
-  rows_affected = numrows;
 }
 
 void PacketManager::CompleteCommand(const std::string &query_type, int rows) {
@@ -316,14 +351,39 @@ void PacketManager::ExecQueryMessage(InputPacket *pkt) {
         return;
       }
 
-      std::vector<StatementResult> result;
-      std::vector<FieldInfo> tuple_descriptor;
       std::string error_message;
-      int rows_affected;
+      int rows_affected = 0;
+
+      // prepare the query using tcop, with its literals as parameters of a
+      // cached plan
+      std::vector<type::Value> params;
+      auto statement =
+          traffic_cop_->PrepareCachedStatement(query, params, error_message);
+      if (statement.get() == nullptr) {
+        SendErrorResponse(
+            {{NetworkMessageType::HUMAN_READABLE_ERROR, error_message}});
+        break;
+      }
 
-      // execute the query using tcop
+      // execute it, sending the attribute names ahead of the first rows
+      auto tuple_descriptor = statement->GetTupleDescriptor();
+      std::vector<int> result_format(tuple_descriptor.size(), 0);
+      bool described = false;
+      int rows_sent = 0;
+      queued_row_bytes_ = 0;
+      stream_failed_ = false;
       auto status = traffic_cop_->ExecuteStatement(
-          query, result, tuple_descriptor, rows_affected, error_message);
+          statement, params, true, nullptr,
+          [&](executor::LogicalTile *tile) {
+            if (described == false) {
+              PutTupleDescriptor(tuple_descriptor);
+              described = true;
+            }
+            SendDataRows(tile, result_format, tuple_descriptor.size(),
+                         rows_sent);
+          },
+          rows_affected, error_message);
+      traffic_cop_->ReleaseCachedStatement(statement);
 
       // check status
       if (status == ResultType::FAILURE) {
@@ -332,11 +392,13 @@ void PacketManager::ExecQueryMessage(InputPacket *pkt) {
         break;
       }
 
-      // send the attribute names
-      PutTupleDescriptor(tuple_descriptor);
-
-      // send the result rows
-      SendDataRows(result, tuple_descriptor.size(), rows_affected);
+      // send the attribute names of an empty result
+      if (described == false) {
+        PutTupleDescriptor(tuple_descriptor);
+      }
+      if (rows_sent > 0) {
+        rows_affected = rows_sent;
+      }
 
       // TODO: should change to query_type
       CompleteCommand(query, rows_affected);
@@ -559,6 +621,18 @@ void PacketManager::ExecBindMessage(InputPacket *pkt) {
     }
   }
 
+  // Columns without a binary encoding are sent as text whatever the client
+  // asked for, and they are described so
+  auto tuple_descriptor = statement->GetTupleDescriptor();
+  for (size_t i = 0; i < result_format_.size() && i < tuple_descriptor.size();
+       i++) {
+    auto field_type =
+        static_cast<PostgresValueType>(std::get<1>(tuple_descriptor[i]));
+    if (result_format_[i] != 0 && HasBinaryFormat(field_type) == false) {
+      result_format_[i] = 0;
+    }
+  }
+
   if (param_values.size() > 0) {
     statement->GetPlanTree()->SetParameterValues(&param_values);
     // Instead of tree traversal, we should put param values in the
@@ -761,7 +835,7 @@ bool PacketManager::ExecDescribeMessage(InputPacket *pkt) {
     }
 
     auto statement = portal->GetStatement();
-    PutTupleDescriptor(statement->GetTupleDescriptor());
+    PutTupleDescriptor(statement->GetTupleDescriptor(), result_format_);
   } else {
     LOG_TRACE("Describe a prepared statement");
   }
@@ -770,7 +844,6 @@ bool PacketManager::ExecDescribeMessage(InputPacket *pkt) {
 
 void PacketManager::ExecExecuteMessage(InputPacket *pkt) {
   // EXECUTE message
-  std::vector<StatementResult> results;
   std::string error_message, portal_name;
   int rows_affected = 0;
   GetStringToken(pkt, portal_name);
@@ -812,8 +885,15 @@ void PacketManager::ExecExecuteMessage(InputPacket *pkt) {
   bool unnamed = statement_name.empty();
   auto param_values = portal->GetParameters();
 
+  auto tuple_descriptor = statement->GetTupleDescriptor();
+  int rows_sent = 0;
+  queued_row_bytes_ = 0;
+  stream_failed_ = false;
   auto status = traffic_cop_->ExecuteStatement(
-      statement, param_values, unnamed, param_stat, result_format_, results,
+      statement, param_values, unnamed, param_stat,
+      [&](executor::LogicalTile *tile) {
+        SendDataRows(tile, result_format_, tuple_descriptor.size(), rows_sent);
+      },
       rows_affected, error_message);
 
   switch (status) {
@@ -832,8 +912,9 @@ void PacketManager::ExecExecuteMessage(InputPacket *pkt) {
       }
       return;
     default: {
-      auto tuple_descriptor = statement->GetTupleDescriptor();
-      SendDataRows(results, tuple_descriptor.size(), rows_affected);
+      if (rows_sent > 0) {
+        rows_affected = rows_sent;
+      }
       CompleteCommand(query_type, rows_affected);
       return;
     }
@@ -931,6 +1012,11 @@ bool PacketManager::ProcessPacket(InputPacket *pkt) {
                 static_cast<unsigned char>(pkt->msg_type));
     }
   }
+  // The client has only part of a result, the session cannot go on
+  if (stream_failed_ == true) {
+    LOG_ERROR("Closing the connection after a failed result stream");
+    return false;
+  }
   return true;
 }
 
@@ -970,6 +1056,8 @@ void PacketManager::Reset() {
   force_flush = false;
 
   responses.clear();
+  queued_row_bytes_ = 0;
+  stream_failed_ = false;
   unnamed_statement_.reset();
   result_format_.clear();
   txn_state_ = NetworkTransactionStateType::IDLE;
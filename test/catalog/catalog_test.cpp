@@ -96,11 +96,35 @@ TEST_F(CatalogTests, CreatingTable) {
             72);
 }
 
+TEST_F(CatalogTests, LookingUpTable) {
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database = catalog->GetDatabaseWithName("EMP_DB");
+  auto table = catalog->GetTableWithName("EMP_DB", "salary_table");
+  EXPECT_NE(table, nullptr);
+  EXPECT_EQ(table, catalog->GetTableWithName("EMP_DB", "salary_table"));
+  EXPECT_EQ(table, catalog->GetTableWithOid(database->GetOid(),
+                                            table->GetOid()));
+  EXPECT_EQ(database, catalog->GetDatabaseWithOid(database->GetOid()));
+  EXPECT_THROW(catalog->GetTableWithName("EMP_DB", "void_table"),
+               CatalogException);
+
+  // Adding an index changes the catalog
+  auto version = catalog::Catalog::GetVersion();
+  catalog->CreateIndex("EMP_DB", "salary_table", {"name"}, "salary_name_idx",
+                       false, IndexType::BWTREE);
+  EXPECT_GT(catalog::Catalog::GetVersion(), version);
+  EXPECT_EQ(table, catalog->GetTableWithName("EMP_DB", "salary_table"));
+}
+
 TEST_F(CatalogTests, DroppingTable) {
   EXPECT_EQ(catalog::Catalog::GetInstance()
                 ->GetDatabaseWithName("EMP_DB")
                 ->GetTableCount(),
             3);
+  EXPECT_NE(catalog::Catalog::GetInstance()->GetTableWithName(
+                "EMP_DB", "department_table"),
+            nullptr);
+  auto version = catalog::Catalog::GetVersion();
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   auto txn = txn_manager.BeginTransaction();
   catalog::Catalog::GetInstance()->DropTable("EMP_DB", "department_table", txn);
@@ -110,6 +134,10 @@ TEST_F(CatalogTests, DroppingTable) {
                 ->GetDatabaseWithName("EMP_DB")
                 ->GetTableCount(),
             2);
+  EXPECT_GT(catalog::Catalog::GetVersion(), version);
+  EXPECT_THROW(catalog::Catalog::GetInstance()->GetTableWithName(
+                   "EMP_DB", "department_table"),
+               CatalogException);
 
   // Try to drop again
   txn = txn_manager.BeginTransaction();
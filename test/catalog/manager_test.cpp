@@ -16,6 +16,7 @@
 #include "common/macros.h"
 #include "catalog/manager.h"
 #include "catalog/schema.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_factory.h"
 
@@ -70,5 +71,71 @@ TEST_F(ManagerTests, TransactionTest) {
   // EXPECT_EQ(catalog::Manager::GetInstance().GetCurrentTileGroupId(), 800);
 }
 
+static std::shared_ptr<storage::TileGroup> MakeTileGroup(oid_t tile_group_id) {
+  std::vector<catalog::Column> columns = {
+      catalog::Column(type::Type::INTEGER,
+                      type::Type::GetTypeSize(type::Type::INTEGER), "A", true)};
+  std::vector<catalog::Schema> schemas = {catalog::Schema(columns)};
+
+  std::map<oid_t, std::pair<oid_t, oid_t>> column_map;
+  column_map[0] = std::make_pair(0, 0);
+
+  return std::shared_ptr<storage::TileGroup>(
+      storage::TileGroupFactory::GetTileGroup(INVALID_OID, INVALID_OID,
+                                              tile_group_id, nullptr, schemas,
+                                              column_map, 3));
+}
+
+TEST_F(ManagerTests, TileGroupPtrTest) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  // Without an epoch thread, a dropped tile group goes away at once
+  oid_t tile_group_id = manager.GetNextTileGroupId();
+  auto tile_group = MakeTileGroup(tile_group_id);
+  std::weak_ptr<storage::TileGroup> tile_group_ref = tile_group;
+  manager.AddTileGroup(tile_group_id, tile_group);
+  tile_group.reset();
+
+  EXPECT_EQ(tile_group_ref.lock().get(),
+            manager.GetTileGroupPtr(tile_group_id));
+  manager.DropTileGroup(tile_group_id);
+  EXPECT_EQ(nullptr, manager.GetTileGroupPtr(tile_group_id));
+  EXPECT_TRUE(tile_group_ref.expired());
+
+  // With one, it outlives the transactions of its epoch
+  std::unique_ptr<std::thread> epoch_thread;
+  epoch_manager.StartEpoch(epoch_thread);
+
+  tile_group_id = manager.GetNextTileGroupId();
+  tile_group = MakeTileGroup(tile_group_id);
+  tile_group_ref = tile_group;
+  manager.AddTileGroup(tile_group_id, tile_group);
+  tile_group.reset();
+
+  auto epoch_id = epoch_manager.EnterEpoch(START_CID);
+  auto tile_group_ptr = manager.GetTileGroupPtr(tile_group_id);
+  manager.DropTileGroup(tile_group_id);
+  EXPECT_EQ(nullptr, manager.GetTileGroupPtr(tile_group_id));
+  EXPECT_FALSE(tile_group_ref.expired());
+  EXPECT_EQ(tile_group_id, tile_group_ptr->GetTileGroupId());
+  epoch_manager.ExitEpoch(epoch_id);
+
+  // Dropping another tile group frees the retired ones once their epoch is
+  // over
+  for (int drop_itr = 0; drop_itr < 100 && tile_group_ref.expired() == false;
+       drop_itr++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+    oid_t other_tile_group_id = manager.GetNextTileGroupId();
+    manager.AddTileGroup(other_tile_group_id,
+                         MakeTileGroup(other_tile_group_id));
+    manager.DropTileGroup(other_tile_group_id);
+  }
+  EXPECT_TRUE(tile_group_ref.expired());
+
+  epoch_manager.StopEpoch();
+  epoch_thread->join();
+}
+
 }  // End test namespace
 }  // End peloton namespace
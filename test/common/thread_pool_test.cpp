@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <stdexcept>
+
 #include "common/thread_pool.h"
 #include "common/harness.h"
 
@@ -74,5 +76,41 @@ TEST_F(ThreadPoolTests, BasicTest) {
   thread_pool.Shutdown();
 }
 
+TEST_F(ThreadPoolTests, RunTasksTest) {
+  ThreadPool thread_pool;
+  thread_pool.Initialize(3, 0);
+
+  // Every task runs exactly once
+  std::vector<std::atomic<int>> run_counts(100);
+  for (auto &run_count : run_counts) run_count = 0;
+  thread_pool.RunTasks(run_counts.size(), [&run_counts](size_t task_id) {
+    run_counts[task_id].fetch_add(1);
+  });
+  for (auto &run_count : run_counts) {
+    EXPECT_EQ(1, run_count.load());
+  }
+
+  // Exceptions thrown by tasks reach the caller
+  bool caught = false;
+  try {
+    thread_pool.RunTasks(10, [](size_t task_id) {
+      if (task_id == 7) throw std::runtime_error("task failed");
+    });
+  } catch (std::runtime_error &) {
+    caught = true;
+  }
+  EXPECT_TRUE(caught);
+
+  thread_pool.Shutdown();
+
+  // Without pool threads the caller runs all the tasks
+  ThreadPool empty_pool;
+  empty_pool.Initialize(0, 0);
+  std::atomic<int> counter(0);
+  empty_pool.RunTasks(5, [&counter](size_t) { counter.fetch_add(1); });
+  EXPECT_EQ(5, counter.load());
+  empty_pool.Shutdown();
+}
+
 }  // End test namespace
 }  // End peloton namespace
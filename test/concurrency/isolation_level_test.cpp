@@ -24,7 +24,8 @@ namespace test {
 class IsolationLevelTests : public PelotonTest {};
 
 static std::vector<ConcurrencyType> TEST_TYPES = {
-    ConcurrencyType::TIMESTAMP_ORDERING};
+    ConcurrencyType::TIMESTAMP_ORDERING,
+    ConcurrencyType::TIMESTAMP_ORDERING_EPOCH};
 
 void DirtyWriteTest() {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
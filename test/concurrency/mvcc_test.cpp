@@ -26,7 +26,8 @@ namespace test {
 class MVCCTests : public PelotonTest {};
 
 static std::vector<ConcurrencyType> TEST_TYPES = {
-    ConcurrencyType::TIMESTAMP_ORDERING};
+    ConcurrencyType::TIMESTAMP_ORDERING,
+    ConcurrencyType::TIMESTAMP_ORDERING_EPOCH};
 
 TEST_F(MVCCTests, SingleThreadVersionChainTest) {
   LOG_INFO("SingleThreadVersionChainTest");
@@ -169,5 +170,71 @@ TEST_F(MVCCTests, VersionChainTest) {
   }
 }
 
+// Checks that the batch visibility of every tile group matches IsVisible()
+static void CheckBatchVisibility(concurrency::TransactionManager &txn_manager,
+                                 concurrency::Transaction *txn,
+                                 storage::DataTable *table) {
+  for (oid_t offset = 0; offset < table->GetTileGroupCount(); offset++) {
+    auto tile_group = table->GetTileGroup(offset);
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t tuple_count = tile_group->GetNextTupleSlot();
+
+    std::vector<oid_t> expected_tuples;
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      if (txn_manager.IsVisible(txn, tile_group_header, tuple_id) ==
+          VisibilityType::OK) {
+        expected_tuples.push_back(tuple_id);
+      }
+    }
+
+    std::vector<oid_t> visible_tuples;
+    txn_manager.GetVisibleTuples(txn, tile_group_header, tuple_count,
+                                 visible_tuples);
+    EXPECT_EQ(expected_tuples, visible_tuples);
+  }
+}
+
+TEST_F(MVCCTests, BatchVisibilityTest) {
+  LOG_INFO("BatchVisibilityTest");
+
+  for (auto protocol : TEST_TYPES) {
+    concurrency::TransactionManagerFactory::Configure(
+        protocol, IsolationLevelType::FULL);
+
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+    // The first tile group is filled with committed tuples
+    const int num_key = 100;
+    std::unique_ptr<storage::DataTable> table(
+        TestingTransactionUtil::CreateTable(num_key));
+    auto tile_group_header = table->GetTileGroup(0)->GetHeader();
+
+    auto txn = txn_manager.BeginTransaction();
+    CheckBatchVisibility(txn_manager, txn, table.get());
+    EXPECT_TRUE(tile_group_header->IsFrozen(txn->GetBeginCommitId()));
+    CheckBatchVisibility(txn_manager, txn, table.get());
+    txn_manager.CommitTransaction(txn);
+
+    // An update in flight thaws the tile group
+    auto update_txn = txn_manager.BeginTransaction();
+    auto read_txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(
+        TestingTransactionUtil::ExecuteUpdate(update_txn, table.get(), 0, 1));
+    EXPECT_FALSE(tile_group_header->IsFrozen(read_txn->GetBeginCommitId()));
+    CheckBatchVisibility(txn_manager, update_txn, table.get());
+    CheckBatchVisibility(txn_manager, read_txn, table.get());
+    txn_manager.CommitTransaction(update_txn);
+
+    // The old snapshot still sees the old version
+    CheckBatchVisibility(txn_manager, read_txn, table.get());
+    txn_manager.CommitTransaction(read_txn);
+
+    txn = txn_manager.BeginTransaction();
+    CheckBatchVisibility(txn_manager, txn, table.get());
+    EXPECT_FALSE(tile_group_header->IsFrozen(txn->GetBeginCommitId()));
+    txn_manager.CommitTransaction(txn);
+  }
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -11,6 +11,9 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <algorithm>
+#include <set>
+
 #include "concurrency/testing_transaction_util.h"
 #include "common/harness.h"
 
@@ -25,7 +28,8 @@ namespace test {
 class TransactionTests : public PelotonTest {};
 
 static std::vector<ConcurrencyType> TEST_TYPES = {
-    ConcurrencyType::TIMESTAMP_ORDERING
+    ConcurrencyType::TIMESTAMP_ORDERING,
+    ConcurrencyType::TIMESTAMP_ORDERING_EPOCH
 };
 
 void TransactionTest(concurrency::TransactionManager *txn_manager,
@@ -230,5 +234,75 @@ TEST_F(TransactionTests, AbortTest) {
   }
 }
 
+TEST_F(TransactionTests, ReadWriteSetTest) {
+  // Enough tuples to move the set from linear search to its index, twice
+  // over so that buffers are recycled by the second transaction
+  for (int round = 0; round < 2; round++) {
+    concurrency::Transaction txn(round + 1, 1);
+
+    for (oid_t tuple_id = 0; tuple_id < 100; tuple_id++) {
+      txn.RecordRead(ItemPointer(tuple_id % 7, tuple_id));
+    }
+    txn.RecordUpdate(ItemPointer(3, 10));
+    txn.RecordReadOwn(ItemPointer(1, 50));
+    txn.RecordInsert(ItemPointer(8, 0));
+    EXPECT_TRUE(txn.RecordDelete(ItemPointer(8, 0)));
+    txn.RecordRead(ItemPointer(3, 10));
+
+    EXPECT_EQ(RWType::UPDATE, txn.GetRWType(ItemPointer(3, 10)));
+    EXPECT_EQ(RWType::READ_OWN, txn.GetRWType(ItemPointer(1, 50)));
+    EXPECT_EQ(RWType::INS_DEL, txn.GetRWType(ItemPointer(8, 0)));
+    EXPECT_EQ(RWType::READ, txn.GetRWType(ItemPointer(6, 6)));
+    EXPECT_EQ(RWType::INVALID, txn.GetRWType(ItemPointer(0, 6)));
+    EXPECT_FALSE(txn.IsReadOnly());
+
+    // Entries come in the order of first access
+    auto &rw_set = txn.GetReadWriteSet();
+    EXPECT_EQ(101UL, rw_set.size());
+    oid_t expected_tuple_id = 0;
+    for (auto &entry : rw_set) {
+      EXPECT_EQ(expected_tuple_id, entry.location.offset);
+      expected_tuple_id++;
+      if (expected_tuple_id == 100) expected_tuple_id = 0;
+    }
+  }
+}
+
+void CommitIdTest(concurrency::TransactionManager *txn_manager,
+                  std::vector<std::vector<cid_t>> *commit_ids,
+                  uint64_t thread_itr) {
+  for (size_t cid_itr = 0; cid_itr < 1000; cid_itr++) {
+    (*commit_ids)[thread_itr].push_back(txn_manager->GetNextCommitId());
+  }
+}
+
+TEST_F(TransactionTests, EpochCommitIdTest) {
+  auto &txn_manager = concurrency::TimestampOrderingTransactionManager::
+      GetInstance(ConcurrencyType::TIMESTAMP_ORDERING_EPOCH);
+  EXPECT_TRUE(txn_manager.IsEpochCommitId());
+
+  const size_t thread_count = 8;
+  std::vector<std::vector<cid_t>> commit_ids(thread_count);
+  LaunchParallelTest(thread_count, CommitIdTest, &txn_manager, &commit_ids);
+
+  // Commit ids are unique, and every thread sees its own ones grow
+  std::set<cid_t> all_commit_ids;
+  for (auto &thread_commit_ids : commit_ids) {
+    EXPECT_TRUE(std::is_sorted(thread_commit_ids.begin(),
+                               thread_commit_ids.end()));
+    for (auto cid : thread_commit_ids) {
+      EXPECT_LE(START_CID, cid);
+      all_commit_ids.insert(cid);
+    }
+  }
+  EXPECT_EQ(thread_count * 1000, all_commit_ids.size());
+
+  // Recovery moves commit ids past the recovered ones
+  cid_t recovered_cid = *all_commit_ids.rbegin() + (UINT64_C(1) << 32);
+  txn_manager.SetNextCid(recovered_cid);
+  EXPECT_LT(recovered_cid, txn_manager.GetNextCommitId());
+  txn_manager.ResetStates();
+}
+
 }  // End test namespace
 }  // End peloton namespace
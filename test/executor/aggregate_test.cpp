@@ -22,6 +22,8 @@
 #include "type/value.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/aggregate_executor.h"
+#include "executor/aggregate_hash_table.h"
+#include "executor/aggregator.h"
 #include "executor/executor_context.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
@@ -863,5 +865,70 @@ TEST_F(AggregateTests, PlainSumCountDistinctTest) {
   EXPECT_TRUE(cmp == type::CMP_TRUE);
 }
 
+TEST_F(AggregateTests, HashTableGroupTest) {
+  // COUNT(*) ... GROUP BY a and COUNT(*) ... GROUP BY a, b
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms;
+  agg_terms.emplace_back(ExpressionType::AGGREGATE_COUNT_STAR, nullptr);
+  std::vector<oid_t> integer_key = {0};
+  std::vector<oid_t> composite_key = {0, 1};
+
+  executor::AggregateHashTable integer_table(integer_key, agg_terms, 2);
+  executor::AggregateHashTable composite_table(composite_key, agg_terms, 2);
+
+  // Enough groups to grow both tables a few times
+  const int group_count = 2000;
+  std::vector<type::Value> values(2);
+  expression::ContainerTuple<std::vector<type::Value>> tuple(&values);
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < group_count; i++) {
+      values[0] = type::ValueFactory::GetIntegerValue(i);
+      values[1] = type::ValueFactory::GetVarcharValue(
+          (i % 2 == 0) ? "even" : "odd");
+      auto one = type::ValueFactory::GetIntegerValue(1);
+      integer_table.GetAggregator(integer_table.FindOrCreateGroup(&tuple), 0)
+          ->Advance(one);
+      composite_table.GetAggregator(composite_table.FindOrCreateGroup(&tuple),
+                                    0)->Advance(one);
+    }
+  }
+
+  // NULL keys form a single group
+  values[0] = type::ValueFactory::GetNullValueByType(type::Type::INTEGER);
+  auto one = type::ValueFactory::GetIntegerValue(1);
+  integer_table.GetAggregator(integer_table.FindOrCreateGroup(&tuple), 0)
+      ->Advance(one);
+  integer_table.GetAggregator(integer_table.FindOrCreateGroup(&tuple), 0)
+      ->Advance(one);
+
+  EXPECT_EQ(group_count + 1, integer_table.GetGroupCount());
+  EXPECT_EQ(group_count, composite_table.GetGroupCount());
+
+  for (int i = 0; i < group_count; i++) {
+    // Groups are kept in the order they were created
+    char *group = integer_table.GetGroup(i);
+    type::Value key = integer_table.GetFirstTupleValues(group)[0];
+    EXPECT_EQ(type::CMP_TRUE,
+              key.CompareEquals(type::ValueFactory::GetIntegerValue(i)));
+    EXPECT_EQ(type::CMP_TRUE,
+              integer_table.GetAggregator(group, 0)->Finalize().CompareEquals(
+                  type::ValueFactory::GetBigIntValue(3)));
+
+    group = composite_table.GetGroup(i);
+    type::Value name = composite_table.GetFirstTupleValues(group)[1];
+    EXPECT_EQ(type::CMP_TRUE,
+              name.CompareEquals(type::ValueFactory::GetVarcharValue(
+                  (i % 2 == 0) ? "even" : "odd")));
+    EXPECT_EQ(type::CMP_TRUE,
+              composite_table.GetAggregator(group, 0)->Finalize().CompareEquals(
+                  type::ValueFactory::GetBigIntValue(3)));
+  }
+
+  char *null_group = integer_table.GetGroup(group_count);
+  EXPECT_TRUE(integer_table.GetFirstTupleValues(null_group)[0].IsNull());
+  EXPECT_EQ(type::CMP_TRUE,
+            integer_table.GetAggregator(null_group, 0)->Finalize().CompareEquals(
+                type::ValueFactory::GetBigIntValue(2)));
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -0,0 +1,173 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_expression_test.cpp
+//
+// Identification: test/executor/compiled_expression_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/container_tuple.h"
+#include "executor/compiled_expression.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "executor/testing_executor_util.h"
+#include "expression/expression_util.h"
+#include "storage/tile_group.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Compiled Expression Tests
+//===--------------------------------------------------------------------===//
+
+class CompiledExpressionTests : public PelotonTest {};
+
+static const int tuple_count = 20;
+
+static std::unique_ptr<catalog::Schema> GetSchema() {
+  std::vector<catalog::Column> columns;
+  for (oid_t col_itr = 0; col_itr < 4; col_itr++) {
+    columns.push_back(TestingExecutorUtil::GetColumnInfo(col_itr));
+  }
+  return std::unique_ptr<catalog::Schema>(new catalog::Schema(columns));
+}
+
+static expression::AbstractExpression *Column(oid_t column_id) {
+  auto schema = GetSchema();
+  return expression::ExpressionUtil::TupleValueFactory(
+      schema->GetType(column_id), 0, column_id);
+}
+
+static expression::AbstractExpression *Integer(int32_t value) {
+  return expression::ExpressionUtil::ConstantValueFactory(
+      type::ValueFactory::GetIntegerValue(value));
+}
+
+// Check the compiled expression against the interpreter on every tuple
+static void CheckTileGroup(const expression::AbstractExpression *expr,
+                           storage::TileGroup *tile_group) {
+  auto schema = GetSchema();
+  auto compiled = executor::CompiledExpression::Compile(expr, schema.get(),
+                                                        nullptr, nullptr);
+  ASSERT_NE(nullptr, compiled);
+  EXPECT_EQ(expr->GetValueType(), compiled->GetValueType());
+  ASSERT_TRUE(compiled->Bind(0, tile_group));
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    expression::ContainerTuple<storage::TileGroup> tuple(tile_group, tuple_id);
+    oid_t tuple_ids[2] = {tuple_id, INVALID_OID};
+    type::Value expected = expr->Evaluate(&tuple, nullptr, nullptr);
+    type::Value value = compiled->Evaluate(tuple_ids);
+    EXPECT_EQ(type::CMP_TRUE, expected.CompareEquals(value))
+        << expected.ToString() << " != " << value.ToString();
+  }
+}
+
+TEST_F(CompiledExpressionTests, ArithmeticTest) {
+  auto tile_group = TestingExecutorUtil::CreateTileGroup(tuple_count);
+  TestingExecutorUtil::PopulateTiles(tile_group, tuple_count);
+
+  // a * 3 - b
+  std::unique_ptr<expression::AbstractExpression> integer_expr(
+      expression::ExpressionUtil::OperatorFactory(
+          ExpressionType::OPERATOR_MINUS, type::Type::INTEGER,
+          expression::ExpressionUtil::OperatorFactory(
+              ExpressionType::OPERATOR_MULTIPLY, type::Type::INTEGER,
+              Column(0), Integer(3)),
+          Column(1)));
+  CheckTileGroup(integer_expr.get(), tile_group.get());
+
+  // c / (a + 1)
+  std::unique_ptr<expression::AbstractExpression> decimal_expr(
+      expression::ExpressionUtil::OperatorFactory(
+          ExpressionType::OPERATOR_DIVIDE, type::Type::DECIMAL, Column(2),
+          expression::ExpressionUtil::OperatorFactory(
+              ExpressionType::OPERATOR_PLUS, type::Type::INTEGER, Column(0),
+              Integer(1))));
+  CheckTileGroup(decimal_expr.get(), tile_group.get());
+
+  // b % a divides by zero on the first tuple, as in the interpreter
+  std::unique_ptr<expression::AbstractExpression> modulo_expr(
+      expression::ExpressionUtil::OperatorFactory(
+          ExpressionType::OPERATOR_MOD, type::Type::INTEGER, Column(1),
+          Column(0)));
+  auto schema = GetSchema();
+  auto compiled = executor::CompiledExpression::Compile(
+      modulo_expr.get(), schema.get(), nullptr, nullptr);
+  ASSERT_NE(nullptr, compiled);
+  ASSERT_TRUE(compiled->Bind(0, tile_group.get()));
+  oid_t tuple_ids[2] = {0, INVALID_OID};
+  EXPECT_THROW(compiled->Evaluate(tuple_ids), Exception);
+  tuple_ids[0] = 1;
+  EXPECT_EQ(1, compiled->Evaluate(tuple_ids).GetAs<int32_t>());
+}
+
+TEST_F(CompiledExpressionTests, PredicateTest) {
+  auto tile_group = TestingExecutorUtil::CreateTileGroup(tuple_count);
+  TestingExecutorUtil::PopulateTiles(tile_group, tuple_count);
+
+  // a >= 50 AND NOT (b = 71) OR c < 20.0
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ConjunctionFactory(
+          ExpressionType::CONJUNCTION_OR,
+          expression::ExpressionUtil::ConjunctionFactory(
+              ExpressionType::CONJUNCTION_AND,
+              expression::ExpressionUtil::ComparisonFactory(
+                  ExpressionType::COMPARE_GREATERTHANOREQUALTO, Column(0),
+                  Integer(50)),
+              new expression::OperatorExpression(
+                  ExpressionType::OPERATOR_NOT, type::Type::BOOLEAN,
+                  expression::ExpressionUtil::ComparisonFactory(
+                      ExpressionType::COMPARE_EQUAL, Column(1), Integer(71)),
+                  nullptr)),
+          expression::ExpressionUtil::ComparisonFactory(
+              ExpressionType::COMPARE_LESSTHAN, Column(2),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  type::ValueFactory::GetDecimalValue(20.0)))));
+  CheckTileGroup(predicate.get(), tile_group.get());
+
+  // Read the same columns through a logical tile
+  auto schema = GetSchema();
+  auto compiled = executor::CompiledExpression::Compile(
+      predicate.get(), schema.get(), nullptr, nullptr);
+  ASSERT_NE(nullptr, compiled);
+  std::unique_ptr<executor::LogicalTile> logical_tile(
+      executor::LogicalTileFactory::WrapTileGroup(tile_group));
+  logical_tile->RemoveVisibility(3);
+  ASSERT_TRUE(compiled->Bind(0, logical_tile.get()));
+
+  size_t matched = 0;
+  for (oid_t tuple_id : *logical_tile) {
+    oid_t tuple_ids[2] = {tuple_id, INVALID_OID};
+    if (compiled->EvaluatePredicate(tuple_ids) == type::CMP_TRUE) matched++;
+  }
+  // Tuples 0, 1, 5, 6 and 8 onwards
+  EXPECT_EQ(tuple_count - 4, matched);
+}
+
+TEST_F(CompiledExpressionTests, UnsupportedTest) {
+  auto schema = GetSchema();
+
+  // Varchar columns are left to the interpreter
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_EQUAL, Column(3),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetVarcharValue("3"))));
+  EXPECT_EQ(nullptr, executor::CompiledExpression::Compile(
+                         predicate.get(), schema.get(), nullptr, nullptr));
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -17,10 +17,14 @@
 #include "common/logger.h"
 #include "common/statement.h"
 #include "executor/copy_executor.h"
+#include "executor/logical_tile.h"
 #include "executor/seq_scan_executor.h"
+#include "executor/testing_executor_util.h"
 #include "optimizer/simple_optimizer.h"
 #include "parser/parser.h"
+#include "planner/copy_plan.h"
 #include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
 #include "tcop/tcop.h"
 
 #include "gtest/gtest.h"
@@ -136,5 +140,173 @@ TEST_F(CopyTests, Copying) {
   txn_manager.CommitTransaction(txn);
 }
 
+// Load a table from a file in several chunks
+TEST_F(CopyTests, LoadingTest) {
+  const int tuple_count = 200000;
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(1000));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  std::string file_path = "./copy_input.csv";
+  FILE *file = fopen(file_path.c_str(), "w");
+  ASSERT_NE(nullptr, file);
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    if (tuple_itr % 1000 == 0) {
+      // Escaped delimiter and newline, Windows line ending
+      fprintf(file, "%d,%d,%d.5,a\\,b\\\nc\r\n", tuple_itr, tuple_itr * 10,
+              tuple_itr);
+    } else {
+      fprintf(file, "%d,%d,%d.5,row %d\n", tuple_itr, tuple_itr * 10,
+              tuple_itr, tuple_itr);
+    }
+  }
+  fclose(file);
+
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  planner::CopyPlan copy_plan(const_cast<char *>(file_path.c_str()),
+                              table.get(), ',');
+  executor::CopyExecutor copy_executor(&copy_plan, context.get());
+  EXPECT_TRUE(copy_executor.Init());
+  EXPECT_TRUE(copy_executor.Execute());
+  EXPECT_FALSE(copy_executor.Execute());
+  EXPECT_EQ(tuple_count, context->num_processed);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  EXPECT_EQ(tuple_count, table->GetTupleCount());
+
+  // Every row is visible once
+  txn = txn_manager.BeginTransaction();
+  context.reset(new executor::ExecutorContext(txn));
+  planner::SeqScanPlan scan_plan(table.get(), nullptr, {0, 1, 2, 3});
+  executor::SeqScanExecutor scan_executor(&scan_plan, context.get());
+  EXPECT_TRUE(scan_executor.Init());
+  int64_t key_sum = 0;
+  int row_count = 0;
+  while (scan_executor.Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> tile(scan_executor.GetOutput());
+    for (auto tuple_id : *tile) {
+      int key = tile->GetValue(tuple_id, 0).GetAs<int32_t>();
+      key_sum += key;
+      row_count++;
+      EXPECT_EQ(key * 10, tile->GetValue(tuple_id, 1).GetAs<int32_t>());
+      EXPECT_EQ(key + 0.5, tile->GetValue(tuple_id, 2).GetAs<double>());
+      if (key % 1000 == 0) {
+        EXPECT_EQ("a,b\nc", tile->GetValue(tuple_id, 3).ToString());
+      } else {
+        EXPECT_EQ("row " + std::to_string(key),
+                  tile->GetValue(tuple_id, 3).ToString());
+      }
+    }
+  }
+  EXPECT_EQ(tuple_count, row_count);
+  EXPECT_EQ(int64_t(tuple_count) * (tuple_count - 1) / 2, key_sum);
+  txn_manager.CommitTransaction(txn);
+
+  // Loading the file again violates the primary key
+  txn = txn_manager.BeginTransaction();
+  context.reset(new executor::ExecutorContext(txn));
+  executor::CopyExecutor failed_executor(&copy_plan, context.get());
+  EXPECT_TRUE(failed_executor.Init());
+  EXPECT_FALSE(failed_executor.Execute());
+  EXPECT_EQ(ResultType::FAILURE, txn->GetResult());
+  txn_manager.AbortTransaction(txn);
+
+  // None of the rows of the failed load is visible
+  txn = txn_manager.BeginTransaction();
+  context.reset(new executor::ExecutorContext(txn));
+  executor::SeqScanExecutor rescan_executor(&scan_plan, context.get());
+  EXPECT_TRUE(rescan_executor.Init());
+  row_count = 0;
+  while (rescan_executor.Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> tile(rescan_executor.GetOutput());
+    row_count += tile->GetTupleCount();
+  }
+  EXPECT_EQ(tuple_count, row_count);
+  txn_manager.CommitTransaction(txn);
+
+  remove(file_path.c_str());
+}
+
+// Load a file into the table, return the result of the transaction
+static ResultType LoadFile(storage::DataTable *table,
+                           const std::string &file_path,
+                           size_t load_thread_count) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  planner::CopyPlan copy_plan(const_cast<char *>(file_path.c_str()), table,
+                              ',');
+  executor::CopyExecutor copy_executor(&copy_plan, context.get());
+  copy_executor.SetLoadThreadCount(load_thread_count);
+  EXPECT_TRUE(copy_executor.Init());
+  copy_executor.Execute();
+
+  ResultType result = txn->GetResult();
+  if (result == ResultType::SUCCESS) {
+    return txn_manager.CommitTransaction(txn);
+  }
+  txn_manager.AbortTransaction(txn);
+  return result;
+}
+
+// Count the rows of the table a transaction sees
+static int CountRows(storage::DataTable *table) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  planner::SeqScanPlan scan_plan(table, nullptr, {0});
+  executor::SeqScanExecutor scan_executor(&scan_plan, context.get());
+  EXPECT_TRUE(scan_executor.Init());
+  int row_count = 0;
+  while (scan_executor.Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> tile(scan_executor.GetOutput());
+    row_count += tile->GetTupleCount();
+  }
+  txn_manager.CommitTransaction(txn);
+  return row_count;
+}
+
+TEST_F(CopyTests, DuplicateKeyTest) {
+  const int tuple_count = 100000;
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(1000));
+  std::string file_path = "./copy_duplicate_input.csv";
+
+  // A key repeated within the single chunk of a small file
+  FILE *file = fopen(file_path.c_str(), "w");
+  ASSERT_NE(nullptr, file);
+  fprintf(file, "1,10,1.5,a\n2,20,2.5,b\n1,30,3.5,c\n");
+  fclose(file);
+  EXPECT_EQ(ResultType::FAILURE, LoadFile(table.get(), file_path, 1));
+
+  // The last row repeats the key of the first one, in another chunk
+  file = fopen(file_path.c_str(), "w");
+  ASSERT_NE(nullptr, file);
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    int key = (tuple_itr == tuple_count - 1) ? 0 : tuple_itr;
+    fprintf(file, "%d,%d,%d.5,row %d\n", key, key * 10, key, key);
+  }
+  fclose(file);
+  EXPECT_LT(COPY_LOAD_CHUNK_SIZE, tuple_count * 20);
+  EXPECT_EQ(ResultType::FAILURE, LoadFile(table.get(), file_path, 2));
+  EXPECT_EQ(0, CountRows(table.get()));
+
+  // The failed loads left none of their keys behind
+  file = fopen(file_path.c_str(), "w");
+  ASSERT_NE(nullptr, file);
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    fprintf(file, "%d,%d,%d.5,row %d\n", tuple_itr, tuple_itr * 10,
+            tuple_itr, tuple_itr);
+  }
+  fclose(file);
+  EXPECT_EQ(ResultType::SUCCESS, LoadFile(table.get(), file_path, 2));
+  EXPECT_EQ(tuple_count, CountRows(table.get()));
+
+  remove(file_path.c_str());
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -173,5 +173,69 @@ TEST_F(IndexScanTests, MultiColumnPredicateTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+// Large range scan returned one batch of index entries at a time
+TEST_F(IndexScanTests, BatchedRangeScanTest) {
+  // All the rows are in the same tile group, so that every tile comes from
+  // a separate batch
+  const int num_rows = 5000;
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(num_rows));
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(data_table.get(), num_rows, false, false,
+                                     false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Column ids to be added to logical tile after scan.
+  std::vector<oid_t> column_ids({0, 1, 3});
+
+  //===--------------------------------------------------------------------===//
+  // ATTR 0 > 100 & ATTR 0 < 40000
+  //===--------------------------------------------------------------------===//
+
+  auto index = data_table->GetIndex(0);
+  std::vector<oid_t> key_column_ids({0, 0});
+  std::vector<ExpressionType> expr_types(
+      {ExpressionType::COMPARE_GREATERTHAN, ExpressionType::COMPARE_LESSTHAN});
+  std::vector<type::Value> values;
+  std::vector<expression::AbstractExpression *> runtime_keys;
+
+  values.push_back(type::ValueFactory::GetIntegerValue(100).Copy());
+  values.push_back(type::ValueFactory::GetIntegerValue(40000).Copy());
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, key_column_ids, expr_types, values, runtime_keys);
+
+  expression::AbstractExpression *predicate = nullptr;
+
+  planner::IndexScanPlan node(data_table.get(), predicate, column_ids,
+                              index_scan_desc);
+
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::IndexScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  // The boundaries are left out of the first and the last batch
+  size_t tile_count = 0;
+  size_t tuple_count = 0;
+  while (executor.Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    EXPECT_LE(result_tile->GetTupleCount(), INDEX_SCAN_BATCH_SIZE);
+    if (tile_count == 0) {
+      EXPECT_EQ(110, result_tile->GetValue(0, 0).GetAs<int32_t>());
+    }
+    tile_count++;
+    tuple_count += result_tile->GetTupleCount();
+  }
+
+  EXPECT_EQ(4, tile_count);
+  EXPECT_EQ(3989, tuple_count);
+
+  txn_manager.CommitTransaction(txn);
+}
+
 }  // namespace test
 }  // namespace peloton
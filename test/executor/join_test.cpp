@@ -23,6 +23,7 @@
 #include "executor/hash_executor.h"
 #include "executor/hash_join_executor.h"
 #include "executor/index_scan_executor.h"
+#include "executor/join_hash_table.h"
 #include "executor/merge_join_executor.h"
 #include "executor/nested_loop_join_executor.h"
 
@@ -219,6 +220,69 @@ TEST_F(JoinTests, BasicNestedLoopTest) {
   ExecuteNestedLoopJoinTest(JoinType::INNER);
 }
 
+TEST_F(JoinTests, PartitionedHashTableTest) {
+  // Every key shows up once in every tile, and there are enough tuples to
+  // split the table into several partitions
+  const int tile_count = 30;
+  const int tuple_count = 1000;
+  std::vector<std::unique_ptr<executor::LogicalTile>> tiles;
+  for (int tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    auto tile_group = TestingExecutorUtil::CreateTileGroup(tuple_count);
+    TestingExecutorUtil::PopulateTiles(tile_group, tuple_count);
+    tiles.emplace_back(executor::LogicalTileFactory::WrapTileGroup(tile_group));
+  }
+
+  std::vector<oid_t> key_column_ids = {0};
+  executor::JoinHashTable hash_table;
+  std::vector<executor::JoinHashTable::Entry> duplicates;
+  hash_table.Build(tiles, key_column_ids, duplicates);
+
+  EXPECT_GT(hash_table.GetPartitionCount(), 1UL);
+  EXPECT_EQ((size_t)(tile_count - 1) * tuple_count, duplicates.size());
+  for (auto &duplicate : duplicates) {
+    EXPECT_NE(0U, duplicate.tile_idx);
+  }
+
+  // Probing with the first tile finds the tuple of its key in every tile
+  std::vector<std::unique_ptr<executor::LogicalTile>> probe_tiles;
+  probe_tiles.push_back(std::move(tiles[0]));
+  executor::JoinHashTable::PartitionedEntries partitions;
+  hash_table.Partition(probe_tiles, key_column_ids, true, partitions);
+  tiles[0] = std::move(probe_tiles[0]);
+
+  EXPECT_EQ(hash_table.GetPartitionCount(), partitions.size());
+  size_t probe_count = 0;
+  for (size_t partition_idx = 0; partition_idx < partitions.size();
+       partition_idx++) {
+    for (auto &probe : partitions[partition_idx]) {
+      size_t match_count = 0;
+      hash_table.FindMatches(
+          partition_idx, probe.hash,
+          [&](const executor::JoinHashTable::Entry &entry) {
+            EXPECT_EQ(probe.tuple_id, entry.tuple_id);
+            match_count++;
+          });
+      EXPECT_EQ((size_t)tile_count, match_count);
+      probe_count++;
+    }
+  }
+  EXPECT_EQ((size_t)tuple_count, probe_count);
+
+  // Keys that are not in the table mostly fail the bloom filter
+  auto &bloom_filter = hash_table.GetBloomFilter();
+  size_t false_positive_count = 0;
+  for (int key = 0; key < tuple_count; key++) {
+    size_t key_hash = 0;
+    type::ValueFactory::GetIntegerValue(
+        TestingExecutorUtil::PopulatedValue(key, 0) + 1).HashCombine(key_hash);
+    if (bloom_filter.MayContain(
+            executor::JoinHashTable::MixHash(key_hash)) == true) {
+      false_positive_count++;
+    }
+  }
+  EXPECT_LT(false_positive_count, (size_t)tuple_count / 10);
+}
+
 void PopulateTable(storage::DataTable *table, int num_rows, bool random,
                    concurrency::Transaction *current_txn) {
   // Random values
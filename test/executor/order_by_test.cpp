@@ -62,9 +62,26 @@ void RunTest(executor::OrderByExecutor &executor, size_t expected_num_tuples,
   EXPECT_GT(sort_keys.size(), 0);
   EXPECT_GT(descend_flags.size(), 0);
 
-  // TODO: Verify
-  for (UNUSED_ATTRIBUTE auto &tile : result_tiles) {
+  // Every tuple must not sort before the one preceding it
+  std::vector<type::Value> prev_keys;
+  for (auto &tile : result_tiles) {
     LOG_TRACE("%s", tile->GetInfo().c_str());
+    for (oid_t tuple_id : *tile) {
+      std::vector<type::Value> keys;
+      for (auto key : sort_keys) {
+        keys.push_back(tile->GetValue(tuple_id, key));
+      }
+      for (size_t i = 0; i < prev_keys.size(); i++) {
+        if (prev_keys[i].CompareEquals(keys[i]) == type::CMP_TRUE) continue;
+        if (descend_flags[i] == true) {
+          EXPECT_TRUE(keys[i].CompareLessThan(prev_keys[i]) == type::CMP_TRUE);
+        } else {
+          EXPECT_TRUE(prev_keys[i].CompareLessThan(keys[i]) == type::CMP_TRUE);
+        }
+        break;
+      }
+      prev_keys = std::move(keys);
+    }
   }
 }
 
@@ -300,6 +317,131 @@ TEST_F(OrderByTests, StringDescIntAscTest) {
 
   RunTest(executor, tile_size * 2, sort_keys, descend_flags);
 }
+
+TEST_F(OrderByTests, LimitTest) {
+  // Create the plan node
+  std::vector<oid_t> sort_keys({1, 3});
+  std::vector<bool> descend_flags({true, false});
+  std::vector<oid_t> output_columns({0, 1, 2, 3});
+  planner::OrderByPlan node(sort_keys, descend_flags, output_columns);
+  node.SetLimit(true);
+  node.SetLimitNumber(7);
+  node.SetLimitOffset(3);
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(nullptr));
+
+  // Create and set up executor
+  executor::OrderByExecutor executor(&node, context.get());
+  MockExecutor child_executor;
+  executor.AddChild(&child_executor);
+
+  EXPECT_CALL(child_executor, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  // Create a table and wrap it in logical tile
+  size_t tile_size = 20;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tile_size));
+  bool random = true;
+  TestingExecutorUtil::PopulateTable(data_table.get(), tile_size * 2, false,
+                                   random, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // The largest value of the first sort key
+  type::Value max_value = data_table->GetTileGroup(0)->GetValue(0, 1);
+  for (oid_t tile_group_id = 0; tile_group_id < 2; tile_group_id++) {
+    auto tile_group = data_table->GetTileGroup(tile_group_id);
+    for (oid_t tuple_id = 0; tuple_id < tile_size; tuple_id++) {
+      auto value = tile_group->GetValue(tuple_id, 1);
+      if (max_value.CompareLessThan(value) == type::CMP_TRUE) {
+        max_value = value;
+      }
+    }
+  }
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile1(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(0)));
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile2(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(1)));
+
+  EXPECT_CALL(child_executor, GetOutput())
+      .WillOnce(Return(source_logical_tile1.release()))
+      .WillOnce(Return(source_logical_tile2.release()));
+
+  // The executor keeps the offset, it is skipped by the limit above it
+  EXPECT_TRUE(executor.Init());
+  std::vector<std::unique_ptr<executor::LogicalTile>> result_tiles;
+  while (executor.Execute()) {
+    result_tiles.emplace_back(executor.GetOutput());
+  }
+  ASSERT_EQ(1, result_tiles.size());
+  EXPECT_EQ(10, result_tiles[0]->GetTupleCount());
+  EXPECT_TRUE(result_tiles[0]->GetValue(0, 1).CompareEquals(max_value) ==
+              type::CMP_TRUE);
+}
+
+TEST_F(OrderByTests, SpillTest) {
+  // Create the plan node
+  std::vector<oid_t> sort_keys({3, 1});
+  std::vector<bool> descend_flags({false, true});
+  std::vector<oid_t> output_columns({0, 1, 2, 3});
+  planner::OrderByPlan node(sort_keys, descend_flags, output_columns);
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(nullptr));
+
+  // Create and set up executor
+  executor::OrderByExecutor executor(&node, context.get());
+  MockExecutor child_executor;
+  executor.AddChild(&child_executor);
+
+  EXPECT_CALL(child_executor, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  // Create a table and wrap it in logical tile
+  size_t tile_size = 20;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tile_size));
+  bool random = true;
+  TestingExecutorUtil::PopulateTable(data_table.get(), tile_size * 3, false,
+                                   random, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile1(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(0)));
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile2(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(1)));
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile3(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(2)));
+
+  EXPECT_CALL(child_executor, GetOutput())
+      .WillOnce(Return(source_logical_tile1.release()))
+      .WillOnce(Return(source_logical_tile2.release()))
+      .WillOnce(Return(source_logical_tile3.release()));
+
+  // Every input tile goes to a run of its own
+  size_t memory_budget = executor::OrderByExecutor::GetMemoryBudget();
+  executor::OrderByExecutor::SetMemoryBudget(1);
+  RunTest(executor, tile_size * 3, sort_keys, descend_flags);
+  executor::OrderByExecutor::SetMemoryBudget(memory_budget);
+}
 }
 
 }  // namespace test
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <string>
@@ -19,6 +20,9 @@
 #include "common/harness.h"
 
 #include "catalog/schema.h"
+#include "common/init.h"
+#include "common/thread_pool.h"
+#include "configuration/configuration.h"
 #include "type/types.h"
 #include "type/value.h"
 #include "type/value_factory.h"
@@ -28,6 +32,7 @@
 #include "executor/executor_context.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
+#include "executor/plan_executor.h"
 #include "executor/seq_scan_executor.h"
 #include "expression/abstract_expression.h"
 #include "expression/expression_util.h"
@@ -173,6 +178,62 @@ expression::AbstractExpression *CreatePredicate(
   return predicate;
 }
 
+/**
+ * @brief Convenience method to create a predicate that is mostly evaluated
+ *        on tile columns.
+ *
+ * The predicate matches the tuples in g_tuple_ids:
+ *   COL_A <= 30 AND 40 > COL_C AND
+ *   (COL_B = 1 OR COL_B = 21 OR COL_B = 31) AND COL_D != '23'
+ *
+ * All but the last conjunct compare a fixed-width column with a constant,
+ * and the VARCHAR comparison is left for per-tuple evaluation.
+ */
+expression::AbstractExpression *CreateVectorizablePredicate() {
+  auto compare_column = [](ExpressionType type, oid_t column_id,
+                           type::Type::TypeId column_type,
+                           const type::Value &value) {
+    return expression::ExpressionUtil::ComparisonFactory(
+        type,
+        expression::ExpressionUtil::TupleValueFactory(column_type, 0,
+                                                      column_id),
+        expression::ExpressionUtil::ConstantValueFactory(value));
+  };
+
+  expression::AbstractExpression *predicate = compare_column(
+      ExpressionType::COMPARE_LESSTHANOREQUALTO, 0, type::Type::INTEGER,
+      type::ValueFactory::GetIntegerValue(30));
+
+  // Constant on the left hand side, compared with a DECIMAL column.
+  predicate = expression::ExpressionUtil::ConjunctionFactory(
+      ExpressionType::CONJUNCTION_AND, predicate,
+      expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_GREATERTHAN,
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetIntegerValue(40)),
+          expression::ExpressionUtil::TupleValueFactory(type::Type::DECIMAL,
+                                                        0, 2)));
+
+  expression::AbstractExpression *disjunction = nullptr;
+  for (int value : {1, 21, 31}) {
+    auto equality_expr =
+        compare_column(ExpressionType::COMPARE_EQUAL, 1, type::Type::INTEGER,
+                       type::ValueFactory::GetIntegerValue(value));
+    disjunction = (disjunction == nullptr)
+                      ? equality_expr
+                      : expression::ExpressionUtil::ConjunctionFactory(
+                            ExpressionType::CONJUNCTION_OR, disjunction,
+                            equality_expr);
+  }
+  predicate = expression::ExpressionUtil::ConjunctionFactory(
+      ExpressionType::CONJUNCTION_AND, predicate, disjunction);
+
+  return expression::ExpressionUtil::ConjunctionFactory(
+      ExpressionType::CONJUNCTION_AND, predicate,
+      compare_column(ExpressionType::COMPARE_NOTEQUAL, 3, type::Type::VARCHAR,
+                     type::ValueFactory::GetVarcharValue("23")));
+}
+
 /**
  * @brief Convenience method to extract next tile from executor.
  * @param executor Executor to be tested.
@@ -269,6 +330,136 @@ TEST_F(SeqScanTests, TwoTileGroupsWithPredicateTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+// Sequential scan of table with a predicate that is evaluated on tile
+// columns, with a residual part that is evaluated per tuple.
+TEST_F(SeqScanTests, VectorizedPredicateTest) {
+  std::unique_ptr<storage::DataTable> table(CreateTable());
+
+  std::vector<oid_t> column_ids({0, 1, 3});
+
+  planner::SeqScanPlan node(table.get(), CreateVectorizablePredicate(),
+                            column_ids);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::SeqScanExecutor executor(&node, context.get());
+  RunTest(executor, table->GetTileGroupCount(), column_ids.size());
+
+  txn_manager.CommitTransaction(txn);
+}
+
+// Result tiles handed to a callback carry the same rows as the collected
+// result of the plan.
+TEST_F(SeqScanTests, StreamResultTilesTest) {
+  std::unique_ptr<storage::DataTable> table(CreateTable());
+
+  std::vector<oid_t> column_ids({0, 1, 3});
+  planner::SeqScanPlan node(table.get(), CreatePredicate(g_tuple_ids),
+                            column_ids);
+  std::vector<type::Value> params;
+  std::vector<int> result_format(column_ids.size(), 0);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  std::vector<StatementResult> result;
+  auto status =
+      bridge::PlanExecutor::ExecutePlan(&node, txn, params, result,
+                                        result_format);
+  EXPECT_EQ(ResultType::SUCCESS, status.m_result);
+
+  size_t tile_count = 0;
+  std::vector<StatementResult> streamed_result;
+  status = bridge::PlanExecutor::ExecutePlan(
+      &node, txn, params, [&](executor::LogicalTile *tile) {
+        tile_count++;
+        EXPECT_EQ(column_ids.size(), tile->GetColumnCount());
+        bridge::PlanExecutor::AddResultTile(tile, result_format,
+                                            streamed_result);
+      });
+  EXPECT_EQ(ResultType::SUCCESS, status.m_result);
+
+  txn_manager.CommitTransaction(txn);
+
+  EXPECT_EQ(table->GetTileGroupCount(), tile_count);
+  EXPECT_EQ(g_tuple_ids.size() * tile_count * column_ids.size(),
+            result.size());
+  ASSERT_EQ(result.size(), streamed_result.size());
+  for (size_t i = 0; i < result.size(); i++) {
+    EXPECT_EQ(result[i].second, streamed_result[i].second);
+  }
+}
+
+// Sequential scan of a table with many tile groups on several threads.
+// Tiles come out in table order, and the same as with a single thread.
+TEST_F(SeqScanTests, ParallelScanTest) {
+  const int tile_group_count = 40;
+  std::unique_ptr<storage::DataTable> table(
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(
+      table.get(), TESTS_TUPLES_PER_TILEGROUP * tile_group_count, false,
+      false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Drop the first tuple of every tile group
+  auto scan = [&table, &txn_manager]() {
+    expression::AbstractExpression *predicate = nullptr;
+    for (int tile_group_itr = 0; tile_group_itr < tile_group_count;
+         tile_group_itr++) {
+      auto not_equal = expression::ExpressionUtil::ComparisonFactory(
+          ExpressionType::COMPARE_NOTEQUAL,
+          expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER,
+                                                        0, 0),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetIntegerValue(
+                  TestingExecutorUtil::PopulatedValue(
+                      tile_group_itr * TESTS_TUPLES_PER_TILEGROUP, 0))));
+      predicate = (predicate == nullptr)
+                      ? not_equal
+                      : expression::ExpressionUtil::ConjunctionFactory(
+                            ExpressionType::CONJUNCTION_AND, predicate,
+                            not_equal);
+    }
+    planner::SeqScanPlan node(table.get(), predicate,
+                              std::vector<oid_t>({0, 1}));
+
+    auto txn = txn_manager.BeginTransaction();
+    std::unique_ptr<executor::ExecutorContext> context(
+        new executor::ExecutorContext(txn));
+    executor::SeqScanExecutor executor(&node, context.get());
+
+    std::vector<int> values;
+    EXPECT_TRUE(executor.Init());
+    while (executor.Execute()) {
+      std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+      for (oid_t tuple_id : *result_tile) {
+        values.push_back(result_tile->GetValue(tuple_id, 0).GetAs<int32_t>());
+      }
+    }
+    txn_manager.CommitTransaction(txn);
+    return values;
+  };
+
+  auto serial_values = scan();
+
+  thread_pool.Initialize(3, 0);
+  FLAGS_parallel_scan_degree = 4;
+  auto parallel_values = scan();
+  FLAGS_parallel_scan_degree = 1;
+  thread_pool.Shutdown();
+
+  EXPECT_EQ((TESTS_TUPLES_PER_TILEGROUP - 1) * tile_group_count,
+            (int)parallel_values.size());
+  EXPECT_EQ(serial_values, parallel_values);
+  EXPECT_TRUE(std::is_sorted(parallel_values.begin(), parallel_values.end()));
+}
+
 // Sequential scan of logical tile with predicate.
 TEST_F(SeqScanTests, NonLeafNodePredicateTest) {
   // No table for this case as seq scan is not a leaf node.
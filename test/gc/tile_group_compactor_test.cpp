@@ -0,0 +1,242 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor_test.cpp
+//
+// Identification: test/gc/tile_group_compactor_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/testing_transaction_util.h"
+#include "executor/testing_executor_util.h"
+#include "common/harness.h"
+#include "gc/gc_manager_factory.h"
+#include "gc/tile_group_compactor.h"
+#include "concurrency/epoch_manager.h"
+
+#include "catalog/catalog.h"
+#include "catalog/manager.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Compactor Tests
+//===--------------------------------------------------------------------===//
+
+class TileGroupCompactorTests : public PelotonTest {};
+
+// count the tile groups of a table that have been released
+static size_t ReleasedNum(storage::DataTable *table) {
+  size_t released_count = 0;
+  for (oid_t offset = 0; offset < table->GetTileGroupCount(); offset++) {
+    auto tile_group = table->GetTileGroup(offset);
+    if (tile_group->GetHeader()->GetCompactingCid() == INVALID_CID) {
+      EXPECT_EQ(1, tile_group->GetAllocatedTupleCount());
+      released_count++;
+    }
+  }
+  return released_count;
+}
+
+TEST_F(TileGroupCompactorTests, CompactionTest) {
+  std::vector<std::unique_ptr<std::thread>> gc_threads;
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+  auto &compactor = gc::TileGroupCompactor::GetInstance();
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(0);
+
+  auto catalog = catalog::Catalog::GetInstance();
+  // create database
+  auto database = TestingExecutorUtil::InitializeDatabase(DEFAULT_DB_NAME);
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(catalog->HasDatabase(db_id));
+
+  // create a table with 100 tuples per tile group and fill 10 of them
+  const int num_key = 1000;
+  std::unique_ptr<storage::DataTable> table(TestingTransactionUtil::CreateTable(
+      0, "TEST_TABLE", db_id, INVALID_OID, 1234, true));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  for (int key = 0; key < num_key; key++) {
+    EXPECT_TRUE(TestingTransactionUtil::ExecuteInsert(txn, table.get(), key,
+                                                      key * 2));
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  // the last one is empty
+  EXPECT_EQ(11, table->GetTileGroupCount());
+  std::vector<std::weak_ptr<storage::TileGroup>> full_tile_groups;
+  for (oid_t offset = 0; offset < 10; offset++) {
+    full_tile_groups.push_back(table->GetTileGroup(offset));
+  }
+
+  gc_manager.StartGC(gc_threads);
+
+  // delete 9 out of 10 tuples. the empty versions of the deletes fill 9
+  // more tile groups.
+  txn = txn_manager.BeginTransaction();
+  for (int key = 0; key < num_key; key++) {
+    if (key % 10 != 0) {
+      EXPECT_TRUE(TestingTransactionUtil::ExecuteDelete(txn, table.get(), key));
+    }
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  EXPECT_EQ(20, table->GetTileGroupCount());
+
+  // every pass has to wait for the transactions running before it
+  size_t released_count = 0;
+  for (size_t epoch = 1; epoch < 100 && released_count < 19; epoch++) {
+    epoch_manager.Reset(epoch);
+    txn = txn_manager.BeginTransaction();
+    int result;
+    TestingTransactionUtil::ExecuteRead(txn, table.get(), 0, result);
+    txn_manager.CommitTransaction(txn);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    compactor.CompactTable(table.get());
+    released_count = ReleasedNum(table.get());
+  }
+
+  // the live tuples have filled the empty tile group
+  EXPECT_EQ(19, released_count);
+  EXPECT_EQ(21, table->GetTileGroupCount());
+  for (auto &tile_group : full_tile_groups) {
+    EXPECT_TRUE(tile_group.expired());
+  }
+
+  // and are still found through the index
+  txn = txn_manager.BeginTransaction();
+  for (int key = 0; key < num_key; key++) {
+    int result;
+    bool found =
+        TestingTransactionUtil::ExecuteRead(txn, table.get(), key, result);
+    EXPECT_EQ(key % 10 == 0, found);
+    EXPECT_EQ(key % 10 == 0 ? key * 2 : -1, result);
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  // the new tile group is not compacted
+  compactor.CompactTable(table.get());
+  EXPECT_EQ(19, ReleasedNum(table.get()));
+  EXPECT_FALSE(table->GetTileGroup(19)->GetHeader()->IsCompacting());
+
+  gc_manager.StopGC();
+
+  table.release();
+
+  // DROP!
+  TestingExecutorUtil::DeleteDatabase(DEFAULT_DB_NAME);
+  EXPECT_FALSE(catalog->HasDatabase(db_id));
+
+  gc::GCManagerFactory::Configure(0);
+
+  for (auto &gc_thread : gc_threads) {
+    gc_thread->join();
+  }
+}
+
+// The GC hands a tile group to the compactor once enough of its slots are
+// free
+TEST_F(TileGroupCompactorTests, CandidateTest) {
+  std::vector<std::unique_ptr<std::thread>> gc_threads;
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+  auto &compactor = gc::TileGroupCompactor::GetInstance();
+
+  // epochs move on from the previous test
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  size_t epoch = epoch_manager.GetCurrentEpoch() + 1;
+
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database = TestingExecutorUtil::InitializeDatabase(DEFAULT_DB_NAME);
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(catalog->HasDatabase(db_id));
+
+  // fill 10 tile groups of 100 tuples
+  const int num_key = 1000;
+  std::unique_ptr<storage::DataTable> table(TestingTransactionUtil::CreateTable(
+      0, "TEST_TABLE", db_id, INVALID_OID, 1234, true));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  for (int key = 0; key < num_key; key++) {
+    EXPECT_TRUE(TestingTransactionUtil::ExecuteInsert(txn, table.get(), key,
+                                                      key * 2));
+  }
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  gc_manager.StartGC(gc_threads);
+
+  auto delete_keys = [&](int begin_key, int end_key) {
+    txn = txn_manager.BeginTransaction();
+    for (int key = begin_key; key < end_key; key++) {
+      EXPECT_TRUE(TestingTransactionUtil::ExecuteDelete(txn, table.get(), key));
+    }
+    EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+  };
+
+  // every pass has to wait for the transactions running before it
+  auto compact = [&]() {
+    epoch_manager.Reset(epoch++);
+    txn = txn_manager.BeginTransaction();
+    int result;
+    TestingTransactionUtil::ExecuteRead(txn, table.get(), num_key - 1, result);
+    txn_manager.CommitTransaction(txn);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    return compactor.CompactTable(table.get());
+  };
+
+  // half of the slots of the first tile group are free, which is not enough
+  delete_keys(0, 50);
+  size_t released_count = 0;
+  for (size_t pass = 0; pass < 20; pass++) {
+    released_count += compact();
+  }
+  EXPECT_EQ(0, released_count);
+  auto tile_group_header = table->GetTileGroup(0)->GetHeader();
+  EXPECT_EQ(0, tile_group_header->GetPendingGarbageCount());
+  EXPECT_EQ(50, tile_group_header->GetFreeSlotCount());
+  EXPECT_FALSE(tile_group_header->IsCompacting());
+
+  // 80 out of 100 of the second one are. The empty versions of the deletes
+  // reuse the free slots of the first one.
+  delete_keys(100, 180);
+  for (size_t pass = 0; pass < 100 && released_count == 0; pass++) {
+    released_count += compact();
+  }
+  EXPECT_EQ(1, released_count);
+  EXPECT_EQ(INVALID_CID,
+            table->GetTileGroup(1)->GetHeader()->GetCompactingCid());
+  EXPECT_EQ(1, ReleasedNum(table.get()));
+  EXPECT_FALSE(table->GetTileGroup(0)->GetHeader()->IsCompacting());
+
+  gc_manager.StopGC();
+
+  table.release();
+
+  TestingExecutorUtil::DeleteDatabase(DEFAULT_DB_NAME);
+  EXPECT_FALSE(catalog->HasDatabase(db_id));
+
+  gc::GCManagerFactory::Configure(0);
+
+  for (auto &gc_thread : gc_threads) {
+    gc_thread->join();
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,68 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index_test.cpp
+//
+// Identification: test/index/hash_index_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "gtest/gtest.h"
+
+#include "index/testing_index_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Hash Index Tests
+//===--------------------------------------------------------------------===//
+
+class HashIndexTests : public PelotonTest {};
+
+TEST_F(HashIndexTests, BasicTest) {
+  TestingIndexUtil::BasicTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, MultiMapInsertTest) {
+  TestingIndexUtil::MultiMapInsertTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, UniqueKeyInsertTest) {
+  TestingIndexUtil::UniqueKeyInsertTest(IndexType::HASH);
+}
+
+//TEST_F(HashIndexTests, UniqueKeyDeleteTest) {
+//  TestingIndexUtil::UniqueKeyDeleteTest(IndexType::HASH);
+//}
+
+TEST_F(HashIndexTests, NonUniqueKeyDeleteTest) {
+  TestingIndexUtil::NonUniqueKeyDeleteTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, MultiThreadedInsertTest) {
+  TestingIndexUtil::MultiThreadedInsertTest(IndexType::HASH);
+}
+
+//TEST_F(HashIndexTests, UniqueKeyMultiThreadedTest) {
+//  TestingIndexUtil::UniqueKeyMultiThreadedTest(IndexType::HASH);
+//}
+
+TEST_F(HashIndexTests, NonUniqueKeyMultiThreadedTest) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, NonUniqueKeyMultiThreadedStressTest) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest(IndexType::HASH);
+}
+
+TEST_F(HashIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::HASH);
+}
+
+}  // End test namespace
+}  // End peloton namespace
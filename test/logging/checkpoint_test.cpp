@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <dirent.h>
 #include <numeric>
 
 #include "common/harness.h"
@@ -22,6 +23,7 @@
 #include "logging/checkpoint/simple_checkpoint.h"
 #include "logging/checkpoint_manager.h"
 #include "storage/database.h"
+#include "storage/tile_group_header.h"
 
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/logical_tile_factory.h"
@@ -116,6 +118,90 @@ TEST_F(CheckpointTests, CheckpointIntegrationTest) {
   logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
 }
 
+TEST_F(CheckpointTests, CheckpointPartsTest) {
+  logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  // table has enough tile groups for several checkpoint files
+  size_t tile_group_size = 5;
+  size_t table_tile_group_count = 2 * CHECKPOINT_TILE_GROUPS_PER_FILE + 1;
+  size_t tuple_count = tile_group_size * table_tile_group_count;
+  storage::DataTable *target_table =
+      TestingExecutorUtil::CreateTable(tile_group_size, false, 14);
+  TestingExecutorUtil::PopulateTable(target_table, tuple_count, false, false,
+                                     false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto catalog = catalog::Catalog::GetInstance();
+  storage::Database *db(new storage::Database(DEFAULT_DB_ID));
+  db->AddTable(target_table);
+  catalog->AddDatabase(db);
+
+  // create checkpoint
+  auto &checkpoint_manager = logging::CheckpointManager::GetInstance();
+  auto &log_manager = logging::LogManager::GetInstance();
+  log_manager.SetGlobalMaxFlushedCommitId(txn_manager.GetNextCommitId());
+  checkpoint_manager.Configure(CheckpointType::NORMAL, false, 1);
+  checkpoint_manager.DestroyCheckpointers();
+  checkpoint_manager.InitCheckpointers();
+  checkpoint_manager.GetCheckpointer(0)->DoCheckpoint();
+
+  // one file per part, and the manifest
+  size_t part_count =
+      (target_table->GetTileGroupCount() + CHECKPOINT_TILE_GROUPS_PER_FILE -
+       1) / CHECKPOINT_TILE_GROUPS_PER_FILE;
+  EXPECT_GE(part_count, 3);
+  size_t file_count = 0;
+  auto dirp = opendir("pl_checkpoint");
+  ASSERT_NE(nullptr, dirp);
+  while (auto file = readdir(dirp)) {
+    if (strncmp(file->d_name, "peloton_checkpoint_0", 20) == 0) file_count++;
+  }
+  closedir(dirp);
+  EXPECT_EQ(part_count + 1, file_count);
+
+  // A checkpoint without a manifest is ignored
+  FILE *partial_file = fopen("pl_checkpoint/peloton_checkpoint_9_0.log", "wb");
+  ASSERT_NE(nullptr, partial_file);
+  fclose(partial_file);
+
+  // restart with an empty table
+  catalog->DropDatabaseWithOid(db->GetOid());
+  target_table = TestingExecutorUtil::CreateTable(tile_group_size, false, 14);
+  db = new storage::Database(DEFAULT_DB_ID);
+  db->AddTable(target_table);
+  catalog->AddDatabase(db);
+  checkpoint_manager.DestroyCheckpointers();
+  checkpoint_manager.InitCheckpointers();
+
+  // recovery from checkpoint
+  auto recovery_checkpointer = checkpoint_manager.GetCheckpointer(0);
+  recovery_checkpointer->DoRecovery();
+
+  EXPECT_EQ(tuple_count, target_table->GetTupleCount());
+  size_t recovered_count = 0;
+  for (oid_t tile_group_offset = 0;
+       tile_group_offset < target_table->GetTileGroupCount();
+       tile_group_offset++) {
+    auto tile_group = target_table->GetTileGroup(tile_group_offset);
+    auto tile_group_header = tile_group->GetHeader();
+    for (oid_t tuple_id = 0; tuple_id < tile_group->GetAllocatedTupleCount();
+         tuple_id++) {
+      if (tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID)
+        continue;
+      recovered_count++;
+      auto key = tile_group->GetValue(tuple_id, 0).GetAs<int32_t>();
+      EXPECT_EQ(std::to_string(key + 3),
+                tile_group->GetValue(tuple_id, 3).ToString());
+    }
+  }
+  EXPECT_EQ(tuple_count, recovered_count);
+
+  catalog->DropDatabaseWithOid(db->GetOid());
+  logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
+}
+
 TEST_F(CheckpointTests, CheckpointScanTest) {
   logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
 
@@ -316,6 +316,45 @@ TEST_F(LoggingTests, InsertUpdateDeleteTest) {
   scheduler.Cleanup();
 }
 
+TEST_F(LoggingTests, GroupCommitTest) {
+  peloton_logging_mode = LoggingType::INVALID;
+  auto &log_manager = logging::LogManager::GetInstance();
+  log_manager.DropFrontendLoggers();
+  log_manager.ResetLogStatus();
+  peloton_logging_mode = LoggingType::NVM_WAL;
+
+  log_manager.SetSyncCommit(true);
+  log_manager.SetGroupCommit(true);
+  log_manager.SetGroupCommitLatencyBudget(100);
+  log_manager.SetGroupCommitMaxBatchSize(8);
+  log_manager.StartStandbyMode();
+  log_manager.GetFrontendLogger(0)->SetTestMode(true);
+  log_manager.StartRecoveryMode();
+  log_manager.WaitForModeTransition(LoggingStatusType::LOGGING, true);
+  log_manager.SetGlobalMaxFlushedCommitId(4);
+
+  // every sync commit returns once its batch is flushed, after which its
+  // durability future is ready right away. The backend logger is thread
+  // local, so log from a thread of its own
+  std::thread backend_thread([&log_manager] {
+    for (cid_t commit_id = 5; commit_id < 25; commit_id++) {
+      log_manager.PrepareLogging();
+      log_manager.LogBeginTransaction(commit_id);
+      log_manager.LogCommitTransaction(commit_id);
+      EXPECT_LE(commit_id, log_manager.GetPersistentFlushedCommitId());
+
+      auto future = log_manager.GetDurabilityFuture(commit_id);
+      EXPECT_EQ(std::future_status::ready,
+                future.wait_for(std::chrono::seconds(0)));
+    }
+  });
+  backend_thread.join();
+
+  log_manager.EndLogging();
+  log_manager.SetGroupCommit(false);
+  log_manager.ResetLogStatus();
+}
+
 TEST_F(LoggingTests, BasicLogManagerTest) {
   peloton_logging_mode = LoggingType::INVALID;
   auto &log_manager = logging::LogManager::GetInstance();
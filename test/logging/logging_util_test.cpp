@@ -11,8 +11,11 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <cstdio>
+
 #include "common/harness.h"
 
+#include "logging/log_file_reader.h"
 #include "logging/logging_util.h"
 
 namespace peloton {
@@ -31,5 +34,42 @@ TEST_F(LoggingUtilTests, BasicLoggingUtilTest) {
   EXPECT_EQ(status, true);
 }
 
+TEST_F(LoggingUtilTests, LogFileReaderTest) {
+  std::string file_name = "log_file_reader_test.log";
+  FILE *fp = fopen(file_name.c_str(), "wb");
+
+  logging::TransactionRecord record_begin(LOGRECORD_TYPE_TRANSACTION_BEGIN, 3);
+  CopySerializeOutput output_buffer_begin;
+  record_begin.Serialize(output_buffer_begin);
+  fwrite(record_begin.GetMessage(), sizeof(char),
+         record_begin.GetMessageLength(), fp);
+
+  // Only write half of the commit record to emulate a torn write
+  logging::TransactionRecord record_commit(LOGRECORD_TYPE_TRANSACTION_COMMIT,
+                                           3);
+  CopySerializeOutput output_buffer_commit;
+  record_commit.Serialize(output_buffer_commit);
+  fwrite(record_commit.GetMessage(), sizeof(char),
+         record_commit.GetMessageLength() / 2, fp);
+  fclose(fp);
+
+  logging::LogFileReader reader;
+  EXPECT_TRUE(reader.Open(file_name));
+  EXPECT_EQ(reader.GetSize(), record_begin.GetMessageLength() +
+                                  record_commit.GetMessageLength() / 2);
+
+  EXPECT_EQ(reader.ReadRecordType(), LOGRECORD_TYPE_TRANSACTION_BEGIN);
+  logging::TransactionRecord txn_record(LOGRECORD_TYPE_TRANSACTION_BEGIN);
+  EXPECT_TRUE(reader.ReadTransactionRecordHeader(txn_record));
+  EXPECT_EQ(txn_record.GetTransactionId(), 3);
+  EXPECT_EQ(reader.GetPosition(), record_begin.GetMessageLength());
+
+  EXPECT_EQ(reader.ReadRecordType(), LOGRECORD_TYPE_TRANSACTION_COMMIT);
+  EXPECT_FALSE(reader.ReadTransactionRecordHeader(txn_record));
+
+  reader.Close();
+  EXPECT_EQ(remove(file_name.c_str()), 0);
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -97,7 +97,8 @@ std::vector<storage::Tuple *> BuildLoggingTuples(storage::DataTable *table,
   return tuples;
 }
 
-TEST_F(RecoveryTests, RestartTest) {
+// Write a few log files, restart from them and check the recovered table
+static void RestartFromLogFiles() {
   auto catalog = catalog::Catalog::GetInstance();
   LOG_TRACE("Finish creating catalog");
   LOG_TRACE("Creating recovery_table");
@@ -276,6 +277,19 @@ TEST_F(RecoveryTests, RestartTest) {
   catalog->DropDatabaseWithOid(DEFAULT_DB_ID);
 }
 
+TEST_F(RecoveryTests, RestartTest) { RestartFromLogFiles(); }
+
+TEST_F(RecoveryTests, ParallelRestartTest) {
+  // Parse the log files and replay them with more threads than files
+  auto &log_manager = logging::LogManager::GetInstance();
+  auto recovery_thread_count = log_manager.GetRecoveryThreadCount();
+  log_manager.SetRecoveryThreadCount(4);
+
+  RestartFromLogFiles();
+
+  log_manager.SetRecoveryThreadCount(recovery_thread_count);
+}
+
 TEST_F(RecoveryTests, BasicInsertTest) {
   auto recovery_table = TestingExecutorUtil::CreateTable(1024);
   auto catalog = catalog::Catalog::GetInstance();
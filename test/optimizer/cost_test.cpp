@@ -0,0 +1,209 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// cost_test.cpp
+//
+// Identification: test/optimizer/cost_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/testing_executor_util.h"
+#include "expression/comparison_expression.h"
+#include "expression/conjunction_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/operator_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "optimizer/column_manager.h"
+#include "optimizer/cost.h"
+#include "optimizer/cost_and_stats_calculator.h"
+#include "optimizer/group_expression.h"
+#include "optimizer/operators.h"
+#include "optimizer/properties.h"
+#include "optimizer/stats.h"
+#include "optimizer/stats_storage.h"
+#include "storage/data_table.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Cost Tests
+//===--------------------------------------------------------------------===//
+
+class CostTests : public PelotonTest {};
+
+// column < value, on the given column of the test table
+static expression::AbstractExpression *MakeComparison(ExpressionType type,
+                                                      oid_t column_id,
+                                                      int value) {
+  return new expression::ComparisonExpression(
+      type, new expression::TupleValueExpression(type::Type::INTEGER, 0,
+                                                 column_id),
+      new expression::ConstantValueExpression(
+          type::ValueFactory::GetIntegerValue(value)));
+}
+
+// create and analyze a table where the first column holds two values and the
+// second one is unique, from 1 to 10 * (num_rows - 1) + 1
+static storage::DataTable *CreateAnalyzedTable(int num_rows,
+                                               oid_t table_oid) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto table = TestingExecutorUtil::CreateTable(100, false, table_oid);
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table, num_rows, false, false, true, txn);
+  txn_manager.CommitTransaction(txn);
+  optimizer::StatsStorage::GetInstance().AnalyzeTable(table, nullptr);
+  return table;
+}
+
+TEST_F(CostTests, CostFormulaTest) {
+  using optimizer::Cost;
+
+  // An index pays off for selective predicates only
+  EXPECT_LT(Cost::IndexScanCost(100000, 10, 0), Cost::SeqScanCost(100000, 1));
+  EXPECT_GT(Cost::IndexScanCost(100000, 90000, 0),
+            Cost::SeqScanCost(100000, 1));
+
+  // Hash joins win on large inputs, nested loops on tiny ones
+  EXPECT_LT(Cost::HashJoinCost(10000, 1000, 10000),
+            Cost::NLJoinCost(10000, 1000, 10000));
+  EXPECT_LT(Cost::NLJoinCost(1, 1, 1), Cost::HashJoinCost(1, 1, 1));
+
+  // Building the hash table is dearer than probing it
+  EXPECT_LT(Cost::HashJoinCost(10000, 100, 10000),
+            Cost::HashJoinCost(100, 10000, 10000));
+
+  // Sorting is superlinear
+  EXPECT_GT(Cost::SortCost(20000), 2 * Cost::SortCost(10000));
+  EXPECT_EQ(0, Cost::SortCost(0));
+
+  EXPECT_LT(Cost::AggregateCost(10000, 10, 1),
+            Cost::AggregateCost(10000, 5000, 1));
+  EXPECT_LT(Cost::AggregateCost(10000, 10, 1),
+            Cost::AggregateCost(10000, 10, 3));
+
+  EXPECT_EQ(10000, Cost::GetJoinRows(10000, 100));
+}
+
+TEST_F(CostTests, SelectivityTest) {
+  using optimizer::Cost;
+  const int num_rows = 2000;
+  const oid_t table_oid = 34567;
+  std::unique_ptr<storage::DataTable> table(
+      CreateAnalyzedTable(num_rows, table_oid));
+
+  optimizer::Stats stats(num_rows);
+  stats.AddTableStats(
+      optimizer::StatsStorage::GetInstance().GetTableStats(table_oid));
+
+  int middle = 10 * (num_rows / 2) + 1;
+  std::unique_ptr<expression::AbstractExpression> less_than(
+      MakeComparison(ExpressionType::COMPARE_LESSTHAN, 1, middle));
+  EXPECT_NEAR(0.5, Cost::GetSelectivity(stats, less_than.get(), table_oid),
+              0.02);
+
+  // Without the table the columns cannot be resolved
+  EXPECT_DOUBLE_EQ(DEFAULT_SELECTIVITY,
+                   Cost::GetSelectivity(stats, less_than.get()));
+
+  // The comparison is mirrored when the constant comes first
+  std::unique_ptr<expression::AbstractExpression> mirrored(
+      new expression::ComparisonExpression(
+          ExpressionType::COMPARE_GREATERTHAN,
+          new expression::ConstantValueExpression(
+              type::ValueFactory::GetIntegerValue(middle)),
+          new expression::TupleValueExpression(type::Type::INTEGER, 0, 1)));
+  EXPECT_NEAR(Cost::GetSelectivity(stats, less_than.get(), table_oid),
+              Cost::GetSelectivity(stats, mirrored.get(), table_oid), 0.001);
+
+  // Conjunctions combine the terms as independent
+  std::unique_ptr<expression::AbstractExpression> conjunction(
+      new expression::ConjunctionExpression(
+          ExpressionType::CONJUNCTION_AND,
+          MakeComparison(ExpressionType::COMPARE_EQUAL, 0, 0),
+          MakeComparison(ExpressionType::COMPARE_LESSTHAN, 1, middle)));
+  EXPECT_NEAR(0.25, Cost::GetSelectivity(stats, conjunction.get(), table_oid),
+              0.02);
+  EXPECT_EQ(2, Cost::GetPredicateCount(conjunction.get()));
+
+  std::unique_ptr<expression::AbstractExpression> disjunction(
+      new expression::ConjunctionExpression(
+          ExpressionType::CONJUNCTION_OR,
+          MakeComparison(ExpressionType::COMPARE_EQUAL, 0, 0),
+          MakeComparison(ExpressionType::COMPARE_EQUAL, 0, 10)));
+  EXPECT_NEAR(0.75, Cost::GetSelectivity(stats, disjunction.get(), table_oid),
+              0.01);
+  EXPECT_EQ(1, Cost::GetPredicateCount(disjunction.get()));
+
+  std::unique_ptr<expression::AbstractExpression> negation(
+      new expression::OperatorExpression(
+          ExpressionType::OPERATOR_NOT, type::Type::BOOLEAN,
+          MakeComparison(ExpressionType::COMPARE_LESSTHAN, 1, middle),
+          nullptr));
+  EXPECT_NEAR(0.5, Cost::GetSelectivity(stats, negation.get(), table_oid),
+              0.02);
+
+  EXPECT_EQ(1, Cost::GetSelectivity(stats, nullptr, table_oid));
+}
+
+TEST_F(CostTests, CostAndStatsCalculatorTest) {
+  const int num_rows = 2000;
+  const oid_t table_oid = 45678;
+  std::unique_ptr<storage::DataTable> table(
+      CreateAnalyzedTable(num_rows, table_oid));
+
+  optimizer::ColumnManager manager;
+  optimizer::PropertySet no_properties;
+  std::vector<optimizer::PropertySet> input_properties;
+
+  // The scan filters half of the table
+  optimizer::PropertySet scan_properties;
+  scan_properties.AddProperty(std::make_shared<optimizer::PropertyPredicate>(
+      MakeComparison(ExpressionType::COMPARE_LESSTHAN, 1,
+                     10 * (num_rows / 2) + 1)));
+  auto scan = std::make_shared<optimizer::GroupExpression>(
+      optimizer::PhysicalScan::make(table.get()),
+      std::vector<optimizer::GroupID>());
+  optimizer::CostAndStatsCalculator scan_calculator(manager);
+  scan_calculator.CalculateCostAndStats(scan, &scan_properties,
+                                        &input_properties, {}, {});
+  auto scan_stats = scan_calculator.GetOutputStats();
+  EXPECT_NEAR(num_rows / 2, scan_stats->GetNumRows(), num_rows * 0.02);
+  EXPECT_NE(nullptr, scan_stats->GetColumnStats(table_oid, 1));
+  double scan_cost = scan_calculator.GetOutputCost();
+  EXPECT_DOUBLE_EQ(optimizer::Cost::SeqScanCost(num_rows, 1), scan_cost);
+
+  // A join of the scan with a small input prefers hashing
+  auto small_stats = std::make_shared<optimizer::Stats>(10);
+  std::vector<optimizer::GroupID> child_groups = {0, 1, 2};
+  auto nl_join = std::make_shared<optimizer::GroupExpression>(
+      optimizer::PhysicalInnerNLJoin::make(), child_groups);
+  auto hash_join = std::make_shared<optimizer::GroupExpression>(
+      optimizer::PhysicalInnerHashJoin::make(), child_groups);
+
+  optimizer::CostAndStatsCalculator nl_calculator(manager);
+  nl_calculator.CalculateCostAndStats(nl_join, &no_properties,
+                                      &input_properties,
+                                      {scan_stats, small_stats}, {scan_cost, 0});
+  optimizer::CostAndStatsCalculator hash_calculator(manager);
+  hash_calculator.CalculateCostAndStats(hash_join, &no_properties,
+                                        &input_properties,
+                                        {scan_stats, small_stats},
+                                        {scan_cost, 0});
+
+  EXPECT_LT(hash_calculator.GetOutputCost(), nl_calculator.GetOutputCost());
+  EXPECT_LT(scan_cost, hash_calculator.GetOutputCost());
+  auto join_stats = hash_calculator.GetOutputStats();
+  EXPECT_DOUBLE_EQ(scan_stats->GetNumRows(), join_stats->GetNumRows());
+  EXPECT_NE(nullptr, join_stats->GetColumnStats(table_oid, 1));
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,198 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// table_stats_test.cpp
+//
+// Identification: test/optimizer/table_stats_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "catalog/catalog.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/testing_executor_util.h"
+#include "optimizer/hyperloglog.h"
+#include "optimizer/stats_storage.h"
+#include "optimizer/table_stats.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Table Stats Tests
+//===--------------------------------------------------------------------===//
+
+class TableStatsTests : public PelotonTest {};
+
+// count the rows of the column stats catalog table recorded for a table
+static size_t ColumnStatsRowCount(oid_t table_id) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto column_stats_table = catalog::Catalog::GetInstance()->GetTableWithName(
+      CATALOG_DATABASE_NAME, COLUMN_STATS_NAME);
+
+  auto txn = txn_manager.BeginTransaction();
+  size_t row_count = 0;
+  std::vector<oid_t> visible_tuples;
+  for (oid_t offset = 0; offset < column_stats_table->GetTileGroupCount();
+       offset++) {
+    auto tile_group = column_stats_table->GetTileGroup(offset);
+    txn_manager.GetVisibleTuples(txn, tile_group->GetHeader(),
+                                 tile_group->GetNextTupleSlot(),
+                                 visible_tuples);
+    for (auto tuple_id : visible_tuples) {
+      if (tile_group->GetValue(tuple_id, 0).GetAs<int32_t>() ==
+          (int32_t)table_id) {
+        row_count++;
+      }
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+  return row_count;
+}
+
+// create a table where the first column holds two values and the second one
+// is unique
+static storage::DataTable *CreatePopulatedTable(int num_rows,
+                                                oid_t table_oid) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto table = TestingExecutorUtil::CreateTable(100, false, table_oid);
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table, num_rows, false, false, true, txn);
+  txn_manager.CommitTransaction(txn);
+  return table;
+}
+
+TEST_F(TableStatsTests, HyperLogLogTest) {
+  optimizer::HyperLogLog sketch, first_half, second_half;
+  const int value_count = 100000;
+  for (int value = 0; value < value_count; value++) {
+    // every value is seen twice
+    sketch.Add(type::ValueFactory::GetIntegerValue(value));
+    sketch.Add(type::ValueFactory::GetIntegerValue(value));
+    if (value < value_count / 2) {
+      first_half.Add(type::ValueFactory::GetIntegerValue(value));
+    } else {
+      second_half.Add(type::ValueFactory::GetIntegerValue(value));
+    }
+  }
+
+  EXPECT_NEAR(value_count, sketch.Estimate(), value_count * 0.05);
+
+  first_half.Merge(second_half);
+  EXPECT_DOUBLE_EQ(sketch.Estimate(), first_half.Estimate());
+
+  optimizer::HyperLogLog small;
+  for (int value = 0; value < 10; value++) {
+    small.Add(type::ValueFactory::GetIntegerValue(value));
+  }
+  EXPECT_NEAR(10, small.Estimate(), 1);
+}
+
+TEST_F(TableStatsTests, CollectTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  const int num_rows = 5000;
+  std::unique_ptr<storage::DataTable> table(
+      CreatePopulatedTable(num_rows, 12345));
+
+  auto txn = txn_manager.BeginTransaction();
+  auto table_stats = optimizer::TableStats::Collect(table.get(), txn);
+  txn_manager.CommitTransaction(txn);
+  LOG_TRACE("%s", table_stats->GetInfo().c_str());
+
+  EXPECT_EQ(num_rows, table_stats->GetNumRows());
+  EXPECT_EQ(4, table_stats->GetColumnCount());
+  EXPECT_EQ(nullptr, table_stats->GetColumnStats(4));
+
+  // The first column holds 0 and 10 in equal parts
+  auto group_stats = table_stats->GetColumnStats(0);
+  EXPECT_EQ(0, group_stats->GetNullFraction());
+  EXPECT_NEAR(2, group_stats->GetDistinctCount(), 0.5);
+  EXPECT_EQ(2, group_stats->GetMostCommonValues().size());
+  EXPECT_TRUE(group_stats->GetHistogramBounds().empty());
+  auto zero = type::ValueFactory::GetIntegerValue(0);
+  auto ten = type::ValueFactory::GetIntegerValue(10);
+  EXPECT_NEAR(0.5, group_stats->GetSelectivity(ExpressionType::COMPARE_EQUAL,
+                                               zero),
+              0.01);
+  EXPECT_NEAR(0.5, group_stats->GetSelectivity(
+                       ExpressionType::COMPARE_GREATERTHAN, zero),
+              0.01);
+  EXPECT_NEAR(1, group_stats->GetSelectivity(
+                     ExpressionType::COMPARE_LESSTHANOREQUALTO, ten),
+              0.01);
+
+  // The second column is unique, from 1 to 10 * (num_rows - 1) + 1
+  auto unique_stats = table_stats->GetColumnStats(1);
+  EXPECT_NEAR(num_rows, unique_stats->GetDistinctCount(), num_rows * 0.05);
+  EXPECT_TRUE(unique_stats->GetMostCommonValues().empty());
+  EXPECT_EQ(STATS_HISTOGRAM_BUCKETS + 1,
+            unique_stats->GetHistogramBounds().size());
+  auto middle = type::ValueFactory::GetIntegerValue(10 * (num_rows / 2) + 1);
+  EXPECT_NEAR(0.5, unique_stats->GetSelectivity(
+                       ExpressionType::COMPARE_LESSTHAN, middle),
+              0.02);
+  EXPECT_NEAR(1.0 / num_rows, unique_stats->GetSelectivity(
+                                  ExpressionType::COMPARE_EQUAL, middle),
+              0.001);
+  EXPECT_EQ(0, unique_stats->GetSelectivity(
+                   ExpressionType::COMPARE_LESSTHAN,
+                   type::ValueFactory::GetIntegerValue(0)));
+
+  // The distinct counts don't depend on the sample
+  txn = txn_manager.BeginTransaction();
+  auto sampled_stats = optimizer::TableStats::Collect(table.get(), txn, 1000);
+  txn_manager.CommitTransaction(txn);
+  EXPECT_EQ(num_rows, sampled_stats->GetNumRows());
+  EXPECT_DOUBLE_EQ(unique_stats->GetDistinctCount(),
+                   sampled_stats->GetColumnStats(1)->GetDistinctCount());
+  EXPECT_NEAR(0.5, sampled_stats->GetColumnStats(1)->GetSelectivity(
+                       ExpressionType::COMPARE_LESSTHAN, middle),
+              0.1);
+
+  // The strings of the fourth column outlive the table
+  auto string_stats = table_stats->GetColumnStats(3);
+  table.reset();
+  auto &string_bounds = string_stats->GetHistogramBounds();
+  EXPECT_EQ(STATS_HISTOGRAM_BUCKETS + 1, string_bounds.size());
+  EXPECT_EQ("10003", string_bounds.front().ToString());
+  EXPECT_EQ("9993", string_bounds.back().ToString());
+}
+
+TEST_F(TableStatsTests, AnalyzeTableTest) {
+  const int num_rows = 1000;
+  const oid_t table_oid = 23456;
+  std::unique_ptr<storage::DataTable> table(
+      CreatePopulatedTable(num_rows, table_oid));
+
+  auto &stats_storage = optimizer::StatsStorage::GetInstance();
+  EXPECT_EQ(nullptr, stats_storage.GetTableStats(table_oid));
+
+  auto table_stats = stats_storage.AnalyzeTable(table.get(), nullptr);
+  EXPECT_EQ(table_stats, stats_storage.GetTableStats(table_oid));
+  EXPECT_EQ(num_rows, table_stats->GetNumRows());
+
+  // A row per column, replaced when the table is analyzed again
+  EXPECT_EQ(4, ColumnStatsRowCount(table_oid));
+  stats_storage.AnalyzeTable(table.get(), nullptr);
+  EXPECT_EQ(4, ColumnStatsRowCount(table_oid));
+
+  // The first report of the aggregator only sets the starting point
+  stats_storage.RefreshTableStats(table.get(), 1000);
+  table_stats = stats_storage.GetTableStats(table_oid);
+  stats_storage.RefreshTableStats(table.get(), 1000 + STATS_REFRESH_THRESHOLD);
+  EXPECT_EQ(table_stats, stats_storage.GetTableStats(table_oid));
+  stats_storage.RefreshTableStats(
+      table.get(), 1000 + STATS_REFRESH_THRESHOLD +
+                       STATS_REFRESH_SCALE_FACTOR * num_rows + 1);
+  EXPECT_NE(table_stats, stats_storage.GetTableStats(table_oid));
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// pool_performance_test.cpp
+//
+// Identification: test/performance/pool_performance_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <thread>
+
+#include "common/harness.h"
+#include "common/timer.h"
+#include "type/arena_pool.h"
+#include "type/ephemeral_pool.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Pool Performance Tests
+//===--------------------------------------------------------------------===//
+
+class PoolPerformanceTests : public PelotonTest {};
+
+// Allocate varchar-sized blocks from one pool on every thread, like the
+// executors of a query do with the pool of their context
+static void AllocateStrings(type::AbstractPool *pool, size_t allocation_count,
+                            uint64_t thread_itr) {
+  for (size_t i = 0; i < allocation_count; i++) {
+    size_t size = 16 + (i + thread_itr) % 48;
+    char *location = static_cast<char *>(pool->Allocate(size));
+    location[0] = static_cast<char>(i);
+  }
+}
+
+static double MeasurePool(type::AbstractPool *pool, uint64_t thread_count,
+                          size_t allocation_count) {
+  Timer<> timer;
+  timer.Start();
+  LaunchParallelTest(thread_count, AllocateStrings, pool, allocation_count);
+  timer.Stop();
+  return timer.GetDuration();
+}
+
+TEST_F(PoolPerformanceTests, AllocateTest) {
+  const size_t allocation_count = 200000;
+  uint64_t max_thread_count =
+      std::max<uint64_t>(std::thread::hardware_concurrency(), 1);
+
+  for (uint64_t thread_count = 1; thread_count <= max_thread_count;
+       thread_count *= 2) {
+    std::unique_ptr<type::AbstractPool> ephemeral_pool(
+        new type::EphemeralPool());
+    std::unique_ptr<type::AbstractPool> arena_pool(new type::ArenaPool());
+
+    auto ephemeral_duration =
+        MeasurePool(ephemeral_pool.get(), thread_count, allocation_count);
+    auto arena_duration =
+        MeasurePool(arena_pool.get(), thread_count, allocation_count);
+
+    LOG_INFO("%lu threads, %lu allocations each : ephemeral %.3lf s, "
+             "arena %.3lf s",
+             thread_count, allocation_count, ephemeral_duration,
+             arena_duration);
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
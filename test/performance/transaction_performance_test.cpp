@@ -0,0 +1,67 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// transaction_performance_test.cpp
+//
+// Identification: test/performance/transaction_performance_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <thread>
+
+#include "common/harness.h"
+#include "common/timer.h"
+#include "concurrency/transaction_manager_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Transaction Performance Tests
+//===--------------------------------------------------------------------===//
+
+class TransactionPerformanceTests : public PelotonTest {};
+
+// Begin and commit empty transactions, which only costs the commit ids and
+// the epoch bookkeeping
+static void BeginCommit(concurrency::TransactionManager *txn_manager,
+                        size_t txn_count,
+                        UNUSED_ATTRIBUTE uint64_t thread_itr) {
+  for (size_t txn_itr = 0; txn_itr < txn_count; txn_itr++) {
+    auto txn = txn_manager->BeginTransaction();
+    txn_manager->CommitTransaction(txn);
+  }
+}
+
+TEST_F(TransactionPerformanceTests, BeginCommitTest) {
+  const size_t txn_count = 100000;
+  uint64_t max_thread_count =
+      std::max<uint64_t>(std::thread::hardware_concurrency(), 1);
+
+  for (auto protocol : {ConcurrencyType::TIMESTAMP_ORDERING,
+                        ConcurrencyType::TIMESTAMP_ORDERING_EPOCH}) {
+    concurrency::TransactionManagerFactory::Configure(protocol);
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+    for (uint64_t thread_count = 1; thread_count <= max_thread_count;
+         thread_count *= 2) {
+      Timer<> timer;
+      timer.Start();
+      LaunchParallelTest(thread_count, BeginCommit, &txn_manager, txn_count);
+      timer.Stop();
+
+      LOG_INFO("%s commit ids, %lu threads : %.0lf txns/s",
+               (txn_manager.IsEpochCommitId() ? "epoch" : "shared"),
+               thread_count, thread_count * txn_count / timer.GetDuration());
+    }
+  }
+
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -17,6 +17,7 @@
 #include "common/harness.h"
 #include "executor/create_executor.h"
 #include "optimizer/simple_optimizer.h"
+#include "optimizer/stats_storage.h"
 #include "planner/create_plan.h"
 
 
@@ -53,10 +54,20 @@ TEST_F(DropSQLTests, DropTableTest) {
                                 rows_affected, error_message);
   EXPECT_EQ(result[0].second[0], '1');
 
+  // Analyze it
+  oid_t table_oid = table->GetOid();
+  auto &stats_storage = optimizer::StatsStorage::GetInstance();
+  EXPECT_EQ(TestingSQLUtil::ExecuteSQLQuery("ANALYZE test;"),
+            ResultType::SUCCESS);
+  EXPECT_NE(stats_storage.GetTableStats(table_oid), nullptr);
+
   // Drop the table
   EXPECT_EQ(TestingSQLUtil::ExecuteSQLQuery("DROP TABLE test;"),
             ResultType::SUCCESS);
 
+  // Its statistics are gone
+  EXPECT_EQ(stats_storage.GetTableStats(table_oid), nullptr);
+
   // Query from the dropped table
   result.clear();
   TestingSQLUtil::ExecuteSQLQuery("SELECT * FROM test;", result, tuple_descriptor,
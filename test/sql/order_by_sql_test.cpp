@@ -579,5 +579,63 @@ TEST_F(OrderBySQLTests, OrderByWithProjectionLimitDescTest) {
   catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
   txn_manager.CommitTransaction(txn);
 }
+
+TEST_F(OrderBySQLTests, OrderByWithHashIndexTest) {
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, nullptr);
+
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE test(a INT PRIMARY KEY, b INT, c INT);");
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE INDEX idx_hash ON test (b,c) USING HASH;");
+
+  // c is inserted out of order, so that nothing but a sort returns it
+  // ordered
+  int table_size = 20;
+  for (int count = 0; count < table_size; count++) {
+    int c_value = (count * 7) % table_size;
+    std::string insert_statement =
+        "INSERT INTO test VALUES (" + std::to_string(count) + "," +
+        std::to_string(count % 2) + "," + std::to_string(c_value) + ");";
+    TestingSQLUtil::ExecuteSQLQuery(insert_statement);
+  }
+
+  std::vector<StatementResult> result;
+  std::vector<FieldInfo> tuple_descriptor;
+  std::string error_message;
+  int rows_changed;
+
+  // A hash index scan returns its tuples in no order, the sort and the
+  // limit must stay above it
+  TestingSQLUtil::ExecuteSQLQuery(
+      "SELECT c FROM test WHERE b = 0 ORDER BY c;", result, tuple_descriptor,
+      rows_changed, error_message);
+  EXPECT_EQ(table_size / 2, result.size() / tuple_descriptor.size());
+  for (int i = 0; i < table_size / 2; i++) {
+    EXPECT_EQ(std::to_string(i * 2),
+              TestingSQLUtil::GetResultValueAsString(result, i));
+  }
+
+  TestingSQLUtil::ExecuteSQLQuery(
+      "SELECT c FROM test WHERE b = 1 ORDER BY c LIMIT 3;", result,
+      tuple_descriptor, rows_changed, error_message);
+  EXPECT_EQ(3, result.size() / tuple_descriptor.size());
+  EXPECT_EQ("1", TestingSQLUtil::GetResultValueAsString(result, 0));
+  EXPECT_EQ("3", TestingSQLUtil::GetResultValueAsString(result, 1));
+  EXPECT_EQ("5", TestingSQLUtil::GetResultValueAsString(result, 2));
+
+  TestingSQLUtil::ExecuteSQLQuery(
+      "SELECT c FROM test WHERE b = 1 ORDER BY c DESC LIMIT 3;", result,
+      tuple_descriptor, rows_changed, error_message);
+  EXPECT_EQ(3, result.size() / tuple_descriptor.size());
+  EXPECT_EQ("19", TestingSQLUtil::GetResultValueAsString(result, 0));
+  EXPECT_EQ("17", TestingSQLUtil::GetResultValueAsString(result, 1));
+  EXPECT_EQ("15", TestingSQLUtil::GetResultValueAsString(result, 2));
+
+  // free the database just created
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
 }  // namespace test
 }  // namespace peloton
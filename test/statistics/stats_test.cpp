@@ -24,7 +24,10 @@
 #include "executor/executor_context.h"
 #include "executor/insert_executor.h"
 #include "statistics/backend_stats_context.h"
+#include "statistics/fragmentation_metric.h"
+#include "statistics/histogram_metric.h"
 #include "statistics/stats_aggregator.h"
+#include "statistics/table_metric.h"
 #include "tcop/tcop.h"
 
 #define NUM_ITERATION 50
@@ -364,11 +367,12 @@ TEST_F(StatsTests, PerQueryStatsTest) {
   catalog->CreateDatabase("emp_db", nullptr);
   TestingStatsUtil::CreateTable();
 
-  // Default database should include 4 metrics tables and the test table
+  // Default database should include 4 metrics tables, the column stats table
+  // and the test table besides the table catalog
   EXPECT_EQ(catalog::Catalog::GetInstance()
                 ->GetDatabaseWithName(CATALOG_DATABASE_NAME)
                 ->GetTableCount(),
-            6);
+            7);
   LOG_TRACE("Table created!");
 
   auto backend_context = stats::BackendStatsContext::GetInstance();
@@ -439,5 +443,68 @@ TEST_F(StatsTests, PerQueryStatsTest) {
   catalog->DropDatabaseWithName("emp_db", txn);
   txn_manager.CommitTransaction(txn);
 }
+
+TEST_F(StatsTests, HistogramMetricTest) {
+  stats::HistogramMetric histogram(HISTOGRAM_METRIC, "TEST", "us");
+  EXPECT_EQ(0, histogram.GetCount());
+  EXPECT_EQ(0, histogram.GetPercentile(0.5));
+
+  // 0 | 1 | 2, 3 | 4 ... 7 | 8 ... 15
+  for (uint64_t value = 0; value < 16; value++) {
+    histogram.Record(value);
+  }
+  EXPECT_EQ(16, histogram.GetCount());
+  EXPECT_EQ(1, histogram.GetBucketCount(0));
+  EXPECT_EQ(1, histogram.GetBucketCount(1));
+  EXPECT_EQ(2, histogram.GetBucketCount(2));
+  EXPECT_EQ(4, histogram.GetBucketCount(3));
+  EXPECT_EQ(8, histogram.GetBucketCount(4));
+  EXPECT_EQ(7.5, histogram.GetAverage());
+  EXPECT_EQ(7, histogram.GetPercentile(0.5));
+  EXPECT_EQ(15, histogram.GetPercentile(0.99));
+
+  // values beyond the last bucket are counted in the last bucket
+  histogram.Record(UINT64_MAX >> 1);
+  EXPECT_EQ(1, histogram.GetBucketCount(stats::HistogramMetric::BUCKET_COUNT -
+                                        1));
+
+  stats::HistogramMetric other(HISTOGRAM_METRIC, "TEST", "us");
+  other.Record(5);
+  other.Aggregate(histogram);
+  EXPECT_EQ(18, other.GetCount());
+  EXPECT_EQ(5, other.GetBucketCount(3));
+
+  other.Reset();
+  EXPECT_EQ(0, other.GetCount());
+}
+
+TEST_F(StatsTests, FragmentationMetricTest) {
+  stats::FragmentationMetric fragmentation(FRAGMENTATION_METRIC);
+  EXPECT_EQ(0, fragmentation.GetFragmentation());
+
+  // 4 tile groups of 100 slots, 2 of them filled by 10 tuples
+  fragmentation.SetSnapshot(4, 400, 220, 2);
+  fragmentation.IncrementRelocatedTuples(10);
+  fragmentation.IncrementReleasedTileGroups(1);
+  EXPECT_DOUBLE_EQ(0.45, fragmentation.GetFragmentation());
+
+  // only the thread running the compactor sets a snapshot
+  stats::FragmentationMetric aggregated(FRAGMENTATION_METRIC);
+  stats::FragmentationMetric other(FRAGMENTATION_METRIC);
+  aggregated.Aggregate(fragmentation);
+  aggregated.Aggregate(other);
+  EXPECT_TRUE(aggregated == fragmentation);
+  EXPECT_EQ(2, aggregated.GetSparseTileGroupCount());
+  EXPECT_EQ(10, aggregated.GetRelocatedTupleCount());
+  EXPECT_EQ(1, aggregated.GetReleasedTileGroupCount());
+
+  // the table metric carries it
+  stats::TableMetric table_metric(TABLE_METRIC, INVALID_OID, INVALID_OID);
+  table_metric.GetTableFragmentation().Aggregate(fragmentation);
+  EXPECT_EQ(400, table_metric.GetTableFragmentation().GetSlotCount());
+  table_metric.Reset();
+  EXPECT_EQ(0, table_metric.GetTableFragmentation().GetSlotCount());
+  EXPECT_EQ(0, table_metric.GetTableFragmentation().GetReleasedTileGroupCount());
+}
 }  // namespace stats
 }  // namespace peloton
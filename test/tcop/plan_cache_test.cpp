@@ -0,0 +1,267 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_cache_test.cpp
+//
+// Identification: test/tcop/plan_cache_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "catalog/catalog.h"
+#include "common/statement.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "sql/testing_sql_util.h"
+#include "statistics/backend_stats_context.h"
+#include "tcop/plan_cache.h"
+#include "tcop/tcop.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Plan Cache Tests
+//===--------------------------------------------------------------------===//
+
+class PlanCacheTests : public PelotonTest {};
+
+static std::shared_ptr<Statement> MakeStatement(oid_t table_id) {
+  std::shared_ptr<Statement> statement(
+      new Statement("unnamed", "SELECT * FROM foo;"));
+  statement->SetReferencedTables({table_id});
+  return statement;
+}
+
+// Run a query with a cached plan, as the simple query protocol does
+static ResultType ExecuteCachedQuery(tcop::TrafficCop &traffic_cop,
+                                     const std::string &query,
+                                     std::vector<StatementResult> &result) {
+  std::vector<type::Value> params;
+  std::string error_message;
+  auto statement =
+      traffic_cop.PrepareCachedStatement(query, params, error_message);
+  EXPECT_NE(nullptr, statement) << error_message;
+  if (statement.get() == nullptr) return ResultType::FAILURE;
+
+  std::vector<int> result_format(statement->GetTupleDescriptor().size(), 0);
+  int rows_changed = 0;
+  result.clear();
+  auto status =
+      traffic_cop.ExecuteStatement(statement, params, true, nullptr,
+                                   result_format, result, rows_changed,
+                                   error_message);
+  traffic_cop.ReleaseCachedStatement(statement);
+  return status;
+}
+
+TEST_F(PlanCacheTests, ParameterizeQueryTest) {
+  std::string key, query_string;
+  std::vector<type::Value> params;
+
+  EXPECT_TRUE(tcop::PlanCache::ParameterizeQuery(
+      "SELECT a, b  FROM foo\n WHERE a = 5 AND \"B\" = 'x y' LIMIT 10;", key,
+      query_string, params));
+  EXPECT_EQ("SELECT a, b FROM foo WHERE a = $1 AND \"B\" = $2 LIMIT 10;",
+            query_string);
+  ASSERT_EQ(2, params.size());
+  EXPECT_EQ(5, params[0].GetAs<int32_t>());
+  EXPECT_EQ("x y", params[1].ToString());
+
+  EXPECT_TRUE(tcop::PlanCache::ParameterizeQuery(
+      "select * from foo where a > 1.5 and b = 'bar' and c < -3 order by a;",
+      key, query_string, params));
+  EXPECT_EQ(
+      "select * from foo where a > $1 and b = $2 and c < $3 order by a;",
+      query_string);
+  ASSERT_EQ(3, params.size());
+  EXPECT_EQ(type::Type::DECIMAL, params[0].GetTypeId());
+  EXPECT_EQ(type::Type::VARCHAR, params[1].GetTypeId());
+  EXPECT_EQ("bar", params[1].ToString());
+  EXPECT_EQ(type::Type::INTEGER, params[2].GetTypeId());
+  EXPECT_EQ(-3, params[2].GetAs<int32_t>());
+  EXPECT_EQ(query_string + "\ndsi", key);
+
+  // The types of the literals are part of the key
+  std::string other_key;
+  EXPECT_TRUE(tcop::PlanCache::ParameterizeQuery(
+      "select * from foo where a > 1 and b = 'bar' and c < -3 order by a;",
+      other_key, query_string, params));
+  EXPECT_NE(key, other_key);
+
+  // The SET clause of an update keeps its literals
+  EXPECT_TRUE(tcop::PlanCache::ParameterizeQuery(
+      "UPDATE foo SET a = 1, b = 'x' WHERE c = 2;", key, query_string,
+      params));
+  EXPECT_EQ("UPDATE foo SET a = 1, b = 'x' WHERE c = $1;", query_string);
+  ASSERT_EQ(1, params.size());
+
+  EXPECT_TRUE(tcop::PlanCache::ParameterizeQuery(
+      "INSERT INTO foo VALUES (1, 'a', 2.5);", key, query_string, params));
+  EXPECT_EQ("INSERT INTO foo VALUES ($1, $2, $3);", query_string);
+  ASSERT_EQ(3, params.size());
+
+  // Queries planned with their literals
+  EXPECT_FALSE(tcop::PlanCache::ParameterizeQuery(
+      "INSERT INTO foo VALUES (1, 'a'), (2, 'b');", key, query_string,
+      params));
+  EXPECT_FALSE(tcop::PlanCache::ParameterizeQuery(
+      "SELECT * FROM foo WHERE a = $1;", key, query_string, params));
+  EXPECT_FALSE(tcop::PlanCache::ParameterizeQuery(
+      "SELECT * FROM foo WHERE a = 'x;", key, query_string, params));
+  EXPECT_FALSE(tcop::PlanCache::ParameterizeQuery(
+      "SELECT * FROM foo WHERE a = 'x\ny';", key, query_string, params));
+  EXPECT_FALSE(tcop::PlanCache::ParameterizeQuery(
+      "SELECT * FROM foo WHERE a = 4294967296;", key, query_string, params));
+  EXPECT_FALSE(tcop::PlanCache::ParameterizeQuery(
+      "CREATE TABLE foo (a INT);", key, query_string, params));
+}
+
+TEST_F(PlanCacheTests, AcquireReleaseTest) {
+  tcop::PlanCache plan_cache(2, 1);
+  uint64_t version;
+
+  EXPECT_EQ(nullptr, plan_cache.Acquire("a", version));
+  auto statement = MakeStatement(1);
+  plan_cache.Release("a", statement, version);
+  EXPECT_EQ(1, plan_cache.GetQueryCount());
+
+  // The statement is lent to one query at a time
+  uint64_t first_version, second_version;
+  auto first = plan_cache.Acquire("a", first_version);
+  EXPECT_EQ(statement, first);
+  EXPECT_EQ(nullptr, plan_cache.Acquire("a", second_version));
+  auto second = MakeStatement(1);
+
+  // One idle statement per query is kept
+  plan_cache.Release("a", first, first_version);
+  plan_cache.Release("a", second, second_version);
+  EXPECT_EQ(statement, plan_cache.Acquire("a", version));
+  EXPECT_EQ(nullptr, plan_cache.Acquire("a", version));
+  plan_cache.Release("a", statement, version);
+
+  // The least recently used query is evicted
+  plan_cache.Release("b", MakeStatement(2), version);
+  first = plan_cache.Acquire("a", version);
+  plan_cache.Release("a", first, version);
+  plan_cache.Release("c", MakeStatement(3), version);
+  EXPECT_EQ(2, plan_cache.GetQueryCount());
+  EXPECT_EQ(nullptr, plan_cache.Acquire("b", version));
+  first = plan_cache.Acquire("a", version);
+  EXPECT_NE(nullptr, first);
+  plan_cache.Release("a", first, version);
+}
+
+TEST_F(PlanCacheTests, InvalidateTest) {
+  tcop::PlanCache plan_cache;
+  uint64_t version;
+
+  plan_cache.Acquire("a", version);
+  plan_cache.Release("a", MakeStatement(1), version);
+  plan_cache.Acquire("b", version);
+  plan_cache.Release("b", MakeStatement(2), version);
+  EXPECT_EQ(2, plan_cache.GetQueryCount());
+
+  // A statement in use when its table changes is not cached again
+  auto statement = plan_cache.Acquire("b", version);
+  EXPECT_NE(nullptr, statement);
+  plan_cache.InvalidateTable(1);
+  EXPECT_EQ(1, plan_cache.GetQueryCount());
+  EXPECT_EQ(nullptr, plan_cache.Acquire("a", version));
+  plan_cache.Release("b", statement, version - 1);
+  EXPECT_EQ(nullptr, plan_cache.Acquire("b", version));
+
+  plan_cache.Release("b", statement, version);
+  plan_cache.Clear();
+  EXPECT_EQ(0, plan_cache.GetQueryCount());
+}
+
+TEST_F(PlanCacheTests, CachedStatementTest) {
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, nullptr);
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE cached_table(a INT PRIMARY KEY, b INT, c INT);");
+
+  tcop::TrafficCop traffic_cop;
+  std::vector<StatementResult> result;
+
+  // NULL is not a parameter, so the literal after it is the second one.
+  // The second insert reuses the plan of the first.
+  EXPECT_EQ(ResultType::SUCCESS,
+            ExecuteCachedQuery(
+                traffic_cop,
+                "INSERT INTO cached_table (a, b, c) VALUES (1, NULL, 5);",
+                result));
+  EXPECT_EQ(ResultType::SUCCESS,
+            ExecuteCachedQuery(
+                traffic_cop,
+                "INSERT INTO cached_table (a, b, c) VALUES (2, NULL, 6);",
+                result));
+
+  EXPECT_EQ(ResultType::SUCCESS,
+            ExecuteCachedQuery(traffic_cop,
+                               "SELECT c FROM cached_table WHERE a = 2;",
+                               result));
+  ASSERT_EQ(1, result.size());
+  EXPECT_EQ("6", TestingSQLUtil::GetResultValueAsString(result, 0));
+  EXPECT_EQ(ResultType::SUCCESS,
+            ExecuteCachedQuery(traffic_cop,
+                               "SELECT c FROM cached_table WHERE a = 1;",
+                               result));
+  ASSERT_EQ(1, result.size());
+  EXPECT_EQ("5", TestingSQLUtil::GetResultValueAsString(result, 0));
+
+  // A prepared insert binds $n to the n-th parameter, not to the n-th
+  // parameter of the row
+  std::string error_message;
+  auto statement = traffic_cop.PrepareStatement(
+      "insert_stmt", "INSERT INTO cached_table (a, b, c) VALUES ($2, NULL, $1);",
+      error_message);
+  ASSERT_NE(nullptr, statement) << error_message;
+  std::vector<type::Value> params = {type::ValueFactory::GetIntegerValue(7),
+                                     type::ValueFactory::GetIntegerValue(3)};
+  statement->GetPlanTree()->SetParameterValues(&params);
+  std::vector<int> result_format(statement->GetTupleDescriptor().size(), 0);
+  int rows_changed = 0;
+  EXPECT_EQ(ResultType::SUCCESS,
+            traffic_cop.ExecuteStatement(statement, params, false, nullptr,
+                                         result_format, result, rows_changed,
+                                         error_message));
+  EXPECT_EQ(1, rows_changed);
+  EXPECT_EQ(ResultType::SUCCESS,
+            ExecuteCachedQuery(traffic_cop,
+                               "SELECT c FROM cached_table WHERE a = 3;",
+                               result));
+  ASSERT_EQ(1, result.size());
+  EXPECT_EQ("7", TestingSQLUtil::GetResultValueAsString(result, 0));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+TEST_F(PlanCacheTests, StatsTest) {
+  stats::BackendStatsContext stats_context(0, false);
+  stats_context.IncrementPlanCacheLookups(true);
+  stats_context.IncrementPlanCacheLookups(true);
+  stats_context.IncrementPlanCacheLookups(false);
+  EXPECT_EQ(2, stats_context.GetPlanCacheHits().GetCounter());
+  EXPECT_EQ(1, stats_context.GetPlanCacheMisses().GetCounter());
+
+  stats::BackendStatsContext aggregate(0, false);
+  aggregate.Aggregate(stats_context);
+  EXPECT_EQ(2, aggregate.GetPlanCacheHits().GetCounter());
+  aggregate.Reset();
+  EXPECT_EQ(0, aggregate.GetPlanCacheHits().GetCounter());
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -12,7 +12,13 @@
 
 #include <limits.h>
 #include <pthread.h>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
 
+#include "type/arena_pool.h"
 #include "type/ephemeral_pool.h"
 #include "gtest/gtest.h"
 #include "common/harness.h"
@@ -57,5 +63,86 @@ TEST_F(PoolTests, AllocateOnceTest) {
   delete pool;
 }
 
+// Allocate from an arena pool on several threads at once
+TEST_F(PoolTests, ArenaPoolTest) {
+  type::ArenaPool pool;
+  const size_t thread_count = 4;
+  const size_t allocation_count = 5000;
+  std::vector<std::vector<char *>> allocations(thread_count);
+
+  LaunchParallelTest(thread_count, [&](uint64_t thread_itr) {
+    for (size_t i = 0; i < allocation_count; i++) {
+      // Mostly small strings, with a large one now and then
+      size_t size = (i % 1000 == 0) ? 4 * str_len * 16 : RANDOM(str_len) + 1;
+      char *location = static_cast<char *>(pool.Allocate(size));
+      EXPECT_TRUE(location != nullptr);
+      EXPECT_EQ(0UL, reinterpret_cast<uintptr_t>(location) % 8);
+      memset(location, static_cast<int>(thread_itr), size);
+      allocations[thread_itr].push_back(location);
+      pool.Free(location);
+    }
+  });
+
+  // No thread wrote over the memory of another one
+  for (size_t thread_itr = 0; thread_itr < thread_count; thread_itr++) {
+    for (auto location : allocations[thread_itr]) {
+      EXPECT_EQ(static_cast<char>(thread_itr), location[0]);
+    }
+  }
+  EXPECT_GE(pool.GetReservedSize(),
+            thread_count * type::ArenaPool::CHUNK_SIZE);
+}
+
+// Allocate from an arena pool on more threads than it keeps chunks for
+TEST_F(PoolTests, ArenaPoolSharedChunkTest) {
+  type::ArenaPool pool;
+  const size_t thread_count = type::ArenaPool::MAX_THREAD_COUNT + 4;
+  const size_t allocation_count = 100;
+  std::vector<std::vector<char *>> allocations(thread_count);
+  std::atomic<size_t> started_count(0);
+
+  LaunchParallelTest(thread_count, [&](uint64_t thread_itr) {
+    // All threads are alive at once, so some of them have no slot
+    started_count++;
+    while (started_count.load() < thread_count) {
+      std::this_thread::yield();
+    }
+    for (size_t i = 0; i < allocation_count; i++) {
+      char *location = static_cast<char *>(pool.Allocate(str_len));
+      EXPECT_TRUE(location != nullptr);
+      memset(location, static_cast<int>(thread_itr), str_len);
+      allocations[thread_itr].push_back(location);
+    }
+  });
+
+  for (size_t thread_itr = 0; thread_itr < thread_count; thread_itr++) {
+    for (auto location : allocations[thread_itr]) {
+      EXPECT_EQ(static_cast<char>(thread_itr), location[0]);
+      EXPECT_EQ(static_cast<char>(thread_itr), location[str_len - 1]);
+    }
+  }
+}
+
+// Allocate from several arena pools in turn on one thread
+TEST_F(PoolTests, ArenaPoolInTurnTest) {
+  const size_t pool_count = 8;
+  const size_t allocation_count = 1000;
+  std::vector<std::unique_ptr<type::ArenaPool>> pools;
+  for (size_t pool_itr = 0; pool_itr < pool_count; pool_itr++) {
+    pools.emplace_back(new type::ArenaPool());
+  }
+
+  for (size_t i = 0; i < allocation_count; i++) {
+    for (auto &pool : pools) {
+      EXPECT_TRUE(pool->Allocate(16) != nullptr);
+    }
+  }
+
+  // Every pool kept its chunk while the thread allocated from the others
+  for (auto &pool : pools) {
+    EXPECT_EQ(type::ArenaPool::CHUNK_SIZE, pool->GetReservedSize());
+  }
+}
+
 }
 }
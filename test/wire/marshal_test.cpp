@@ -0,0 +1,200 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// marshal_test.cpp
+//
+// Identification: test/wire/marshal_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "storage/tile.h"
+#include "storage/tile_group_header.h"
+#include "tcop/tcop.h"
+#include "type/value_factory.h"
+#include "wire/marshal.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Marshal Tests
+//===--------------------------------------------------------------------===//
+
+class MarshalTests : public PelotonTest {};
+
+// Read the DataRow field at the cursor, returning its length and advancing
+// the cursor past it
+static int GetField(const wire::OutputPacket &pkt, size_t &ptr,
+                    std::vector<uchar> &content) {
+  int32_t len = 0;
+  for (int i = 0; i < 4; i++) {
+    len = (len << 8) | pkt.buf[ptr++];
+  }
+  content.clear();
+  if (len > 0) {
+    content.insert(content.end(), pkt.buf.begin() + ptr,
+                   pkt.buf.begin() + ptr + len);
+    ptr += len;
+  }
+  return len;
+}
+
+static int64_t GetBigEndian(const std::vector<uchar> &content) {
+  int64_t value = 0;
+  for (auto byte : content) {
+    value = (value << 8) | byte;
+  }
+  return value;
+}
+
+TEST_F(MarshalTests, TileFieldTest) {
+  std::vector<catalog::Column> columns = {
+      catalog::Column(type::Type::INTEGER,
+                      type::Type::GetTypeSize(type::Type::INTEGER), "A", true),
+      catalog::Column(type::Type::BIGINT,
+                      type::Type::GetTypeSize(type::Type::BIGINT), "B", true),
+      catalog::Column(type::Type::DECIMAL,
+                      type::Type::GetTypeSize(type::Type::DECIMAL), "C", true),
+      catalog::Column(type::Type::TIMESTAMP,
+                      type::Type::GetTypeSize(type::Type::TIMESTAMP), "D",
+                      true),
+      catalog::Column(type::Type::VARCHAR, 25, "E", false),
+      catalog::Column(type::Type::SMALLINT,
+                      type::Type::GetTypeSize(type::Type::SMALLINT), "F",
+                      true)};
+  catalog::Schema schema(columns);
+
+  const int tuple_count = 2;
+  std::unique_ptr<storage::TileGroupHeader> header(
+      new storage::TileGroupHeader(BackendType::MM, tuple_count));
+  std::unique_ptr<storage::Tile> tile(storage::TileFactory::GetTile(
+      BackendType::MM, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
+      header.get(), schema, nullptr, tuple_count));
+
+  // 2000-01-02 00:00:01 in the packed timestamp layout
+  uint64_t timestamp =
+      ((((UINT64_C(1) * 32 + 2) * 27 + 12) * 10000 + 2000) * 100000 + 1) *
+      1000000;
+
+  tile->SetValue(type::ValueFactory::GetIntegerValue(-7), 0, 0);
+  tile->SetValue(type::ValueFactory::GetBigIntValue(INT64_C(1) << 40), 0, 1);
+  tile->SetValue(type::ValueFactory::GetDecimalValue(1.5), 0, 2);
+  tile->SetValue(type::ValueFactory::GetTimestampValue(timestamp), 0, 3);
+  tile->SetValue(type::ValueFactory::GetVarcharValue("peloton"), 0, 4);
+  tile->SetValue(type::ValueFactory::GetSmallIntValue(300), 0, 5);
+
+  for (oid_t column_id = 0; column_id < schema.GetColumnCount();
+       column_id++) {
+    tile->SetValue(type::ValueFactory::GetNullValueByType(
+                       schema.GetType(column_id)),
+                   1, column_id);
+  }
+
+  std::vector<uchar> content;
+
+  // Binary format
+  wire::OutputPacket binary_pkt;
+  binary_pkt.Reset();
+  for (oid_t column_id = 0; column_id < schema.GetColumnCount();
+       column_id++) {
+    wire::PacketPutTileField(&binary_pkt, tile.get(), 0, column_id, 1);
+  }
+  EXPECT_EQ(binary_pkt.buf.size(), binary_pkt.len);
+
+  size_t ptr = 0;
+  EXPECT_EQ(4, GetField(binary_pkt, ptr, content));
+  EXPECT_EQ(-7, static_cast<int32_t>(GetBigEndian(content)));
+  EXPECT_EQ(8, GetField(binary_pkt, ptr, content));
+  EXPECT_EQ(INT64_C(1) << 40, GetBigEndian(content));
+  EXPECT_EQ(8, GetField(binary_pkt, ptr, content));
+  int64_t bits = GetBigEndian(content);
+  double decimal;
+  PL_MEMCPY(&decimal, &bits, sizeof(double));
+  EXPECT_EQ(1.5, decimal);
+  EXPECT_EQ(8, GetField(binary_pkt, ptr, content));
+  EXPECT_EQ(INT64_C(86401000000), GetBigEndian(content));
+  EXPECT_EQ(7, GetField(binary_pkt, ptr, content));
+  EXPECT_EQ("peloton", std::string(content.begin(), content.end()));
+  EXPECT_EQ(2, GetField(binary_pkt, ptr, content));
+  EXPECT_EQ(300, GetBigEndian(content));
+  EXPECT_EQ(binary_pkt.len, ptr);
+
+  // Text format matches the strings of the values
+  wire::OutputPacket text_pkt;
+  text_pkt.Reset();
+  for (oid_t column_id = 0; column_id < schema.GetColumnCount();
+       column_id++) {
+    wire::PacketPutTileField(&text_pkt, tile.get(), 0, column_id, 0);
+  }
+
+  ptr = 0;
+  for (oid_t column_id = 0; column_id < schema.GetColumnCount();
+       column_id++) {
+    auto expected = tile->GetValue(0, column_id).ToString();
+    EXPECT_EQ(static_cast<int>(expected.size()),
+              GetField(text_pkt, ptr, content));
+    EXPECT_EQ(expected, std::string(content.begin(), content.end()));
+  }
+  EXPECT_EQ(text_pkt.len, ptr);
+
+  // NULLs in both formats
+  for (int format = 0; format <= 1; format++) {
+    wire::OutputPacket null_pkt;
+    null_pkt.Reset();
+    for (oid_t column_id = 0; column_id < schema.GetColumnCount();
+         column_id++) {
+      wire::PacketPutTileField(&null_pkt, tile.get(), 1, column_id, format);
+    }
+
+    ptr = 0;
+    for (oid_t column_id = 0; column_id < schema.GetColumnCount();
+         column_id++) {
+      EXPECT_EQ(NULL_CONTENT_SIZE, GetField(null_pkt, ptr, content));
+    }
+    EXPECT_EQ(null_pkt.len, ptr);
+  }
+}
+
+TEST_F(MarshalTests, SetIntTest) {
+  wire::OutputPacket pkt;
+  pkt.Reset();
+  wire::PacketPutByte(&pkt, 'D');
+  wire::PacketPutInt(&pkt, 0, 4);
+  wire::PacketPutInt64(&pkt, -2);
+  wire::PacketSetInt(&pkt, 1, pkt.len - 1);
+
+  EXPECT_EQ(13, pkt.len);
+  std::vector<uchar> expected = {'D',  0,    0,    0,    12,   0xff, 0xff,
+                                 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe};
+  EXPECT_EQ(expected, pkt.buf);
+}
+
+TEST_F(MarshalTests, BinaryFormatTest) {
+  // The types that tile fields are described with all have an encoding
+  tcop::TrafficCop traffic_cop;
+  for (auto type_id : {type::Type::BOOLEAN, type::Type::SMALLINT,
+                       type::Type::INTEGER, type::Type::BIGINT,
+                       type::Type::DECIMAL, type::Type::TIMESTAMP,
+                       type::Type::VARCHAR, type::Type::VARBINARY}) {
+    auto field = traffic_cop.GetColumnFieldForValueType("a", type_id);
+    EXPECT_TRUE(wire::HasBinaryFormat(
+        static_cast<PostgresValueType>(std::get<1>(field))));
+  }
+
+  // Others are sent as text
+  EXPECT_FALSE(wire::HasBinaryFormat(PostgresValueType::DECIMAL));
+  EXPECT_FALSE(wire::HasBinaryFormat(PostgresValueType::DATE));
+  EXPECT_FALSE(wire::HasBinaryFormat(PostgresValueType::INT4_ARRAY));
+}
+
+}  // namespace test
+}  // namespace peloton